@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_chan
+ * @{
+ *
+ * @file
+ * @brief       Buffer channel implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "chan.h"
+#include "irq.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+void chan_pool_init(chan_pool_t *pool, void *mem, uint16_t size,
+                    uint16_t numof)
+{
+    assert(((uintptr_t)mem % sizeof(void *)) == 0);
+
+    uint8_t *pos = mem;
+
+    pool->free = NULL;
+    pool->size = size;
+    pool->avail = numof;
+    for (unsigned i = 0; i < numof; i++) {
+        chan_buf_t *buf = (chan_buf_t *)(uintptr_t)pos;
+
+        buf->pool = pool;
+        buf->refs = 0;
+        buf->next = pool->free;
+        pool->free = buf;
+        pos += CHAN_BUF_SIZE(size);
+    }
+}
+
+chan_buf_t *chan_buf_alloc(chan_pool_t *pool)
+{
+    unsigned irqstate = irq_disable();
+    chan_buf_t *buf = pool->free;
+
+    if (buf) {
+        pool->free = buf->next;
+        pool->avail--;
+        buf->next = NULL;
+        buf->refs = 1;
+        buf->len = 0;
+        buf->type = 0;
+    }
+    irq_restore(irqstate);
+
+    DEBUG("chan: allocated %p from pool %p\n", (void *)buf, (void *)pool);
+    return buf;
+}
+
+void chan_buf_hold(chan_buf_t *buf)
+{
+    unsigned irqstate = irq_disable();
+
+    assert((buf->refs > 0) && (buf->refs < UINT8_MAX));
+    buf->refs++;
+    irq_restore(irqstate);
+}
+
+void chan_buf_release(chan_buf_t *buf)
+{
+    unsigned irqstate = irq_disable();
+
+    assert(buf->refs > 0);
+    if (--buf->refs == 0) {
+        chan_pool_t *pool = buf->pool;
+
+        DEBUG("chan: returning %p to pool %p\n", (void *)buf, (void *)pool);
+        buf->next = pool->free;
+        pool->free = buf;
+        pool->avail++;
+    }
+    irq_restore(irqstate);
+}
+
+void chan_init(chan_t *chan, chan_pool_t *pool, msg_t *queue,
+               unsigned queue_size)
+{
+    mbox_init(&chan->mbox, queue, queue_size);
+    chan->pool = pool;
+#ifdef MODULE_CORE_THREAD_FLAGS
+    chan->notify = NULL;
+    chan->flags = 0;
+#endif
+}
+
+#ifdef MODULE_CORE_THREAD_FLAGS
+void chan_notify(chan_t *chan, thread_t *thread, thread_flags_t flags)
+{
+    unsigned irqstate = irq_disable();
+
+    chan->notify = thread;
+    chan->flags = flags;
+    irq_restore(irqstate);
+}
+#endif
+
+int _chan_send(chan_t *chan, chan_buf_t *buf, int blocking)
+{
+    assert(buf->pool == chan->pool);
+    assert(!blocking || !irq_is_in());
+
+    msg_t msg = { .content = { .ptr = buf } };
+
+    if (!_mbox_put(&chan->mbox, &msg, blocking)) {
+        return 0;
+    }
+
+#ifdef MODULE_CORE_THREAD_FLAGS
+    thread_t *notify = chan->notify;
+
+    if (notify) {
+        thread_flags_set(notify, chan->flags);
+    }
+#endif
+    return 1;
+}
+
+unsigned _chan_recv(chan_t *chan, chan_buf_t **bufs, unsigned numof,
+                    int blocking)
+{
+    assert(numof > 0);
+    assert(!blocking || !irq_is_in());
+
+    msg_t msg;
+    unsigned received = 0;
+
+    if (!_mbox_get(&chan->mbox, &msg, blocking)) {
+        return 0;
+    }
+
+    do {
+        bufs[received++] = msg.content.ptr;
+    } while ((received < numof) && _mbox_get(&chan->mbox, &msg, NON_BLOCKING));
+
+    return received;
+}
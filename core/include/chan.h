@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_chan Buffer channels
+ * @ingroup     core
+ * @brief       Passes reference counted buffers between threads without
+ *              copying their payload
+ *
+ * A @ref msg_t only carries 32 bits of content, so larger payloads are
+ * usually passed as a pointer in it, with the ownership of the memory agreed
+ * upon case by case. Channels make this explicit: the payload is stored in a
+ * buffer taken from a pool of equally sized buffers (@ref chan_pool_t), and
+ * sending a buffer through a channel (@ref chan_t) passes the reference of
+ * the sender to the receiver. Whoever drops the last reference with
+ * chan_buf_release() returns the buffer to its pool.
+ *
+ * A channel only accepts buffers of the pool it was initialized with, so a
+ * receiver knows the size and layout of what it gets. To send the same
+ * buffer to several channels, the sender takes an additional reference for
+ * every further channel with chan_buf_hold().
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * chan_buf_t *buf = chan_buf_alloc(&pool);
+ * buf->len = sensor_read(chan_buf_data(buf), chan_pool_buf_size(&pool));
+ * chan_send(&chan, buf);
+ *
+ * ...
+ *
+ * chan_buf_t *buf = chan_recv(&chan);
+ * process(chan_buf_data(buf), buf->len);
+ * chan_buf_release(buf);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Channels are built on @ref core_mbox "mailboxes", so senders block while
+ * the queue is full and receivers while it is empty, and chan_try_send() and
+ * chan_try_recv() return right away instead. The non-blocking functions and
+ * the buffer functions can be used in interrupt context. With
+ * `core_thread_flags`, a channel can set thread flags on every buffer
+ * queued, so that a thread can wait for channels along with other events.
+ *
+ * This API is optional and must be enabled by adding "core_chan" to
+ * USEMODULE.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Buffer channel API
+ */
+
+#ifndef CHAN_H
+#define CHAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mbox.h"
+#ifdef MODULE_CORE_THREAD_FLAGS
+#include "thread_flags.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of a buffer pool
+ */
+typedef struct chan_pool chan_pool_t;
+
+/**
+ * @brief   Buffer header, followed by the payload
+ */
+typedef struct chan_buf {
+    struct chan_buf *next;  /**< next free buffer, only valid in the pool */
+    chan_pool_t *pool;      /**< pool the buffer belongs to */
+    uint16_t len;           /**< number of valid payload bytes, maintained
+                                 by the user */
+    uint8_t refs;           /**< number of references held */
+    uint8_t type;           /**< free for use, e.g. to tell apart different
+                                 kinds of payload */
+} chan_buf_t;
+
+/**
+ * @brief   Pool of equally sized buffers
+ */
+struct chan_pool {
+    chan_buf_t *free;       /**< list of free buffers */
+    uint16_t size;          /**< payload bytes per buffer */
+    uint16_t avail;         /**< number of free buffers */
+};
+
+/**
+ * @brief   Channel of buffers of one pool
+ */
+typedef struct {
+    mbox_t mbox;            /**< queue of the buffers sent */
+    chan_pool_t *pool;      /**< pool of the buffers passed */
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+    thread_t *notify;       /**< thread to set @ref chan_t::flags on */
+    thread_flags_t flags;   /**< flags set on every buffer queued */
+#endif
+} chan_t;
+
+/**
+ * @brief   Memory needed for a buffer with @p size bytes of payload
+ */
+#define CHAN_BUF_SIZE(size) \
+    (sizeof(chan_buf_t) + (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1)))
+
+/**
+ * @brief   Initialize a pool
+ *
+ * @p mem must be aligned to the size of a pointer and hold
+ * `numof * CHAN_BUF_SIZE(size)` bytes.
+ *
+ * @param[out]  pool    pool to initialize
+ * @param[in]   mem     memory of the buffers
+ * @param[in]   size    payload bytes per buffer
+ * @param[in]   numof   number of buffers
+ */
+void chan_pool_init(chan_pool_t *pool, void *mem, uint16_t size,
+                    uint16_t numof);
+
+/**
+ * @brief   Get the payload size of the buffers of a pool
+ *
+ * @param[in]   pool    pool to query
+ *
+ * @return  payload bytes per buffer
+ */
+static inline uint16_t chan_pool_buf_size(const chan_pool_t *pool)
+{
+    return pool->size;
+}
+
+/**
+ * @brief   Get the number of free buffers of a pool
+ *
+ * @param[in]   pool    pool to query
+ *
+ * @return  number of buffers chan_buf_alloc() can take without failing
+ */
+static inline uint16_t chan_pool_avail(const chan_pool_t *pool)
+{
+    return pool->avail;
+}
+
+/**
+ * @brief   Take a buffer from a pool
+ *
+ * The caller holds the only reference to the buffer, its
+ * chan_buf_t::len and chan_buf_t::type are 0.
+ *
+ * @param[in]   pool    pool to take the buffer from
+ *
+ * @return  the buffer
+ * @return  NULL if all buffers are in use
+ */
+chan_buf_t *chan_buf_alloc(chan_pool_t *pool);
+
+/**
+ * @brief   Take an additional reference to a buffer
+ *
+ * @pre     The caller holds a reference to @p buf
+ *
+ * @param[in]   buf     buffer to reference
+ */
+void chan_buf_hold(chan_buf_t *buf);
+
+/**
+ * @brief   Drop a reference to a buffer
+ *
+ * The buffer is returned to its pool when the last reference is dropped.
+ *
+ * @param[in]   buf     buffer to release
+ */
+void chan_buf_release(chan_buf_t *buf);
+
+/**
+ * @brief   Get the payload of a buffer
+ *
+ * @param[in]   buf     buffer
+ *
+ * @return  payload, aligned to the size of a pointer
+ */
+static inline void *chan_buf_data(chan_buf_t *buf)
+{
+    return (uint8_t *)buf + sizeof(chan_buf_t);
+}
+
+/**
+ * @brief   Initialize a channel
+ *
+ * @note    The queue size must be a power of two!
+ *
+ * @param[out]  chan        channel to initialize
+ * @param[in]   pool        pool of the buffers passed through @p chan
+ * @param[in]   queue       array of msg_t used as queue
+ * @param[in]   queue_size  number of msg_t objects in @p queue
+ */
+void chan_init(chan_t *chan, chan_pool_t *pool, msg_t *queue,
+               unsigned queue_size);
+
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+/**
+ * @brief   Set thread flags on every buffer queued in a channel
+ *
+ * The flags are set after the buffer was queued, so the notified thread
+ * receives it with chan_try_recv() or chan_try_recv_batch().
+ *
+ * @param[in]   chan    channel to watch
+ * @param[in]   thread  thread to notify, NULL to stop notifying
+ * @param[in]   flags   flags to set on @p thread
+ */
+void chan_notify(chan_t *chan, thread_t *thread, thread_flags_t flags);
+#endif
+
+/**
+ * @brief   Send a buffer through a channel
+ *
+ * @internal
+ *
+ * @param[in]   chan        channel to send through
+ * @param[in]   buf         buffer to send
+ * @param[in]   blocking    block if 1, don't block if 0
+ *
+ * @return  1   if @p buf was queued
+ * @return  0   otherwise
+ */
+int _chan_send(chan_t *chan, chan_buf_t *buf, int blocking);
+
+/**
+ * @brief   Receive buffers from a channel
+ *
+ * @internal
+ *
+ * @param[in]   chan        channel to receive from
+ * @param[out]  bufs        received buffers
+ * @param[in]   numof       maximum number of buffers to receive
+ * @param[in]   blocking    block until a buffer is available if 1,
+ *                          don't block if 0
+ *
+ * @return  number of buffers received
+ */
+unsigned _chan_recv(chan_t *chan, chan_buf_t **bufs, unsigned numof,
+                    int blocking);
+
+/**
+ * @brief   Send a buffer through a channel
+ *
+ * If the queue of the channel is full, this function blocks until there is
+ * room. The reference of the caller is passed to the receiver.
+ *
+ * @pre     @p buf belongs to the pool of @p chan
+ *
+ * @param[in]   chan    channel to send through
+ * @param[in]   buf     buffer to send
+ */
+static inline void chan_send(chan_t *chan, chan_buf_t *buf)
+{
+    _chan_send(chan, buf, BLOCKING);
+}
+
+/**
+ * @brief   Send a buffer through a channel without blocking
+ *
+ * @pre     @p buf belongs to the pool of @p chan
+ *
+ * @param[in]   chan    channel to send through
+ * @param[in]   buf     buffer to send
+ *
+ * @return  1   if @p buf was queued, the reference of the caller was passed
+ *              to the receiver
+ * @return  0   if the queue is full, the caller still holds its reference
+ */
+static inline int chan_try_send(chan_t *chan, chan_buf_t *buf)
+{
+    return _chan_send(chan, buf, NON_BLOCKING);
+}
+
+/**
+ * @brief   Receive a buffer from a channel
+ *
+ * If the channel is empty, this function blocks until a buffer is sent.
+ * The caller has to release the buffer.
+ *
+ * @param[in]   chan    channel to receive from
+ *
+ * @return  received buffer
+ */
+static inline chan_buf_t *chan_recv(chan_t *chan)
+{
+    chan_buf_t *buf;
+
+    _chan_recv(chan, &buf, 1, BLOCKING);
+    return buf;
+}
+
+/**
+ * @brief   Receive a buffer from a channel without blocking
+ *
+ * @param[in]   chan    channel to receive from
+ *
+ * @return  received buffer, to be released by the caller
+ * @return  NULL if the channel is empty
+ */
+static inline chan_buf_t *chan_try_recv(chan_t *chan)
+{
+    chan_buf_t *buf;
+
+    return _chan_recv(chan, &buf, 1, NON_BLOCKING) ? buf : NULL;
+}
+
+/**
+ * @brief   Receive all queued buffers up to a maximum
+ *
+ * If the channel is empty, this function blocks until a buffer is sent.
+ *
+ * @param[in]   chan    channel to receive from
+ * @param[out]  bufs    received buffers, to be released by the caller
+ * @param[in]   numof   maximum number of buffers to receive, at least one
+ *
+ * @return  number of buffers received
+ */
+static inline unsigned chan_recv_batch(chan_t *chan, chan_buf_t **bufs,
+                                       unsigned numof)
+{
+    return _chan_recv(chan, bufs, numof, BLOCKING);
+}
+
+/**
+ * @brief   Receive all queued buffers up to a maximum without blocking
+ *
+ * @param[in]   chan    channel to receive from
+ * @param[out]  bufs    received buffers, to be released by the caller
+ * @param[in]   numof   maximum number of buffers to receive
+ *
+ * @return  number of buffers received, 0 if the channel is empty
+ */
+static inline unsigned chan_try_recv_batch(chan_t *chan, chan_buf_t **bufs,
+                                           unsigned numof)
+{
+    return _chan_recv(chan, bufs, numof, NON_BLOCKING);
+}
+
+/**
+ * @brief   Get the number of buffers queued in a channel
+ *
+ * @param[in]   chan    channel to query
+ *
+ * @return  number of buffers that can be received without blocking
+ */
+static inline size_t chan_avail(chan_t *chan)
+{
+    return mbox_avail(&chan->mbox);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAN_H */
+/** @} */
@@ -91,6 +91,29 @@
  *       `MUTEX_LOCK`.
  *     - The scheduler is run, so that if the unblocked waiting thread can
  *       run now, in case it has a higher priority than the running thread.
+ *
+ * Priority Inheritance
+ * --------------------
+ *
+ * With the `core_mutex_priority_inheritance` module, a mutex remembers the
+ * thread holding it. A thread blocking on the mutex lends its priority to
+ * that thread, so that threads with a priority in between cannot delay the
+ * thread holding the mutex and thereby the blocked thread indefinitely
+ * (priority inversion). If the holder is itself blocked on another mutex, the
+ * priority is passed on along the chain.
+ *
+ * Every thread keeps a list of the mutexes it holds. When it releases one of
+ * them, its priority is set back to the highest priority of the threads still
+ * waiting for the others, or to its own one if none is waiting. Hence nested
+ * mutexes can be released in any order. The same happens when a waiter gives
+ * up early through @ref mutex_cancel, e.g. on the timeout of
+ * `ztimer_mutex_lock_timeout()`.
+ *
+ * Mutexes statically initialized with @ref MUTEX_INIT_LOCKED have no holder
+ * until they are unlocked for the first time, so no priority is passed on for
+ * them. Changing the priority of a thread with sched_change_priority() while
+ * it holds mutexes is undone once it releases them.
+ *
  * @{
  *
  * @file
@@ -120,13 +143,25 @@ extern "C" {
 /**
  * @brief Mutex structure. Must never be modified by the user.
  */
-typedef struct {
+typedef struct _mutex {
     /**
      * @brief   The process waiting queue of the mutex. **Must never be changed
      *          by the user.**
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, if known
+     * @internal
+     */
+    thread_t *owner;
+    /**
+     * @brief   The mutex the owner locked before this one
+     * @internal
+     */
+    struct _mutex *owner_next;
+#endif
 } mutex_t;
 
 /**
@@ -141,16 +176,29 @@ typedef struct {
     uint8_t cancelled;  /**< Flag whether the mutex has been cancelled */
 } mutex_cancel_t;
 
+/**
+ * @cond INTERNAL
+ * @brief Static initializer for the fields used for priority inheritance
+ */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_OWNER , NULL, NULL
+#else
+#define MUTEX_INIT_OWNER
+#endif
+/**
+ * @endcond
+ */
+
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL } MUTEX_INIT_OWNER }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
-#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } MUTEX_INIT_OWNER }
 
 /**
  * @cond INTERNAL
@@ -171,8 +219,24 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = NULL;
+#endif
 }
 
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+/**
+ * @brief   Record that a thread now holds a mutex
+ *
+ * @internal
+ * @pre     IRQs are disabled
+ *
+ * @param[in,out]   mutex   The mutex that was just locked
+ * @param[in,out]   thread  The thread holding @p mutex now
+ */
+void mutex_owner_set(mutex_t *mutex, thread_t *thread);
+#endif
+
 /**
  * @brief   Initialize a mutex cancellation structure
  * @param   mutex       The mutex that the calling thread wants to lock
@@ -231,6 +295,9 @@ static inline int mutex_trylock(mutex_t *mutex)
 
     if (mutex->queue.next == NULL) {
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        mutex_owner_set(mutex, thread_get_active());
+#endif
         retval = 1;
     }
     irq_restore(irq_state);
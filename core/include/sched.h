@@ -194,6 +194,28 @@ typedef enum {
 #define SCHED_PRIO_LEVELS 16
 #endif
 
+#if IS_USED(MODULE_SCHED_EDF) || defined(DOXYGEN)
+/**
+ * @brief   Priority whose runqueue is ordered by deadline
+ *
+ * Threads of this priority are scheduled earliest deadline first (see
+ * @ref sys_sched_edf) instead of in FIFO order. The default is one above
+ * @ref THREAD_PRIORITY_MAIN, which system threads use as well. Those have
+ * no deadline, so they run in FIFO order once no thread with a deadline is
+ * pending.
+ */
+#ifndef CONFIG_SCHED_EDF_PRIO
+#define CONFIG_SCHED_EDF_PRIO (SCHED_PRIO_LEVELS / 2 - 2)
+#endif
+
+/**
+ * @brief   Deadline of threads that have none
+ *
+ * Such threads are queued in FIFO order behind all threads with a deadline.
+ */
+#define SCHED_EDF_NO_DEADLINE   (0U)
+#endif
+
 /**
  * @brief   Triggers the scheduler to schedule the next thread
  *
@@ -262,6 +284,9 @@ NORETURN void sched_task_exit(void);
  *
  * @note    This functions expects interrupts to be disabled when called!
  *
+ * May be called from an ISR, the context switch then happens when the ISR
+ * returns.
+ *
  * @pre     (thread != NULL)
  * @pre     (priority < SCHED_PRIO_LEVELS)
  *
@@ -270,6 +295,23 @@ NORETURN void sched_task_exit(void);
  */
 void sched_change_priority(thread_t *thread, uint8_t priority);
 
+#if IS_USED(MODULE_SCHED_EDF) || defined(DOXYGEN)
+/**
+ * @brief   Set the absolute deadline of the given thread
+ *
+ * If @p thread is in the runqueue of @ref CONFIG_SCHED_EDF_PRIO, it is moved
+ * to its new position. This function does not yield, even if @p thread is
+ * the active thread and no longer has the earliest deadline.
+ * @ref SCHED_EDF_NO_DEADLINE removes the deadline of @p thread.
+ *
+ * @pre     (thread != NULL)
+ *
+ * @param[in,out] thread    target thread
+ * @param[in]     deadline  new deadline in microseconds of `ZTIMER_USEC`
+ */
+void sched_set_deadline(thread_t *thread, uint32_t deadline);
+#endif
+
 /**
  * @brief  Set CPU to idle mode (CPU dependent)
  *
@@ -322,6 +364,12 @@ void sched_register_cb(sched_callback_t callback);
  */
 static inline void sched_runq_advance(uint8_t prio)
 {
+#if IS_USED(MODULE_SCHED_EDF)
+    if (prio == CONFIG_SCHED_EDF_PRIO) {
+        /* the order of this runqueue is given by the deadlines */
+        return;
+    }
+#endif
     clist_lpoprpush(&sched_runqueues[prio]);
 }
 
@@ -33,6 +33,7 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#include "sched_trace.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -104,6 +105,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
 
     thread_t *me = thread_get_active();
 
+    sched_trace_record(SCHED_TRACE_MSG_SEND, target_pid, m->type);
+
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
           ". block=%i src->state=%i target->state=%i\n", RIOT_FILE_RELATIVE,
           __LINE__, thread_getpid(), target_pid,
@@ -185,6 +188,7 @@ int msg_send_to_self(msg_t *m)
     unsigned state = irq_disable();
 
     m->sender_pid = thread_getpid();
+    sched_trace_record(SCHED_TRACE_MSG_SEND, m->sender_pid, m->type);
     int res = queue_msg(thread_get_active(), m);
 
     irq_restore(state);
@@ -206,6 +210,8 @@ static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
         return -1;
     }
 
+    sched_trace_record(SCHED_TRACE_MSG_SEND, target_pid, m->type);
+
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("%s: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", __func__, thread_getpid(), target_pid);
@@ -284,7 +290,12 @@ int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
      * overwritten if the target is not in RECEIVE_BLOCKED */
     *reply = *m;
     /* msg_send blocks until reply received */
-    return _msg_send(reply, target_pid, true, state);
+    int res = _msg_send(reply, target_pid, true, state);
+
+    if (res == 1) {
+        sched_trace_record(SCHED_TRACE_MSG_RECV, target_pid, reply->type);
+    }
+    return res;
 }
 
 int msg_reply(msg_t *m, msg_t *reply)
@@ -305,6 +316,7 @@ int msg_reply(msg_t *m, msg_t *reply)
 
     DEBUG("msg_reply(): %" PRIkernel_pid ": Direct msg copy.\n",
           thread_getpid());
+    sched_trace_record(SCHED_TRACE_MSG_SEND, target->pid, reply->type);
     /* copy msg to target */
     msg_t *target_message = (msg_t *)target->wait_data;
 
@@ -329,6 +341,8 @@ int msg_reply_int(msg_t *m, msg_t *reply)
         return -1;
     }
 
+    sched_trace_record(SCHED_TRACE_MSG_SEND, target->pid, reply->type);
+
     msg_t *target_message = (msg_t *)target->wait_data;
 
     *target_message = *reply;
@@ -339,12 +353,20 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res == 1) {
+        sched_trace_record(SCHED_TRACE_MSG_RECV, m->sender_pid, m->type);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    sched_trace_record(SCHED_TRACE_MSG_RECV, m->sender_pid, m->type);
+    return res;
 }
 
 static int _msg_receive(msg_t *m, int block)
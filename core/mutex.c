@@ -29,12 +29,205 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#include "sched_trace.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
 #if MAXTHREADS > 1
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+void mutex_owner_set(mutex_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread;
+    if (thread == NULL) {
+        /* locked before the scheduler was started */
+        return;
+    }
+    if (thread->mutexes_held == NULL) {
+        thread->base_priority = thread->priority;
+    }
+    mutex->owner_next = thread->mutexes_held;
+    thread->mutexes_held = mutex;
+}
+
+/**
+ * @brief   Whether the owner of @p mutex is tracked
+ *
+ * Mutexes used for signalling (e.g. initialized with @ref MUTEX_INIT_LOCKED
+ * and unlocked from an ISR) have no owner. Their waiters must not become
+ * owners on wake-up either, as such mutexes are often on the stack and never
+ * unlocked again.
+ */
+static inline bool _owner_tracked(const mutex_t *mutex)
+{
+    return mutex->owner != NULL;
+}
+
+/**
+ * @brief   Priority a thread inherits from the waiters of a mutex, or
+ *          SCHED_PRIO_LEVELS if there are none
+ */
+static uint8_t _waiter_priority(const mutex_t *mutex)
+{
+    if ((mutex->queue.next == NULL) || (mutex->queue.next == MUTEX_LOCKED)) {
+        return SCHED_PRIO_LEVELS;
+    }
+    /* the queue is sorted by priority */
+    thread_t *waiter = container_of((clist_node_t *)mutex->queue.next,
+                                    thread_t, rq_entry);
+    return waiter->priority;
+}
+
+/**
+ * @brief   Priority of @p owner inherited from the waiters of the mutexes it
+ *          holds, or its own one if that is higher
+ */
+static uint8_t _owner_priority(const thread_t *owner)
+{
+    uint8_t priority = owner->base_priority;
+
+    for (const mutex_t *m = owner->mutexes_held; m != NULL; m = m->owner_next) {
+        uint8_t inherited = _waiter_priority(m);
+        if (inherited < priority) {
+            priority = inherited;
+        }
+    }
+    return priority;
+}
+
+/**
+ * @brief   Remove the owner of a mutex and compute its priority without it
+ * @pre     IRQs are disabled
+ *
+ * @return  The former owner if its priority has to be changed to
+ *          @p priority, NULL otherwise
+ */
+static thread_t *_owner_clear(mutex_t *mutex, uint8_t *priority)
+{
+    thread_t *owner = mutex->owner;
+
+    if (owner == NULL) {
+        return NULL;
+    }
+    mutex->owner = NULL;
+
+    for (mutex_t **m = &owner->mutexes_held; *m != NULL; m = &(*m)->owner_next) {
+        if (*m == mutex) {
+            *m = mutex->owner_next;
+            break;
+        }
+    }
+    *priority = _owner_priority(owner);
+
+    return (*priority != owner->priority) ? owner : NULL;
+}
+
+/**
+ * @brief   Lend the priority of the calling thread to the owner of @p mutex
+ * @pre     IRQs are disabled
+ * @pre     The calling thread has been added to the waiters of @p mutex
+ */
+static void _owner_inherit(mutex_t *mutex, thread_t *me)
+{
+    me->wait_data = mutex;
+
+    thread_t *owner = mutex->owner;
+
+    /* Pass the priority on along the chain of owners blocked on other
+     * mutexes. In case of a deadlock this stops once every thread in the
+     * cycle has the priority. */
+    while ((owner != NULL) && (owner->priority > me->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "] mutex_lock(): raising priority of %"
+              PRIkernel_pid " to %u\n", thread_getpid(), owner->pid,
+              (unsigned)me->priority);
+        sched_change_priority(owner, me->priority);
+        if (owner->status != STATUS_MUTEX_BLOCKED) {
+            break;
+        }
+        mutex = owner->wait_data;
+        /* keep the waiters sorted by priority */
+        list_remove(&mutex->queue, (list_node_t *)&owner->rq_entry);
+        thread_add_to_list(&mutex->queue, owner);
+        owner = mutex->owner;
+    }
+}
+
+/**
+ * @brief   Take back the priority a waiter that stopped waiting for @p mutex
+ *          lent to its owner
+ * @pre     IRQs are disabled
+ * @pre     The waiter has been removed from the waiters of @p mutex
+ */
+static void _owner_disinherit(mutex_t *mutex)
+{
+    thread_t *owner = mutex->owner;
+
+    /* undo what _owner_inherit() passed on along the chain of owners */
+    while (owner != NULL) {
+        uint8_t priority = _owner_priority(owner);
+
+        if (priority == owner->priority) {
+            break;
+        }
+        DEBUG("PID[%" PRIkernel_pid "] mutex_cancel(): setting priority of %"
+              PRIkernel_pid " back to %u\n", thread_getpid(), owner->pid,
+              (unsigned)priority);
+        sched_change_priority(owner, priority);
+        if (owner->status != STATUS_MUTEX_BLOCKED) {
+            break;
+        }
+        mutex = owner->wait_data;
+        list_remove(&mutex->queue, (list_node_t *)&owner->rq_entry);
+        thread_add_to_list(&mutex->queue, owner);
+        owner = mutex->owner;
+    }
+}
+#else
+static inline void mutex_owner_set(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline bool _owner_tracked(const mutex_t *mutex)
+{
+    (void)mutex;
+    return false;
+}
+
+static inline thread_t *_owner_clear(mutex_t *mutex, uint8_t *priority)
+{
+    (void)mutex;
+    (void)priority;
+    return NULL;
+}
+
+static inline void _owner_inherit(mutex_t *mutex, thread_t *me)
+{
+    (void)mutex;
+    (void)me;
+}
+
+static inline void _owner_disinherit(mutex_t *mutex)
+{
+    (void)mutex;
+}
+#endif
+
+/**
+ * @brief   Give up the priority inherited for a mutex no longer held
+ *
+ * Called after IRQs are restored, so that the owner yields right away if its
+ * priority drops. May be called from an ISR.
+ */
+static inline void _owner_restore(thread_t *owner, uint8_t priority)
+{
+    if (owner != NULL) {
+        sched_change_priority(owner, priority);
+    }
+}
+
 /**
  * @brief   Block waiting for a locked mutex
  * @pre     IRQs are disabled
@@ -65,10 +258,13 @@ static inline __attribute__((always_inline)) void _block(mutex_t *mutex,
     else {
         thread_add_to_list(&mutex->queue, me);
     }
+    _owner_inherit(mutex, me);
+    sched_trace_record(SCHED_TRACE_MUTEX_BLOCK, 0, (uintptr_t)mutex);
 
     irq_restore(irq_state);
     thread_yield_higher();
     /* We were woken up by scheduler. Waker removed us from queue. */
+    sched_trace_record(SCHED_TRACE_MUTEX_WAKE, 0, (uintptr_t)mutex);
 }
 
 void mutex_lock(mutex_t *mutex)
@@ -80,6 +276,7 @@ void mutex_lock(mutex_t *mutex)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        mutex_owner_set(mutex, thread_get_active());
         DEBUG("PID[%" PRIkernel_pid "] mutex_lock(): early out.\n",
               thread_getpid());
         irq_restore(irq_state);
@@ -108,6 +305,7 @@ int mutex_lock_cancelable(mutex_cancel_t *mc)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        mutex_owner_set(mutex, thread_get_active());
         DEBUG("PID[%" PRIkernel_pid "] mutex_lock_cancelable() early out.\n",
               thread_getpid());
         irq_restore(irq_state);
@@ -136,10 +334,15 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    uint8_t owner_priority = 0;
+    bool tracked = _owner_tracked(mutex);
+    thread_t *owner = _owner_clear(mutex, &owner_priority);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+        _owner_restore(owner, owner_priority);
         return;
     }
 
@@ -154,10 +357,14 @@ void mutex_unlock(mutex_t *mutex)
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
+    if (tracked) {
+        mutex_owner_set(mutex, process);
+    }
 
     uint16_t process_priority = process->priority;
 
     irq_restore(irqstate);
+    _owner_restore(owner, owner_priority);
     sched_switch(process_priority);
 }
 
@@ -166,8 +373,13 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     DEBUG("PID[%" PRIkernel_pid "] mutex_unlock_and_sleep(): queue.next: %p\n",
           thread_getpid(), (void *)mutex->queue.next);
     unsigned irqstate = irq_disable();
+    uint8_t owner_priority = 0;
+    thread_t *owner = NULL;
 
     if (mutex->queue.next) {
+        bool tracked = _owner_tracked(mutex);
+
+        owner = _owner_clear(mutex, &owner_priority);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -181,6 +393,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+            if (tracked) {
+                mutex_owner_set(mutex, process);
+            }
         }
     }
 
@@ -188,6 +403,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
           thread_getpid());
     sched_set_status(thread_get_active(), STATUS_SLEEPING);
     irq_restore(irqstate);
+    _owner_restore(owner, owner_priority);
     thread_yield_higher();
 }
 
@@ -214,6 +430,7 @@ void mutex_cancel(mutex_cancel_t *mc)
         if (mutex->queue.next == NULL) {
             mutex->queue.next = MUTEX_LOCKED;
         }
+        _owner_disinherit(mutex);
         sched_set_status(thread, STATUS_PENDING);
         irq_restore(irq_state);
         sched_switch(thread->priority);
@@ -29,6 +29,7 @@
 #include "irq.h"
 #include "thread.h"
 #include "log.h"
+#include "sched_trace.h"
 
 #ifdef MODULE_MPU_STACK_GUARD
 #include "mpu.h"
@@ -196,6 +197,12 @@ thread_t *__attribute__((used)) sched_run(void)
         sched_active_pid = next_thread->pid;
         sched_active_thread = next_thread;
 
+        sched_trace_record(SCHED_TRACE_SWITCH,
+                           previous_thread ? previous_thread->pid
+                                           : KERNEL_PID_UNDEF,
+                           previous_thread ? previous_thread->status
+                                           : STATUS_NOT_FOUND);
+
 #ifdef MODULE_SCHED_CB
         if (sched_cb) {
             sched_cb(KERNEL_PID_UNDEF, next_thread->pid);
@@ -219,6 +226,36 @@ thread_t *__attribute__((used)) sched_run(void)
     return next_thread;
 }
 
+#ifdef MODULE_SCHED_EDF
+/* Inserts a thread into the EDF runqueue behind all threads whose deadline
+ * is not later than its own. Deadlines are compared relative to each other,
+ * so they may wrap around. Threads without deadline (e.g. system threads of
+ * the same priority) are queued FIFO behind all others, as comparing their
+ * deadline would order them differently every 2^31 us. */
+static void _edf_insert(thread_t *thread)
+{
+    clist_node_t *rq = &sched_runqueues[CONFIG_SCHED_EDF_PRIO];
+
+    if (rq->next && (thread->deadline != SCHED_EDF_NO_DEADLINE)) {
+        clist_node_t *prev = rq->next;
+
+        do {
+            thread_t *other = container_of(prev->next, thread_t, rq_entry);
+
+            if ((other->deadline == SCHED_EDF_NO_DEADLINE)
+                || ((int32_t)(other->deadline - thread->deadline) > 0)) {
+                thread->rq_entry.next = prev->next;
+                prev->next = &thread->rq_entry;
+                return;
+            }
+            prev = prev->next;
+        } while (prev != rq->next);
+    }
+
+    clist_rpush(rq, &thread->rq_entry);
+}
+#endif
+
 /* Note: Forcing the compiler to inline this function will reduce .text for applications
  *       not linking in sched_change_priority(), which benefits the vast majority of apps.
  */
@@ -226,6 +263,12 @@ static inline __attribute__((always_inline)) void _runqueue_push(thread_t *threa
 {
     DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu8 ".\n",
           thread->pid, priority);
+#ifdef MODULE_SCHED_EDF
+    if (priority == CONFIG_SCHED_EDF_PRIO) {
+        _edf_insert(thread);
+    }
+    else
+#endif
     clist_rpush(&sched_runqueues[priority], &(thread->rq_entry));
     _set_runqueue_bit(priority);
 
@@ -247,6 +290,14 @@ static inline __attribute__((always_inline)) void _runqueue_pop(thread_t *thread
 {
     DEBUG("sched_set_status: removing thread %" PRIkernel_pid " from runqueue %" PRIu8 ".\n",
           thread->pid, thread->priority);
+#ifdef MODULE_SCHED_EDF
+    /* a thread woken up by the active one may have been inserted in front
+     * of it */
+    if (thread->priority == CONFIG_SCHED_EDF_PRIO) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+    }
+    else
+#endif
     clist_lpop(&sched_runqueues[thread->priority]);
 
     if (!sched_runqueues[thread->priority].next) {
@@ -279,6 +330,16 @@ void sched_switch(uint16_t other_prio)
     uint16_t current_prio = active_thread->priority;
     int on_runqueue = (active_thread->status >= STATUS_ON_RUNQUEUE);
 
+#ifdef MODULE_SCHED_EDF
+    /* within the EDF priority, the thread with the earliest deadline runs */
+    if (on_runqueue && (current_prio == CONFIG_SCHED_EDF_PRIO)
+        && (other_prio == current_prio)
+        && (sched_runqueues[current_prio].next->next
+            != &active_thread->rq_entry)) {
+        on_runqueue = 0;
+    }
+#endif
+
     DEBUG("sched_switch: active pid=%" PRIkernel_pid " prio=%" PRIu16 " on_runqueue=%i "
           ", other_prio=%" PRIu16 "\n",
           active_thread->pid, current_prio, on_runqueue,
@@ -338,6 +399,10 @@ void sched_change_priority(thread_t *thread, uint8_t priority)
     unsigned irq_state = irq_disable();
 
     if (thread_is_active(thread)) {
+        /* _runqueue_pop() removes the head of the run queue, which a pending
+         * thread not necessarily is */
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        clist_lpush(&sched_runqueues[thread->priority], &thread->rq_entry);
         _runqueue_pop(thread);
         _runqueue_push(thread, priority);
     }
@@ -360,6 +425,31 @@ void sched_change_priority(thread_t *thread, uint8_t priority)
          * 2) The priority of a pending thread has been increased (lower numeric value) so that it
          *    now has priority over the running thread.
          */
-        thread_yield_higher();
+        if (irq_is_in()) {
+            /* e.g. a mutex unlocked or cancelled from an ISR */
+            sched_context_switch_request = 1;
+        }
+        else {
+            thread_yield_higher();
+        }
+    }
+}
+
+#ifdef MODULE_SCHED_EDF
+void sched_set_deadline(thread_t *thread, uint32_t deadline)
+{
+    assert(thread);
+
+    unsigned irq_state = irq_disable();
+
+    thread->deadline = deadline;
+    if ((thread->priority == CONFIG_SCHED_EDF_PRIO)
+        && (thread->status >= STATUS_ON_RUNQUEUE)) {
+        clist_remove(&sched_runqueues[CONFIG_SCHED_EDF_PRIO],
+                     &thread->rq_entry);
+        _edf_insert(thread);
     }
+
+    irq_restore(irq_state);
 }
+#endif
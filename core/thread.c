@@ -291,6 +291,15 @@ kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority,
 
     thread->rq_entry.next = NULL;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    thread->wait_data = NULL;
+    thread->mutexes_held = NULL;
+#endif
+
+#ifdef MODULE_SCHED_EDF
+    thread->deadline = SCHED_EDF_NO_DEADLINE;
+#endif
+
 #ifdef MODULE_CORE_MSG
     thread->wait_data = NULL;
     thread->msg_waiters.next = NULL;
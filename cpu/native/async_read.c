@@ -19,10 +19,14 @@
 
 #include <err.h>
 #include <signal.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
@@ -30,10 +34,16 @@
 static int _next_index;
 static struct pollfd _fds[ASYNC_READ_NUMOF];
 static async_read_t pollers[ASYNC_READ_NUMOF];
+#ifdef __linux__
+/* epoll instance watching all file descriptors, -1 if poll() is used */
+static int _epfd = -1;
+/* epoll failed for one of the file descriptors (e.g. a regular file) */
+static bool _use_poll;
+#endif
 
 static void _sigio_child(int fd);
 
-static void _async_io_isr(void) {
+static void _async_io_poll(void) {
     if (real_poll(_fds, _next_index, 0) > 0) {
         for (int i = 0; i < _next_index; i++) {
             /* handle if one of the events has happened */
@@ -44,7 +54,29 @@ static void _async_io_isr(void) {
     }
 }
 
+static void _async_io_isr(void) {
+#ifdef __linux__
+    if ((_epfd >= 0) && !_use_poll) {
+        /* only the ready file descriptors are returned, all at once */
+        struct epoll_event events[ASYNC_READ_NUMOF];
+        int n = epoll_wait(_epfd, events, ASYNC_READ_NUMOF, 0);
+
+        for (int i = 0; i < n; i++) {
+            async_read_t *poller = &pollers[events[i].data.u32];
+            poller->cb(poller->fd->fd, poller->arg);
+        }
+        return;
+    }
+#endif
+    _async_io_poll();
+}
+
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if (_epfd < 0) {
+        _epfd = epoll_create1(EPOLL_CLOEXEC);
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
@@ -57,6 +89,12 @@ void native_async_read_cleanup(void) {
             kill(pollers[i].child_pid, SIGKILL);
         }
     }
+#ifdef __linux__
+    if (_epfd >= 0) {
+        real_close(_epfd);
+        _epfd = -1;
+    }
+#endif
 }
 
 void native_async_read_continue(int fd) {
@@ -67,6 +105,34 @@ void native_async_read_continue(int fd) {
     }
 }
 
+bool native_async_read_pending(int fd) {
+    struct pollfd pfd = { .fd = fd, .events = POLLIN | POLLPRI };
+    int res;
+
+    _native_in_syscall++; /* no switching here */
+    res = real_poll(&pfd, 1, 0);
+    _native_in_syscall--;
+
+    return (res == 1) && (pfd.revents & pfd.events);
+}
+
+void native_async_read_continue_pending(int fd, bool pending) {
+    _native_in_syscall++; /* no switching here */
+
+    if (pending) {
+        /* work around lost signals: the host only signals new data */
+        int sig = SIGIO;
+        extern int _sig_pipefd[2];
+        real_write(_sig_pipefd[1], &sig, sizeof(int));
+        _native_sigpend++;
+    }
+    else {
+        native_async_read_continue(fd);
+    }
+
+    _native_in_syscall--;
+}
+
 static void _add_handler(int fd, void *arg, native_async_read_callback_t handler) {
     _fds[_next_index].fd = fd;
     _fds[_next_index].events = POLLIN | POLLPRI;
@@ -76,6 +142,16 @@ static void _add_handler(int fd, void *arg, native_async_read_callback_t handler
     poll->cb = handler;
     poll->arg = arg;
     poll->fd = &_fds[_next_index];
+
+#ifdef __linux__
+    struct epoll_event event = {
+        .events = EPOLLIN | EPOLLPRI,
+        .data.u32 = _next_index,
+    };
+    if ((_epfd < 0) || (epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &event) < 0)) {
+        _use_poll = true;
+    }
+#endif
 }
 
 void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
@@ -18,6 +18,7 @@
 #ifndef ASYNC_READ_H
 #define ASYNC_READ_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 #include <poll.h>
 
@@ -50,7 +51,9 @@ typedef struct {
 /**
  * @brief   initialize asynchronus read system
  *
- * This registers SIGIO signal handler.
+ * This registers SIGIO signal handler. On Linux, the file descriptors are
+ * watched with epoll, so the handler gets all ready file descriptors with one
+ * system call instead of polling each of them.
  */
 void native_async_read_setup(void);
 
@@ -70,6 +73,23 @@ void native_async_read_cleanup(void);
  */
 void native_async_read_continue(int fd);
 
+/**
+ * @brief   check if a file descriptor has data to read
+ * @param[in] fd  The file descriptor to check
+ * @return  true if reading from @p fd would not block
+ */
+bool native_async_read_pending(int fd);
+
+/**
+ * @brief   resume monitoring of file descriptor after reading outside of the
+ *          callback
+ * The host signals new data only, so if data is left to read, the file
+ * descriptor is signaled again right away instead.
+ * @param[in] fd       The file descriptor to monitor
+ * @param[in] pending  Result of @ref native_async_read_pending() for @p fd
+ */
+void native_async_read_continue_pending(int fd, bool pending);
+
 /**
  * @brief   start monitoring of file descriptor
  *
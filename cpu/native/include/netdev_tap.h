@@ -36,6 +36,16 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames read in one call of the ISR handler
+ *
+ * Further frames are signaled again after the handler returned, so other
+ * events get handled in between.
+ */
+#ifndef CONFIG_NETDEV_TAP_RX_BURST
+#define CONFIG_NETDEV_TAP_RX_BURST  (8U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -39,6 +39,7 @@
 #include "periph/pm.h"
 
 #include "native_internal.h"
+#include "sched_trace.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -272,7 +273,9 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+            sched_trace_record(SCHED_TRACE_ISR_ENTER, 0, sig);
             native_irq_handlers[sig]();
+            sched_trace_record(SCHED_TRACE_ISR_EXIT, 0, sig);
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
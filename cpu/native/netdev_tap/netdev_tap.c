@@ -102,8 +102,18 @@ static inline int _get_wired(netdev_t *netdev)
 
 static inline void _isr(netdev_t *netdev)
 {
+    netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
+
     if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        /* read the frames the host queued up meanwhile without waiting for
+         * another signal each */
+        unsigned n = 0;
+        bool pending;
+        do {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+            pending = native_async_read_pending(dev->tap_fd);
+        } while (pending && (++n < CONFIG_NETDEV_TAP_RX_BURST));
+        native_async_read_continue_pending(dev->tap_fd, pending);
     }
 #if DEVELHELP
     else {
@@ -193,33 +203,6 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev_tap_t *dev)
-{
-    /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->tap_fd, &rfds);
-
-    _native_in_syscall++; /* no switching here */
-
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-        int sig = SIGIO;
-        extern int _sig_pipefd[2];
-        extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
-        real_write(_sig_pipefd[1], &sig, sizeof(int));
-        _native_sigpend++;
-        DEBUG("netdev_tap: sigpend++\n");
-    }
-    else {
-        DEBUG("netdev_tap: native_async_read_continue\n");
-        native_async_read_continue(dev->tap_fd);
-    }
-
-    _native_in_syscall--;
-}
-
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
@@ -241,8 +224,6 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             static uint8_t nullbuf[ETHERNET_FRAME_LEN];
 
             real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
-
-            _continue_reading(dev);
         }
 
         /* no way of figuring out packet size without racey buffering,
@@ -268,8 +249,6 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             return 0;
         }
 
-        _continue_reading(dev);
-
         return nread;
     }
     else if (nread == -1) {
@@ -81,26 +81,8 @@ static inline size_t _zep_hdr_fill(socket_zep_t *dev, zep_hdr_t *hdr,
 
 static void _continue_reading(socket_zep_t *dev)
 {
-    /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->sock_fd, &rfds);
-
-    _native_in_syscall++; /* no switching here */
-
-    if (real_select(dev->sock_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-        int sig = SIGIO;
-        extern int _sig_pipefd[2];
-        real_write(_sig_pipefd[1], &sig, sizeof(sig));
-        _native_sigpend++;
-    }
-    else {
-        native_async_read_continue(dev->sock_fd);
-    }
-
-    _native_in_syscall--;
+    native_async_read_continue_pending(dev->sock_fd,
+                                       native_async_read_pending(dev->sock_fd));
 }
 
 static inline bool _dst_not_me(socket_zep_t *dev, const void *buf)
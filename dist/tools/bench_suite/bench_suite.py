@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Build the benchmark applications for `native`, run them and collect their
+results.
+
+The applications are built with `CONFIG_BENCHMARK_OUTPUT` set to JSON, so every
+result of the `benchmark` module is printed as one JSON object per line. The
+results of all applications are written as one JSON list (or as CSV) to stdout
+or to a file, to be compared between releases.
+
+As applications on `native` don't exit when `main()` returns, an application
+is stopped when it printed nothing for `--idle-timeout` seconds.
+
+Usage:
+
+    ./bench_suite.py [--riotbase RIOTBASE] [--csv] [--output FILE] [APP ...]
+"""
+
+import argparse
+import csv
+import json
+import os
+import select
+import subprocess
+import sys
+import time
+
+DEFAULT_APPS = [
+    "bench_fib",
+    "bench_gcoap_dispatch",
+    "bench_inet_csum",
+    "bench_lfrb",
+    "bench_msg_pingpong",
+    "bench_mutex_pingpong",
+    "bench_runtime_coreapis",
+    "bench_sched_nop",
+    "bench_sys_atomic_utils",
+    "bench_sys_base64",
+    "bench_thread_flags_pingpong",
+    "bench_thread_yield_pingpong",
+    "bench_xtimer",
+    "bench_ztimer",
+]
+
+FIELDS = ["app", "name", "unit", "samples", "runs",
+          "min", "median", "p99", "max", "mean"]
+
+
+def build(riotbase, app, jobs):
+    """Build 'app' for native and return the path of its binary"""
+    appdir = os.path.join(riotbase, "tests", app)
+    env = dict(os.environ)
+    env["BOARD"] = "native"
+    env["CFLAGS"] = (env.get("CFLAGS", "") +
+                     " -DCONFIG_BENCHMARK_OUTPUT=BENCHMARK_OUTPUT_JSON")
+    subprocess.run(["make", "-C", appdir, "-j{}".format(jobs), "all"],
+                   env=env, check=True, stdout=subprocess.DEVNULL)
+    out = subprocess.run(["make", "-C", appdir, "--no-print-directory",
+                          "info-debug-variable-ELFFILE"],
+                         env=env, check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True)
+    return out.stdout.strip().splitlines()[-1]
+
+
+def run(elffile, idle_timeout, timeout):
+    """Run 'elffile' and return the benchmark results it printed"""
+    results = []
+    proc = subprocess.Popen([elffile], stdin=subprocess.PIPE,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    # start applications waiting in test_utils_interactive_sync
+    proc.stdin.write("s\n")
+    proc.stdin.flush()
+    end = time.monotonic() + timeout
+    try:
+        while time.monotonic() < end:
+            ready, _, _ = select.select([proc.stdout], [], [], idle_timeout)
+            if not ready:
+                break
+            line = proc.stdout.readline()
+            if not line:
+                break
+            line = line.strip()
+            if line.startswith("{\"name\""):
+                results.append(json.loads(line))
+    finally:
+        proc.kill()
+        proc.wait()
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("apps", nargs="*", default=DEFAULT_APPS,
+                        help="applications in tests/ to run")
+    parser.add_argument("--riotbase", default=os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), "..", "..", ".."),
+                        help="RIOT directory")
+    parser.add_argument("--csv", action="store_true",
+                        help="write CSV instead of JSON")
+    parser.add_argument("--output", help="output file (default: stdout)")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(),
+                        help="parallel jobs for building")
+    parser.add_argument("--idle-timeout", type=float, default=10,
+                        help="seconds without output to stop an application")
+    parser.add_argument("--timeout", type=float, default=600,
+                        help="seconds to stop an application in any case")
+    args = parser.parse_args()
+
+    results = []
+    for app in args.apps:
+        print("running {}".format(app), file=sys.stderr)
+        elffile = build(args.riotbase, app, args.jobs)
+        app_results = run(elffile, args.idle_timeout, args.timeout)
+        if not app_results:
+            print("{}: no results".format(app), file=sys.stderr)
+        for result in app_results:
+            result["app"] = app
+            results.append(result)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    try:
+        if args.csv:
+            writer = csv.DictWriter(out, fieldnames=FIELDS)
+            writer.writeheader()
+            writer.writerows(results)
+        else:
+            json.dump(results, out, indent=2)
+            out.write("\n")
+    finally:
+        if args.output:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()
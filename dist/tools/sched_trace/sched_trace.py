@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Convert a dump of the `sched_trace` module to the Chrome trace event format.
+
+The input is the terminal output of an application that called
+`sched_trace_dump()` (or ran the `schedtrace dump` shell command). Other
+lines and prefixes added by the terminal are ignored. If there are several
+dumps, the last one is converted. The resulting JSON file can be opened with
+https://ui.perfetto.dev or chrome://tracing.
+
+Every thread gets a track showing when it ran. ISRs and ztimer callbacks
+called from them are shown on an extra `ISR` track. Messages are drawn as
+arrows from the sender to the receiver, the time between sending and
+receiving is an argument of the receive event. Waiting for a mutex is shown
+as an async slice.
+
+Usage:
+
+    ./sched_trace.py [--output FILE] [LOGFILE]
+"""
+
+import argparse
+import collections
+import json
+import sys
+
+DUMP_VERSION = 1
+TAG = "sched_trace: "
+
+IN_ISR = 0x80
+MSG_BUS_PID_FLAG = 0x8000
+
+(SWITCH, MSG_SEND, MSG_RECV, MUTEX_BLOCK, MUTEX_WAKE, ISR_ENTER, ISR_EXIT,
+ TIMER_ENTER, TIMER_EXIT, USER) = range(10)
+
+# thread_status_t in core/include/sched.h
+STATUS = ["stopped", "zombie", "sleeping", "mutex blocked", "receive blocked",
+          "send blocked", "reply blocked", "flag blocked any",
+          "flag blocked all", "mbox blocked", "cond blocked", "running",
+          "pending"]
+
+PID = 0
+ISR_TID = 1000
+
+
+class Dump:
+    """Threads and events of one dump"""
+
+    def __init__(self, lost, pid_isr):
+        self.lost = lost
+        self.pid_isr = pid_isr
+        self.threads = {}
+        self.events = []
+
+
+def parse(lines):
+    """Return the last complete dump in 'lines'"""
+    dump = None
+    last = None
+    for line in lines:
+        pos = line.find(TAG)
+        if pos < 0:
+            continue
+        fields = line[pos + len(TAG):].split()
+        if not fields:
+            continue
+        if fields[0] == "begin":
+            if int(fields[1]) != DUMP_VERSION:
+                sys.exit("unsupported dump version {}".format(fields[1]))
+            dump = Dump(int(fields[3]), int(fields[4]))
+        elif dump is None:
+            continue
+        elif fields[0] == "thread":
+            dump.threads[int(fields[1])] = " ".join(fields[2:]) or "-"
+        elif fields[0] == "events":
+            for event in fields[1:]:
+                dump.events.append((int(event[0:8], 16), int(event[8:10], 16),
+                                    int(event[10:12], 16),
+                                    int(event[12:16], 16),
+                                    int(event[16:24], 16)))
+        elif fields[0] == "end":
+            last = dump
+            dump = None
+    if last is None:
+        sys.exit("no complete sched_trace dump found")
+    return last
+
+
+def unwrap(events):
+    """Extend the 32 bit timestamps and sort the events by time"""
+    result = []
+    offset = 0
+    last = None
+    for (time, event, pid, arg, data) in events:
+        time += offset
+        if last is not None and time < last - (1 << 31):
+            offset += 1 << 32
+            time += 1 << 32
+        elif last is not None and time > last + (1 << 31):
+            # recorded before the wrap, but claimed a slot after it
+            time -= 1 << 32
+        last = time if last is None else max(last, time)
+        result.append((time, event, pid, arg, data))
+    result.sort(key=lambda e: e[0])
+    return result
+
+
+def convert(dump):
+    """Return the Chrome trace events for 'dump'"""
+    out = [{"ph": "M", "pid": PID, "name": "process_name",
+            "args": {"name": "RIOT"}},
+           {"ph": "M", "pid": PID, "tid": ISR_TID, "name": "thread_name",
+            "args": {"name": "ISR"}},
+           {"ph": "M", "pid": PID, "tid": 0, "name": "thread_name",
+            "args": {"name": "no thread"}}]
+    for pid, name in sorted(dump.threads.items()):
+        out.append({"ph": "M", "pid": PID, "tid": pid, "name": "thread_name",
+                    "args": {"name": "{} ({})".format(name, pid)}})
+
+    events = unwrap(dump.events)
+    if not events:
+        return out
+    start = events[0][0]
+
+    def thread(pid):
+        return dump.threads.get(pid, "pid {}".format(pid))
+
+    running = None
+    running_since = 0
+    messages = collections.defaultdict(collections.deque)
+    flow_id = 0
+
+    for (time, event, pid, arg, data) in events:
+        ts = time - start
+        in_isr = bool(event & IN_ISR)
+        event &= ~IN_ISR
+        tid = ISR_TID if in_isr else pid
+        if running is None:
+            running = pid
+
+        if event == SWITCH:
+            if running:
+                state = STATUS[data] if data < len(STATUS) else "-"
+                out.append({"ph": "X", "pid": PID, "tid": running,
+                            "name": thread(running), "ts": running_since,
+                            "dur": ts - running_since,
+                            "args": {"switched out": state}})
+            running = pid
+            running_since = ts
+        elif event == MSG_SEND:
+            sender = "isr" if in_isr else pid
+            messages[(sender, arg, data)].append((ts, flow_id))
+            out.append({"ph": "s", "pid": PID, "tid": tid, "ts": ts,
+                        "id": flow_id, "cat": "msg",
+                        "name": "msg 0x{:04x}".format(data)})
+            out.append({"ph": "i", "pid": PID, "tid": tid, "ts": ts,
+                        "s": "t", "name": "msg send",
+                        "args": {"to": thread(arg),
+                                 "type": "0x{:04x}".format(data)}})
+            flow_id += 1
+        elif event == MSG_RECV:
+            arg &= ~MSG_BUS_PID_FLAG
+            sender = "isr" if arg == dump.pid_isr else arg
+            args = {"from": "ISR" if sender == "isr" else thread(arg),
+                    "type": "0x{:04x}".format(data)}
+            queue = messages.get((sender, pid, data))
+            if queue:
+                sent, flow = queue.popleft()
+                args["latency_us"] = ts - sent
+                out.append({"ph": "f", "bp": "e", "pid": PID, "tid": tid,
+                            "ts": ts, "id": flow, "cat": "msg",
+                            "name": "msg 0x{:04x}".format(data)})
+            out.append({"ph": "i", "pid": PID, "tid": tid, "ts": ts,
+                        "s": "t", "name": "msg recv", "args": args})
+        elif event in (MUTEX_BLOCK, MUTEX_WAKE):
+            out.append({"ph": "b" if event == MUTEX_BLOCK else "e",
+                        "pid": PID, "tid": tid, "ts": ts, "cat": "mutex",
+                        "id": "{}-0x{:x}".format(pid, data),
+                        "name": "{} waits for mutex 0x{:x}".format(
+                            thread(pid), data)})
+        elif event in (ISR_ENTER, ISR_EXIT):
+            out.append({"ph": "B" if event == ISR_ENTER else "E",
+                        "pid": PID, "tid": ISR_TID, "ts": ts,
+                        "name": "irq {}".format(data)})
+        elif event in (TIMER_ENTER, TIMER_EXIT):
+            out.append({"ph": "B" if event == TIMER_ENTER else "E",
+                        "pid": PID, "tid": tid, "ts": ts,
+                        "name": "ztimer 0x{:x}".format(data)})
+        elif event == USER:
+            out.append({"ph": "i", "pid": PID, "tid": tid, "ts": ts,
+                        "s": "t", "name": "user {}".format(arg),
+                        "args": {"data": data}})
+
+    if running:
+        out.append({"ph": "X", "pid": PID, "tid": running,
+                    "name": thread(running), "ts": running_since,
+                    "dur": events[-1][0] - start - running_since})
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("logfile", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="terminal output containing the dump "
+                             "(default: stdin)")
+    parser.add_argument("--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    dump = parse(args.logfile)
+    if dump.lost:
+        print("{} older events were overwritten".format(dump.lost),
+              file=sys.stderr)
+
+    trace = {"traceEvents": convert(dump)}
+    out = open(args.output, "w") if args.output else sys.stdout
+    try:
+        json.dump(trace, out)
+        out.write("\n")
+    finally:
+        if args.output:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -23,6 +23,13 @@
 PSEUDOMODULES += atomic_utils
 PSEUDOMODULES += base64url
 
+## @defgroup pseudomodule_benchmark_cycles benchmark_cycles
+## @brief Measure benchmarks in CPU cycles instead of microseconds
+##
+## Available on Cortex-M3 and above (DWT cycle counter) and on native on x86
+## hosts.
+PSEUDOMODULES += benchmark_cycles
+
 ## @defgroup pseudomodule_board_software_reset board_software_reset
 ## @brief Use any software-only reset button on the board to reboot
 ##
@@ -54,6 +61,7 @@ PSEUDOMODULES += dhcpv6_client_ia_pd
 PSEUDOMODULES += dhcpv6_client_ia_na
 PSEUDOMODULES += dhcpv6_client_mud_url
 PSEUDOMODULES += dhcpv6_relay
+PSEUDOMODULES += dns_cache
 PSEUDOMODULES += dns_msg
 PSEUDOMODULES += ecc_%
 PSEUDOMODULES += ethos_stdio
@@ -63,10 +71,12 @@ PSEUDOMODULES += event_timeout_ztimer
 PSEUDOMODULES += evtimer_mbox
 PSEUDOMODULES += evtimer_on_ztimer
 PSEUDOMODULES += fatfs_vfs_format
+PSEUDOMODULES += fib_hashed
 PSEUDOMODULES += fmt_%
 PSEUDOMODULES += gcoap_forward_proxy
 PSEUDOMODULES += gcoap_fileserver
 PSEUDOMODULES += gcoap_dtls
+PSEUDOMODULES += gcoap_path_index
 PSEUDOMODULES += fido2_tests
 PSEUDOMODULES += gnrc_dhcpv6_%
 PSEUDOMODULES += gnrc_ipv6_auto_subnets_auto_init
@@ -86,12 +96,16 @@ PSEUDOMODULES += gnrc_netdev_default
 PSEUDOMODULES += gnrc_neterr
 PSEUDOMODULES += gnrc_netapi_callbacks
 PSEUDOMODULES += gnrc_netapi_mbox
+PSEUDOMODULES += gnrc_netreg_hashed
+PSEUDOMODULES += gnrc_netreg_stats
 PSEUDOMODULES += gnrc_netif_bus
 PSEUDOMODULES += gnrc_netif_timestamp
 PSEUDOMODULES += gnrc_pktbuf_cmd
+PSEUDOMODULES += gnrc_pktprof_cmd
 PSEUDOMODULES += gnrc_netif_6lo
 PSEUDOMODULES += gnrc_netif_ipv6
 PSEUDOMODULES += gnrc_netif_mac
+PSEUDOMODULES += gnrc_netif_rx_batch
 PSEUDOMODULES += gnrc_netif_single
 PSEUDOMODULES += gnrc_netif_cmd_%
 PSEUDOMODULES += gnrc_netif_dedup
@@ -107,6 +121,10 @@ PSEUDOMODULES += gnrc_sixlowpan_router_default
 PSEUDOMODULES += gnrc_udp_cmd
 PSEUDOMODULES += gnrc_sock_async
 PSEUDOMODULES += gnrc_sock_check_reuse
+PSEUDOMODULES += gnrc_tcp_congure
+PSEUDOMODULES += gnrc_tcp_congure_%
+PSEUDOMODULES += gnrc_tcp_direct_rcv
+PSEUDOMODULES += gnrc_tcp_sack
 PSEUDOMODULES += gnrc_txtsnd
 PSEUDOMODULES += heap_cmd
 PSEUDOMODULES += i2c_scan
@@ -126,6 +144,12 @@ PSEUDOMODULES += lora
 ##
 PSEUDOMODULES += libc_gettimeofday
 
+## @defgroup pseudomodule_malloc_thread_cache malloc_thread_cache
+## @brief Per-thread caches of small heap blocks
+##
+## See @ref sys_malloc_thread_cache
+PSEUDOMODULES += malloc_thread_cache
+
 ## @defgroup pseudomodule_mpu_stack_guard mpu_stack_guard
 ## @brief MPU based stack guard
 ##
@@ -195,6 +219,7 @@ PSEUDOMODULES += saul_pwm
 PSEUDOMODULES += scanf_float
 PSEUDOMODULES += sched_cb
 PSEUDOMODULES += sched_runq_callback
+PSEUDOMODULES += sched_trace_cmd
 PSEUDOMODULES += sema_deprecated
 PSEUDOMODULES += semtech_loramac_rx
 PSEUDOMODULES += senml_cbor
@@ -211,6 +236,7 @@ PSEUDOMODULES += sock_async
 PSEUDOMODULES += sock_aux_local
 PSEUDOMODULES += sock_aux_rssi
 PSEUDOMODULES += sock_aux_timestamp
+PSEUDOMODULES += sock_dns_async
 PSEUDOMODULES += sock_dtls
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
@@ -288,6 +314,14 @@ PSEUDOMODULES += ztimer64_%
 ## configuration header board.h. These can be found out by running tests/ztimer_overhead
 PSEUDOMODULES += ztimer_auto_adjust
 
+## @defgroup pseudomodule_ztimer_wheel ztimer_wheel
+## @brief Keep the timers of a ztimer clock in a hierarchical timer wheel
+##
+## Setting and removing timers becomes O(1) for clocks with a wheel attached,
+## see @ref ztimer_wheel_init. ZTIMER_USEC, ZTIMER_MSEC and ZTIMER_SEC get a
+## wheel each.
+PSEUDOMODULES += ztimer_wheel
+
 # core_lib is not a submodule
 NO_PSEUDOMODULES += core_lib
 
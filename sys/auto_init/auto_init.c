@@ -65,6 +65,11 @@ extern void init_schedstatistics(void);
 AUTO_INIT(init_schedstatistics,
           AUTO_INIT_PRIO_MOD_SCHEDSTATISTICS);
 #endif
+#if IS_USED(MODULE_STACK_MONITOR)
+extern void stack_monitor_init(void);
+AUTO_INIT(stack_monitor_init,
+          AUTO_INIT_PRIO_MOD_STACK_MONITOR);
+#endif
 #if IS_USED(MODULE_SCHED_ROUND_ROBIN)
 extern void sched_round_robin_init(void);
 AUTO_INIT(sched_round_robin_init,
@@ -100,6 +105,11 @@ extern void gnrc_pktbuf_init(void);
 AUTO_INIT(gnrc_pktbuf_init,
           AUTO_INIT_PRIO_MOD_GNRC_PKTBUF);
 #endif
+#if IS_USED(MODULE_GNRC_PKTPROF)
+extern void gnrc_pktprof_init(void);
+AUTO_INIT(gnrc_pktprof_init,
+          AUTO_INIT_PRIO_MOD_GNRC_PKTPROF);
+#endif
 #if IS_USED(MODULE_AUTO_INIT_GNRC_PKTDUMP)
 extern void gnrc_pktdump_init(void);
 AUTO_INIT(gnrc_pktdump_init,
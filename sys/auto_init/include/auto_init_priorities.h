@@ -53,6 +53,13 @@ extern "C" {
  */
 #define AUTO_INIT_PRIO_MOD_SCHEDSTATISTICS              1050
 #endif
+#ifndef AUTO_INIT_PRIO_MOD_STACK_MONITOR
+/**
+ * @brief   stack usage monitor priority, after schedstatistics as it takes
+ *          over its scheduler callback
+ */
+#define AUTO_INIT_PRIO_MOD_STACK_MONITOR                1055
+#endif
 #ifndef AUTO_INIT_PRIO_MOD_SCHED_ROUND_ROBIN
 /**
  * @brief   round robin scheduling priority
@@ -95,6 +102,12 @@ extern "C" {
  */
 #define AUTO_INIT_PRIO_MOD_GNRC_PKTBUF                  1120
 #endif
+#ifndef AUTO_INIT_PRIO_MOD_GNRC_PKTPROF
+/**
+ * @brief   GNRC packet profiling priority
+ */
+#define AUTO_INIT_PRIO_MOD_GNRC_PKTPROF                 1125
+#endif
 #ifndef AUTO_INIT_PRIO_MOD_GNRC_PKTDUMP
 /**
  * @brief   GNRC pktdump priority
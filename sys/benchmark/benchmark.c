@@ -18,7 +18,12 @@
  * @}
  */
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+
+#include "kernel_defines.h"
+#include "matstat.h"
 #include "timex.h"
 
 #include "benchmark.h"
@@ -35,3 +40,91 @@ void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
            "  ---  %9" PRIu32 " calls per sec\n",
            name, time, full, div, per_sec);
 }
+
+void benchmark_init(benchmark_t *bench, const char *name, unsigned long runs)
+{
+    bench->name = name;
+    bench->runs = runs;
+    bench->samples_numof = 0;
+    benchmark_start_cycles();
+}
+
+/* per call in thousandths of a tick */
+static uint64_t _per_call(const benchmark_t *bench, uint32_t ticks)
+{
+    return ((uint64_t)ticks * 1000) / bench->runs;
+}
+
+static void _print_fixed(uint64_t milli)
+{
+    printf("%" PRIu32 ".%03" PRIu32, (uint32_t)(milli / 1000),
+           (uint32_t)(milli % 1000));
+}
+
+void benchmark_report(benchmark_t *bench)
+{
+    matstat_state_t stats = MATSTAT_STATE_INIT;
+    unsigned n = bench->samples_numof;
+    uint64_t res[5];    /* min, median, p99, max, mean */
+    static const char *labels[] = { "min", "median", "p99", "max", "mean" };
+
+    if ((n == 0) || (bench->runs == 0)) {
+        return;
+    }
+    /* insertion sort, there are only a few samples */
+    for (unsigned i = 1; i < n; i++) {
+        uint32_t sample = bench->samples[i];
+        unsigned j = i;
+
+        for (; (j > 0) && (bench->samples[j - 1] > sample); j--) {
+            bench->samples[j] = bench->samples[j - 1];
+        }
+        bench->samples[j] = sample;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        uint32_t sample = bench->samples[i];
+
+        matstat_add(&stats, (sample > INT32_MAX) ? INT32_MAX : (int32_t)sample);
+    }
+    res[0] = _per_call(bench, stats.min);
+    res[1] = (n & 1) ? _per_call(bench, bench->samples[n / 2])
+                     : (_per_call(bench, bench->samples[n / 2 - 1]) +
+                        _per_call(bench, bench->samples[n / 2])) / 2;
+    /* nearest rank */
+    res[2] = _per_call(bench, bench->samples[(99 * n + 99) / 100 - 1]);
+    res[3] = _per_call(bench, stats.max);
+    res[4] = _per_call(bench, matstat_mean(&stats));
+
+    if (CONFIG_BENCHMARK_OUTPUT == BENCHMARK_OUTPUT_JSON) {
+        printf("{\"name\": \"%s\", \"unit\": \"" BENCHMARK_UNIT "\", "
+               "\"samples\": %u, \"runs\": %lu", bench->name, n, bench->runs);
+        for (unsigned i = 0; i < ARRAY_SIZE(res); i++) {
+            printf(", \"%s\": ", labels[i]);
+            _print_fixed(res[i]);
+        }
+        puts("}");
+    }
+    else if (CONFIG_BENCHMARK_OUTPUT == BENCHMARK_OUTPUT_CSV) {
+        static bool header_printed;
+
+        if (!header_printed) {
+            puts("name,unit,samples,runs,min,median,p99,max,mean");
+            header_printed = true;
+        }
+        printf("%s," BENCHMARK_UNIT ",%u,%lu", bench->name, n, bench->runs);
+        for (unsigned i = 0; i < ARRAY_SIZE(res); i++) {
+            putchar(',');
+            _print_fixed(res[i]);
+        }
+        puts("");
+    }
+    else {
+        printf("%25s:", bench->name);
+        for (unsigned i = 0; i < ARRAY_SIZE(res); i++) {
+            printf("  %s ", labels[i]);
+            _print_fixed(res[i]);
+        }
+        printf(" " BENCHMARK_UNIT " per call  (%u x %lu calls)\n", n,
+               bench->runs);
+    }
+}
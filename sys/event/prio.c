@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Priority event queue implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "event/prio.h"
+#include "irq.h"
+#include "thread.h"
+#include "ztimer.h"
+
+/* priority_queue_node_t::data of queued events, to tell them apart from
+ * the last event of a queue */
+#define QUEUED          (1U)
+
+static list_node_t _queues;
+
+void event_prio_queue_init(event_prio_queue_t *queue, const char *name)
+{
+    priority_queue_init(&queue->queue);
+    queue->waiter = thread_get_active();
+    queue->name = name;
+    queue->stats = (event_prio_stats_t){ 0 };
+
+    unsigned state = irq_disable();
+    list_add(&_queues, &queue->next);
+    irq_restore(state);
+}
+
+static void _post(event_prio_queue_t *queue, event_prio_t *event,
+                  uint32_t key)
+{
+    assert(queue && event);
+
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+    unsigned state = irq_disable();
+
+    if (event->node.data == QUEUED) {
+        priority_queue_remove(&queue->queue, &event->node);
+    }
+    else {
+        event->node.data = QUEUED;
+        event->posted = now;
+    }
+    event->node.priority = key;
+    priority_queue_add(&queue->queue, &event->node);
+    thread_t *waiter = queue->waiter;
+    irq_restore(state);
+
+    if (waiter) {
+        thread_flags_set(waiter, THREAD_FLAG_EVENT);
+    }
+}
+
+void event_prio_post(event_prio_queue_t *queue, event_prio_t *event,
+                     uint32_t prio)
+{
+    _post(queue, event, prio);
+}
+
+void event_prio_post_deadline(event_prio_queue_t *queue, event_prio_t *event,
+                              uint32_t deadline)
+{
+    _post(queue, event, ztimer_now(ZTIMER_MSEC) + deadline);
+}
+
+void event_prio_cancel(event_prio_queue_t *queue, event_prio_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    if (event->node.data == QUEUED) {
+        priority_queue_remove(&queue->queue, &event->node);
+        event->node.data = 0;
+    }
+    irq_restore(state);
+}
+
+event_prio_t *event_prio_get(event_prio_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    priority_queue_node_t *node = priority_queue_remove_head(&queue->queue);
+    if (node) {
+        node->next = NULL;
+        node->data = 0;
+    }
+    irq_restore(state);
+
+    return node ? container_of(node, event_prio_t, node) : NULL;
+}
+
+event_prio_t *event_prio_wait(event_prio_queue_t *queue)
+{
+    assert(queue->waiter == thread_get_active());
+    event_prio_t *result;
+
+    while ((result = event_prio_get(queue)) == NULL) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+
+    return result;
+}
+
+void event_prio_handle(event_prio_queue_t *queue, event_prio_t *event)
+{
+    uint32_t latency = ztimer_now(ZTIMER_USEC) - event->posted;
+    unsigned state = irq_disable();
+
+    queue->stats.handled++;
+    queue->stats.latency_sum += latency;
+    if (latency > queue->stats.latency_max) {
+        queue->stats.latency_max = latency;
+    }
+    irq_restore(state);
+
+    event->super.handler(&event->super);
+}
+
+void event_prio_stats(const event_prio_queue_t *queue,
+                      event_prio_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = queue->stats;
+    irq_restore(state);
+}
+
+void event_prio_print_stats(void)
+{
+    printf("%-16s | %8s | %6s | %10s | %10s\n",
+           "queue", "handled", "queued", "max [us]", "avg [us]");
+
+    for (list_node_t *node = _queues.next; node; node = node->next) {
+        event_prio_queue_t *queue = container_of(node, event_prio_queue_t,
+                                                 next);
+        event_prio_stats_t stats;
+        unsigned queued = 0;
+
+        unsigned state = irq_disable();
+        stats = queue->stats;
+        for (priority_queue_node_t *n = queue->queue.first; n; n = n->next) {
+            queued++;
+        }
+        irq_restore(state);
+
+        printf("%-16s | %8" PRIu32 " | %6u | %10" PRIu32 " | %10" PRIu32 "\n",
+               queue->name ? queue->name : "-", stats.handled, queued,
+               stats.latency_max,
+               stats.handled ? (uint32_t)(stats.latency_sum / stats.handled)
+                             : 0);
+    }
+}
@@ -10,6 +10,24 @@
  * @defgroup    sys_benchmark Benchmark
  * @ingroup     sys
  * @brief       Framework for running simple runtime benchmarks
+ *
+ * @ref BENCHMARK_FUNC() times a number of calls once and prints the total.
+ *
+ * @ref BENCHMARK_RUN() runs the calls for @ref CONFIG_BENCHMARK_WARMUP
+ * samples without measuring them, then takes @ref CONFIG_BENCHMARK_SAMPLES
+ * samples. It reports the minimum, median, 99th percentile, maximum and mean
+ * time per call. If the code to benchmark does not fit in a macro argument,
+ * the samples can be taken with @ref benchmark_now() and be added with
+ * @ref benchmark_add() instead.
+ *
+ * The results are printed as text, CSV or as one JSON object per line, see
+ * @ref CONFIG_BENCHMARK_OUTPUT. Times are in microseconds, or in CPU cycles
+ * with the `benchmark_cycles` module. Cycles can be counted on Cortex-M3 and
+ * above and on `native` on x86 hosts.
+ *
+ * ```C
+ * BENCHMARK_RUN("mutex_unlock", 1000, mutex_unlock(&_mutex));
+ * ```
  * @{
  *
  * @file
@@ -24,12 +42,174 @@
 #include <stdint.h>
 
 #include "irq.h"
+#include "kernel_defines.h"
 #include "ztimer.h"
+#if IS_USED(MODULE_BENCHMARK_CYCLES) && !defined(CPU_NATIVE)
+#include "cpu.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @name    Output formats of the benchmark results
+ * @{
+ */
+#define BENCHMARK_OUTPUT_TEXT   (0)     /**< aligned text */
+#define BENCHMARK_OUTPUT_CSV    (1)     /**< CSV, header printed once */
+#define BENCHMARK_OUTPUT_JSON   (2)     /**< one JSON object per line */
+/** @} */
+
+/**
+ * @defgroup sys_benchmark_conf Benchmark compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of samples taken by @ref BENCHMARK_RUN()
+ */
+#ifndef CONFIG_BENCHMARK_SAMPLES
+#define CONFIG_BENCHMARK_SAMPLES    (32U)
+#endif
+
+/**
+ * @brief   Number of samples run before measuring, to warm up caches and
+ *          to settle the system
+ */
+#ifndef CONFIG_BENCHMARK_WARMUP
+#define CONFIG_BENCHMARK_WARMUP     (2U)
+#endif
+
+/**
+ * @brief   Output format of the results, one of BENCHMARK_OUTPUT_TEXT,
+ *          BENCHMARK_OUTPUT_CSV or BENCHMARK_OUTPUT_JSON
+ */
+#ifndef CONFIG_BENCHMARK_OUTPUT
+#define CONFIG_BENCHMARK_OUTPUT     BENCHMARK_OUTPUT_TEXT
+#endif
+/** @} */
+
+#if IS_USED(MODULE_BENCHMARK_CYCLES) || defined(DOXYGEN)
+/**
+ * @brief   Unit of the results
+ */
+#define BENCHMARK_UNIT              "cycles"
+#else
+#define BENCHMARK_UNIT              "us"
+#endif
+
+/**
+ * @brief   Samples of a benchmark
+ */
+typedef struct {
+    const char *name;           /**< name for labeling the output */
+    unsigned long runs;         /**< calls per sample */
+    unsigned samples_numof;     /**< number of samples taken */
+    /**
+     * @brief   Duration of the samples in @ref benchmark_now() ticks
+     */
+    uint32_t samples[CONFIG_BENCHMARK_SAMPLES];
+} benchmark_t;
+
+/**
+ * @brief   Get the time for measuring a sample
+ *
+ * @return  Current time in microseconds, or in CPU cycles with the
+ *          `benchmark_cycles` module
+ */
+static inline uint32_t benchmark_now(void)
+{
+#if IS_USED(MODULE_BENCHMARK_CYCLES)
+#  if defined(CPU_NATIVE) && (defined(__i386__) || defined(__x86_64__))
+    return __builtin_ia32_rdtsc();
+#  elif defined(DWT_CTRL_CYCCNTENA_Msk)
+    return DWT->CYCCNT;
+#  else
+#    error "benchmark_cycles: no cycle counter on this CPU"
+#  endif
+#else
+    return ztimer_now(ZTIMER_USEC);
+#endif
+}
+
+/**
+ * @brief   Start the cycle counter read by @ref benchmark_now(), if needed
+ *
+ * Called by benchmark_init(), only needed to use benchmark_now() without a
+ * @ref benchmark_t.
+ */
+static inline void benchmark_start_cycles(void)
+{
+#if IS_USED(MODULE_BENCHMARK_CYCLES) && defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/**
+ * @brief   Prepare a benchmark for taking samples
+ *
+ * This also starts the cycle counter, if needed.
+ *
+ * @param[out] bench    benchmark to prepare
+ * @param[in]  name     name for labeling the output
+ * @param[in]  runs     number of calls per sample
+ */
+void benchmark_init(benchmark_t *bench, const char *name, unsigned long runs);
+
+/**
+ * @brief   Add a sample to a benchmark
+ *
+ * Samples beyond @ref CONFIG_BENCHMARK_SAMPLES are dropped.
+ *
+ * @param[in,out] bench     benchmark to add to
+ * @param[in]     ticks     duration of the sample in @ref benchmark_now()
+ *                          ticks
+ */
+static inline void benchmark_add(benchmark_t *bench, uint32_t ticks)
+{
+    if (bench->samples_numof < CONFIG_BENCHMARK_SAMPLES) {
+        bench->samples[bench->samples_numof++] = ticks;
+    }
+}
+
+/**
+ * @brief   Calculate the statistics of a benchmark and print them in the
+ *          format selected by @ref CONFIG_BENCHMARK_OUTPUT
+ *
+ * @note    Sorts the samples of @p bench.
+ *
+ * @param[in,out] bench     benchmark to report
+ */
+void benchmark_report(benchmark_t *bench);
+
+/**
+ * @brief   Measure the distribution of the runtime of a given function call
+ *
+ * @param[in] name      name for labeling the output
+ * @param[in] runs      number of times to run @p func per sample
+ * @param[in] func      function call to benchmark
+ */
+#define BENCHMARK_RUN(name, runs, func)                                 \
+    do {                                                                \
+        benchmark_t _benchmark;                                         \
+        benchmark_init(&_benchmark, name, runs);                        \
+        for (unsigned _s = 0;                                           \
+             _s < (CONFIG_BENCHMARK_WARMUP + CONFIG_BENCHMARK_SAMPLES); \
+             _s++) {                                                    \
+            uint32_t _benchmark_time = benchmark_now();                 \
+            for (unsigned long i = 0; i < (runs); i++) {                \
+                func;                                                   \
+            }                                                           \
+            _benchmark_time = benchmark_now() - _benchmark_time;        \
+            if (_s >= CONFIG_BENCHMARK_WARMUP) {                        \
+                benchmark_add(&_benchmark, _benchmark_time);            \
+            }                                                           \
+        }                                                               \
+        benchmark_report(&_benchmark);                                  \
+    } while (0)
+
 /**
  * @brief   Measure the runtime of a given function call
  *
@@ -37,6 +217,9 @@ extern "C" {
  * using a preprocessor function, as going with a function pointer or similar
  * would influence the measured runtime...
  *
+ * @deprecated  Use @ref BENCHMARK_RUN(), which also prints the distribution
+ *              of the runtime
+ *
  * @param[in] name      name for labeling the output
  * @param[in] runs      number of times to run @p func
  * @param[in] func      function call to benchmark
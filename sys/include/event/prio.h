@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @brief       Provides event queues ordered by priority or deadline
+ *
+ * An @ref event_queue_t handles its events first in, first out, so an urgent
+ * event waits for all events posted before it. The events of an
+ * @ref event_prio_queue_t are ordered by a key given on posting, events with
+ * the same key are handled in the order they were posted. The key is either
+ * a priority (lower values are handled first) given to event_prio_post(), or
+ * the deadline computed by event_prio_post_deadline(). A queue should use
+ * only one of them.
+ *
+ * The time from posting an event to calling its handler is measured for
+ * every queue. With the `event_prio_cmd` module, the shell command `evprio`
+ * lists the queues with the number of events handled and the maximum and
+ * average latency.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static event_prio_queue_t queue;
+ * static event_prio_t radio_event = { .super.handler = radio_handler };
+ * static event_prio_t housekeeping = { .super.handler = housekeeping_handler };
+ *
+ * [...] event_prio_queue_init(&queue, "radio");
+ *       event_prio_loop(&queue);
+ *
+ * [...] event_prio_post(&queue, &housekeeping, 10);
+ *       event_prio_post(&queue, &radio_event, 0);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Priority event queue API
+ */
+
+#ifndef EVENT_PRIO_H
+#define EVENT_PRIO_H
+
+#include <stdint.h>
+
+#include "event.h"
+#include "list.h"
+#include "priority_queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Event with a priority, extends @ref event_t
+ */
+typedef struct {
+    event_t super;                  /**< event, only its handler is used */
+    priority_queue_node_t node;     /**< queue entry, ordered by the key */
+    uint32_t posted;                /**< time of posting in microseconds */
+} event_prio_t;
+
+/**
+ * @brief   Latency statistics of a queue
+ */
+typedef struct {
+    uint32_t handled;               /**< number of events handled */
+    uint32_t latency_max;           /**< maximum time from posting to
+                                         calling the handler in
+                                         microseconds */
+    uint64_t latency_sum;           /**< sum of those times */
+} event_prio_stats_t;
+
+/**
+ * @brief   Event queue ordered by priority or deadline
+ */
+typedef struct {
+    priority_queue_t queue;         /**< queued events */
+    thread_t *waiter;               /**< thread owning the queue */
+    const char *name;               /**< name shown by the shell command */
+    list_node_t next;               /**< next queue for the shell command */
+    event_prio_stats_t stats;       /**< latency statistics */
+} event_prio_queue_t;
+
+/**
+ * @brief   Initialize a queue owned by the calling thread
+ *
+ * @param[out]  queue   queue to initialize
+ * @param[in]   name    name of the queue in statistics
+ */
+void event_prio_queue_init(event_prio_queue_t *queue, const char *name);
+
+/**
+ * @brief   Queue an event with a priority
+ *
+ * If @p event is already queued, it is only moved to its new position.
+ * Can be called from interrupt context.
+ *
+ * @param[in]   queue   queue to post @p event to
+ * @param[in]   event   event to post
+ * @param[in]   prio    priority, lower values are handled first
+ */
+void event_prio_post(event_prio_queue_t *queue, event_prio_t *event,
+                     uint32_t prio);
+
+/**
+ * @brief   Queue an event ordered by its deadline
+ *
+ * The event is queued with its absolute deadline on `ZTIMER_MSEC` as
+ * priority. Events whose deadlines lie on different sides of a wrap around
+ * of the clock, i.e. every 49 days, are handled in the wrong order.
+ *
+ * @param[in]   queue       queue to post @p event to
+ * @param[in]   event       event to post
+ * @param[in]   deadline    deadline relative to now in milliseconds
+ */
+void event_prio_post_deadline(event_prio_queue_t *queue, event_prio_t *event,
+                              uint32_t deadline);
+
+/**
+ * @brief   Remove an event from a queue
+ *
+ * @param[in]   queue   queue @p event may be queued in
+ * @param[in]   event   event to remove
+ */
+void event_prio_cancel(event_prio_queue_t *queue, event_prio_t *event);
+
+/**
+ * @brief   Take the most urgent event from a queue without blocking
+ *
+ * @param[in]   queue   queue to take the event from
+ *
+ * @return  the event
+ * @return  NULL if @p queue is empty
+ */
+event_prio_t *event_prio_get(event_prio_queue_t *queue);
+
+/**
+ * @brief   Wait for the most urgent event of a queue
+ *
+ * @param[in]   queue   queue owned by the calling thread
+ *
+ * @return  the event
+ */
+event_prio_t *event_prio_wait(event_prio_queue_t *queue);
+
+/**
+ * @brief   Handle an event taken from a queue
+ *
+ * Accounts the latency of @p event to @p queue and calls its handler.
+ *
+ * @param[in]   queue   queue @p event was taken from
+ * @param[in]   event   event to handle
+ */
+void event_prio_handle(event_prio_queue_t *queue, event_prio_t *event);
+
+/**
+ * @brief   Handle the events of a queue forever
+ *
+ * @param[in]   queue   queue owned by the calling thread
+ */
+static inline NORETURN void event_prio_loop(event_prio_queue_t *queue)
+{
+    while (1) {
+        event_prio_handle(queue, event_prio_wait(queue));
+    }
+}
+
+/**
+ * @brief   Get the latency statistics of a queue
+ *
+ * @param[in]   queue   queue to query
+ * @param[out]  stats   statistics
+ */
+void event_prio_stats(const event_prio_queue_t *queue,
+                      event_prio_stats_t *stats);
+
+/**
+ * @brief   Print the latency statistics of all queues
+ */
+void event_prio_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_PRIO_H */
+/** @} */
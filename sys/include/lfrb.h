@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_lfrb Lock-free ringbuffer
+ * @ingroup     sys
+ * @brief       Ringbuffer of fixed size elements that never disables IRQs
+ *
+ * Unlike @ref sys_tsrb, which disables IRQs while copying bytes in and out,
+ * the producer and the consumer of an lfrb only synchronize through C11
+ * atomics. Elements can be of any size and are written and read in bulk,
+ * either by copying or in place:
+ *
+ * - lfrb_reserve() returns a contiguous part of the free space to fill in
+ *   place, lfrb_commit() makes the elements written there available to the
+ *   consumer.
+ * - lfrb_acquire() returns a contiguous part of the available elements to
+ *   read in place, lfrb_release() frees them again.
+ *
+ * By default, there must be only one producer and one consumer, e.g. an ISR
+ * and a thread. A ringbuffer initialized with lfrb_mp_init() accepts any
+ * number of producers, also ISRs preempting each other or threads, which
+ * then have to use the `lfrb_mp_*()` functions. Every element then has a
+ * flag that is set when it is committed, so producers never wait for each
+ * other. The consumer only sees elements up to the first one not committed
+ * yet.
+ *
+ * @attention   The number of elements must be a power of two!
+ *
+ * @note        On platforms without atomic read-modify-write instructions,
+ *              such as ARMv6-M, the compare-and-swap of the multi-producer
+ *              variant disables IRQs for a few instructions.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free ringbuffer interface definition
+ */
+
+#ifndef LFRB_H
+#define LFRB_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/* The stdatomic.h in GCC gives compilation errors with C++
+ * see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60932
+ */
+#ifdef __cplusplus
+#include "c11_atomics_compat.hpp"
+#else
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of words needed for the commit flags of a multi-producer
+ *          ringbuffer with @p numof elements
+ */
+#define LFRB_MP_FLAGS_NUMOF(numof)  (((numof) + 31) / 32)
+
+/**
+ * @brief   Lock-free ringbuffer struct
+ */
+typedef struct {
+    uint8_t *buf;                   /**< elements */
+    atomic_uint_least32_t *flags;   /**< commit flags, NULL if only one
+                                         producer is allowed */
+    unsigned numof;                 /**< number of elements, power of two */
+    unsigned elem_size;             /**< size of an element in bytes */
+    atomic_uint reads;              /**< total number of elements read */
+    atomic_uint writes;             /**< total number of elements written */
+    atomic_uint reserved;           /**< total number of elements reserved
+                                         by multiple producers */
+} lfrb_t;
+
+/**
+ * @brief       Initialize a ringbuffer for a single producer
+ *
+ * @param[out]  rb          ringbuffer to initialize
+ * @param[in]   buf         buffer for @p numof elements
+ * @param[in]   elem_size   size of an element in bytes
+ * @param[in]   numof       number of elements, must be a power of two
+ */
+void lfrb_init(lfrb_t *rb, void *buf, unsigned elem_size, unsigned numof);
+
+/**
+ * @brief       Initialize a ringbuffer for multiple producers
+ *
+ * @param[out]  rb          ringbuffer to initialize
+ * @param[in]   buf         buffer for @p numof elements
+ * @param[in]   elem_size   size of an element in bytes
+ * @param[in]   numof       number of elements, must be a power of two
+ * @param[in]   flags       `LFRB_MP_FLAGS_NUMOF(numof)` words for the
+ *                          commit flags
+ */
+void lfrb_mp_init(lfrb_t *rb, void *buf, unsigned elem_size, unsigned numof,
+                  atomic_uint_least32_t *flags);
+
+/**
+ * @brief       Get the number of elements available for reading
+ *
+ * @note        Only to be called by the consumer
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return      number of elements that can be read
+ */
+unsigned lfrb_avail(lfrb_t *rb);
+
+/**
+ * @brief       Test if the ringbuffer is empty
+ *
+ * @note        Only to be called by the consumer
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return      true if no element can be read
+ */
+static inline bool lfrb_empty(lfrb_t *rb)
+{
+    return lfrb_avail(rb) == 0;
+}
+
+/**
+ * @brief       Get the number of free elements
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return      number of elements that can be written
+ */
+static inline unsigned lfrb_free(const lfrb_t *rb)
+{
+    const atomic_uint *head = rb->flags ? &rb->reserved : &rb->writes;
+
+    return rb->numof - (atomic_load_explicit(head, memory_order_relaxed) -
+                        atomic_load_explicit(&rb->reads,
+                                             memory_order_acquire));
+}
+
+/**
+ * @brief       Add elements to a ringbuffer with a single producer
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   src elements to add
+ * @param[in]   n   number of elements in @p src
+ *
+ * @return      number of elements added, less than @p n if the ringbuffer
+ *              is full
+ */
+unsigned lfrb_put(lfrb_t *rb, const void *src, unsigned n);
+
+/**
+ * @brief       Reserve contiguous space in a ringbuffer with a single
+ *              producer
+ *
+ * The space is not available to the consumer until it is committed with
+ * lfrb_commit(). Reserving again before that returns the same space.
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in,out] n in: number of elements wanted,
+ *                  out: number of elements reserved
+ *
+ * @return      first reserved element, NULL if the ringbuffer is full
+ */
+void *lfrb_reserve(lfrb_t *rb, unsigned *n);
+
+/**
+ * @brief       Commit elements written to the reserved space
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   n   number of elements to commit, at most the number of
+ *                  reserved elements
+ */
+void lfrb_commit(lfrb_t *rb, unsigned n);
+
+/**
+ * @brief       Add elements to a ringbuffer with multiple producers
+ *
+ * If the free space wraps around the end of the buffer, elements of other
+ * producers may end up between the ones added before and after the end.
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   src elements to add
+ * @param[in]   n   number of elements in @p src
+ *
+ * @return      number of elements added, less than @p n if the ringbuffer
+ *              is full
+ */
+unsigned lfrb_mp_put(lfrb_t *rb, const void *src, unsigned n);
+
+/**
+ * @brief       Reserve contiguous space in a ringbuffer with multiple
+ *              producers
+ *
+ * All reserved elements must be committed with lfrb_mp_commit(), as the
+ * consumer cannot read past them before.
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in,out] n in: number of elements wanted,
+ *                  out: number of elements reserved
+ *
+ * @return      first reserved element, NULL if the ringbuffer is full
+ */
+void *lfrb_mp_reserve(lfrb_t *rb, unsigned *n);
+
+/**
+ * @brief       Commit reserved elements of a ringbuffer with multiple
+ *              producers
+ *
+ * @param[in]   rb      ringbuffer to operate on
+ * @param[in]   elems   first element to commit, as returned by
+ *                      lfrb_mp_reserve()
+ * @param[in]   n       number of elements to commit
+ */
+void lfrb_mp_commit(lfrb_t *rb, const void *elems, unsigned n);
+
+/**
+ * @brief       Get elements from a ringbuffer
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[out]  dst buffer for the elements
+ * @param[in]   n   maximum number of elements to get
+ *
+ * @return      number of elements written to @p dst
+ */
+unsigned lfrb_get(lfrb_t *rb, void *dst, unsigned n);
+
+/**
+ * @brief       Get contiguous elements to read in place
+ *
+ * The elements stay in the ringbuffer until they are released with
+ * lfrb_release().
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in,out] n in: maximum number of elements wanted,
+ *                  out: number of elements returned
+ *
+ * @return      first element, NULL if the ringbuffer is empty
+ */
+const void *lfrb_acquire(lfrb_t *rb, unsigned *n);
+
+/**
+ * @brief       Remove elements read in place
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   n   number of elements to remove, at most the number of
+ *                  elements returned by lfrb_acquire()
+ */
+void lfrb_release(lfrb_t *rb, unsigned n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LFRB_H */
+/** @} */
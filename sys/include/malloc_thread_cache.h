@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_malloc_thread_cache Per-thread caches of small heap blocks
+ * @ingroup     sys_malloc_ts
+ * @brief       Serves small allocations from per-thread free lists without
+ *              taking the heap lock
+ *
+ * @ref sys_malloc_ts serializes every call of `malloc()` and `free()` with a
+ * single mutex. With the `malloc_thread_cache` module, every thread keeps up
+ * to @ref CONFIG_MALLOC_THREAD_CACHE_DEPTH freed blocks of each size class
+ * (16, 32, 64, ... bytes, see @ref CONFIG_MALLOC_THREAD_CACHE_CLASSES).
+ * `malloc()` and `calloc()` take a block of the matching class from the
+ * cache of the calling thread if there is one, only a cache miss or a
+ * larger request goes to the shared heap. `free()` puts a block into the
+ * cache of the calling thread if there is room, which works for blocks
+ * allocated by other threads as well.
+ *
+ * Small requests are rounded up to the size of their class. The class of a
+ * freed block is determined with `malloc_usable_size()` (or
+ * `tlsf_block_size()` with `tlsf-malloc`), which AVR libc does not provide.
+ *
+ * Cached blocks are not returned to the heap when a thread exits, the next
+ * thread with the same PID uses them. A thread that freed many blocks it
+ * will not need again can return them with malloc_thread_cache_flush().
+ *
+ * With the module, `ps` shows the number of allocations, frees and cache
+ * hits of every thread.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Per-thread caches of small heap blocks interface definition
+ */
+
+#ifndef MALLOC_THREAD_CACHE_H
+#define MALLOC_THREAD_CACHE_H
+
+#include <stdint.h>
+
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_malloc_thread_cache_config Per-thread heap cache compile
+ *                                          time configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of size classes, the smallest is 16 bytes and every
+ *          further class doubles the size
+ *
+ * The default of 4 caches blocks of up to 128 bytes.
+ */
+#ifndef CONFIG_MALLOC_THREAD_CACHE_CLASSES
+#define CONFIG_MALLOC_THREAD_CACHE_CLASSES  (4U)
+#endif
+
+/**
+ * @brief   Maximum number of blocks cached per thread and size class
+ */
+#ifndef CONFIG_MALLOC_THREAD_CACHE_DEPTH
+#define CONFIG_MALLOC_THREAD_CACHE_DEPTH    (4U)
+#endif
+/** @} */
+
+/**
+ * @brief   Size of the smallest class in bytes
+ */
+#define MALLOC_THREAD_CACHE_MIN             (16U)
+
+/**
+ * @brief   Size of the largest class in bytes
+ */
+#define MALLOC_THREAD_CACHE_MAX \
+    (MALLOC_THREAD_CACHE_MIN << (CONFIG_MALLOC_THREAD_CACHE_CLASSES - 1))
+
+/**
+ * @brief   Allocation statistics of a thread
+ */
+typedef struct {
+    uint32_t allocs;    /**< successful calls of `malloc()` and `calloc()` */
+    uint32_t frees;     /**< calls of `free()` with a block */
+    uint32_t hits;      /**< allocations served from the cache */
+} malloc_thread_cache_stats_t;
+
+/**
+ * @brief   Get the allocation statistics of a thread
+ *
+ * The statistics are reset when a new thread allocates or frees memory for
+ * the first time.
+ *
+ * @param[in]   pid     thread to get the statistics of
+ * @param[out]  stats   statistics, all zero if @p pid has not used the heap
+ */
+void malloc_thread_cache_stats(kernel_pid_t pid,
+                               malloc_thread_cache_stats_t *stats);
+
+/**
+ * @brief   Return all blocks cached by the calling thread to the heap
+ */
+void malloc_thread_cache_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MALLOC_THREAD_CACHE_H */
+/** @} */
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_dns_cache DNS cache
+ * @ingroup     net_dns
+ * @brief       Cache of resolved DNS names
+ *
+ * Keeps addresses for as long as the TTL of their DNS records allows, and
+ * remembers names that do not exist for the negative caching time of their
+ * SOA record ([RFC 2308](https://tools.ietf.org/html/rfc2308)).
+ *
+ * The cache has a fixed number of entries. If all of them are in use, the
+ * least recently used entry is replaced. Names longer than
+ * @ref CONFIG_DNS_CACHE_NAME_LEN are not cached.
+ *
+ * @ref sock_dns_query() uses the cache if module `dns_cache` is used.
+ *
+ * @{
+ * @file
+ * @brief       DNS cache definitions
+ */
+#ifndef NET_DNS_CACHE_H
+#define NET_DNS_CACHE_H
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_dns_cache_conf DNS cache configuration
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of cache entries
+ */
+#ifndef CONFIG_DNS_CACHE_SIZE
+#define CONFIG_DNS_CACHE_SIZE           (4U)
+#endif
+
+/**
+ * @brief   Maximum length of a cached name
+ */
+#ifndef CONFIG_DNS_CACHE_NAME_LEN
+#define CONFIG_DNS_CACHE_NAME_LEN       (32U)
+#endif
+
+/**
+ * @brief   Maximum time in seconds a negative reply is cached
+ *
+ * Upper bound of the negative caching time of the SOA record.
+ */
+#ifndef CONFIG_DNS_CACHE_NEG_TTL_MAX
+#define CONFIG_DNS_CACHE_NEG_TTL_MAX    (300U)
+#endif
+/** @} */
+
+/**
+ * @brief   Cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< Lookups answered with an address */
+    uint32_t neg_hits;      /**< Lookups answered with a non-existent name */
+    uint32_t misses;        /**< Lookups not answered */
+    uint32_t evictions;     /**< Valid entries replaced by a new one */
+} dns_cache_stats_t;
+
+#if IS_USED(MODULE_DNS_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Looks up a name in the cache
+ *
+ * @param[in]   domain_name     Name to look up
+ * @param[out]  addr_out        Buffer for the address, must hold 16 bytes
+ *                              unless @p family is AF_INET
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC. An
+ *                              IPv6 address is preferred for AF_UNSPEC, an
+ *                              IPv4 address is only returned for it if the
+ *                              name is known to have no IPv6 address.
+ *
+ * @return  Length of the address in @p addr_out
+ * @return  -ENOENT, if the name is known not to have an address of @p family
+ * @return  0, if the name is not cached
+ */
+int dns_cache_query(const char *domain_name, void *addr_out, int family);
+
+/**
+ * @brief   Adds the address of a name to the cache
+ *
+ * @param[in]   domain_name     Resolved name
+ * @param[in]   addr            Address of @p domain_name
+ * @param[in]   addr_len        Length of @p addr, 4 or 16
+ * @param[in]   ttl             Time in seconds @p addr is valid, nothing is
+ *                              cached if 0
+ */
+void dns_cache_add(const char *domain_name, const void *addr, int addr_len,
+                   uint32_t ttl);
+
+/**
+ * @brief   Adds a name without address to the cache
+ *
+ * @param[in]   domain_name     Name without address
+ * @param[in]   family          Family that was queried
+ * @param[in]   ttl             Negative caching time in seconds, capped at
+ *                              @ref CONFIG_DNS_CACHE_NEG_TTL_MAX. Nothing is
+ *                              cached if 0.
+ */
+void dns_cache_add_negative(const char *domain_name, int family, uint32_t ttl);
+
+/**
+ * @brief   Removes all entries from the cache
+ */
+void dns_cache_flush(void);
+
+/**
+ * @brief   Gets the cache statistics
+ *
+ * @param[out]  stats   Statistics since boot
+ */
+void dns_cache_get_stats(dns_cache_stats_t *stats);
+#else
+static inline int dns_cache_query(const char *domain_name, void *addr_out,
+                                  int family)
+{
+    (void)domain_name;
+    (void)addr_out;
+    (void)family;
+    return 0;
+}
+
+static inline void dns_cache_add(const char *domain_name, const void *addr,
+                                 int addr_len, uint32_t ttl)
+{
+    (void)domain_name;
+    (void)addr;
+    (void)addr_len;
+    (void)ttl;
+}
+
+static inline void dns_cache_add_negative(const char *domain_name, int family,
+                                          uint32_t ttl)
+{
+    (void)domain_name;
+    (void)family;
+    (void)ttl;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_DNS_CACHE_H */
+/** @} */
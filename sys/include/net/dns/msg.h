@@ -104,13 +104,20 @@ size_t dns_msg_compose_query(void *dns_buf, const char *domain_name,
  * @param[in] family        The address family used to compose the query for
  *                          this response (see @ref dns_msg_compose_query())
  * @param[out] addr_out     The IP address returned by the response.
+ * @param[out] ttl_out      Time in seconds the result may be cached. On
+ *                          success, the smallest TTL of the records leading
+ *                          to @p addr_out. On -ENOENT, the negative caching
+ *                          time of the SOA record in @p buf, or 0 if there is
+ *                          none (see [RFC 2308](https://tools.ietf.org/html/rfc2308)).
+ *                          May be NULL.
  *
  * @return  Length of the @p addr_out on success.
- * @return  -EBADMSG, when an address corresponding to @p family can not be found
- *          in @p buf.
+ * @return  -ENOENT, when @p buf states that the name does not exist or has no
+ *          address corresponding to @p family.
+ * @return  -EBADMSG, when @p buf is malformed or reports an error.
  */
 int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
-                        void *addr_out);
+                        void *addr_out, uint32_t *ttl_out);
 
 #ifdef __cplusplus
 }
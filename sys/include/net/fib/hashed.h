@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_fib_hashed  Hashed FIB engine
+ * @ingroup     net_fib
+ * @brief       Hash index and lifetime expiry wheel for FIB tables
+ *
+ * Without an index, every lookup in a FIB table scans all entries, checks
+ * their lifetime and compares the destination bit by bit. With the
+ * `fib_hashed` module a table can be given a @ref fib_hashed_t as index
+ * (see fib_table_t::hashed):
+ *
+ * - Entries are hashed by their full destination address. Network prefix
+ *   entries are additionally hashed by their destination masked to the prefix
+ *   length. A lookup probes the full destination first, then one bucket for
+ *   each prefix length in use (longest first) and finally the default route.
+ *   Among matching prefixes, the longest prefix wins. Prefixes match bit by
+ *   bit, so any prefix length works, and bits of a prefix entry after its
+ *   prefix length are ignored.
+ * - Entries with a finite lifetime are kept in a timer wheel of
+ *   @ref CONFIG_FIB_HASHED_WHEEL_SIZE slots of
+ *   @ref CONFIG_FIB_HASHED_WHEEL_TICK_MS each. Every slot is sorted by
+ *   lifetime, so expired entries are removed as the wheel advances and
+ *   lookups never visit them.
+ * - Source routes are hashed by their destination in the same way.
+ *
+ * Tables without an index keep using the linear search.
+ *
+ * ```C
+ * static fib_entry_t _entries[TABLE_SIZE];
+ * static uint16_t _buckets[TABLE_SIZE];
+ * static fib_hashed_t _index = { .buckets = _buckets,
+ *                                .buckets_numof = ARRAY_SIZE(_buckets) };
+ * static fib_table_t _table = { .data.entries = _entries,
+ *                               .table_type = FIB_TABLE_TYPE_SH,
+ *                               .size = TABLE_SIZE,
+ *                               .mtx_access = MUTEX_INIT,
+ *                               .hashed = &_index };
+ * ```
+ *
+ * @{
+ *
+ * @file
+ * @brief       Types and configuration of the hashed FIB engine
+ */
+
+#ifndef NET_FIB_HASHED_H
+#define NET_FIB_HASHED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_fib_hashed_conf    Hashed FIB engine compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of slots of the lifetime expiry wheel
+ *
+ * @note    Must not exceed 256.
+ */
+#ifndef CONFIG_FIB_HASHED_WHEEL_SIZE
+#define CONFIG_FIB_HASHED_WHEEL_SIZE        (32U)
+#endif
+
+/**
+ * @brief   Time covered by one slot of the lifetime expiry wheel in ms
+ */
+#ifndef CONFIG_FIB_HASHED_WHEEL_TICK_MS
+#define CONFIG_FIB_HASHED_WHEEL_TICK_MS     (1000U)
+#endif
+
+/**
+ * @brief   Maximum number of distinct prefix lengths in a table
+ *
+ * Adding a network prefix entry with another prefix length fails with
+ * `-ENOMEM`.
+ */
+#ifndef CONFIG_FIB_HASHED_PFX_LEN_NUMOF
+#define CONFIG_FIB_HASHED_PFX_LEN_NUMOF     (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Per entry state of the hashed FIB engine
+ *
+ * @note    Only used internally by the FIB.
+ */
+typedef struct {
+    uint16_t hash_next[2];  /**< next entry in the hash chains */
+    uint16_t bucket[2];     /**< buckets of the hash chains */
+    uint16_t wheel_next;    /**< next entry in the wheel slot */
+    uint16_t wheel_prev;    /**< previous entry in the wheel slot */
+    uint8_t wheel_slot;     /**< slot of the wheel */
+    uint8_t flags;          /**< index memberships of the entry */
+} fib_hashed_link_t;
+
+/**
+ * @brief   Index of a FIB table
+ */
+typedef struct {
+    /**
+     * @brief   Heads of the hash chains
+     *
+     * Any number of buckets works, but about one bucket per table entry is
+     * a good trade-off.
+     */
+    uint16_t *buckets;
+    uint16_t buckets_numof;                 /**< number of buckets */
+    uint8_t pfx_len_numof;                  /**< number of prefix lengths in use */
+    /**
+     * @brief   Prefix lengths in use, longest first
+     */
+    uint8_t pfx_len[CONFIG_FIB_HASHED_PFX_LEN_NUMOF];
+    /**
+     * @brief   Number of entries of each length in fib_hashed_t::pfx_len
+     */
+    uint16_t pfx_len_users[CONFIG_FIB_HASHED_PFX_LEN_NUMOF];
+    uint16_t wheel[CONFIG_FIB_HASHED_WHEEL_SIZE];   /**< heads of the wheel slots */
+    uint64_t wheel_tick;                    /**< current tick of the wheel */
+} fib_hashed_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_FIB_HASHED_H */
+/** @} */
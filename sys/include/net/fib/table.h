@@ -24,6 +24,9 @@
 #include "sched.h"
 #include "universal_address.h"
 #include "mutex.h"
+#if defined(MODULE_FIB_HASHED) || defined(DOXYGEN)
+#include "net/fib/hashed.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +54,10 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_HASHED) || defined(DOXYGEN)
+    /** State of the entry in fib_table_t::hashed */
+    fib_hashed_link_t hashed;
+#endif
 } fib_entry_t;
 
 /**
@@ -77,6 +84,10 @@ typedef struct {
     fib_sr_entry_t *sr_path;
     /** Pointer to the destination of the source route */
     fib_sr_entry_t *sr_dest;
+#if defined(MODULE_FIB_HASHED) || defined(DOXYGEN)
+    /** State of the source route in fib_table_t::hashed */
+    fib_hashed_link_t hashed;
+#endif
 } fib_sr_t;
 
 /**
@@ -133,6 +144,12 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_HASHED) || defined(DOXYGEN)
+    /** index of the table, the table is searched linearly if NULL.
+    *   See @ref net_fib_hashed
+    */
+    fib_hashed_t *hashed;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
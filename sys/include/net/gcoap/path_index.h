@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @defgroup    net_gcoap_path_index    Gcoap path index
+ * @ingroup     net_gcoap
+ * @brief       Radix tree of the resource paths of all listeners
+ *
+ * By default, gcoap finds the resource for a request by comparing its path
+ * with every resource of every listener. With the `gcoap_path_index` module,
+ * the resources of listeners that use the default request matcher are added
+ * to a radix tree when the listener is registered. A request then only
+ * follows its path down the tree, so the time to find a resource does not
+ * grow with the number of resources anymore.
+ *
+ * The result is the same as with the default request matcher: The first
+ * matching resource of the most recently registered listener wins, paths
+ * with @ref COAP_MATCH_SUBTREE match every path they are a prefix of and
+ * @ref GCOAP_RESOURCE_WRONG_METHOD is reported if only the method did not
+ * match. Listeners with their own request matcher and listeners that do not
+ * fit into the index anymore are still searched one by one.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the gcoap path index
+ */
+
+#ifndef NET_GCOAP_PATH_INDEX_H
+#define NET_GCOAP_PATH_INDEX_H
+
+#include <stdbool.h>
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of resources in the index
+ */
+#ifndef CONFIG_GCOAP_PATH_INDEX_SIZE
+#define CONFIG_GCOAP_PATH_INDEX_SIZE    (64U)
+#endif
+
+/**
+ * @brief   Add the resources of a listener to the index
+ *
+ * On success, the request matcher of @p listener is set to one using the
+ * index.
+ *
+ * @param[in,out] listener  listener to add, with the default request matcher
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if the resources do not fit into the index
+ */
+int gcoap_path_index_add(gcoap_listener_t *listener);
+
+/**
+ * @brief   Check if the resources of a listener are in the index
+ *
+ * @param[in] listener  listener to check
+ *
+ * @return  true if @p listener was added with gcoap_path_index_add()
+ */
+bool gcoap_path_index_contains(const gcoap_listener_t *listener);
+
+/**
+ * @brief   Find the resource for a request in the index
+ *
+ * @param[in]  uri          Uri-Path of the request
+ * @param[in]  method       method flag of the request
+ * @param[in]  tl_type      transport the request came over
+ * @param[out] resource     matching resource
+ * @param[out] listener     listener of @p resource
+ *
+ * @return  GCOAP_RESOURCE_FOUND on match
+ * @return  GCOAP_RESOURCE_WRONG_METHOD if resources only match the path
+ * @return  GCOAP_RESOURCE_NO_PATH if no resource matches
+ */
+int gcoap_path_index_find(const char *uri, coap_method_flags_t method,
+                          gcoap_socket_type_t tl_type,
+                          const coap_resource_t **resource,
+                          gcoap_listener_t **listener);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GCOAP_PATH_INDEX_H */
+/** @} */
@@ -220,6 +220,21 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   Index off-link entries in a compressed binary trie
+ *
+ * By default, the longest-prefix match for a destination is searched by
+ * comparing it against every off-link entry (i.e. every forwarding table and
+ * prefix list entry). With this option, a path-compressed binary trie over the
+ * prefixes of the off-link entries is maintained alongside them, so the cost of
+ * a lookup only depends on the prefix length, not on
+ * @ref CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF. This is worth it for routers with large
+ * forwarding tables, e.g. border routers carrying many RPL downward routes.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE
+#define CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE            0
+#endif
+
 /**
  * @brief   Multihop duplicate address detection
  *
@@ -93,6 +93,16 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing several received packets up the
+ *          network stack at once
+ *
+ * The content is a packet of type @ref GNRC_NETTYPE_UNDEF holding the
+ * pointers to the received packets. Only sent to subscribers that set
+ * gnrc_netreg_entry_t::rcv_batch, see gnrc_netapi_dispatch_receive_batch().
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BATCH  (0x0206)
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -214,6 +224,43 @@ static inline int gnrc_netapi_dispatch_receive(gnrc_nettype_t type, uint32_t dem
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Passes several received packets to all subscribers to
+ *          (@p type, @p demux_ctx)
+ *
+ * If the only subscriber is a thread that set
+ * gnrc_netreg_entry_t::rcv_batch, all packets are passed on in a single
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH message. Otherwise, each packet is
+ * passed on like with gnrc_netapi_dispatch_receive().
+ *
+ * @note    Only available with `gnrc_netif_rx_batch` module.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] pkts      received packets
+ * @param[in] numof     number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx). The packets are
+ *         not released if 0.
+ */
+int gnrc_netapi_dispatch_receive_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                                       gnrc_pktsnip_t **pkts, unsigned numof);
+
+/**
+ * @brief   Handles the packets of a @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH
+ *          message
+ *
+ * @note    Only available with `gnrc_netif_rx_batch` module.
+ *
+ * @param[in] batch     content of the message, released afterwards
+ * @param[in] receive   called with each packet like for a
+ *                      @ref GNRC_NETAPI_MSG_TYPE_RCV message
+ */
+void gnrc_netapi_receive_batch(gnrc_pktsnip_t *batch,
+                               void (*receive)(gnrc_pktsnip_t *pkt));
+#endif
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_GET messages and
  *          parsing the returned @ref GNRC_NETAPI_MSG_TYPE_ACK message
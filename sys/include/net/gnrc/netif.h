@@ -19,6 +19,18 @@
  * If you only have one network interface on the board, you can select the
  * `gnrc_netif_single` pseudo-module to enable further optimisations.
  *
+ * ## Batched receive
+ *
+ * With the `gnrc_netif_rx_batch` pseudo-module, the packets a network device
+ * reports during one call of its ISR handler are collected and passed on to
+ * the upper layers after the handler returned, up to
+ * @ref CONFIG_GNRC_NETIF_RX_BATCH_SIZE at a time. Consecutive packets of the
+ * same type are handed over to their subscriber in a single
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH message, if it is the only one and
+ * takes batches (see gnrc_netreg_entry_t::rcv_batch), as @ref net_gnrc_ipv6
+ * does. Devices that drain their receive queue in one ISR call (such as
+ * `netdev_tap`) benefit most.
+ *
  * @{
  *
  * @file
@@ -181,6 +193,16 @@ typedef struct {
      * @note    Only available with @ref net_gnrc_netif_pktq.
      */
     gnrc_netif_pktq_t send_queue;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH) || defined(DOXYGEN)
+    /**
+     * @brief   Packets received during the current ISR of the device
+     *
+     * @note    Only available with `gnrc_netif_rx_batch`.
+     */
+    gnrc_pktsnip_t *rx_batch[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    uint8_t rx_batch_numof;                 /**< Number of packets in gnrc_netif_t::rx_batch */
+    bool rx_batch_active;                   /**< Device ISR is being handled */
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
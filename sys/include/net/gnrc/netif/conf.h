@@ -163,6 +163,16 @@ extern "C" {
 #define CONFIG_GNRC_NETIF_DEFAULT_HL      (64U)   /**< default hop limit */
 #endif
 
+/**
+ * @brief   Maximum number of received packets collected before they are
+ *          passed on to the upper layers
+ *
+ * @note    Only used with the `gnrc_netif_rx_batch` pseudo-module.
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_BATCH_SIZE
+#define CONFIG_GNRC_NETIF_RX_BATCH_SIZE     (8U)
+#endif
+
 /**
  * @brief   Minimum wait time in microseconds after a send operation
  *
@@ -29,6 +29,9 @@
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netif.h"
+#if IS_USED(MODULE_GNRC_PKTPROF)
+#include "net/gnrc/pktprof.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -153,6 +156,14 @@ typedef struct {
      */
     uint64_t timestamp;
 #endif /* MODULE_GNRC_NETIF_TIMESTAMP */
+#if IS_USED(MODULE_GNRC_PKTPROF) || defined(DOXYGEN)
+    /**
+     * @brief   Stage stamps of a received packet
+     *
+     * This field is only provided if module `gnrc_pktprof` is used.
+     */
+    gnrc_pktprof_t prof;
+#endif
 } gnrc_netif_hdr_t;
 
 /**
@@ -171,6 +182,9 @@ static inline void gnrc_netif_hdr_init(gnrc_netif_hdr_t *hdr, uint8_t src_l2addr
     hdr->rssi = GNRC_NETIF_HDR_NO_RSSI;
     hdr->lqi = GNRC_NETIF_HDR_NO_LQI;
     hdr->flags = 0;
+#if IS_USED(MODULE_GNRC_PKTPROF)
+    hdr->prof.stamped = 0;
+#endif
 }
 
 /**
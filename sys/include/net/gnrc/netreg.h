@@ -10,6 +10,16 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default, the registry keeps one list of entries per
+ * @ref gnrc_nettype_t, so a lookup visits all entries of a type. With many
+ * entries of one type (e.g. hundreds of UDP ports), the `gnrc_netreg_hashed`
+ * module can be used instead: Entries are then hashed by type and
+ * @ref gnrc_netreg_entry_t::demux_ctx into
+ * @ref CONFIG_GNRC_NETREG_HASHED_BUCKETS lists.
+ *
+ * With the `gnrc_netreg_stats` module the registry counts how many entries
+ * its lookups visit, see gnrc_netreg_stats_get().
  * @{
  *
  * @file
@@ -22,7 +32,9 @@
 #define NET_GNRC_NETREG_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
+#include "kernel_defines.h"
 #include "sched.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
@@ -35,6 +47,21 @@
 extern "C" {
 #endif
 
+/**
+ * @defgroup net_gnrc_netreg_conf GNRC NETREG compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of lists of the hashed registry
+ *
+ * @note    Only used with `gnrc_netreg_hashed` module. Should be a power of 2.
+ */
+#ifndef CONFIG_GNRC_NETREG_HASHED_BUCKETS
+#define CONFIG_GNRC_NETREG_HASHED_BUCKETS   (16U)
+#endif
+/** @} */
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
@@ -87,52 +114,65 @@ typedef enum {
 /**
  * @brief   Initializes a netreg entry statically with PID
  *
- * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
- *                      for the netreg entry
- * @param[in] pid       The PID of the registering thread
+ * @param[in] _demux_ctx    The @ref gnrc_netreg_entry_t::demux_ctx
+ *                          "demux context" for the netreg entry
+ * @param[in] _pid          The PID of the registering thread
  *
  * @return  An initialized netreg entry
  */
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
-                                                      GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(_demux_ctx, _pid) { \
+        .next = NULL, \
+        .demux_ctx = _demux_ctx, \
+        .type = GNRC_NETREG_TYPE_DEFAULT, \
+        .target = { .pid = _pid } \
+    }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(_demux_ctx, _pid) { \
+        .next = NULL, \
+        .demux_ctx = _demux_ctx, \
+        .target = { .pid = _pid } \
+    }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
 /**
  * @brief   Initializes a netreg entry statically with mbox
  *
- * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
- *                      for the netreg entry
- * @param[in] _mbox      Target @ref core_mbox "mailbox" for the registry entry
+ * @param[in] _demux_ctx    The @ref gnrc_netreg_entry_t::demux_ctx
+ *                          "demux context" for the netreg entry
+ * @param[in] _mbox         Target @ref core_mbox "mailbox" for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_mbox.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
-                                                       GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = _mbox } }
+#define GNRC_NETREG_ENTRY_INIT_MBOX(_demux_ctx, _mbox) { \
+        .next = NULL, \
+        .demux_ctx = _demux_ctx, \
+        .type = GNRC_NETREG_TYPE_MBOX, \
+        .target = { .mbox = _mbox } \
+    }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
 /**
  * @brief   Initializes a netreg entry statically with callback
  *
- * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
- *                      for the netreg entry
- * @param[in] _cbd       Target callback for the registry entry
+ * @param[in] _demux_ctx    The @ref gnrc_netreg_entry_t::demux_ctx
+ *                          "demux context" for the netreg entry
+ * @param[in] _cbd          Target callback for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_callbacks.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
-                                                      GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = _cbd } }
+#define GNRC_NETREG_ENTRY_INIT_CB(_demux_ctx, _cbd) { \
+        .next = NULL, \
+        .demux_ctx = _demux_ctx, \
+        .type = GNRC_NETREG_TYPE_CB, \
+        .target = { .cbd = _cbd } \
+    }
 /** @} */
 
 /**
@@ -210,8 +250,41 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+#if defined(MODULE_GNRC_NETREG_HASHED) || defined(DOXYGEN)
+    /**
+     * @brief   Type of the protocol the entry is registered for
+     *
+     * @note    Only available with `gnrc_netreg_hashed` module.
+     *
+     * @internal
+     */
+    gnrc_nettype_t nettype;
+#endif
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH) || defined(DOXYGEN)
+    /**
+     * @brief   The registering thread handles
+     *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH messages
+     *
+     * @note    Only available with `gnrc_netif_rx_batch` module. Only
+     *          evaluated for entries of threads.
+     */
+    bool rcv_batch;
+#endif
 } gnrc_netreg_entry_t;
 
+#if defined(MODULE_GNRC_NETREG_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Lookup statistics of the registry
+ *
+ * @note    Only available with `gnrc_netreg_stats` module.
+ */
+typedef struct {
+    uint32_t lookups;           /**< number of lookups */
+    uint32_t visited;           /**< number of entries visited by all lookups */
+    uint16_t depth_max;         /**< most entries visited by a single lookup */
+} gnrc_netreg_stats_t;
+#endif
+
 /**
  * @brief   Initializes module.
  */
@@ -241,6 +314,9 @@ static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
     entry->type = GNRC_NETREG_TYPE_DEFAULT;
 #endif
     entry->target.pid = pid;
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    entry->rcv_batch = false;
+#endif
 }
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -377,6 +453,28 @@ gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry);
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+#if defined(MODULE_GNRC_NETREG_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Gets the lookup statistics of the registry
+ *
+ * gnrc_netreg_lookup(), gnrc_netreg_getnext() and every step of
+ * gnrc_netreg_num() count as one lookup each. Their depth is the number of
+ * entries they visit until they find a match or the end of a list.
+ *
+ * @note    Only available with `gnrc_netreg_stats` module.
+ *
+ * @param[out] stats    The statistics.
+ */
+void gnrc_netreg_stats_get(gnrc_netreg_stats_t *stats);
+
+/**
+ * @brief   Resets the lookup statistics of the registry
+ *
+ * @note    Only available with `gnrc_netreg_stats` module.
+ */
+void gnrc_netreg_stats_reset(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktbuf_slab    Size-class packet buffer
+ * @ingroup     net_gnrc_pktbuf
+ * @brief       Implementation of @ref net_gnrc_pktbuf based on segregated
+ *              size classes
+ *
+ * Instead of a first-fit walk over a single arena (as done by
+ * `gnrc_pktbuf_static`), this implementation splits the packet buffer into a
+ * fixed number of size classes ("slabs"). Each class consists of equally sized
+ * blocks which are kept in a free list of their own. Allocating and freeing a
+ * block thus takes constant time and the buffer can not fragment into holes
+ * that are too small to be used.
+ *
+ * The smallest class is dimensioned for @ref gnrc_pktsnip_t descriptors, the
+ * remaining classes for small headers, IEEE 802.15.4 sized frames and
+ * Ethernet/full-MTU IPv6 sized frames. If a class is exhausted the allocation
+ * falls back to the next bigger class.
+ *
+ * Marking a packet (see @ref gnrc_pktbuf_mark()) does not copy any data: both
+ * resulting snips share the original block, which is reference counted.
+ *
+ * To use this implementation instead of the default one, add
+ *
+ *     USEMODULE += gnrc_pktbuf_slab
+ *
+ * to your application's Makefile.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Size-class packet buffer definitions
+ */
+#ifndef NET_GNRC_PKTBUF_SLAB_H
+#define NET_GNRC_PKTBUF_SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_gnrc_pktbuf_slab_conf GNRC size-class packet buffer compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of blocks reserved for packet snip descriptors
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF      (32U)
+#endif
+
+/**
+ * @brief   Block size of the small data class in bytes
+ *
+ * @details Dimensioned for headers, e.g. an IPv6 header or a
+ *          @ref gnrc_netif_hdr_t with link-layer addresses.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE      (64U)
+#endif
+
+/**
+ * @brief   Number of blocks in the small data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF     (16U)
+#endif
+
+/**
+ * @brief   Block size of the medium data class in bytes
+ *
+ * @details Dimensioned for IEEE 802.15.4 frames and 6LoWPAN fragments.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_SIZE     (256U)
+#endif
+
+/**
+ * @brief   Number of blocks in the medium data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_NUMOF    (8U)
+#endif
+
+/**
+ * @brief   Block size of the large data class in bytes
+ *
+ * @details Dimensioned for Ethernet frames and full-MTU IPv6 packets.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE      (1536U)
+#endif
+
+/**
+ * @brief   Number of blocks in the large data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF     (2U)
+#endif
+/** @} */
+
+/**
+ * @brief   Alignment of all blocks in the packet buffer
+ */
+#define GNRC_PKTBUF_SLAB_ALIGN                  (8U)
+
+/**
+ * @brief   Rounds @p size up to @ref GNRC_PKTBUF_SLAB_ALIGN
+ */
+#define GNRC_PKTBUF_SLAB_ALIGN_UP(size) \
+    (((size) + GNRC_PKTBUF_SLAB_ALIGN - 1) & ~(GNRC_PKTBUF_SLAB_ALIGN - 1))
+
+/**
+ * @brief   Block size of the packet snip class
+ */
+#define GNRC_PKTBUF_SLAB_SNIP_SIZE \
+    GNRC_PKTBUF_SLAB_ALIGN_UP(sizeof(gnrc_pktsnip_t))
+
+/**
+ * @brief   Number of size classes
+ */
+#define GNRC_PKTBUF_SLAB_CLASS_NUMOF            (4U)
+
+/**
+ * @brief   Total size of the packet buffer arena in bytes
+ */
+#define GNRC_PKTBUF_SLAB_SIZE \
+    ((GNRC_PKTBUF_SLAB_SNIP_SIZE * CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ALIGN_UP(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ALIGN_UP(CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ALIGN_UP(CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF))
+
+/**
+ * @brief   Statistics of a single size class
+ */
+typedef struct {
+    uint16_t size;          /**< size of a block in bytes */
+    uint16_t numof;         /**< number of blocks in the class */
+    uint16_t used;          /**< number of blocks currently in use */
+    uint16_t max_used;      /**< high-water mark of blocks in use */
+    uint32_t fallbacks;     /**< allocations that had to fall back to a bigger
+                             *   class because this one was exhausted */
+} gnrc_pktbuf_slab_class_stats_t;
+
+/**
+ * @brief   Global statistics of the packet buffer
+ */
+typedef struct {
+    size_t requested;       /**< bytes currently requested by users */
+    size_t reserved;        /**< bytes currently reserved in blocks */
+    size_t max_reserved;    /**< high-water mark of reserved bytes */
+    uint32_t fails;         /**< allocations that failed */
+    uint32_t frag_fails;    /**< allocations that failed although the sum of
+                             *   free bytes would have sufficed */
+} gnrc_pktbuf_slab_stats_t;
+
+/**
+ * @brief   Get the statistics of a size class
+ *
+ * @param[in] cls       Index of the size class, classes are ordered by block
+ *                      size. Must be < @ref GNRC_PKTBUF_SLAB_CLASS_NUMOF.
+ * @param[out] stats    Statistics of class @p cls.
+ */
+void gnrc_pktbuf_slab_get_class_stats(unsigned cls,
+                                      gnrc_pktbuf_slab_class_stats_t *stats);
+
+/**
+ * @brief   Get the global statistics of the packet buffer
+ *
+ * Internal fragmentation (bytes wasted due to rounding up to block sizes) is
+ * `stats->reserved - stats->requested`.
+ *
+ * @param[out] stats    Global statistics.
+ */
+void gnrc_pktbuf_slab_get_stats(gnrc_pktbuf_slab_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTBUF_SLAB_H */
+/** @} */
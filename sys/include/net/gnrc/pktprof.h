@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktprof Packet profiling
+ * @ingroup     net_gnrc
+ * @brief       Measures the latency of received packets between the layers
+ *              of GNRC
+ *
+ * GNRC passes a received packet from the network interface thread through
+ * the threads of the network and transport layers to a socket, and every
+ * hop between them waits in a message queue. With this module, each layer
+ * stamps the packet when it starts handling it (see @ref
+ * gnrc_pktprof_stage_t). The stamps are kept in the @ref gnrc_netif_hdr_t
+ * of the packet, which stays attached to it up to the socket.
+ *
+ * For every stage, the time since the previous stamp of the packet is added
+ * to a histogram with logarithmic buckets, so that the median and tail
+ * latency of each hop can be estimated with bounded memory. Times are in
+ * @ref benchmark_now() ticks, i.e. in microseconds, or in CPU cycles with
+ * the `benchmark_cycles` module.
+ *
+ * With the `gnrc_pktprof_cmd` module, the shell command `pktprof` prints the
+ * histograms as a table or as one JSON object per stage.
+ *
+ * @note    Datagrams reassembled from 6LoWPAN fragments get a new interface
+ *          header, so their hops are counted from the 6LoWPAN stage on.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet profiling definitions
+ */
+
+#ifndef NET_GNRC_PKTPROF_H
+#define NET_GNRC_PKTPROF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_gnrc_pktprof_conf GNRC packet profiling compile
+ *                                 configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of histogram buckets per stage
+ *
+ * Bucket `i` counts latencies in [2^i, 2^(i + 1)), the last bucket also
+ * counts all larger latencies.
+ */
+#ifndef CONFIG_GNRC_PKTPROF_BUCKETS
+#define CONFIG_GNRC_PKTPROF_BUCKETS     (24U)
+#endif
+/** @} */
+
+/**
+ * @brief   Stages of a received packet
+ */
+typedef enum {
+    GNRC_PKTPROF_NETIF,         /**< received from the device by the
+                                     interface */
+    GNRC_PKTPROF_SIXLOWPAN,     /**< handled by the 6LoWPAN thread */
+    GNRC_PKTPROF_IPV6,          /**< handled by the IPv6 thread */
+    GNRC_PKTPROF_UDP,           /**< handled by the UDP thread */
+    GNRC_PKTPROF_SOCK,          /**< received by a socket */
+    GNRC_PKTPROF_NUMOF,         /**< number of stages */
+} gnrc_pktprof_stage_t;
+
+/**
+ * @brief   Stamps of a packet, part of its interface header
+ */
+typedef struct {
+    uint32_t stamps[GNRC_PKTPROF_NUMOF];    /**< time of each stage */
+    uint8_t stamped;                        /**< stages stamped, one bit per
+                                                 stage */
+} gnrc_pktprof_t;
+
+/**
+ * @brief   Latency histogram of a stage
+ */
+typedef struct {
+    uint32_t count;                                 /**< packets counted */
+    uint32_t max;                                   /**< maximum latency */
+    uint64_t sum;                                   /**< sum of latencies */
+    uint32_t buckets[CONFIG_GNRC_PKTPROF_BUCKETS];  /**< histogram */
+} gnrc_pktprof_hist_t;
+
+#if IS_USED(MODULE_GNRC_PKTPROF) || defined(DOXYGEN)
+/**
+ * @brief   Stamp a packet on entering a stage
+ *
+ * Adds the time since the latest previous stage the packet was stamped at to
+ * the histogram of @p stage. Does nothing if @p pkt has no interface header.
+ *
+ * A packet that is shared with other receivers (any snip up to the interface
+ * header has more than one user) is not stamped, because its stamps could be
+ * written concurrently. The next stage stamping it then counts the time since
+ * the latest stamp before.
+ *
+ * @param[in]   pkt     received packet
+ * @param[in]   stage   stage entered
+ */
+void gnrc_pktprof_stamp(gnrc_pktsnip_t *pkt, gnrc_pktprof_stage_t stage);
+#else
+static inline void gnrc_pktprof_stamp(gnrc_pktsnip_t *pkt,
+                                      gnrc_pktprof_stage_t stage)
+{
+    (void)pkt;
+    (void)stage;
+}
+#endif
+
+/**
+ * @brief   Initialize packet profiling, starts the cycle counter if needed
+ *
+ * Called by auto_init.
+ */
+void gnrc_pktprof_init(void);
+
+/**
+ * @brief   Add a latency to the histogram of a stage
+ *
+ * @param[in]   stage   stage the latency was measured for
+ * @param[in]   ticks   latency in @ref benchmark_now() ticks
+ */
+void gnrc_pktprof_record(gnrc_pktprof_stage_t stage, uint32_t ticks);
+
+/**
+ * @brief   Get a copy of the histogram of a stage
+ *
+ * @param[in]   stage   stage to query
+ * @param[out]  hist    histogram
+ */
+void gnrc_pktprof_get(gnrc_pktprof_stage_t stage, gnrc_pktprof_hist_t *hist);
+
+/**
+ * @brief   Estimate a percentile from a histogram
+ *
+ * Interpolates linearly within the bucket the percentile falls into, and
+ * never returns more than gnrc_pktprof_hist_t::max.
+ *
+ * @param[in]   hist        histogram
+ * @param[in]   percent     percentile, 1 to 100
+ *
+ * @return  estimated latency, 0 if @p hist is empty
+ */
+uint32_t gnrc_pktprof_percentile(const gnrc_pktprof_hist_t *hist,
+                                 unsigned percent);
+
+/**
+ * @brief   Clear the histograms of all stages
+ */
+void gnrc_pktprof_reset(void);
+
+/**
+ * @brief   Get the name of a stage
+ *
+ * @param[in]   stage   stage
+ *
+ * @return  name of @p stage
+ */
+const char *gnrc_pktprof_stage_name(gnrc_pktprof_stage_t stage);
+
+/**
+ * @brief   Print count, p50, p99, maximum and average latency of all stages
+ *
+ * @param[in]   json    print one JSON object per stage instead of a table
+ */
+void gnrc_pktprof_print(bool json);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTPROF_H */
+/** @} */
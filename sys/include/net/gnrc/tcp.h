@@ -11,6 +11,25 @@
  * @ingroup     net_gnrc
  * @brief       RIOT's TCP implementation for the GNRC network stack.
  *
+ * Up to @ref CONFIG_GNRC_TCP_RTX_QUEUE_SIZE segments per connection can be in
+ * flight, limited by the send window of the peer. With a `gnrc_tcp_congure_%`
+ * module, e.g. `gnrc_tcp_congure_reno`, the data in flight is also limited by
+ * the congestion window of @ref sys_congure, and duplicate ACKs trigger a fast
+ * retransmit.
+ *
+ * Received data is kept in chunks of a receive pool shared by all connections
+ * (see @ref CONFIG_GNRC_TCP_RCV_CHUNKS). A connection reserves free chunks up
+ * to its fair share of the pool for the receive window it advertises, so the
+ * window does not shrink when other connections take chunks.
+ *
+ * API calls run the state machine of a connection in the calling thread.
+ * Received segments and timers are handled by the TCP eventloop thread. With
+ * module `gnrc_tcp_direct_rcv`, received segments are handled right in the
+ * network layer thread instead, saving a context switch per segment. Each
+ * connection is protected by its own lock, which is always taken before the
+ * lock of the connection list, never after it. The network layer thread
+ * needs additional stack space though (see `GNRC_IPV6_STACK_SIZE`).
+ *
  * @{
  *
  * @file
@@ -70,6 +89,23 @@ typedef struct {
 } gnrc_tcp_ep_t;
 #endif
 
+/**
+ * @brief Usage statistics of the receive pool shared by all connections.
+ */
+typedef struct {
+    uint16_t chunks;           /**< Number of chunks in the pool */
+    uint16_t chunks_free;      /**< Number of currently free chunks */
+    uint16_t chunks_free_min;  /**< Lowest number of free chunks so far */
+    uint16_t users;            /**< Number of connections holding a receive buffer */
+    uint32_t denied;           /**< Number of chunks denied to a connection, because
+                                    the pool was exhausted or the connection
+                                    reached its fair share */
+    uint32_t refused;          /**< Number of connections refused, because the
+                                    pool was exhausted */
+    uint16_t chunks_reserved;  /**< Number of free chunks reserved for advertised
+                                    receive windows */
+} gnrc_tcp_rcvbuf_stats_t;
+
 /**
  * @brief Initialize TCP connection endpoint.
  *
@@ -150,7 +186,7 @@ void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue);
  * @return   -EINVAL if @p remote and @p tcb address_family do not match
  *                    or @p target_addr is invalid.
  * @return   -EISCONN if @p tcb is already connected.
- * @return   -ENOMEM if there are no receive buffer left to use for @p tcb.
+ * @return   -ENOMEM if the receive pool has no chunk left to use for @p tcb.
  * @return   -EADDRINUSE if @p local_port is already in use.
  * @return   -ETIMEDOUT if the connection attempt timed out.
  * @return   -ECONNREFUSED if the connection attempt was reset by the peer.
@@ -176,8 +212,8 @@ int gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote, uint16_t loc
  * @return   -EAFNOSUPPORT given address family in @p local is not supported.
  * @return   -EINVAL address_family in @p tcbs and @p local do not match.
  * @return   -EISCONN a TCB in @p tcbs is already connected.
- * @return   -ENOMEM all available receive buffers are in use.
- *                   Increase GNRC_TCP_RCV_BUFFERS.
+ * @return   -ENOMEM the receive pool has no chunk left for a TCB in @p tcbs.
+ *                   Increase CONFIG_GNRC_TCP_RCV_CHUNKS.
  */
 int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
                     const gnrc_tcp_ep_t *local);
@@ -214,6 +250,8 @@ int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       Transmitted data is kept in the retransmission queue until the peer
+ *       acknowledged it, the function does not wait for the acknowledgment.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -342,6 +380,15 @@ int gnrc_tcp_get_remote(gnrc_tcp_tcb_t *tcb, gnrc_tcp_ep_t *ep);
  */
 int gnrc_tcp_queue_get_local(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_ep_t *ep);
 
+/**
+ * @brief Get usage statistics of the receive pool shared by all connections.
+ *
+ * @pre @p stats must not be NULL.
+ *
+ * @param[out] stats   Current statistics.
+ */
+void gnrc_tcp_get_rcvbuf_stats(gnrc_tcp_rcvbuf_stats_t *stats);
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
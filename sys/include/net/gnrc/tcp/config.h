@@ -92,22 +92,75 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers.
+ * @brief Number of full sized receive buffers the receive pool is sized for.
  *
- * This value determines how many parallel TCP connections can be active at the
- * same time.
+ * All connections share a pool of @ref CONFIG_GNRC_TCP_RCV_CHUNKS chunks,
+ * which by default holds this number of @ref GNRC_TCP_RCV_BUF_SIZE sized
+ * buffers. Far more connections can be active at the same time, each one
+ * occupies at least a single chunk.
  */
 #ifndef CONFIG_GNRC_TCP_RCV_BUFFERS
 #define CONFIG_GNRC_TCP_RCV_BUFFERS (1U)
 #endif
 
 /**
- * @brief Default receive buffer size
+ * @brief Maximum receive buffer size of a connection
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
 #define GNRC_TCP_RCV_BUF_SIZE (CONFIG_GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of a receive pool chunk in bytes.
+ *
+ * Receive buffers grow and shrink in steps of this size.
+ */
+#ifndef CONFIG_GNRC_TCP_RCV_CHUNK_SIZE
+#define CONFIG_GNRC_TCP_RCV_CHUNK_SIZE (128U)
+#endif
+
+/**
+ * @brief Number of chunks in the receive pool shared by all connections.
+ *
+ * Each connection holds one chunk while it is open and reserves further chunks
+ * for its receive window, up to @ref GNRC_TCP_RCV_BUF_SIZE and its fair share
+ * of the pool. The last free chunk is never reserved, and listeners reserve
+ * nothing until a SYN arrives.
+ */
+#ifndef CONFIG_GNRC_TCP_RCV_CHUNKS
+#define CONFIG_GNRC_TCP_RCV_CHUNKS ((CONFIG_GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE + \
+                                     CONFIG_GNRC_TCP_RCV_CHUNK_SIZE - 1) / \
+                                    CONFIG_GNRC_TCP_RCV_CHUNK_SIZE)
+#endif
+
+/**
+ * @brief Maximum number of segments in flight per connection.
+ *
+ * Sent segments are kept in the packet buffer until they are acknowledged, so
+ * this limits the packet buffer space a connection can occupy.
+ */
+#ifndef CONFIG_GNRC_TCP_RTX_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_RTX_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Maximum number of out-of-order segments kept per connection.
+ *
+ * Only used with module `gnrc_tcp_sack`. Segments received beyond a gap are
+ * kept in the packet buffer until the gap is filled, and are reported to the
+ * peer in SACK blocks.
+ */
+#ifndef CONFIG_GNRC_TCP_SACK_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_SACK_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Maximum number of SACK blocks sent in a segment (1 to 4).
+ */
+#ifndef CONFIG_GNRC_TCP_SACK_BLOCKS
+#define CONFIG_GNRC_TCP_SACK_BLOCKS (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO in milliseconds. Default is 1 sec (see RFC 6298)
  *
@@ -186,6 +239,17 @@ extern "C" {
 #define CONFIG_GNRC_TCP_EVENTLOOP_MSG_QUEUE_SIZE_EXP (3U)
 #endif
 
+/**
+ * @brief Number of buckets of the table used to find the TCB of a received
+ *        segment.
+ * @note The number of buckets must be a power of two.
+ *       This value defines the exponent of 2^n. Zero degrades the lookup
+ *       to a walk over all TCBs.
+ */
+#ifndef CONFIG_GNRC_TCP_TCB_HASH_BUCKETS_EXP
+#define CONFIG_GNRC_TCP_TCB_HASH_BUCKETS_EXP (3U)
+#endif
+
 /**
  * @brief Enable experimental feature "dynamic msl". Disabled by default.
  * @experimental This feature is experimental because it deviates from the TCP RFC.
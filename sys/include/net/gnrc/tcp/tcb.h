@@ -21,7 +21,6 @@
 #define NET_GNRC_TCP_TCB_H
 
 #include <stdint.h>
-#include "ringbuffer.h"
 #include "mutex.h"
 #include "evtimer_msg.h"
 #include "evtimer_mbox.h"
@@ -34,10 +33,65 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_TCP_CONGURE
+#include "congure.h"
+#endif
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+#include "congure/reno.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Segment in the retransmission queue of a TCB.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< Sent packet */
+    uint32_t seq;          /**< Sequence number of the segment */
+    uint32_t sent;         /**< Time of the first transmission in milliseconds */
+    uint16_t len;          /**< Sequence number space consumed by the segment */
+    uint8_t resends;       /**< Number of retransmissions */
+    uint8_t flags;         /**< Selective acknowledgment and loss recovery flags */
+} gnrc_tcp_rtx_t;
+
+/**
+ * @brief Receive buffer of a TCB, a chain of chunks of the shared receive pool.
+ */
+typedef struct {
+    uint16_t head;         /**< Index of the first chunk */
+    uint16_t tail;         /**< Index of the last chunk */
+    uint16_t rd;           /**< Read offset in the first chunk */
+    uint16_t wr;           /**< Write offset in the last chunk */
+    uint16_t chunks;       /**< Number of chunks, zero if no buffer is assigned */
+    uint16_t reserved;     /**< Number of free chunks of the pool reserved for
+                                the advertised window */
+} gnrc_tcp_rcvbuf_t;
+
+#if defined(MODULE_GNRC_TCP_SACK) || defined(DOXYGEN)
+/**
+ * @brief Segment received out of order, kept until the gap before it is filled.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< Received packet */
+    uint32_t seq;          /**< Sequence number of the segment */
+    uint16_t len;          /**< Payload length of the segment */
+} gnrc_tcp_ooo_t;
+#endif
+
+#if defined(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+/**
+ * @brief Congestion control state of a TCB, one member per implementation.
+ */
+typedef union {
+    congure_snd_t super;          /**< Common state */
+#if defined(MODULE_GNRC_TCP_CONGURE_RENO) || defined(DOXYGEN)
+    congure_reno_snd_t reno;      /**< TCP Reno state */
+#endif
+} gnrc_tcp_congure_t;
+#endif
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -62,21 +116,32 @@ typedef struct sock_tcp {
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
-    uint32_t rtt_start;    /**< Timer value for rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    uint32_t recover;      /**< Highest sequence number sent when loss recovery started */
     evtimer_msg_event_t event_retransmit; /**< Retransmission event */
     evtimer_msg_event_t event_timeout;    /**< Timeout event */
     evtimer_mbox_event_t event_misc;      /**< General purpose event */
-    gnrc_pktsnip_t *pkt_retransmit;       /**< Pointer to packet in "retransmit queue" */
+    gnrc_tcp_rtx_t rtx[CONFIG_GNRC_TCP_RTX_QUEUE_SIZE]; /**< Retransmission queue */
+    uint8_t rtx_head;      /**< Index of the oldest segment in the retransmission queue */
+    uint8_t rtx_len;       /**< Number of segments in the retransmission queue */
+#if defined(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+    gnrc_tcp_congure_t congure; /**< Congestion control state */
+#endif
+#if defined(MODULE_GNRC_TCP_SACK) || defined(DOXYGEN)
+    gnrc_tcp_ooo_t ooo[CONFIG_GNRC_TCP_SACK_QUEUE_SIZE]; /**< Out-of-order segments, sorted */
+    uint32_t ooo_latest;   /**< Sequence number of the latest out-of-order segment */
+    uint8_t ooo_len;       /**< Number of out-of-order segments */
+#endif
     mbox_t *mbox;            /**< TCB mbox for synchronization */
-    uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
-    ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    gnrc_tcp_rcvbuf_t rcv_buf; /**< Receive buffer */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
     struct sock_tcp *next;   /**< Pointer next TCB */
+    struct sock_tcp *hash_next; /**< Pointer next TCB in the same lookup table bucket */
+    uint8_t hash_bucket;     /**< Lookup table bucket plus one, zero if not inserted */
 } gnrc_tcp_tcb_t;
 
 /**
@@ -12,6 +12,13 @@
  *
  * @brief       Sock DNS client
  *
+ * Concurrent queries for the same name and address family share a single
+ * request to the DNS server. With module `dns_cache`, results are cached as
+ * long as their TTL allows (see @ref net_dns_cache).
+ *
+ * With module `sock_dns_async`, names can also be resolved without blocking
+ * using @ref sock_dns_query_async().
+ *
  * @{
  *
  * @file
@@ -28,10 +35,16 @@
 #include <stdint.h>
 #include <unistd.h>
 
+#include "kernel_defines.h"
 #include "net/dns/msg.h"
 
 #include "net/sock/udp.h"
 
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+#include "event.h"
+#include "event/timeout.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -81,6 +94,24 @@ extern "C" {
 #define SOCK_DNS_MAX_NAME_LEN   (CONFIG_DNS_MSG_LEN - sizeof(dns_hdr_t) - 4)
 /** @} */
 
+/**
+ * @brief Caller waiting for the result of a DNS query (internal)
+ */
+typedef struct sock_dns_waiter {
+    struct sock_dns_waiter *next;       /**< Next pending query, or next caller
+                                             sharing the same query */
+    struct sock_dns_waiter *waiters;    /**< Callers sharing the query sent
+                                             for this caller */
+    const char *domain_name;            /**< Name to resolve */
+    void *addr_out;                     /**< Buffer for the result */
+    int family;                         /**< Address family to resolve */
+    int res;                            /**< Result of the query */
+    /**
+     * @brief   Passes the result to a caller sharing the query of another one
+     */
+    void (*done)(struct sock_dns_waiter *waiter);
+} sock_dns_waiter_t;
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -93,6 +124,9 @@ extern "C" {
  * This function will return the first DNS record it receives. IF both A and
  * AAAA are requested, AAAA will be preferred.
  *
+ * If another thread is already resolving @p domain_name for @p family, this
+ * function waits for its result instead of sending a request of its own.
+ *
  * @note @p addr_out needs to provide space for any possible result!
  *       (4byte when family==AF_INET, 16byte otherwise)
  *
@@ -101,10 +135,72 @@ extern "C" {
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
  * @return      the size of the resolved address on success
+ * @return      -ENOENT, if @p domain_name has no address of @p family
  * @return      < 0 otherwise
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+#if IS_USED(MODULE_SOCK_DNS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Asynchronous DNS request type
+ */
+typedef struct sock_dns_req sock_dns_req_t;
+
+/**
+ * @brief Called with the result of an asynchronous DNS request
+ *
+ * @param[in]   req     The request
+ * @param[in]   res     The size of the resolved address on success, a negative
+ *                      value like the return value of @ref sock_dns_query()
+ *                      otherwise
+ * @param[in]   addr    The resolved address, NULL if @p res < 0
+ * @param[in]   arg     Argument given to @ref sock_dns_query_async()
+ */
+typedef void (*sock_dns_cb_t)(sock_dns_req_t *req, int res, const void *addr,
+                              void *arg);
+
+/**
+ * @brief Asynchronous DNS request
+ *
+ * All members are internal.
+ */
+struct sock_dns_req {
+    sock_dns_waiter_t waiter;           /**< Pending query */
+    sock_udp_t sock;                    /**< Socket, if the request is sent */
+    event_queue_t *queue;               /**< Queue to handle the request */
+    event_t done_event;                 /**< Calls the callback */
+    event_t retry_event;                /**< Repeats the request */
+    event_timeout_t timeout;            /**< Timer of retry_event */
+    sock_dns_cb_t cb;                   /**< Callback */
+    void *arg;                          /**< Callback argument */
+    uint8_t addr[16];                   /**< Resolved address */
+    uint8_t buf[CONFIG_DNS_MSG_LEN];    /**< Request and reply */
+    uint8_t tries;                      /**< Number of requests sent */
+};
+
+/**
+ * @brief Get IP address for DNS name without blocking
+ *
+ * Like @ref sock_dns_query(), but returns right away. @p cb is called from
+ * the thread handling @p queue once the result is known.
+ *
+ * @note @p req and @p domain_name must stay valid until @p cb was called.
+ *
+ * @param[out]  req             Request to use
+ * @param[in]   domain_name     DNS name to resolve into address
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ * @param[in]   queue           Event queue to handle the request
+ * @param[in]   cb              Called with the result
+ * @param[in]   arg             Argument for @p cb
+ *
+ * @return      0 if @p cb will be called
+ * @return      < 0 otherwise, like the return value of @ref sock_dns_query()
+ */
+int sock_dns_query_async(sock_dns_req_t *req, const char *domain_name,
+                         int family, event_queue_t *queue, sock_dns_cb_t cb,
+                         void *arg);
+#endif
+
 /**
  * @brief global DNS server endpoint
  */
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_pubsub Topic based publish/subscribe
+ * @ingroup     sys
+ * @brief       Delivers events published on hashed topics into queues of
+ *              their subscribers
+ *
+ * The `msg_bus` of @ref core_msg supports 32 event types per bus and tests
+ * every subscriber on every post. This module identifies topics by a 32 bit
+ * hash of their name (see pubsub_topic()), so their number is not limited.
+ * The subscriptions of a bus are kept in @ref CONFIG_PUBSUB_BUCKETS lists
+ * selected by the topic, so publishing only walks the subscriptions of
+ * topics in the same bucket.
+ *
+ * Every subscriber (@ref pubsub_sub_t) has its own queue of events. When it
+ * is full, a new event either is dropped or replaces the oldest one,
+ * depending on the @ref pubsub_drop_t policy of the subscriber, so that a
+ * slow subscriber never blocks the publisher nor the other subscribers. A
+ * subscription may have a filter that is called on publishing, e.g. to only
+ * receive events of a specific network interface.
+ *
+ * Subscribers are notified with a thread flag and may wait for it along
+ * with other flags. Every subscriber counts the events received and dropped
+ * and the latency between publishing and receiving.
+ *
+ * Publishing is allowed in interrupt context.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static pubsub_event_t queue[8];
+ * pubsub_sub_t sub;
+ * pubsub_subscription_t subscription;
+ * pubsub_event_t event;
+ *
+ * pubsub_sub_init(&sub, queue, ARRAY_SIZE(queue), PUBSUB_DROP_OLDEST,
+ *                 THREAD_FLAG_PUBSUB);
+ * pubsub_subscribe(&bus, &subscription, &sub, pubsub_topic("sensor/temp"),
+ *                  NULL, NULL);
+ * while (1) {
+ *     pubsub_receive(&sub, &event);
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Topic based publish/subscribe interface definition
+ */
+
+#ifndef PUBSUB_H
+#define PUBSUB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cib.h"
+#include "list.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_pubsub_config Publish/subscribe compile time configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of subscription lists per bus, must be a power of two
+ */
+#ifndef CONFIG_PUBSUB_BUCKETS
+#define CONFIG_PUBSUB_BUCKETS       (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Thread flag suggested for notifying subscribers
+ */
+#define THREAD_FLAG_PUBSUB          (1u << 13)
+
+/**
+ * @brief   Topic ID
+ */
+typedef uint32_t pubsub_topic_t;
+
+/**
+ * @brief   Drop policies of a subscriber with a full queue
+ */
+typedef enum {
+    PUBSUB_DROP_NEWEST,         /**< drop the event being published */
+    PUBSUB_DROP_OLDEST,         /**< drop the oldest event in the queue */
+} pubsub_drop_t;
+
+/**
+ * @brief   Published event
+ */
+typedef struct {
+    pubsub_topic_t topic;       /**< topic the event was published on */
+    const void *arg;            /**< argument given to pubsub_publish() */
+    uint32_t time;              /**< time of publishing in microseconds */
+} pubsub_event_t;
+
+/**
+ * @brief   Statistics of a subscriber
+ */
+typedef struct {
+    uint32_t received;          /**< events received */
+    uint32_t dropped;           /**< events dropped due to a full queue */
+    uint32_t latency_max;       /**< maximum time from publishing to
+                                     receiving in microseconds */
+    uint64_t latency_sum;       /**< sum of those times, divide by
+                                     pubsub_sub_stats_t::received for the
+                                     average */
+} pubsub_sub_stats_t;
+
+/**
+ * @brief   Subscriber, owned by one thread
+ */
+typedef struct {
+    thread_t *thread;           /**< thread to notify */
+    pubsub_event_t *queue;      /**< queued events */
+    cib_t cib;                  /**< index of the queue */
+    thread_flags_t flag;        /**< flag set on new events */
+    pubsub_drop_t drop;         /**< drop policy */
+    pubsub_sub_stats_t stats;   /**< statistics */
+} pubsub_sub_t;
+
+/**
+ * @brief   Filter of a subscription
+ *
+ * Called while publishing, with interrupts disabled and possibly in
+ * interrupt context, so it must be short.
+ *
+ * @param[in]   event   event being published
+ * @param[in]   arg     argument given to pubsub_subscribe()
+ *
+ * @return  true to queue the event for the subscriber
+ */
+typedef bool (*pubsub_filter_t)(const pubsub_event_t *event, void *arg);
+
+/**
+ * @brief   Subscription of a subscriber to a topic
+ */
+typedef struct {
+    list_node_t next;           /**< next subscription in the bucket */
+    pubsub_topic_t topic;       /**< topic subscribed to */
+    pubsub_sub_t *sub;          /**< subscriber */
+    pubsub_filter_t filter;     /**< filter, may be NULL */
+    void *filter_arg;           /**< argument of the filter */
+} pubsub_subscription_t;
+
+/**
+ * @brief   Bus, i.e. a namespace of topics
+ */
+typedef struct {
+    list_node_t buckets[CONFIG_PUBSUB_BUCKETS];     /**< subscriptions */
+} pubsub_bus_t;
+
+/**
+ * @brief   Get the ID of a topic name
+ *
+ * The ID is the 32 bit FNV-1a hash of @p name. Different names with the
+ * same hash are the same topic, subscribers can tell them apart with a
+ * field of the published argument if that is a concern.
+ *
+ * @param[in]   name    topic name
+ *
+ * @return  topic ID
+ */
+static inline pubsub_topic_t pubsub_topic(const char *name)
+{
+    uint32_t hash = 0x811c9dc5;
+
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief   Initialize a bus
+ *
+ * @param[out]  bus     bus to initialize
+ */
+void pubsub_bus_init(pubsub_bus_t *bus);
+
+/**
+ * @brief   Initialize a subscriber owned by the calling thread
+ *
+ * @note    The queue size must be a power of two!
+ *
+ * @param[out]  sub         subscriber to initialize
+ * @param[in]   queue       memory of the event queue
+ * @param[in]   queue_size  number of events in @p queue
+ * @param[in]   drop        what to drop if the queue is full
+ * @param[in]   flag        thread flag to set when an event is queued
+ */
+void pubsub_sub_init(pubsub_sub_t *sub, pubsub_event_t *queue,
+                     unsigned queue_size, pubsub_drop_t drop,
+                     thread_flags_t flag);
+
+/**
+ * @brief   Subscribe to a topic
+ *
+ * A subscriber may have any number of subscriptions, on one or more buses.
+ *
+ * @param[in]   bus             bus to subscribe on
+ * @param[out]  subscription    subscription to add
+ * @param[in]   sub             subscriber to queue the events for
+ * @param[in]   topic           topic to subscribe to
+ * @param[in]   filter          filter of the events, NULL for all events
+ * @param[in]   filter_arg      argument of @p filter
+ */
+void pubsub_subscribe(pubsub_bus_t *bus, pubsub_subscription_t *subscription,
+                      pubsub_sub_t *sub, pubsub_topic_t topic,
+                      pubsub_filter_t filter, void *filter_arg);
+
+/**
+ * @brief   Remove a subscription
+ *
+ * @param[in]   bus             bus subscribed on
+ * @param[in]   subscription    subscription to remove
+ */
+void pubsub_unsubscribe(pubsub_bus_t *bus,
+                        pubsub_subscription_t *subscription);
+
+/**
+ * @brief   Publish an event
+ *
+ * @param[in]   bus     bus to publish on
+ * @param[in]   topic   topic to publish on
+ * @param[in]   arg     argument passed to the subscribers, must stay valid
+ *                      until they handled it
+ *
+ * @return  number of subscribers that queued the event, including those
+ *          that dropped an older event for it
+ */
+unsigned pubsub_publish(pubsub_bus_t *bus, pubsub_topic_t topic,
+                        const void *arg);
+
+/**
+ * @brief   Take the next event from the queue of a subscriber
+ *
+ * @param[in]   sub     subscriber of the calling thread
+ * @param[out]  event   received event
+ *
+ * @return  true if an event was received
+ * @return  false if the queue is empty
+ */
+bool pubsub_try_receive(pubsub_sub_t *sub, pubsub_event_t *event);
+
+/**
+ * @brief   Wait for the next event of a subscriber
+ *
+ * @param[in]   sub     subscriber of the calling thread
+ * @param[out]  event   received event
+ */
+void pubsub_receive(pubsub_sub_t *sub, pubsub_event_t *event);
+
+/**
+ * @brief   Get the statistics of a subscriber
+ *
+ * @param[in]   sub     subscriber
+ * @param[out]  stats   statistics
+ */
+void pubsub_sub_stats(const pubsub_sub_t *sub, pubsub_sub_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PUBSUB_H */
+/** @} */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_edf Earliest deadline first scheduling
+ * @ingroup     sys
+ * @brief       Schedules periodic threads of one priority by their deadlines
+ *
+ * With this module, the runqueue of @ref CONFIG_SCHED_EDF_PRIO is ordered by
+ * the absolute deadline of its threads instead of first in, first out.
+ * Threads of higher priorities still preempt them, threads of lower
+ * priorities only run if none of them is pending. Threads of that priority
+ * without a deadline, like system threads sharing it, run in FIFO order once
+ * no thread with a deadline is pending.
+ *
+ * A periodic thread calls sched_edf_task_init() once, which moves it to
+ * @ref CONFIG_SCHED_EDF_PRIO and releases its first job, and
+ * sched_edf_task_wait() at the end of every job:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * sched_edf_task_t task;
+ *
+ * sched_edf_task_init(&task, 10 * US_PER_MS, 8 * US_PER_MS);
+ * while (1) {
+ *     do_work();
+ *     sched_edf_task_wait(&task);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * As long as the deadlines equal the periods, all jobs meet their deadline
+ * if the threads use no more than the whole CPU time left by the higher
+ * priorities. With fixed priorities assigned rate monotonic, this is only
+ * guaranteed up to a utilization of about 69 %.
+ *
+ * @note    When combined with @ref sched_round_robin, add
+ *          @ref CONFIG_SCHED_EDF_PRIO to `SCHED_RR_MASK`, as rotating the
+ *          runqueue has no effect on it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling interface definition
+ */
+
+#ifndef SCHED_EDF_H
+#define SCHED_EDF_H
+
+#include <stdint.h>
+
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Periodic task, to be used only by the thread that initialized it
+ */
+typedef struct {
+    uint32_t period;        /**< time between two releases in microseconds */
+    uint32_t deadline;      /**< deadline relative to the release */
+    uint32_t release;       /**< release of the current job */
+    unsigned jobs;          /**< number of completed jobs */
+    unsigned misses;        /**< number of jobs that completed after their
+                                 deadline */
+} sched_edf_task_t;
+
+/**
+ * @brief   Make the calling thread a periodic task and release its first job
+ *
+ * The calling thread is moved to @ref CONFIG_SCHED_EDF_PRIO, the first job
+ * is released right away.
+ *
+ * @pre     0 < @p deadline <= @p period
+ *
+ * @param[out]  task        task to initialize
+ * @param[in]   period      time between two releases in microseconds
+ * @param[in]   deadline    deadline relative to the release in microseconds
+ */
+void sched_edf_task_init(sched_edf_task_t *task, uint32_t period,
+                         uint32_t deadline);
+
+/**
+ * @brief   Complete the current job and wait for the release of the next one
+ *
+ * If the job completed after its deadline, sched_edf_task_t::misses is
+ * incremented. If the next job was already released, it is scheduled
+ * according to its deadline without waiting.
+ *
+ * @param[in,out]   task    task of the calling thread
+ */
+void sched_edf_task_wait(sched_edf_task_t *task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_EDF_H */
+/** @} */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_trace Scheduler trace recorder
+ * @ingroup     sys
+ * @brief       Records context switches, messages, mutex waits, ISRs and
+ *              timer callbacks with timestamps
+ *
+ * Unlike @ref sys_schedstatistics, which only sums up the runtime of every
+ * thread, this module records what happened when, so that e.g. a latency
+ * spike can be tracked down to the ISR or thread that caused it.
+ *
+ * The kernel, ztimer and (on `native`) the ISR dispatcher record events in a
+ * ringbuffer of @ref CONFIG_SCHED_TRACE_NUMOF entries while recording is
+ * started with sched_trace_start(). When the buffer is full, the oldest
+ * events are overwritten, so stopping the recorder right after a spike keeps
+ * the events that led to it. A slot is claimed with a single atomic
+ * increment, so recording never disables IRQs and can be done from anywhere.
+ *
+ * sched_trace_dump() prints the recorded events hex encoded to stdio. The
+ * script in `dist/tools/sched_trace` converts such a dump to the Chrome trace
+ * event format, which is shown on a timeline by https://ui.perfetto.dev.
+ * With the `sched_trace_cmd` module, the shell command `schedtrace`
+ * starts, stops and dumps the recorder.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Scheduler trace recorder interface definition
+ */
+
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_sched_trace_config Scheduler trace recorder compile time
+ *                                  configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of events kept, must be a power of two
+ */
+#ifndef CONFIG_SCHED_TRACE_NUMOF
+#define CONFIG_SCHED_TRACE_NUMOF    (1024U)
+#endif
+/** @} */
+
+/**
+ * @brief   Flag set in sched_trace_entry_t::event if the event was recorded
+ *          in interrupt context
+ */
+#define SCHED_TRACE_IN_ISR          (0x80U)
+
+/**
+ * @brief   Recorded events
+ *
+ * The thread active when the event was recorded is stored along with each
+ * of them.
+ */
+typedef enum {
+    SCHED_TRACE_SWITCH,         /**< context switch, arg: previous thread,
+                                     data: status of the previous thread */
+    SCHED_TRACE_MSG_SEND,       /**< message sent, arg: receiver,
+                                     data: message type */
+    SCHED_TRACE_MSG_RECV,       /**< message received, arg: sender,
+                                     data: message type */
+    SCHED_TRACE_MUTEX_BLOCK,    /**< blocked on a mutex, data: mutex */
+    SCHED_TRACE_MUTEX_WAKE,     /**< woken up after blocking on a mutex,
+                                     data: mutex */
+    SCHED_TRACE_ISR_ENTER,      /**< ISR entered, data: IRQ number */
+    SCHED_TRACE_ISR_EXIT,       /**< ISR left, data: IRQ number */
+    SCHED_TRACE_TIMER_ENTER,    /**< ztimer callback called,
+                                     data: callback */
+    SCHED_TRACE_TIMER_EXIT,     /**< ztimer callback returned,
+                                     data: callback */
+    SCHED_TRACE_USER,           /**< recorded by the application */
+} sched_trace_event_t;
+
+/**
+ * @brief   Recorded entry
+ */
+typedef struct {
+    uint32_t time;              /**< timestamp in microseconds */
+    uint8_t event;              /**< @ref sched_trace_event_t, or-ed with
+                                     @ref SCHED_TRACE_IN_ISR */
+    uint8_t pid;                /**< active thread */
+    uint16_t arg;               /**< event specific */
+    uint32_t data;              /**< event specific */
+} sched_trace_entry_t;
+
+#if IS_USED(MODULE_SCHED_TRACE) || defined(DOXYGEN)
+/**
+ * @brief   Record an event if recording is started
+ *
+ * @param[in]   event   event to record
+ * @param[in]   arg     event specific argument, usually a PID
+ * @param[in]   data    event specific data
+ */
+void sched_trace_record(sched_trace_event_t event, uint16_t arg,
+                        uint32_t data);
+
+/**
+ * @brief   Start recording
+ */
+void sched_trace_start(void);
+
+/**
+ * @brief   Stop recording
+ */
+void sched_trace_stop(void);
+
+/**
+ * @brief   Drop all recorded events
+ */
+void sched_trace_reset(void);
+
+/**
+ * @brief   Stop recording and print the recorded events
+ *
+ * The dump starts with
+ * `sched_trace: begin <version> <events> <lost> <KERNEL_PID_ISR>`,
+ * followed by a `sched_trace: thread <pid> <name>` line for every thread,
+ * `sched_trace: events` lines with up to four events of 24 hex digits each
+ * and `sched_trace: end`.
+ */
+void sched_trace_dump(void);
+#else
+static inline void sched_trace_record(sched_trace_event_t event, uint16_t arg,
+                                      uint32_t data)
+{
+    (void)event;
+    (void)arg;
+    (void)data;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_TRACE_H */
+/** @} */
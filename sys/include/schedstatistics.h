@@ -50,6 +50,14 @@ typedef struct {
  */
 extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+/**
+ *  @brief  Scheduler callback updating the statistics
+ *
+ *  Registered by init_schedstatistics(), exposed for modules that need the
+ *  scheduler callback as well and call it in turn.
+ */
+void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread);
+
 /**
  *  @brief  Registers the sched statistics callback and sets laststart for
  *          caller thread
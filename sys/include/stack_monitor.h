@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_stack_monitor Stack usage monitor
+ * @ingroup     sys
+ * @brief       Tracks the peak stack usage of all threads without scanning
+ *              their stacks
+ *
+ * thread_measure_stack_free() scans a painted stack from its end up to the
+ * first word that was written, which takes long for large stacks and is done
+ * for every thread on every call of `ps`. This module instead keeps a
+ * watermark per thread that is updated on every context switch (using
+ * sched_register_cb()):
+ *
+ * - the stack pointer of the thread being switched out is sampled, the
+ *   watermark is moved down to it if it is lower
+ * - then the next @ref CONFIG_STACK_MONITOR_REFINE_WORDS words below the
+ *   watermark are checked, continuing where the previous switch of the
+ *   thread stopped, and the watermark is moved down to any of them that is
+ *   no longer painted, to catch deeper calls that returned before the switch
+ *
+ * So a switch costs a few memory reads. Once the checks reached the end of
+ * the stack, they start over right below the watermark. Every word below the
+ * watermark is checked within stack size / (word size *
+ * @ref CONFIG_STACK_MONITOR_REFINE_WORDS) switches of the thread, after which
+ * the watermark matches the result of thread_measure_stack_free(), also if a
+ * stack frame leaves words untouched, e.g. an unused local buffer.
+ *
+ * Only stacks painted on creation, i.e. of threads created with
+ * @ref THREAD_CREATE_STACKTEST, are checked. The peak usage of other threads
+ * is only taken from their sampled stack pointers and may be too low.
+ *
+ * When the peak usage of a thread exceeds
+ * @ref CONFIG_STACK_MONITOR_ALARM_PERCENT of its stack, the thread is
+ * flagged and the callback set by stack_monitor_set_alarm_cb() is called
+ * once for it. `ps` shows the peak usage of this module instead of scanning
+ * the stacks, and marks flagged threads with a `!`.
+ *
+ * This module needs `DEVELHELP`, as it uses the stack sizes of the threads.
+ * When used with @ref sys_schedstatistics, it takes over its scheduler
+ * callback and calls it in turn.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Stack usage monitor interface definition
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_stack_monitor_config Stack usage monitor compile time
+ *                                    configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Maximum number of words checked below the watermark per context
+ *          switch
+ */
+#ifndef CONFIG_STACK_MONITOR_REFINE_WORDS
+#define CONFIG_STACK_MONITOR_REFINE_WORDS   (8U)
+#endif
+
+/**
+ * @brief   Stack usage in percent of the stack size from which on a thread
+ *          is flagged
+ */
+#ifndef CONFIG_STACK_MONITOR_ALARM_PERCENT
+#define CONFIG_STACK_MONITOR_ALARM_PERCENT  (90U)
+#endif
+/** @} */
+
+/**
+ * @brief   Stack usage of a thread
+ */
+typedef struct {
+    uint32_t size;              /**< stack size in bytes */
+    uint32_t peak;              /**< peak usage in bytes */
+    bool alarm;                 /**< peak usage exceeded
+                                     @ref CONFIG_STACK_MONITOR_ALARM_PERCENT */
+} stack_monitor_info_t;
+
+/**
+ * @brief   Callback of near overflow alarms
+ *
+ * Called from the scheduler, i.e. in interrupt context, so it must be short,
+ * e.g. post an event or set a thread flag.
+ *
+ * @param[in]   pid     thread whose peak usage exceeded the alarm threshold
+ */
+typedef void (*stack_monitor_alarm_cb_t)(kernel_pid_t pid);
+
+/**
+ * @brief   Initialize the monitor and register its scheduler callback
+ *
+ * Called by auto_init.
+ */
+void stack_monitor_init(void);
+
+/**
+ * @brief   Set the callback of near overflow alarms
+ *
+ * @param[in]   cb      callback, NULL to disable it
+ */
+void stack_monitor_set_alarm_cb(stack_monitor_alarm_cb_t cb);
+
+/**
+ * @brief   Get the stack usage of a thread
+ *
+ * For the calling thread, its current stack pointer is taken into account.
+ *
+ * @param[in]   pid     thread to query
+ * @param[out]  info    stack usage
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no thread @p pid
+ */
+int stack_monitor_get(kernel_pid_t pid, stack_monitor_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_MONITOR_H */
+/** @} */
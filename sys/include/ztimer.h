@@ -158,6 +158,32 @@
  * performance for any reasonable amount of active timers.
  *
  *
+ * ## Timer wheel
+ *
+ * For clocks with many active timers, the `ztimer_wheel` module provides a
+ * hierarchical timer wheel that can be attached to a clock with
+ * @ref ztimer_wheel_init(). The predefined clocks get a wheel each when the
+ * module is used.
+ *
+ * The wheel has @ref CONFIG_ZTIMER_WHEEL_LEVELS levels of 32 slots. A slot of
+ * the lowest level covers 2^shift ticks, every level above covers 32 times as
+ * many ticks per slot. Only timers due within the current slot of the lowest
+ * level are kept in the sorted list described above. All other timers are put
+ * into the slot of the lowest level whose range covers their target, which is
+ * O(1). The timers of a slot are doubly linked, so removing them is O(1) as
+ * well. Timers that were never set may contain anything, so a timer is only
+ * considered to be in a slot if its tag matches its own address and the
+ * wheel's. Whenever time
+ * advances into a new slot, the timers of that slot are moved down one level
+ * or into the list. Timers due further in the future than the top level covers
+ * are parked in its last slot and placed again once that slot is reached.
+ *
+ * The clock is set to the next slot boundary or to the head of the list,
+ * whichever comes first, so a timer set far ahead causes some extra
+ * interrupts on its way down. Timers with the same target are not guaranteed
+ * to fire in the order they were set. Every timer needs one more pointer.
+ *
+ *
  * ## Clock extension
  *
  * The API always allows setting full 32bit relative offsets for every clock.
@@ -278,6 +304,29 @@ extern "C" {
  */
 #define ZTIMER_CLOCK_NO_REQUIRED_PM_MODE (UINT8_MAX)
 
+/**
+ * @defgroup sys_ztimer_conf    ztimer compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of levels of a timer wheel
+ *
+ * Each level has 32 slots of one pointer each.
+ *
+ * @note    The shift of a wheel plus 5 times the number of levels must not
+ *          exceed 32.
+ */
+#ifndef CONFIG_ZTIMER_WHEEL_LEVELS
+#define CONFIG_ZTIMER_WHEEL_LEVELS  (4U)
+#endif
+/** @} */
+
+/**
+ * @brief   Number of slots per level of a timer wheel
+ */
+#define ZTIMER_WHEEL_SLOTS          (32U)
+
 /**
  * @brief ztimer_base_t forward declaration
  */
@@ -298,9 +347,31 @@ typedef void (*ztimer_callback_t)(void *arg);
  */
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
-    uint32_t offset;            /**< offset from last timer in list */
+    uint32_t offset;            /**< offset from last timer in list, or
+                                     target time while in a wheel slot */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< link pointing to this timer, only valid
+                                     while in a wheel slot */
+    uintptr_t tag;              /**< address of the timer XOR that of the
+                                     wheel while in one of its slots, 0
+                                     otherwise */
+#endif
 };
 
+/**
+ * @brief   Timer wheel of a clock
+ *
+ * @see     @ref ztimer_wheel_init()
+ */
+typedef struct {
+    /**
+     * @brief   Heads of the slots
+     */
+    ztimer_base_t *slots[CONFIG_ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    uint32_t occupied[CONFIG_ZTIMER_WHEEL_LEVELS];  /**< non-empty slots */
+    uint8_t shift;      /**< log2 of the ticks per slot of the lowest level */
+} ztimer_wheel_t;
+
 /**
  * @defgroup   sys_ztimer_now64 ztimer_now64
  * @brief 64-bit timestamp support
@@ -379,6 +450,9 @@ struct ztimer_clock {
     uint32_t lower_last;            /**< timer value at last now() call     */
     ztimer_now_t checkpoint;        /**< cumulated time at last now() call  */
 #endif
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_wheel_t *wheel;          /**< timer wheel, NULL for list only    */
+#endif
 #if MODULE_PM_LAYERED || DOXYGEN
     uint8_t block_pm_mode;          /**< min. pm mode to block for the clock to run */
 #endif
@@ -441,6 +515,23 @@ unsigned ztimer_is_set(const ztimer_clock_t *clock, const ztimer_t *timer);
  */
 bool ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer);
 
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+/**
+ * @brief   Attach a timer wheel to a clock
+ *
+ * @pre     No timer is set on @p clock.
+ * @pre     @p shift + 5 * @ref CONFIG_ZTIMER_WHEEL_LEVELS <= 32
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[out]  wheel       wheel to use for @p clock
+ * @param[in]   shift       log2 of the ticks covered by a slot of the lowest
+ *                          level. Timers set to less than that are handled
+ *                          by the list only.
+ */
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel,
+                       uint8_t shift);
+#endif
+
 /**
  * @brief   Post a message after a delay
  *
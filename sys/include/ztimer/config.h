@@ -171,6 +171,36 @@ extern "C" {
 #define CONFIG_ZTIMER_AUTO_ADJUST_SETTLE    0
 #endif
 
+/**
+ * @brief   log2 of the ticks per slot of the lowest level of the timer wheel
+ *          of ZTIMER_USEC (1.024 ms)
+ *
+ * Only used with the `ztimer_wheel` module.
+ */
+#ifndef CONFIG_ZTIMER_USEC_WHEEL_SHIFT
+#define CONFIG_ZTIMER_USEC_WHEEL_SHIFT      10
+#endif
+
+/**
+ * @brief   log2 of the ticks per slot of the lowest level of the timer wheel
+ *          of ZTIMER_MSEC (16 ms)
+ *
+ * Only used with the `ztimer_wheel` module.
+ */
+#ifndef CONFIG_ZTIMER_MSEC_WHEEL_SHIFT
+#define CONFIG_ZTIMER_MSEC_WHEEL_SHIFT      4
+#endif
+
+/**
+ * @brief   log2 of the ticks per slot of the lowest level of the timer wheel
+ *          of ZTIMER_SEC (1 s)
+ *
+ * Only used with the `ztimer_wheel` module.
+ */
+#ifndef CONFIG_ZTIMER_SEC_WHEEL_SHIFT
+#define CONFIG_ZTIMER_SEC_WHEEL_SHIFT       0
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_lfrb
+ * @{
+ *
+ * @file
+ * @brief       Lock-free ringbuffer implementation
+ *
+ * `reads` is only written by the consumer. `writes` is written by the
+ * producer, or by the consumer if there are multiple producers. Then the
+ * consumer advances it over the elements committed in `flags`, while the
+ * producers claim space by advancing `reserved`. The flag of an element is
+ * cleared before `reads` passes it, so it is clear when the space is
+ * reserved again.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "lfrb.h"
+
+static inline unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline unsigned _idx(const lfrb_t *rb, unsigned pos)
+{
+    return pos & (rb->numof - 1);
+}
+
+static inline uint8_t *_elem(const lfrb_t *rb, unsigned pos)
+{
+    return rb->buf + _idx(rb, pos) * rb->elem_size;
+}
+
+static void _copy_in(lfrb_t *rb, unsigned pos, const uint8_t *src, unsigned n)
+{
+    unsigned first = _min(n, rb->numof - _idx(rb, pos));
+
+    memcpy(_elem(rb, pos), src, first * rb->elem_size);
+    memcpy(rb->buf, src + first * rb->elem_size, (n - first) * rb->elem_size);
+}
+
+static void _copy_out(const lfrb_t *rb, unsigned pos, uint8_t *dst, unsigned n)
+{
+    unsigned first = _min(n, rb->numof - _idx(rb, pos));
+
+    memcpy(dst, _elem(rb, pos), first * rb->elem_size);
+    memcpy(dst + first * rb->elem_size, rb->buf, (n - first) * rb->elem_size);
+}
+
+/* returns the position up to which the consumer can read */
+static unsigned _writes(lfrb_t *rb)
+{
+    if (rb->flags == NULL) {
+        return atomic_load_explicit(&rb->writes, memory_order_acquire);
+    }
+
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    while (1) {
+        unsigned idx = _idx(rb, writes);
+        atomic_uint_least32_t *word = &rb->flags[idx / 32];
+        uint32_t bit = 1UL << (idx % 32);
+
+        if (!(atomic_load_explicit(word, memory_order_acquire) & bit)) {
+            break;
+        }
+        atomic_fetch_and_explicit(word, ~bit, memory_order_relaxed);
+        writes++;
+    }
+    atomic_store_explicit(&rb->writes, writes, memory_order_relaxed);
+
+    return writes;
+}
+
+void lfrb_init(lfrb_t *rb, void *buf, unsigned elem_size, unsigned numof)
+{
+    assert((numof != 0) && ((numof & (numof - 1)) == 0));
+
+    rb->buf = buf;
+    rb->flags = NULL;
+    rb->numof = numof;
+    rb->elem_size = elem_size;
+    atomic_init(&rb->reads, 0);
+    atomic_init(&rb->writes, 0);
+    atomic_init(&rb->reserved, 0);
+}
+
+void lfrb_mp_init(lfrb_t *rb, void *buf, unsigned elem_size, unsigned numof,
+                  atomic_uint_least32_t *flags)
+{
+    lfrb_init(rb, buf, elem_size, numof);
+    for (unsigned i = 0; i < LFRB_MP_FLAGS_NUMOF(numof); i++) {
+        atomic_init(&flags[i], 0);
+    }
+    rb->flags = flags;
+}
+
+unsigned lfrb_avail(lfrb_t *rb)
+{
+    return _writes(rb) - atomic_load_explicit(&rb->reads,
+                                              memory_order_relaxed);
+}
+
+unsigned lfrb_put(lfrb_t *rb, const void *src, unsigned n)
+{
+    assert(rb->flags == NULL);
+
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    n = _min(n, lfrb_free(rb));
+    _copy_in(rb, writes, src, n);
+    atomic_store_explicit(&rb->writes, writes + n, memory_order_release);
+
+    return n;
+}
+
+void *lfrb_reserve(lfrb_t *rb, unsigned *n)
+{
+    assert(rb->flags == NULL);
+
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    *n = _min(_min(*n, lfrb_free(rb)), rb->numof - _idx(rb, writes));
+
+    return (*n) ? _elem(rb, writes) : NULL;
+}
+
+void lfrb_commit(lfrb_t *rb, unsigned n)
+{
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    atomic_store_explicit(&rb->writes, writes + n, memory_order_release);
+}
+
+void *lfrb_mp_reserve(lfrb_t *rb, unsigned *n)
+{
+    assert(rb->flags != NULL);
+
+    unsigned pos = atomic_load_explicit(&rb->reserved, memory_order_relaxed);
+    unsigned num;
+
+    /* a stale pos may yield a bogus num, but then the exchange fails */
+    do {
+        unsigned reads = atomic_load_explicit(&rb->reads,
+                                              memory_order_acquire);
+
+        num = _min(_min(*n, rb->numof - (pos - reads)),
+                   rb->numof - _idx(rb, pos));
+        if (num == 0) {
+            *n = 0;
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&rb->reserved, &pos,
+                                                    pos + num,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+
+    *n = num;
+    return _elem(rb, pos);
+}
+
+void lfrb_mp_commit(lfrb_t *rb, const void *elems, unsigned n)
+{
+    unsigned idx = ((const uint8_t *)elems - rb->buf) / rb->elem_size;
+
+    while (n) {
+        unsigned shift = idx % 32;
+        unsigned num = _min(n, 32 - shift);
+        uint32_t bits = (num == 32) ? UINT32_MAX
+                                    : (((1UL << num) - 1) << shift);
+
+        atomic_fetch_or_explicit(&rb->flags[idx / 32], bits,
+                                 memory_order_release);
+        idx += num;
+        n -= num;
+    }
+}
+
+unsigned lfrb_mp_put(lfrb_t *rb, const void *src, unsigned n)
+{
+    unsigned done = 0;
+
+    /* at most twice, when the free space wraps around */
+    while (done < n) {
+        unsigned num = n - done;
+        uint8_t *elems = lfrb_mp_reserve(rb, &num);
+
+        if (elems == NULL) {
+            break;
+        }
+        memcpy(elems, (const uint8_t *)src + done * rb->elem_size,
+               num * rb->elem_size);
+        lfrb_mp_commit(rb, elems, num);
+        done += num;
+    }
+
+    return done;
+}
+
+unsigned lfrb_get(lfrb_t *rb, void *dst, unsigned n)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+
+    n = _min(n, _writes(rb) - reads);
+    _copy_out(rb, reads, dst, n);
+    atomic_store_explicit(&rb->reads, reads + n, memory_order_release);
+
+    return n;
+}
+
+const void *lfrb_acquire(lfrb_t *rb, unsigned *n)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+
+    *n = _min(_min(*n, _writes(rb) - reads), rb->numof - _idx(rb, reads));
+
+    return (*n) ? _elem(rb, reads) : NULL;
+}
+
+void lfrb_release(lfrb_t *rb, unsigned n)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+
+    atomic_store_explicit(&rb->reads, reads + n, memory_order_release);
+}
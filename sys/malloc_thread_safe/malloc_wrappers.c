@@ -20,12 +20,174 @@
 #include "irq.h"
 #include "mutex.h"
 
+#ifdef MODULE_MALLOC_THREAD_CACHE
+#include "bitarithm.h"
+#include "malloc_thread_cache.h"
+#include "thread.h"
+#ifdef MODULE_TLSF_MALLOC
+#include "tlsf.h"
+#else
+#include <malloc.h>
+#endif
+#endif
+
 extern void *__real_malloc(size_t size);
 extern void __real_free(void *ptr);
 extern void *__real_realloc(void *ptr, size_t size);
 
 static mutex_t _lock;
 
+#ifdef MODULE_MALLOC_THREAD_CACHE
+typedef struct {
+    const thread_t *owner;
+    void *blocks[CONFIG_MALLOC_THREAD_CACHE_CLASSES];
+    uint8_t numof[CONFIG_MALLOC_THREAD_CACHE_CLASSES];
+    malloc_thread_cache_stats_t stats;
+} _cache_t;
+
+static _cache_t _caches[MAXTHREADS];
+
+/* Returns the cache of the calling thread, or NULL before the scheduler
+ * started. A new thread reusing the PID keeps the blocks, but not the
+ * statistics of the old one. */
+static _cache_t *_cache(void)
+{
+    thread_t *me = thread_get_active();
+
+    if (!me) {
+        return NULL;
+    }
+
+    _cache_t *cache = &_caches[me->pid - KERNEL_PID_FIRST];
+
+    if (cache->owner != me) {
+        cache->owner = me;
+        memset(&cache->stats, 0, sizeof(cache->stats));
+    }
+
+    return cache;
+}
+
+static size_t _usable_size(void *ptr)
+{
+#ifdef MODULE_TLSF_MALLOC
+    return tlsf_block_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+static void *_heap_malloc(size_t size)
+{
+    mutex_lock(&_lock);
+    void *ptr = __real_malloc(size);
+    mutex_unlock(&_lock);
+    return ptr;
+}
+
+void __attribute__((used)) *__wrap_malloc(size_t size)
+{
+    assert(!irq_is_in());
+
+    _cache_t *cache = _cache();
+
+    if (!cache || (size > MALLOC_THREAD_CACHE_MAX)) {
+        void *ptr = _heap_malloc(size);
+
+        if (cache && ptr) {
+            cache->stats.allocs++;
+        }
+        return ptr;
+    }
+
+    /* smallest class that fits */
+    unsigned cls = (size <= MALLOC_THREAD_CACHE_MIN)
+                 ? 0 : bitarithm_msb(size - 1) - 3;
+    void *ptr = cache->blocks[cls];
+
+    if (ptr) {
+        cache->blocks[cls] = *(void **)ptr;
+        cache->numof[cls]--;
+        cache->stats.hits++;
+    }
+    else {
+        /* allocate the whole class, so that free() sorts it back in */
+        ptr = _heap_malloc(MALLOC_THREAD_CACHE_MIN << cls);
+    }
+
+    if (ptr) {
+        cache->stats.allocs++;
+    }
+    return ptr;
+}
+
+void __attribute__((used)) __wrap_free(void *ptr)
+{
+    assert(!irq_is_in());
+
+    if (!ptr) {
+        return;
+    }
+
+    _cache_t *cache = _cache();
+
+    if (cache) {
+        size_t size = _usable_size(ptr);
+
+        cache->stats.frees++;
+        if ((size >= MALLOC_THREAD_CACHE_MIN)
+            && (size < 2 * MALLOC_THREAD_CACHE_MAX)) {
+            /* largest class that fits into the block */
+            unsigned cls = bitarithm_msb(size) - 4;
+
+            if (cache->numof[cls] < CONFIG_MALLOC_THREAD_CACHE_DEPTH) {
+                *(void **)ptr = cache->blocks[cls];
+                cache->blocks[cls] = ptr;
+                cache->numof[cls]++;
+                return;
+            }
+        }
+    }
+
+    mutex_lock(&_lock);
+    __real_free(ptr);
+    mutex_unlock(&_lock);
+}
+
+void malloc_thread_cache_stats(kernel_pid_t pid,
+                               malloc_thread_cache_stats_t *stats)
+{
+    assert(pid_is_valid(pid));
+
+    const _cache_t *cache = &_caches[pid - KERNEL_PID_FIRST];
+
+    if (cache->owner == thread_get(pid)) {
+        *stats = cache->stats;
+    }
+    else {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+void malloc_thread_cache_flush(void)
+{
+    _cache_t *cache = _cache();
+
+    assert(cache);
+
+    mutex_lock(&_lock);
+    for (unsigned cls = 0; cls < CONFIG_MALLOC_THREAD_CACHE_CLASSES; cls++) {
+        while (cache->blocks[cls]) {
+            void *ptr = cache->blocks[cls];
+
+            cache->blocks[cls] = *(void **)ptr;
+            __real_free(ptr);
+        }
+        cache->numof[cls] = 0;
+    }
+    mutex_unlock(&_lock);
+}
+#else
 void __attribute__((used)) *__wrap_malloc(size_t size)
 {
     assert(!irq_is_in());
@@ -42,6 +204,7 @@ void __attribute__((used)) __wrap_free(void *ptr)
     __real_free(ptr);
     mutex_unlock(&_lock);
 }
+#endif
 
 void * __attribute__((used)) __wrap_calloc(size_t nmemb, size_t size)
 {
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   DNS cache implementation
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+
+#include "mutex.h"
+#include "net/af.h"
+#include "ztimer.h"
+
+#include "net/dns/cache.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief   Cache entry
+ */
+typedef struct {
+    uint32_t expires;       /**< ZTIMER_SEC time the entry expires at */
+    uint32_t last_used;     /**< Use count of the entry when last used */
+    uint8_t addr[16];       /**< Address, unused for negative entries */
+    uint8_t addr_len;       /**< Length of addr, 0 for negative entries */
+    uint8_t family;         /**< Family of addr, or the family queried for
+                                 negative entries */
+    char name[CONFIG_DNS_CACHE_NAME_LEN + 1];   /**< Cached name, empty if the
+                                                     entry is unused */
+} _entry_t;
+
+static _entry_t _cache[CONFIG_DNS_CACHE_SIZE];
+static dns_cache_stats_t _stats;
+static uint32_t _use_count;
+static mutex_t _lock = MUTEX_INIT;
+
+static bool _is_valid(const _entry_t *entry, uint32_t now)
+{
+    return (entry->name[0] != '\0') &&
+           ((int32_t)(entry->expires - now) > 0);
+}
+
+static _entry_t *_find(const char *domain_name, int family, bool negative,
+                       uint32_t now)
+{
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+
+        /* a name without any address has no address of a specific family */
+        bool family_match = (entry->family == family) ||
+                            (negative && (entry->family == AF_UNSPEC));
+
+        if (_is_valid(entry, now) && family_match &&
+            ((entry->addr_len == 0) == negative) &&
+            (strcasecmp(entry->name, domain_name) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* finds what is known about the name not having an address of @p family */
+static _entry_t *_find_negative(const char *domain_name, int family,
+                                uint32_t now)
+{
+    _entry_t *entry = _find(domain_name, family, true, now);
+
+    /* without an address of either family, the name has no address at all */
+    if ((entry == NULL) && (family == AF_UNSPEC) &&
+        (_find(domain_name, AF_INET, true, now) != NULL)) {
+        entry = _find(domain_name, AF_INET6, true, now);
+    }
+    return entry;
+}
+
+static _entry_t *_get_free(const char *domain_name, int family, uint32_t now)
+{
+    _entry_t *lru = NULL;
+
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+
+        /* replace what we know about the name */
+        if (!_is_valid(entry, now) ||
+            ((entry->family == family) &&
+             (strcasecmp(entry->name, domain_name) == 0))) {
+            return entry;
+        }
+        if ((lru == NULL) || ((int32_t)(entry->last_used - lru->last_used) < 0)) {
+            lru = entry;
+        }
+    }
+    _stats.evictions++;
+    DEBUG("dns_cache: evicting %s\n", lru->name);
+    return lru;
+}
+
+static void _add(const char *domain_name, const void *addr, int addr_len,
+                 int family, uint32_t ttl)
+{
+    size_t len = strlen(domain_name);
+
+    if ((ttl == 0) || (len == 0) || (len > CONFIG_DNS_CACHE_NAME_LEN)) {
+        return;
+    }
+    /* keep expiry comparable to the current time */
+    if (ttl > INT32_MAX) {
+        ttl = INT32_MAX;
+    }
+
+    mutex_lock(&_lock);
+    uint32_t now = ztimer_now(ZTIMER_SEC);
+    _entry_t *entry = _get_free(domain_name, family, now);
+
+    memcpy(entry->name, domain_name, len + 1);
+    if (addr_len > 0) {
+        memcpy(entry->addr, addr, addr_len);
+    }
+    entry->addr_len = addr_len;
+    entry->family = family;
+    entry->expires = now + ttl;
+    entry->last_used = ++_use_count;
+    mutex_unlock(&_lock);
+    DEBUG("dns_cache: added %s (%s) for %" PRIu32 " s\n", domain_name,
+          (addr_len) ? "positive" : "negative", ttl);
+}
+
+int dns_cache_query(const char *domain_name, void *addr_out, int family)
+{
+    _entry_t *entry = NULL;
+    int res = 0;
+
+    mutex_lock(&_lock);
+    uint32_t now = ztimer_now(ZTIMER_SEC);
+
+    if ((family == AF_INET6) || (family == AF_UNSPEC)) {
+        entry = _find(domain_name, AF_INET6, false, now);
+    }
+    /* an IPv4 address answers AF_UNSPEC only if the name is known to have no
+     * IPv6 address, a query would return its IPv6 address otherwise */
+    if ((entry == NULL) &&
+        ((family == AF_INET) ||
+         ((family == AF_UNSPEC) &&
+          (_find(domain_name, AF_INET6, true, now) != NULL)))) {
+        entry = _find(domain_name, AF_INET, false, now);
+    }
+    if (entry != NULL) {
+        memcpy(addr_out, entry->addr, entry->addr_len);
+        res = entry->addr_len;
+        _stats.hits++;
+    }
+    else if ((entry = _find_negative(domain_name, family, now)) != NULL) {
+        res = -ENOENT;
+        _stats.neg_hits++;
+    }
+    else {
+        _stats.misses++;
+    }
+    if (entry != NULL) {
+        entry->last_used = ++_use_count;
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void dns_cache_add(const char *domain_name, const void *addr, int addr_len,
+                   uint32_t ttl)
+{
+    int family;
+
+    switch (addr_len) {
+    case 4:
+        family = AF_INET;
+        break;
+    case 16:
+        family = AF_INET6;
+        break;
+    default:
+        return;
+    }
+    _add(domain_name, addr, addr_len, family, ttl);
+}
+
+void dns_cache_add_negative(const char *domain_name, int family, uint32_t ttl)
+{
+    if (ttl > CONFIG_DNS_CACHE_NEG_TTL_MAX) {
+        ttl = CONFIG_DNS_CACHE_NEG_TTL_MAX;
+    }
+    _add(domain_name, NULL, 0, family, ttl);
+}
+
+void dns_cache_flush(void)
+{
+    mutex_lock(&_lock);
+    memset(_cache, 0, sizeof(_cache));
+    mutex_unlock(&_lock);
+}
+
+void dns_cache_get_stats(dns_cache_stats_t *stats)
+{
+    mutex_lock(&_lock);
+    *stats = _stats;
+    mutex_unlock(&_lock);
+}
+
+/** @} */
@@ -26,6 +26,13 @@
 
 #include "net/dns/msg.h"
 
+/* mask of the response code in dns_hdr_t::flags */
+#define DNS_RCODE_MASK          (0x000f)
+/* response code of a non-existent domain name */
+#define DNS_RCODE_NXDOMAIN      (3)
+/* length of the fixed fields at the end of a SOA record */
+#define SOA_FIXED_LENGTH        (20U)
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -68,6 +75,16 @@ static unsigned _get_short(const uint8_t *buf)
     return _tmp;
 }
 
+static uint32_t _get_ttl(const uint8_t *buf)
+{
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    _tmp = ntohl(_tmp);
+    /* values with the most significant bit set are to be treated as zero,
+     * see RFC 2181, section 8 */
+    return (_tmp & 0x80000000UL) ? 0 : _tmp;
+}
+
 static ssize_t _skip_hostname(const uint8_t *buf, size_t len,
                               const uint8_t *bufpos)
 {
@@ -87,6 +104,13 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len,
     }
 
     while (bufpos[res]) {
+        /* labels may end with a pointer */
+        if (bufpos[res] >= 192) {
+            if ((&bufpos[res] + 2) >= buflim) {
+                return -EBADMSG;
+            }
+            return res + 2;
+        }
         res += bufpos[res] + 1;
         if ((&bufpos[res]) >= buflim) {
             /* out-of-bound */
@@ -130,12 +154,69 @@ size_t dns_msg_compose_query(void *dns_buf, const char *domain_name,
     return bufpos - buf;
 }
 
+/* looks for a SOA record in the authority section of a negative reply to
+ * get the time the reply may be cached, see RFC 2308, section 5 */
+static int _parse_negative(const uint8_t *buf, size_t len,
+                           const uint8_t *bufpos, uint32_t *ttl_out)
+{
+    const uint8_t *buflim = buf + len;
+    const dns_hdr_t *hdr = (dns_hdr_t *)buf;
+
+    for (unsigned n = 0; n < ntohs(hdr->nscount); n++) {
+        ssize_t tmp = _skip_hostname(buf, len, bufpos);
+        if (tmp < 0) {
+            return tmp;
+        }
+        bufpos += tmp;
+        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH +
+             RR_TTL_LENGTH + RR_RDLENGTH_LENGTH) > buflim) {
+            return -EBADMSG;
+        }
+        uint16_t _type = ntohs(_get_short(bufpos));
+        bufpos += RR_TYPE_LENGTH + RR_CLASS_LENGTH;
+        uint32_t ttl = _get_ttl(bufpos);
+        bufpos += RR_TTL_LENGTH;
+        unsigned rdlen = ntohs(_get_short(bufpos));
+        bufpos += RR_RDLENGTH_LENGTH;
+        if (rdlen > (size_t)(buflim - bufpos)) {
+            return -EBADMSG;
+        }
+        if (_type != DNS_TYPE_SOA) {
+            bufpos += rdlen;
+            continue;
+        }
+        /* skip MNAME and RNAME, MINIMUM is the last field */
+        const uint8_t *rdlim = bufpos + rdlen;
+        for (unsigned i = 0; i < 2; i++) {
+            tmp = _skip_hostname(buf, rdlim - buf, bufpos);
+            if (tmp < 0) {
+                return tmp;
+            }
+            bufpos += tmp;
+        }
+        if ((bufpos + SOA_FIXED_LENGTH) > rdlim) {
+            return -EBADMSG;
+        }
+        uint32_t minimum = _get_ttl(rdlim - RR_TTL_LENGTH);
+        *ttl_out = (minimum < ttl) ? minimum : ttl;
+        return 0;
+    }
+    return 0;
+}
+
 int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
-                        void *addr_out)
+                        void *addr_out, uint32_t *ttl_out)
 {
     const uint8_t *buflim = buf + len;
     const dns_hdr_t *hdr = (dns_hdr_t *)buf;
     const uint8_t *bufpos = buf + sizeof(*hdr);
+    uint32_t ttl = UINT32_MAX;
+    uint32_t _ttl_out;
+
+    if (ttl_out == NULL) {
+        ttl_out = &_ttl_out;
+    }
+    *ttl_out = 0;
 
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
@@ -162,7 +243,13 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
         bufpos += RR_TYPE_LENGTH;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += RR_CLASS_LENGTH;
-        bufpos += RR_TTL_LENGTH; /* skip ttl */
+        /* the address is valid as long as all records leading to it, e.g.
+         * CNAME records */
+        uint32_t rr_ttl = _get_ttl(bufpos);
+        if (rr_ttl < ttl) {
+            ttl = rr_ttl;
+        }
+        bufpos += RR_TTL_LENGTH;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         /* skip unwanted answers */
@@ -175,7 +262,7 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
                 /* buffer wraps around memory space */
                 return -EBADMSG;
             }
-            bufpos += addrlen;
+            bufpos += RR_RDLENGTH_LENGTH + addrlen;
             /* other out-of-bound is checked in `_skip_hostname()` at start of
              * loop */
             continue;
@@ -192,10 +279,20 @@ int dns_msg_parse_reply(const uint8_t *buf, size_t len, int family,
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        *ttl_out = ttl;
         return addrlen;
     }
 
-    return -EBADMSG;
+    /* name does not exist or has no address of the requested family */
+    switch (ntohs(hdr->flags) & DNS_RCODE_MASK) {
+    case 0:
+    case DNS_RCODE_NXDOMAIN: {
+        int res = _parse_negative(buf, len, bufpos, ttl_out);
+        return (res < 0) ? res : -ENOENT;
+    }
+    default:
+        return -EBADMSG;
+    }
 }
 
 /** @} */
@@ -43,6 +43,7 @@
 #endif
 
 #include "net/gcoap/forward_proxy.h"
+#include "net/gcoap/path_index.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -767,6 +768,22 @@ static int _find_resource(gcoap_socket_type_t tl_type,
                           gcoap_listener_t **listener_ptr)
 {
     int ret = GCOAP_RESOURCE_NO_PATH;
+    int idx_res = GCOAP_RESOURCE_NO_PATH;
+    const coap_resource_t *idx_resource = NULL;
+    gcoap_listener_t *idx_listener = NULL;
+
+    /* Look up the resources of all indexed listeners at once. The result is
+     * only used when their turn comes while walking the list, so listeners
+     * with their own matcher keep their precedence. */
+    if (IS_USED(MODULE_GCOAP_PATH_INDEX)) {
+        uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+
+        if (coap_get_uri_path(pdu, uri) > 0) {
+            idx_res = gcoap_path_index_find((char *)uri,
+                        coap_method2flag(coap_get_code_detail(pdu)),
+                        tl_type, &idx_resource, &idx_listener);
+        }
+    }
 
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
@@ -775,6 +792,18 @@ static int _find_resource(gcoap_socket_type_t tl_type,
         const coap_resource_t *resource;
         int res;
 
+        if (IS_USED(MODULE_GCOAP_PATH_INDEX) &&
+            gcoap_path_index_contains(listener)) {
+            if ((idx_res == GCOAP_RESOURCE_FOUND) &&
+                (listener == idx_listener)) {
+                *resource_ptr = idx_resource;
+                *listener_ptr = listener;
+                return GCOAP_RESOURCE_FOUND;
+            }
+            listener = listener->next;
+            continue;
+        }
+
         /* only makes sense to check if non-UDP transports are supported,
          * so check if module is used first. */
         if (IS_USED(MODULE_GCOAP_DTLS) &&
@@ -808,6 +837,10 @@ static int _find_resource(gcoap_socket_type_t tl_type,
         }
     }
 
+    if (idx_res == GCOAP_RESOURCE_WRONG_METHOD) {
+        ret = GCOAP_RESOURCE_WRONG_METHOD;
+    }
+
     return ret;
 }
 
@@ -1366,7 +1399,11 @@ void gcoap_register_listener(gcoap_listener_t *listener)
     }
 
     if (!listener->request_matcher) {
-        listener->request_matcher = _request_matcher_default;
+        /* fall back to the default matcher if the index is full */
+        if (!IS_USED(MODULE_GCOAP_PATH_INDEX) ||
+            (gcoap_path_index_add(listener) != 0)) {
+            listener->request_matcher = _request_matcher_default;
+        }
     }
 }
 
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Radix tree of the resource paths of gcoap listeners
+ *
+ * Every node stores the part of the path that leads to it from its parent as
+ * a pointer into the path of a resource, so no path is copied. The resources
+ * with a path ending at a node are kept in a list at the node.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/gcoap/path_index.h"
+
+#define ENABLE_DEBUG    0
+#include "debug.h"
+
+/* every resource adds at most one node and splits at most one other */
+#define NODES_NUMOF     (2 * CONFIG_GCOAP_PATH_INDEX_SIZE + 1)
+#define NONE            UINT16_MAX
+
+typedef struct {
+    const char *label;          /* path from the parent, not terminated */
+    uint16_t label_len;
+    uint16_t child;             /* first child */
+    uint16_t sibling;           /* next child of the parent */
+    uint16_t entries;           /* resources with a path ending here */
+} _node_t;
+
+typedef struct {
+    const coap_resource_t *resource;
+    gcoap_listener_t *listener;
+    uint16_t seq;               /* order the listener was added in */
+    uint16_t next;              /* next entry of the same node */
+} _entry_t;
+
+typedef struct {
+    const _entry_t *entry;
+    int res;
+} _match_t;
+
+static mutex_t _lock = MUTEX_INIT;
+/* node 0 is the root with an empty label */
+static _node_t _nodes[NODES_NUMOF] = {
+    { .label = "", .child = NONE, .sibling = NONE, .entries = NONE },
+};
+static _entry_t _entries[CONFIG_GCOAP_PATH_INDEX_SIZE];
+static uint16_t _nodes_numof = 1;
+static uint16_t _entries_numof;
+static uint16_t _seq;
+
+static int _request_matcher_index(gcoap_listener_t *listener,
+                                  const coap_resource_t **resource,
+                                  coap_pkt_t *pdu);
+
+static uint16_t _node_new(const char *label, size_t label_len)
+{
+    _node_t *node = &_nodes[_nodes_numof];
+
+    node->label = label;
+    node->label_len = label_len;
+    node->child = NONE;
+    node->sibling = NONE;
+    node->entries = NONE;
+    return _nodes_numof++;
+}
+
+static uint16_t _find_child(const _node_t *node, char c)
+{
+    uint16_t i = node->child;
+
+    while ((i != NONE) && (_nodes[i].label[0] != c)) {
+        i = _nodes[i].sibling;
+    }
+    return i;
+}
+
+/* returns the node for the path, creating it if needed */
+static uint16_t _insert(const char *path)
+{
+    uint16_t cur = 0;
+
+    while (*path) {
+        uint16_t child = _find_child(&_nodes[cur], *path);
+        size_t len = strlen(path);
+
+        if (child == NONE) {
+            child = _node_new(path, len);
+            _nodes[child].sibling = _nodes[cur].child;
+            _nodes[cur].child = child;
+            return child;
+        }
+
+        _node_t *node = &_nodes[child];
+        size_t common = 1;
+
+        while ((common < node->label_len) && (common < len) &&
+               (node->label[common] == path[common])) {
+            common++;
+        }
+        if (common < node->label_len) {
+            /* split the node, the new one takes over its children and
+             * resources */
+            uint16_t rest = _node_new(node->label + common,
+                                      node->label_len - common);
+
+            _nodes[rest].child = node->child;
+            _nodes[rest].entries = node->entries;
+            node->label_len = common;
+            node->child = rest;
+            node->entries = NONE;
+        }
+        path += common;
+        cur = child;
+    }
+    return cur;
+}
+
+/* true if a has priority over b, as in the list of listeners */
+static bool _before(const _entry_t *a, const _entry_t *b)
+{
+    if (a->seq != b->seq) {
+        return a->seq > b->seq;
+    }
+    return a->resource < b->resource;
+}
+
+static void _match_node(const _node_t *node, bool exact,
+                        coap_method_flags_t method,
+                        gcoap_socket_type_t tl_type,
+                        const gcoap_listener_t *only, _match_t *match)
+{
+    for (uint16_t i = node->entries; i != NONE; i = _entries[i].next) {
+        const _entry_t *entry = &_entries[i];
+        const gcoap_listener_t *listener = entry->listener;
+
+        if (!exact && !(entry->resource->methods & COAP_MATCH_SUBTREE)) {
+            continue;
+        }
+        if (only != NULL) {
+            if (listener != only) {
+                continue;
+            }
+        }
+        else if (IS_USED(MODULE_GCOAP_DTLS) &&
+                 (listener->tl_type != GCOAP_SOCKET_TYPE_UNDEF) &&
+                 !(listener->tl_type & tl_type)) {
+            continue;
+        }
+        if (!(entry->resource->methods & method)) {
+            if (match->res == GCOAP_RESOURCE_NO_PATH) {
+                match->res = GCOAP_RESOURCE_WRONG_METHOD;
+            }
+            continue;
+        }
+        if ((match->res != GCOAP_RESOURCE_FOUND) ||
+            _before(entry, match->entry)) {
+            match->entry = entry;
+            match->res = GCOAP_RESOURCE_FOUND;
+        }
+    }
+}
+
+static void _find(const char *uri, coap_method_flags_t method,
+                  gcoap_socket_type_t tl_type,
+                  const gcoap_listener_t *only, _match_t *match)
+{
+    const _node_t *node = &_nodes[0];
+
+    match->entry = NULL;
+    match->res = GCOAP_RESOURCE_NO_PATH;
+
+    while (1) {
+        /* resources matching the subtree match every node on the way, the
+         * others only the node the path ends at */
+        _match_node(node, *uri == '\0', method, tl_type, only, match);
+        if (*uri == '\0') {
+            return;
+        }
+
+        uint16_t child = _find_child(node, *uri);
+
+        if (child == NONE) {
+            return;
+        }
+        node = &_nodes[child];
+        if (strncmp(uri, node->label, node->label_len) != 0) {
+            return;
+        }
+        uri += node->label_len;
+    }
+}
+
+int gcoap_path_index_add(gcoap_listener_t *listener)
+{
+    mutex_lock(&_lock);
+
+    if ((_entries_numof + listener->resources_len >
+         CONFIG_GCOAP_PATH_INDEX_SIZE) ||
+        (_nodes_numof + 2 * listener->resources_len > NODES_NUMOF)) {
+        mutex_unlock(&_lock);
+        DEBUG("gcoap_path_index: no space for %u resources\n",
+              (unsigned)listener->resources_len);
+        return -ENOMEM;
+    }
+
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        _node_t *node = &_nodes[_insert(listener->resources[i].path)];
+        _entry_t *entry = &_entries[_entries_numof];
+
+        entry->resource = &listener->resources[i];
+        entry->listener = listener;
+        entry->seq = _seq;
+        entry->next = node->entries;
+        node->entries = _entries_numof++;
+    }
+    _seq++;
+    listener->request_matcher = _request_matcher_index;
+
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+bool gcoap_path_index_contains(const gcoap_listener_t *listener)
+{
+    return listener->request_matcher == _request_matcher_index;
+}
+
+int gcoap_path_index_find(const char *uri, coap_method_flags_t method,
+                          gcoap_socket_type_t tl_type,
+                          const coap_resource_t **resource,
+                          gcoap_listener_t **listener)
+{
+    _match_t match;
+
+    mutex_lock(&_lock);
+    _find(uri, method, tl_type, NULL, &match);
+    mutex_unlock(&_lock);
+
+    if (match.res == GCOAP_RESOURCE_FOUND) {
+        *resource = match.entry->resource;
+        *listener = match.entry->listener;
+    }
+    return match.res;
+}
+
+/* used if the matcher of a single listener is called directly */
+static int _request_matcher_index(gcoap_listener_t *listener,
+                                  const coap_resource_t **resource,
+                                  coap_pkt_t *pdu)
+{
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+    _match_t match;
+
+    if (coap_get_uri_path(pdu, uri) <= 0) {
+        return GCOAP_RESOURCE_NO_PATH;
+    }
+
+    mutex_lock(&_lock);
+    _find((char *)uri, coap_method2flag(coap_get_code_detail(pdu)),
+          GCOAP_SOCKET_TYPE_UNDEF, listener, &match);
+    mutex_unlock(&_lock);
+
+    if (match.res == GCOAP_RESOURCE_FOUND) {
+        *resource = match.entry->resource;
+    }
+    return match.res;
+}
+
+/** @} */
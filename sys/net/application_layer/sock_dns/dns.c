@@ -17,21 +17,44 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 
 #include <arpa/inet.h>
 
+#include "mutex.h"
+#include "timex.h"
+#include "utlist.h"
 #include "net/dns.h"
+#include "net/dns/cache.h"
 #include "net/dns/msg.h"
 #include "net/sock/udp.h"
 #include "net/sock/dns.h"
 
+#if IS_USED(MODULE_SOCK_DNS_ASYNC)
+#include "net/sock/async/event.h"
+#include "ztimer.h"
+#endif
+
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(dns_hdr_t) + 7)
 
+/* time to wait for a reply in ms */
+#define DNS_TIMEOUT_MS      (1000U)
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
+/* queries currently sent to the DNS server */
+static sock_dns_waiter_t *_pending;
+static mutex_t _pending_lock = MUTEX_INIT;
+
+typedef struct {
+    sock_dns_waiter_t waiter;
+    mutex_t done;
+} _sync_waiter_t;
+
 #ifdef MODULE_AUTO_INIT_SOCK_DNS
 void auto_init_sock_dns(void)
 {
@@ -65,10 +88,8 @@ void auto_init_sock_dns(void)
 }
 #endif /* MODULE_AUTO_INIT_SOCK_DNS */
 
-int sock_dns_query(const char *domain_name, void *addr_out, int family)
+static int _check_query(const char *domain_name)
 {
-    static uint8_t dns_buf[CONFIG_DNS_MSG_LEN];
-
     if (sock_dns_server.port == 0) {
         return -ECONNREFUSED;
     }
@@ -76,12 +97,83 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
     if (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN) {
         return -ENOSPC;
     }
+    return 0;
+}
+
+/* a reply that makes asking again pointless */
+static bool _is_final(int res)
+{
+    return (res > 0) || (res == -ENOENT);
+}
+
+/* shares the query of another caller for the same name, if there is one,
+ * otherwise @p waiter has to send the query */
+static bool _join(sock_dns_waiter_t *waiter)
+{
+    sock_dns_waiter_t *pending;
+
+    mutex_lock(&_pending_lock);
+    LL_FOREACH(_pending, pending) {
+        if ((pending->family == waiter->family) &&
+            (strcasecmp(pending->domain_name, waiter->domain_name) == 0)) {
+            break;
+        }
+    }
+    if (pending != NULL) {
+        LL_PREPEND(pending->waiters, waiter);
+    }
+    else {
+        waiter->waiters = NULL;
+        LL_PREPEND(_pending, waiter);
+    }
+    mutex_unlock(&_pending_lock);
+    return (pending != NULL);
+}
+
+/* ends the query sent for @p waiter and passes its result on */
+static void _finish(sock_dns_waiter_t *waiter, uint32_t ttl)
+{
+    sock_dns_waiter_t *waiters;
+
+    if (waiter->res > 0) {
+        dns_cache_add(waiter->domain_name, waiter->addr_out, waiter->res, ttl);
+    }
+    else if (waiter->res == -ENOENT) {
+        dns_cache_add_negative(waiter->domain_name, waiter->family, ttl);
+    }
 
+    mutex_lock(&_pending_lock);
+    LL_DELETE(_pending, waiter);
+    waiters = waiter->waiters;
+    mutex_unlock(&_pending_lock);
+
+    while (waiters != NULL) {
+        /* waiters may be gone once notified */
+        sock_dns_waiter_t *next = waiters->next;
+
+        waiters->res = waiter->res;
+        if (waiter->res > 0) {
+            memcpy(waiters->addr_out, waiter->addr_out, waiter->res);
+        }
+        waiters->done(waiters);
+        waiters = next;
+    }
+}
+
+static void _sync_done(sock_dns_waiter_t *waiter)
+{
+    mutex_unlock(&container_of(waiter, _sync_waiter_t, waiter)->done);
+}
+
+static int _sync_query(const char *domain_name, void *addr_out, int family,
+                       uint32_t *ttl)
+{
+    uint8_t dns_buf[CONFIG_DNS_MSG_LEN];
     sock_udp_t sock_dns;
 
     ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
     if (res) {
-        goto out;
+        return res;
     }
 
     uint16_t id = 0;
@@ -92,12 +184,13 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         if (res <= 0) {
             continue;
         }
-        res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf), 1000000LU, NULL);
+        res = sock_udp_recv(&sock_dns, dns_buf, sizeof(dns_buf),
+                            DNS_TIMEOUT_MS * US_PER_MS, NULL);
         if (res > 0) {
             if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = dns_msg_parse_reply(dns_buf, res, family,
-                                               addr_out)) > 0) {
-                    goto out;
+                res = dns_msg_parse_reply(dns_buf, res, family, addr_out, ttl);
+                if (_is_final(res)) {
+                    break;
                 }
             }
             else {
@@ -106,7 +199,169 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         }
     }
 
-out:
     sock_udp_close(&sock_dns);
     return res;
 }
+
+int sock_dns_query(const char *domain_name, void *addr_out, int family)
+{
+    _sync_waiter_t sync = {
+        .waiter = {
+            .domain_name = domain_name,
+            .addr_out = addr_out,
+            .family = family,
+            .done = _sync_done,
+        },
+        .done = MUTEX_INIT_LOCKED,
+    };
+    uint32_t ttl = 0;
+    int res = _check_query(domain_name);
+
+    if (res < 0) {
+        return res;
+    }
+
+    res = dns_cache_query(domain_name, addr_out, family);
+    if (res != 0) {
+        return res;
+    }
+
+    if (_join(&sync.waiter)) {
+        mutex_lock(&sync.done);
+        return sync.waiter.res;
+    }
+
+    sync.waiter.res = _sync_query(domain_name, addr_out, family, &ttl);
+    _finish(&sync.waiter, ttl);
+    return sync.waiter.res;
+}
+
+#if IS_USED(MODULE_SOCK_DNS_ASYNC)
+static void _async_done(event_t *event)
+{
+    sock_dns_req_t *req = container_of(event, sock_dns_req_t, done_event);
+    int res = req->waiter.res;
+
+    req->cb(req, res, (res > 0) ? req->addr : NULL, req->arg);
+}
+
+static void _async_waiter_done(sock_dns_waiter_t *waiter)
+{
+    sock_dns_req_t *req = container_of(waiter, sock_dns_req_t, waiter);
+
+    event_post(req->queue, &req->done_event);
+}
+
+static void _async_send(sock_dns_req_t *req)
+{
+    size_t buflen = dns_msg_compose_query(req->buf, req->waiter.domain_name, 0,
+                                          req->waiter.family);
+
+    req->tries++;
+    event_timeout_set(&req->timeout, DNS_TIMEOUT_MS);
+    /* a failed send is repeated on timeout */
+    sock_udp_send(&req->sock, req->buf, buflen, NULL);
+}
+
+static void _async_finish(sock_dns_req_t *req, uint32_t ttl)
+{
+    event_timeout_clear(&req->timeout);
+    event_cancel(req->queue, &req->retry_event);
+    sock_udp_close(&req->sock);
+    event_cancel(req->queue, &sock_udp_get_async_ctx(&req->sock)->event.super);
+
+    _finish(&req->waiter, ttl);
+    _async_done(&req->done_event);
+}
+
+static void _async_retry(event_t *event)
+{
+    sock_dns_req_t *req = container_of(event, sock_dns_req_t, retry_event);
+
+    if (req->tries < SOCK_DNS_RETRIES) {
+        _async_send(req);
+    }
+    else {
+        _async_finish(req, 0);
+    }
+}
+
+static void _async_recv(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    sock_dns_req_t *req = arg;
+    uint32_t ttl = 0;
+
+    if (!(flags & SOCK_ASYNC_MSG_RECV)) {
+        return;
+    }
+
+    ssize_t res = sock_udp_recv(sock, req->buf, sizeof(req->buf), 0, NULL);
+    if (res <= 0) {
+        return;
+    }
+    if (res > (int)DNS_MIN_REPLY_LEN) {
+        res = dns_msg_parse_reply(req->buf, res, req->waiter.family, req->addr,
+                                  &ttl);
+    }
+    else {
+        res = -EBADMSG;
+    }
+    req->waiter.res = res;
+
+    /* like sock_dns_query(), ask again right away on a bad reply */
+    if (_is_final(res) || (req->tries >= SOCK_DNS_RETRIES)) {
+        _async_finish(req, ttl);
+    }
+    else {
+        _async_send(req);
+    }
+}
+
+int sock_dns_query_async(sock_dns_req_t *req, const char *domain_name,
+                         int family, event_queue_t *queue, sock_dns_cb_t cb,
+                         void *arg)
+{
+    int res = _check_query(domain_name);
+
+    if (res < 0) {
+        return res;
+    }
+
+    req->waiter = (sock_dns_waiter_t){
+        .domain_name = domain_name,
+        .addr_out = req->addr,
+        .family = family,
+        .res = -ETIMEDOUT,
+        .done = _async_waiter_done,
+    };
+    req->queue = queue;
+    req->done_event = (event_t){ .handler = _async_done };
+    req->retry_event = (event_t){ .handler = _async_retry };
+    req->cb = cb;
+    req->arg = arg;
+    req->tries = 0;
+
+    res = dns_cache_query(domain_name, req->addr, family);
+    if (res != 0) {
+        req->waiter.res = res;
+        event_post(queue, &req->done_event);
+        return 0;
+    }
+
+    if (_join(&req->waiter)) {
+        return 0;
+    }
+
+    res = sock_udp_create(&req->sock, NULL, &sock_dns_server, 0);
+    if (res < 0) {
+        req->waiter.res = res;
+        _finish(&req->waiter, 0);
+        return res;
+    }
+    sock_udp_event_init(&req->sock, queue, _async_recv, req);
+    event_timeout_ztimer_init(&req->timeout, ZTIMER_MSEC, queue,
+                              &req->retry_event);
+    _async_send(req);
+    return 0;
+}
+#endif /* MODULE_SOCK_DNS_ASYNC */
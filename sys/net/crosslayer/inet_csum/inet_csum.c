@@ -10,16 +10,137 @@
  * @{
  *
  * @file
+ *
+ * The one's complement sum is independent of the byte order (RFC 1071,
+ * section 2). So the buffer is summed up as words in host byte order into a
+ * wide accumulator, the carries are folded back in only once at the end, and
+ * the result is swapped to network byte order if needed.
  */
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+/* SSE2 and AVX2 are selected at run time on native, as the host CPU is
+ * unknown at compile time */
+#if defined(CPU_NATIVE) && defined(__GNUC__) && \
+    (defined(__i386__) || defined(__x86_64__))
+#define INET_CSUM_X86       1
+#include <immintrin.h>
+#else
+#define INET_CSUM_X86       0
+#endif
+
+/* below this, setting up the vector unit does not pay off */
+#define INET_CSUM_SIMD_MIN  (64U)
+
+static inline uint16_t _fold(uint64_t acc)
+{
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    return acc;
+}
+
+#if INET_CSUM_X86
+/* Every 32 bit lane gains less than 2^17 per iteration, so a lane can't
+ * overflow for the less than 2^16 bytes of a slice. */
+__attribute__((target("sse2")))
+static uint64_t _sum_sse2(const uint8_t **buf, size_t *len)
+{
+    const __m128i mask = _mm_set1_epi32(0xffff);
+    __m128i acc = _mm_setzero_si128();
+    uint32_t lanes[4];
+
+    while (*len >= sizeof(__m128i)) {
+        __m128i v = _mm_loadu_si128((const __m128i *)*buf);
+
+        acc = _mm_add_epi32(acc, _mm_and_si128(v, mask));
+        acc = _mm_add_epi32(acc, _mm_srli_epi32(v, 16));
+        *buf += sizeof(__m128i);
+        *len -= sizeof(__m128i);
+    }
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    return (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2")))
+static uint64_t _sum_avx2(const uint8_t **buf, size_t *len)
+{
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    __m256i acc = _mm256_setzero_si256();
+    uint32_t lanes[8];
+    uint64_t sum = 0;
+
+    while (*len >= sizeof(__m256i)) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)*buf);
+
+        acc = _mm256_add_epi32(acc, _mm256_and_si256(v, mask));
+        acc = _mm256_add_epi32(acc, _mm256_srli_epi32(v, 16));
+        *buf += sizeof(__m256i);
+        *len -= sizeof(__m256i);
+    }
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    for (unsigned i = 0; i < 8; i++) {
+        sum += lanes[i];
+    }
+    return sum;
+}
+#endif
+
+/* one's complement sum of the 16 bit words in buf in host byte order,
+ * len must be even and less than 2^16 */
+static uint16_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t acc = 0;
+
+#if INET_CSUM_X86
+    if (len >= INET_CSUM_SIMD_MIN) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            acc = _sum_avx2(&buf, &len);
+        }
+        else if (__builtin_cpu_supports("sse2")) {
+            acc = _sum_sse2(&buf, &len);
+        }
+    }
+#endif
+
+    /* memcpy() compiles to plain loads where unaligned access is allowed */
+    while (len >= 4 * sizeof(uint32_t)) {
+        uint32_t w[4];
+
+        memcpy(w, buf, sizeof(w));
+        acc += (uint64_t)w[0] + w[1] + w[2] + w[3];
+        buf += sizeof(w);
+        len -= sizeof(w);
+    }
+    while (len >= sizeof(uint32_t)) {
+        uint32_t w;
+
+        memcpy(&w, buf, sizeof(w));
+        acc += w;
+        buf += sizeof(w);
+        len -= sizeof(w);
+    }
+    if (len) {
+        uint16_t w;
+
+        memcpy(&w, buf, sizeof(w));
+        acc += w;
+    }
+
+    return _fold(acc);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -45,9 +166,10 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len > 1) {
+        /* the sum of the swapped words is the swapped sum of the words */
+        csum += ntohs(_sum_words(buf, len & ~1U));
+        buf += len & ~1U;
     }
 
     if ((accum_len + len) & 1)          /* if accumulated length is odd */
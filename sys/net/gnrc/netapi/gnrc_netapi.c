@@ -20,6 +20,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <string.h>
 
 #include "mbox.h"
 #include "msg.h"
@@ -136,3 +137,54 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
 
     return numof;
 }
+
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+int gnrc_netapi_dispatch_receive_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                                       gnrc_pktsnip_t **pkts, unsigned numof)
+{
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+    gnrc_pktsnip_t *batch = NULL;
+
+    if (sendto == NULL) {
+        return 0;
+    }
+    if ((numof > 1) && sendto->rcv_batch &&
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+        (sendto->type == GNRC_NETREG_TYPE_DEFAULT) &&
+#endif
+        (gnrc_netreg_getnext(sendto) == NULL)) {
+        batch = gnrc_pktbuf_add(NULL, NULL, numof * sizeof(*pkts),
+                                GNRC_NETTYPE_UNDEF);
+    }
+    if (batch == NULL) {
+        /* no single receiver of batches or no space for one */
+        int res = 0;
+
+        for (unsigned i = 0; i < numof; i++) {
+            res = gnrc_netapi_dispatch_receive(type, demux_ctx, pkts[i]);
+        }
+        return res;
+    }
+    memcpy(batch->data, pkts, batch->size);
+    if (_gnrc_netapi_send_recv(sendto->target.pid, batch,
+                               GNRC_NETAPI_MSG_TYPE_RCV_BATCH) < 1) {
+        /* unable to dispatch packets */
+        for (unsigned i = 0; i < numof; i++) {
+            gnrc_pktbuf_release_error(pkts[i], EIO);
+        }
+        gnrc_pktbuf_release(batch);
+    }
+    return 1;
+}
+
+void gnrc_netapi_receive_batch(gnrc_pktsnip_t *batch,
+                               void (*receive)(gnrc_pktsnip_t *pkt))
+{
+    gnrc_pktsnip_t **pkts = batch->data;
+
+    for (unsigned i = 0; i < (batch->size / sizeof(*pkts)); i++) {
+        receive(pkts[i]);
+    }
+    gnrc_pktbuf_release(batch);
+}
+#endif
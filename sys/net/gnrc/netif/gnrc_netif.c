@@ -47,6 +47,7 @@
 
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pktprof.h"
 #include "net/gnrc/tx_sync.h"
 
 #define ENABLE_DEBUG 0
@@ -1603,6 +1604,36 @@ int gnrc_netif_default_init(gnrc_netif_t *netif)
 
 static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back);
 
+static void _rx_batch_flush(gnrc_netif_t *netif)
+{
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    gnrc_pktsnip_t **pkts = netif->rx_batch;
+    unsigned start = 0;
+
+    /* consecutive packets of the same type go to the same subscribers */
+    for (unsigned i = 1; i <= netif->rx_batch_numof; i++) {
+        if ((i < netif->rx_batch_numof) &&
+            (pkts[i]->type == pkts[start]->type)) {
+            continue;
+        }
+        /* throw away packets if no one is interested */
+        if (!gnrc_netapi_dispatch_receive_batch(pkts[start]->type,
+                                                GNRC_NETREG_DEMUX_CTX_ALL,
+                                                &pkts[start], i - start)) {
+            DEBUG("gnrc_netif: unable to forward packets of type %i\n",
+                  pkts[start]->type);
+            for (unsigned j = start; j < i; j++) {
+                gnrc_pktbuf_release(pkts[j]);
+            }
+        }
+        start = i;
+    }
+    netif->rx_batch_numof = 0;
+#else
+    (void)netif;
+#endif
+}
+
 /**
  * @brief   Call the ISR handler from an event
  *
@@ -1611,7 +1642,14 @@ static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back);
 static void _event_handler_isr(event_t *evp)
 {
     gnrc_netif_t *netif = container_of(evp, gnrc_netif_t, event_isr);
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    netif->rx_batch_active = true;
+#endif
     netif->dev->driver->isr(netif->dev);
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    netif->rx_batch_active = false;
+#endif
+    _rx_batch_flush(netif);
 }
 
 static void _process_receive_stats(gnrc_netif_t *netdev, gnrc_pktsnip_t *pkt)
@@ -1915,6 +1953,23 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+static void _rx_batch_add(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    /* packets reported outside of the ISR handler are passed on right away */
+    if (netif->rx_batch_active) {
+        if (netif->rx_batch_numof == CONFIG_GNRC_NETIF_RX_BATCH_SIZE) {
+            _rx_batch_flush(netif);
+        }
+        netif->rx_batch[netif->rx_batch_numof++] = pkt;
+        return;
+    }
+#else
+    (void)netif;
+#endif
+    _pass_on_packet(pkt);
+}
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1933,8 +1988,9 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
                  * Further packets will be sent on later TX_COMPLETE */
                 _send_queued_pkt(netif);
                 if (pkt) {
+                    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_NETIF);
                     _process_receive_stats(netif, pkt);
-                    _pass_on_packet(pkt);
+                    _rx_batch_add(netif, pkt);
                 }
                 break;
 #if IS_USED(MODULE_NETSTATS_L2) || IS_USED(MODULE_GNRC_NETIF_PKTQ)
@@ -13,6 +13,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "assert.h"
@@ -30,13 +31,71 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#ifdef MODULE_GNRC_NETREG_HASHED
+#define _NETREG_NUMOF       (CONFIG_GNRC_NETREG_HASHED_BUCKETS)
+#else
+#define _NETREG_NUMOF       (GNRC_NETTYPE_NUMOF)
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t (or by hash of type and
+ * demux context with gnrc_netreg_hashed) */
+static gnrc_netreg_entry_t *netreg[_NETREG_NUMOF];
+
+#ifdef MODULE_GNRC_NETREG_STATS
+static gnrc_netreg_stats_t _stats;
+#endif
+
+/**
+ * @brief   Returns the list of the registry that holds the entries for
+ *          @p type and @p demux_ctx
+ */
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type,
+                                          uint32_t demux_ctx)
+{
+#ifdef MODULE_GNRC_NETREG_HASHED
+    /* demux contexts are mostly small numbers (ports, protocol numbers), so
+     * mix their bits well before taking the modulo */
+    uint32_t hash = (demux_ctx ^ ((uint32_t)type << 24)) * 0x9e3779b1U;
+
+    return &netreg[(hash ^ (hash >> 16)) % CONFIG_GNRC_NETREG_HASHED_BUCKETS];
+#else
+    (void)demux_ctx;
+    return &netreg[type];
+#endif
+}
+
+static inline bool _match(const gnrc_netreg_entry_t *entry,
+                          gnrc_nettype_t type, uint32_t demux_ctx)
+{
+#ifdef MODULE_GNRC_NETREG_HASHED
+    /* entries of other types may share a list */
+    if (entry->nettype != type) {
+        return false;
+    }
+#else
+    (void)type;
+#endif
+    return entry->demux_ctx == demux_ctx;
+}
+
+static inline void _stats_update(unsigned depth)
+{
+#ifdef MODULE_GNRC_NETREG_STATS
+    /* not synchronized, the registry is not either */
+    _stats.lookups++;
+    _stats.visited += depth;
+    if (depth > _stats.depth_max) {
+        _stats.depth_max = depth;
+    }
+#else
+    (void)depth;
+#endif
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, _NETREG_NUMOF * sizeof(gnrc_netreg_entry_t *));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -61,7 +120,10 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+#ifdef MODULE_GNRC_NETREG_HASHED
+    entry->nettype = type;
+#endif
+    LL_PREPEND(*_list(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -72,7 +134,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_list(type, entry->demux_ctx), entry);
 
 #if defined(MODULE_GNRC_NETAPI_MBOX)
     /* drain packets still in the mbox */
@@ -104,8 +166,20 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+        unsigned depth = 0;
+
+#ifdef MODULE_GNRC_NETREG_HASHED
+        if (from) {
+            type = from->nettype;
+        }
+#endif
+        res = (from) ? from->next : *_list(type, demux_ctx);
+        while (res && !_match(res, type, demux_ctx)) {
+            res = res->next;
+            depth++;
+        }
+        /* count the matching entry as well */
+        _stats_update(res ? depth + 1 : depth);
     }
 
     return res;
@@ -132,6 +206,18 @@ gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
     return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
 }
 
+#ifdef MODULE_GNRC_NETREG_STATS
+void gnrc_netreg_stats_get(gnrc_netreg_stats_t *stats)
+{
+    *stats = _stats;
+}
+
+void gnrc_netreg_stats_reset(void)
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+#endif
+
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
     if (pseudo_hdr == NULL) {
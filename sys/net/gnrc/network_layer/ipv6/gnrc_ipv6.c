@@ -30,6 +30,7 @@
 
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pktprof.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
 
@@ -57,6 +58,19 @@ static char _stack[GNRC_IPV6_STACK_SIZE + DEBUG_EXTRA_STACKSIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+#ifdef MODULE_FIB_HASHED
+/**
+ * @brief hash buckets of the index of the IPv6 forwarding table
+ */
+static uint16_t _fib_buckets[GNRC_IPV6_FIB_TABLE_SIZE];
+
+/**
+ * @brief index of the IPv6 forwarding table
+ */
+static fib_hashed_t _fib_index = { .buckets = _fib_buckets,
+                                   .buckets_numof = GNRC_IPV6_FIB_TABLE_SIZE };
+#endif
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -92,6 +106,9 @@ kernel_pid_t gnrc_ipv6_init(void)
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
+#ifdef MODULE_FIB_HASHED
+    gnrc_ipv6_fib_table.hashed = &_fib_index;
+#endif
     fib_init(&gnrc_ipv6_fib_table);
 #endif
 
@@ -170,6 +187,14 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
     }
 }
 
+/* handles a packet passed up by a GNRC_NETAPI_MSG_TYPE_RCV or
+ * GNRC_NETAPI_MSG_TYPE_RCV_BATCH command */
+static void _receive_stamped(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_IPV6);
+    _receive(pkt);
+}
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
@@ -178,6 +203,10 @@ static void *_event_loop(void *args)
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    /* take all packets a network interface received at once */
+    me_reg.rcv_batch = true;
+#endif
 
     /* initialize fragmentation data-structures */
 #ifdef MODULE_GNRC_IPV6_EXT_FRAG
@@ -197,9 +226,16 @@ static void *_event_loop(void *args)
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
+                _receive_stamped(msg.content.ptr);
                 break;
 
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_receive_batch(msg.content.ptr, _receive_stamped);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 _send(msg.content.ptr, true);
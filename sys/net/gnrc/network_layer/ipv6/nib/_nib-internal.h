@@ -196,9 +196,15 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
     ipv6_addr_t pfx;            /**< prefix to the destination */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE) || defined(DOXYGEN)
+    /**
+     * @brief   Next entry with the same prefix in the LPM trie
+     */
+    struct _nib_offl_entry *lpm_next;
+#endif
     /**
      * @brief   Event for @ref GNRC_IPV6_NIB_PFX_TIMEOUT
      */
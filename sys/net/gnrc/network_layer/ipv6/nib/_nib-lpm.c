@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-lpm.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE)
+
+/**
+ * @brief   Every distinct prefix needs at most one leaf and one branching
+ *          node, plus one for the root
+ */
+#define _NODES_NUMOF    ((2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF) + 1)
+
+/**
+ * @brief   Index of the root node. As the root is never a child, it also marks
+ *          the absence of a child.
+ */
+#define _ROOT           (0U)
+
+static_assert(_NODES_NUMOF <= UINT16_MAX,
+              "CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF too large for the LPM trie");
+
+/**
+ * @brief   A node of the trie
+ *
+ * A node either represents the prefix of at least one off-link entry or is a
+ * branching node with two children. Bits of _nib_lpm_node_t::pfx beyond
+ * _nib_lpm_node_t::pfx_len are always zero.
+ */
+typedef struct {
+    ipv6_addr_t pfx;                /**< prefix of the node */
+    _nib_offl_entry_t *entries;     /**< entries with exactly this prefix,
+                                     *   ordered by address */
+    uint16_t child[2];              /**< children by next bit after prefix */
+    uint8_t pfx_len;                /**< length of _nib_lpm_node_t::pfx */
+} _nib_lpm_node_t;
+
+static _nib_lpm_node_t _nodes[_NODES_NUMOF];
+static uint16_t _free_nodes;
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos / 8] >> (7 - (pos % 8))) & 0x1;
+}
+
+static inline unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static uint16_t _node_alloc(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    uint16_t idx = _free_nodes;
+
+    /* the pool is dimensioned so that it can never run out */
+    assert(idx != _ROOT);
+    _free_nodes = _nodes[idx].child[0];
+    memset(&_nodes[idx], 0, sizeof(_nodes[idx]));
+    ipv6_addr_init_prefix(&_nodes[idx].pfx, pfx, pfx_len);
+    _nodes[idx].pfx_len = pfx_len;
+    return idx;
+}
+
+static void _node_free(uint16_t idx)
+{
+    _nodes[idx].entries = NULL;
+    _nodes[idx].child[0] = _free_nodes;
+    _nodes[idx].child[1] = _ROOT;
+    _free_nodes = idx;
+}
+
+void _nib_lpm_init(void)
+{
+    memset(_nodes, 0, sizeof(_nodes));
+    _free_nodes = _ROOT;
+    for (uint16_t i = _NODES_NUMOF - 1; i > _ROOT; i--) {
+        _node_free(i);
+    }
+}
+
+static void _entries_insert(_nib_lpm_node_t *node, _nib_offl_entry_t *entry)
+{
+    _nib_offl_entry_t **ptr = &node->entries;
+
+    /* keep ordered by address to resolve ties like a linear search would */
+    while ((*ptr != NULL) && (*ptr < entry)) {
+        ptr = &(*ptr)->lpm_next;
+    }
+    entry->lpm_next = *ptr;
+    *ptr = entry;
+}
+
+void _nib_lpm_add(_nib_offl_entry_t *entry)
+{
+    const ipv6_addr_t *pfx = &entry->pfx;
+    unsigned pfx_len = entry->pfx_len;
+    uint16_t parent = _ROOT;
+
+    assert((pfx_len > 0) && (pfx_len <= IPV6_ADDR_BIT_LEN));
+    while (1) {
+        unsigned bit = _bit(pfx, _nodes[parent].pfx_len);
+        uint16_t child = _nodes[parent].child[bit];
+        _nib_lpm_node_t *node;
+        unsigned common;
+
+        if (child == _ROOT) {
+            /* no child in that direction => new leaf */
+            child = _node_alloc(pfx, pfx_len);
+            _entries_insert(&_nodes[child], entry);
+            _nodes[parent].child[bit] = child;
+            return;
+        }
+        node = &_nodes[child];
+        common = _min(ipv6_addr_match_prefix(&node->pfx, pfx),
+                      _min(node->pfx_len, pfx_len));
+        if (common == node->pfx_len) {
+            if (node->pfx_len == pfx_len) {
+                /* prefix already in trie */
+                _entries_insert(node, entry);
+                return;
+            }
+            /* prefix is below node */
+            parent = child;
+            continue;
+        }
+        /* prefix diverges from node or is above node */
+        uint16_t split = _node_alloc(pfx, common);
+
+        _nodes[split].child[_bit(&node->pfx, common)] = child;
+        if (common == pfx_len) {
+            _entries_insert(&_nodes[split], entry);
+        }
+        else {
+            uint16_t leaf = _node_alloc(pfx, pfx_len);
+
+            _entries_insert(&_nodes[leaf], entry);
+            _nodes[split].child[_bit(pfx, common)] = leaf;
+        }
+        _nodes[parent].child[bit] = split;
+        return;
+    }
+}
+
+/**
+ * @brief   Removes node @p idx if it neither holds entries nor branches
+ *
+ * @param[in] parent    Parent of @p idx.
+ * @param[in] idx       Node to compact.
+ */
+static void _compact(uint16_t parent, uint16_t idx)
+{
+    _nib_lpm_node_t *node = &_nodes[idx];
+    uint16_t *link;
+
+    if ((idx == _ROOT) || (node->entries != NULL) ||
+        ((node->child[0] != _ROOT) && (node->child[1] != _ROOT))) {
+        return;
+    }
+    link = &_nodes[parent].child[(_nodes[parent].child[0] == idx) ? 0 : 1];
+    /* splice in the only child (or nothing, if node is a leaf) */
+    *link = (node->child[0] != _ROOT) ? node->child[0] : node->child[1];
+    _node_free(idx);
+}
+
+void _nib_lpm_remove(_nib_offl_entry_t *entry)
+{
+    const ipv6_addr_t *pfx = &entry->pfx;
+    unsigned pfx_len = entry->pfx_len;
+    uint16_t grandparent = _ROOT, parent = _ROOT, idx = _ROOT;
+
+    while (_nodes[idx].pfx_len < pfx_len) {
+        grandparent = parent;
+        parent = idx;
+        idx = _nodes[idx].child[_bit(pfx, _nodes[idx].pfx_len)];
+        if (idx == _ROOT) {
+            return;
+        }
+    }
+    if ((_nodes[idx].pfx_len != pfx_len) ||
+        (ipv6_addr_match_prefix(&_nodes[idx].pfx, pfx) < pfx_len)) {
+        return;
+    }
+    for (_nib_offl_entry_t **ptr = &_nodes[idx].entries; *ptr != NULL;
+         ptr = &(*ptr)->lpm_next) {
+        if (*ptr == entry) {
+            *ptr = entry->lpm_next;
+            entry->lpm_next = NULL;
+            break;
+        }
+    }
+    if (_nodes[idx].entries == NULL) {
+        bool leaf = (_nodes[idx].child[0] == _ROOT) &&
+                    (_nodes[idx].child[1] == _ROOT);
+
+        _compact(parent, idx);
+        if (leaf) {
+            /* parent might have become a node with a single child */
+            _compact(grandparent, parent);
+        }
+    }
+}
+
+_nib_offl_entry_t *_nib_lpm_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    uint8_t best_match = 0;
+    uint16_t idx = _ROOT;
+
+    do {
+        const _nib_lpm_node_t *node = &_nodes[idx];
+        uint8_t match = ipv6_addr_match_prefix(&node->pfx, dst);
+
+        if (match < node->pfx_len) {
+            /* dst diverges from all prefixes below */
+            break;
+        }
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->lpm_next) {
+            if (entry->mode != _EMPTY) {
+                /* all entries of the node have the same match, so only the
+                 * first in use (i.e. the one with the lowest address) is a
+                 * candidate */
+                if ((match > best_match) ||
+                    ((match == best_match) && (entry < res))) {
+                    DEBUG("nib: best match (%u bits)\n", match);
+                    res = entry;
+                    best_match = match;
+                }
+                break;
+            }
+        }
+        if (node->pfx_len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        idx = node->child[_bit(dst, node->pfx_len)];
+    } while (idx != _ROOT);
+    return res;
+}
+
+#else  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE */
+typedef int dont_be_pedantic;
+#endif /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE */
+
+/** @} */
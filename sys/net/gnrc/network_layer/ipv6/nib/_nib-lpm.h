@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_ipv6_nib
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief   Definitions related to the longest-prefix match trie over off-link
+ *          entries
+ * @see     @ref CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE
+ */
+#ifndef PRIV_NIB_LPM_H
+#define PRIV_NIB_LPM_H
+
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE) || defined(DOXYGEN)
+/**
+ * @brief   Resets the trie
+ */
+void _nib_lpm_init(void);
+
+/**
+ * @brief   Adds an off-link entry to the trie
+ *
+ * @pre `(entry != NULL) && (entry->pfx_len > 0)`
+ * @pre _nib_offl_entry_t::pfx of @p entry is zeroed beyond
+ *      _nib_offl_entry_t::pfx_len
+ *
+ * @param[in] entry An off-link entry that is not in the trie yet.
+ */
+void _nib_lpm_add(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Removes an off-link entry from the trie
+ *
+ * @param[in] entry An off-link entry previously added with _nib_lpm_add().
+ */
+void _nib_lpm_remove(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Gets the best matching off-link entry for a destination
+ *
+ * The entry that shares the most leading bits with @p dst among all entries
+ * covering @p dst is returned. Ties are resolved in favor of the entry with
+ * the lowest address, which is exactly the result of a linear search over all
+ * off-link entries.
+ *
+ * @param[in] dst   A destination address.
+ *
+ * @return  The best matching off-link entry for @p dst.
+ * @return  NULL, if no entry covers @p dst.
+ */
+_nib_offl_entry_t *_nib_lpm_get_match(const ipv6_addr_t *dst);
+#else   /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE || defined(DOXYGEN) */
+#define _nib_lpm_init()             (void)0
+#define _nib_lpm_add(entry)         (void)entry
+#define _nib_lpm_remove(entry)      (void)entry
+/* _nib_lpm_get_match() doesn't make sense without the trie so don't even use
+ * it => throw error in case it is compiled in => don't define it here as NOP
+ * macro */
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_LPM_TRIE || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_NIB_LPM_H */
+/** @} */
@@ -20,6 +20,7 @@
 #include "utlist.h"
 
 #include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/pktprof.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
@@ -410,6 +411,7 @@ static void *_event_loop(void *args)
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
+                gnrc_pktprof_stamp(msg.content.ptr, GNRC_PKTPROF_SIXLOWPAN);
                 _receive(msg.content.ptr);
                 break;
 
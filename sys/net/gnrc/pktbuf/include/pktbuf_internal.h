@@ -27,6 +27,9 @@
 #include <stdlib.h>
 
 #include "mutex.h"
+#if IS_USED(MODULE_GNRC_PKTBUF_SLAB)
+#include "net/gnrc/pktbuf/slab.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +53,16 @@ extern mutex_t gnrc_pktbuf_mutex;
 extern uint8_t *gnrc_pktbuf_static_buf;
 #endif
 
+#if IS_USED(MODULE_GNRC_PKTBUF_SLAB) || DOXYGEN
+/**
+ * @brief   The arena holding all size classes when module gnrc_pktbuf_slab is
+ *          used
+ *
+ * @warning This is an internal buffer and should not be touched by external code
+ */
+extern uint8_t *gnrc_pktbuf_slab_buf;
+#endif
+
 /**
  * @brief   Check if the given pointer is indeed part of the packet buffer
  *
@@ -65,6 +78,8 @@ static inline bool gnrc_pktbuf_contains(void *ptr)
 {
 #if IS_USED(MODULE_GNRC_PKTBUF_STATIC)
     return (unsigned)((uint8_t *)ptr - gnrc_pktbuf_static_buf) < CONFIG_GNRC_PKTBUF_SIZE;
+#elif IS_USED(MODULE_GNRC_PKTBUF_SLAB)
+    return (size_t)((uint8_t *)ptr - gnrc_pktbuf_slab_buf) < GNRC_PKTBUF_SLAB_SIZE;
 #else
     (void)ptr;
     return true;
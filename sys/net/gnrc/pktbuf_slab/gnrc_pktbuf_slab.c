@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf_slab
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf/slab.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#include "pktbuf_internal.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief   Marks an unused block in the free list of a size class
+ */
+typedef struct _slab_free {
+    struct _slab_free *next;    /**< next unused block of the same class */
+} _slab_free_t;
+
+/**
+ * @brief   A size class
+ */
+typedef struct {
+    _slab_free_t *free;     /**< free list of the class */
+    uint8_t *start;         /**< first block of the class in the arena */
+    uint8_t *refs;          /**< reference counter per block */
+    gnrc_pktbuf_slab_class_stats_t stats;   /**< statistics of the class */
+} _slab_t;
+
+#define _SNIP_NUMOF     CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define _SMALL_NUMOF    CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define _MEDIUM_NUMOF   CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define _LARGE_NUMOF    CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define _LARGE_SIZE     GNRC_PKTBUF_SLAB_ALIGN_UP(CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+/* the arena needs to be aligned to GNRC_PKTBUF_SLAB_ALIGN, so that the start
+ * of all blocks can be casted to `_slab_free_t *` and arbitrary headers
+ * safely. Allocating an array of uint64_t is a trivial way to do this */
+static uint64_t _slab_buf[GNRC_PKTBUF_SLAB_SIZE / sizeof(uint64_t)];
+uint8_t *gnrc_pktbuf_slab_buf = (uint8_t *)_slab_buf;
+
+/* reference counters for all blocks; a block is shared by multiple snips
+ * after gnrc_pktbuf_mark() split its data without copying */
+static uint8_t _refs[_SNIP_NUMOF + _SMALL_NUMOF + _MEDIUM_NUMOF + _LARGE_NUMOF];
+
+static _slab_t _slabs[GNRC_PKTBUF_SLAB_CLASS_NUMOF];
+static gnrc_pktbuf_slab_stats_t _stats;
+
+static const struct {
+    uint16_t size;
+    uint16_t numof;
+} _slab_conf[GNRC_PKTBUF_SLAB_CLASS_NUMOF] = {
+    { GNRC_PKTBUF_SLAB_SNIP_SIZE, _SNIP_NUMOF },
+    { GNRC_PKTBUF_SLAB_ALIGN_UP(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE), _SMALL_NUMOF },
+    { GNRC_PKTBUF_SLAB_ALIGN_UP(CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_SIZE), _MEDIUM_NUMOF },
+    { _LARGE_SIZE, _LARGE_NUMOF },
+};
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+/**
+ * @brief   Finds the size class @p ptr belongs to
+ *
+ * @pre gnrc_pktbuf_contains(@p ptr)
+ */
+static _slab_t *_slab_of(const void *ptr)
+{
+    const uint8_t *p = ptr;
+
+    for (unsigned i = GNRC_PKTBUF_SLAB_CLASS_NUMOF - 1; i > 0; i--) {
+        if (p >= _slabs[i].start) {
+            return &_slabs[i];
+        }
+    }
+    return &_slabs[0];
+}
+
+static inline unsigned _block_idx(const _slab_t *slab, const void *ptr)
+{
+    return ((const uint8_t *)ptr - slab->start) / slab->stats.size;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    uint8_t *start = gnrc_pktbuf_slab_buf;
+    uint8_t *refs = _refs;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    memset(&_stats, 0, sizeof(_stats));
+    memset(_refs, 0, sizeof(_refs));
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        uint8_t *block = start + (_slab_conf[i].size * _slab_conf[i].numof);
+
+        memset(slab, 0, sizeof(*slab));
+        slab->start = start;
+        slab->refs = refs;
+        slab->stats.size = _slab_conf[i].size;
+        slab->stats.numof = _slab_conf[i].numof;
+        /* build free list back to front so blocks are handed out in address
+         * order */
+        while (block > start) {
+            /* alignment is ensured by GNRC_PKTBUF_SLAB_ALIGN_UP() on the
+             * block sizes. We cast to uintptr_t as intermediate step to
+             * silence -Wcast-align */
+            _slab_free_t *free;
+
+            block -= slab->stats.size;
+            free = (_slab_free_t *)(uintptr_t)block;
+            free->next = slab->free;
+            slab->free = free;
+        }
+        start += slab->stats.size * slab->stats.numof;
+        refs += slab->stats.numof;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > largest block size (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&gnrc_pktbuf_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+    if (pkt->size != size) {
+        /* both snips share the block now */
+        _slab_t *slab = _slab_of(pkt->data);
+
+        slab->refs[_block_idx(slab, pkt->data)]++;
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    pkt->next = marked_snip;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && gnrc_pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    else if (size < pkt->size) {
+        /* shrink in place, the block stays reserved as a whole */
+        _stats.requested -= pkt->size - size;
+    }
+    else {
+        if (pkt->data != NULL) {
+            _slab_t *slab = _slab_of(pkt->data);
+            unsigned idx = _block_idx(slab, pkt->data);
+            uint8_t *block = slab->start + (idx * slab->stats.size);
+
+            /* block is not shared and the data still fits => grow in place */
+            if ((slab->refs[idx] == 1) && ((uint8_t *)pkt->data == block) &&
+                (size <= slab->stats.size)) {
+                _stats.requested += size - pkt->size;
+                pkt->size = size;
+                mutex_unlock(&gnrc_pktbuf_mutex);
+                return 0;
+            }
+        }
+        void *new_data = (size > _LARGE_SIZE) ? NULL : _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, pkt->size);
+        }
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    pkt->size = size;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return new;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+void gnrc_pktbuf_slab_get_class_stats(unsigned cls,
+                                      gnrc_pktbuf_slab_class_stats_t *stats)
+{
+    assert(cls < GNRC_PKTBUF_SLAB_CLASS_NUMOF);
+    mutex_lock(&gnrc_pktbuf_mutex);
+    *stats = _slabs[cls].stats;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+void gnrc_pktbuf_slab_get_stats(gnrc_pktbuf_slab_stats_t *stats)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    *stats = _stats;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    gnrc_pktbuf_slab_stats_t stats;
+
+    gnrc_pktbuf_slab_get_stats(&stats);
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&gnrc_pktbuf_slab_buf[0],
+           (void *)&gnrc_pktbuf_slab_buf[GNRC_PKTBUF_SLAB_SIZE],
+           (unsigned)GNRC_PKTBUF_SLAB_SIZE);
+    printf("  requested: %u, reserved: %u (max: %u), fragmentation: %u\n",
+           (unsigned)stats.requested, (unsigned)stats.reserved,
+           (unsigned)stats.max_reserved,
+           (unsigned)(stats.reserved - stats.requested));
+    printf("  failed allocations: %" PRIu32 " (%" PRIu32 " due to fragmentation)\n",
+           stats.fails, stats.frag_fails);
+    puts("  class  size  used  max used  numof  fallbacks");
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        gnrc_pktbuf_slab_class_stats_t cls;
+
+        gnrc_pktbuf_slab_get_class_stats(i, &cls);
+        printf("  %5u  %4u  %4u  %8u  %5u  %9" PRIu32 "\n", i,
+               cls.size, cls.used, cls.max_used, cls.numof, cls.fallbacks);
+    }
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        if (_slabs[i].stats.used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall blocks in a free list: block lies within its class and at a
+     *    block boundary, and its reference counter is 0
+     *  - forall classes: length of free list + used == numof
+     *  - forall classes: used <= max_used
+     *  - forall classes: number of blocks with non-zero reference counter
+     *    == used
+     */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned free_numof = 0, used_numof = 0;
+
+        for (_slab_free_t *ptr = slab->free; ptr != NULL; ptr = ptr->next) {
+            uint8_t *block = (uint8_t *)ptr;
+            size_t offset = block - slab->start;
+
+            if ((block < slab->start) ||
+                (offset >= (size_t)(slab->stats.size * slab->stats.numof)) ||
+                ((offset % slab->stats.size) != 0) ||
+                (slab->refs[offset / slab->stats.size] != 0) ||
+                (++free_numof > slab->stats.numof)) {
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < slab->stats.numof; j++) {
+            if (slab->refs[j] > 0) {
+                used_numof++;
+            }
+        }
+        if (((free_numof + slab->stats.used) != slab->stats.numof) ||
+            (slab->stats.used > slab->stats.max_used) ||
+            (used_numof != slab->stats.used)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            gnrc_pktbuf_free_internal(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    unsigned i = 0;
+
+    /* find smallest class that fits */
+    while ((i < GNRC_PKTBUF_SLAB_CLASS_NUMOF) && (size > _slabs[i].stats.size)) {
+        i++;
+    }
+    if (i == GNRC_PKTBUF_SLAB_CLASS_NUMOF) {
+        DEBUG("pktbuf: no size class for %u bytes\n", (unsigned)size);
+        _stats.fails++;
+        return NULL;
+    }
+    /* fall back to bigger classes if exhausted */
+    while ((i < GNRC_PKTBUF_SLAB_CLASS_NUMOF) && (_slabs[i].free == NULL)) {
+        _slabs[i++].stats.fallbacks++;
+    }
+    if (i == GNRC_PKTBUF_SLAB_CLASS_NUMOF) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _stats.fails++;
+        if ((GNRC_PKTBUF_SLAB_SIZE - _stats.reserved) >= size) {
+            _stats.frag_fails++;
+        }
+        return NULL;
+    }
+
+    _slab_t *slab = &_slabs[i];
+    _slab_free_t *block = slab->free;
+
+    slab->free = block->next;
+    slab->refs[_block_idx(slab, block)] = 1;
+    if (++slab->stats.used > slab->stats.max_used) {
+        slab->stats.max_used = slab->stats.used;
+    }
+    _stats.requested += size;
+    _stats.reserved += slab->stats.size;
+    if (_stats.reserved > _stats.max_reserved) {
+        _stats.max_reserved = _stats.reserved;
+    }
+    return block;
+}
+
+void gnrc_pktbuf_free_internal(void *data, size_t size)
+{
+    _slab_t *slab;
+    unsigned idx;
+
+    if (!gnrc_pktbuf_contains(data)) {
+        return;
+    }
+    slab = _slab_of(data);
+    idx = _block_idx(slab, data);
+    assert(slab->refs[idx] > 0);
+    _stats.requested -= size;
+    if (--slab->refs[idx] == 0) {
+        /* alignment is ensured by the block size. We cast to uintptr_t as
+         * intermediate step to silence -Wcast-align */
+        _slab_free_t *block = (_slab_free_t *)(uintptr_t)(slab->start +
+                                                          (idx * slab->stats.size));
+        block->next = slab->free;
+        slab->free = block;
+        slab->stats.used--;
+        _stats.reserved -= slab->stats.size;
+    }
+}
+
+/** @} */
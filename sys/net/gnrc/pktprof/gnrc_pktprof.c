@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktprof
+ * @{
+ *
+ * @file
+ * @brief       Packet profiling implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "bitarithm.h"
+#include "irq.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktprof.h"
+
+#define LAST_BUCKET     (CONFIG_GNRC_PKTPROF_BUCKETS - 1)
+
+static gnrc_pktprof_hist_t _hists[GNRC_PKTPROF_NUMOF];
+
+static const char *_names[GNRC_PKTPROF_NUMOF] = {
+    [GNRC_PKTPROF_NETIF] = "netif",
+    [GNRC_PKTPROF_SIXLOWPAN] = "sixlowpan",
+    [GNRC_PKTPROF_IPV6] = "ipv6",
+    [GNRC_PKTPROF_UDP] = "udp",
+    [GNRC_PKTPROF_SOCK] = "sock",
+};
+
+void gnrc_pktprof_init(void)
+{
+    benchmark_start_cycles();
+}
+
+void gnrc_pktprof_stamp(gnrc_pktsnip_t *pkt, gnrc_pktprof_stage_t stage)
+{
+    gnrc_pktsnip_t *netif = pkt;
+
+    /* the header is only written if no other receiver can access it */
+    while ((netif != NULL) && (netif->users == 1) &&
+           (netif->type != GNRC_NETTYPE_NETIF)) {
+        netif = netif->next;
+    }
+    if ((netif == NULL) || (netif->users != 1)) {
+        return;
+    }
+
+    gnrc_pktprof_t *prof = &((gnrc_netif_hdr_t *)netif->data)->prof;
+    uint32_t now = benchmark_now();
+    unsigned before = prof->stamped & ((1U << stage) - 1);
+
+    if (before) {
+        gnrc_pktprof_record(stage, now - prof->stamps[bitarithm_msb(before)]);
+    }
+    prof->stamps[stage] = now;
+    prof->stamped |= 1U << stage;
+}
+
+void gnrc_pktprof_record(gnrc_pktprof_stage_t stage, uint32_t ticks)
+{
+    gnrc_pktprof_hist_t *hist = &_hists[stage];
+    unsigned bucket = ticks ? bitarithm_msb(ticks) : 0;
+
+    if (bucket > LAST_BUCKET) {
+        bucket = LAST_BUCKET;
+    }
+
+    unsigned state = irq_disable();
+    hist->count++;
+    hist->sum += ticks;
+    if (ticks > hist->max) {
+        hist->max = ticks;
+    }
+    hist->buckets[bucket]++;
+    irq_restore(state);
+}
+
+void gnrc_pktprof_get(gnrc_pktprof_stage_t stage, gnrc_pktprof_hist_t *hist)
+{
+    unsigned state = irq_disable();
+    *hist = _hists[stage];
+    irq_restore(state);
+}
+
+uint32_t gnrc_pktprof_percentile(const gnrc_pktprof_hist_t *hist,
+                                 unsigned percent)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    /* rank of the percentile among the sorted latencies, starting at 1 */
+    uint32_t rank = ((uint64_t)hist->count * percent + 99) / 100;
+    uint32_t below = 0;
+
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTPROF_BUCKETS; i++) {
+        uint32_t numof = hist->buckets[i];
+
+        if (below + numof < rank) {
+            below += numof;
+            continue;
+        }
+
+        uint64_t low = (i == 0) ? 0 : (1ULL << i);
+        uint64_t high = (i == LAST_BUCKET) ? hist->max : (2ULL << i) - 1;
+        uint64_t est = low + ((high - low) * (rank - below)) / numof;
+
+        return (est < hist->max) ? est : hist->max;
+    }
+
+    return hist->max;
+}
+
+void gnrc_pktprof_reset(void)
+{
+    unsigned state = irq_disable();
+    memset(_hists, 0, sizeof(_hists));
+    irq_restore(state);
+}
+
+const char *gnrc_pktprof_stage_name(gnrc_pktprof_stage_t stage)
+{
+    return _names[stage];
+}
+
+void gnrc_pktprof_print(bool json)
+{
+    if (!json) {
+        printf("%-10s| %10s | %10s | %10s | %10s | %10s  [%s]\n", "stage",
+               "count", "p50", "p99", "max", "avg", BENCHMARK_UNIT);
+    }
+
+    for (unsigned i = 0; i < GNRC_PKTPROF_NUMOF; i++) {
+        gnrc_pktprof_hist_t hist;
+
+        gnrc_pktprof_get(i, &hist);
+
+        uint32_t p50 = gnrc_pktprof_percentile(&hist, 50);
+        uint32_t p99 = gnrc_pktprof_percentile(&hist, 99);
+        uint32_t avg = (hist.count) ? hist.sum / hist.count : 0;
+
+        if (json) {
+            printf("{\"stage\":\"%s\",\"unit\":\"%s\",\"count\":%" PRIu32
+                   ",\"p50\":%" PRIu32 ",\"p99\":%" PRIu32 ",\"max\":%" PRIu32
+                   ",\"avg\":%" PRIu32 "}\n",
+                   _names[i], BENCHMARK_UNIT, hist.count, p50, p99, hist.max,
+                   avg);
+        }
+        else {
+            printf("%-10s| %10" PRIu32 " | %10" PRIu32 " | %10" PRIu32
+                   " | %10" PRIu32 " | %10" PRIu32 "\n",
+                   _names[i], hist.count, p50, p99, hist.max, avg);
+        }
+    }
+}
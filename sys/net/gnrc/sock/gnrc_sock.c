@@ -23,6 +23,7 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/netreg.h"
+#include "net/gnrc/pktprof.h"
 #include "net/gnrc/tx_sync.h"
 #include "net/udp.h"
 #include "utlist.h"
@@ -165,6 +166,7 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     switch (msg.type) {
         case GNRC_NETAPI_MSG_TYPE_RCV:
             pkt = msg.content.ptr;
+            gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_SOCK);
             break;
 #if IS_USED(MODULE_XTIMER) || IS_USED(MODULE_ZTIMER_USEC)
         case _TIMEOUT_MSG_TYPE:
@@ -96,8 +96,20 @@ static void _close(gnrc_tcp_tcb_t *tcb)
     /* Setup connection timeout */
     _sched_connection_timeout(&tcb->event_misc, &mbox);
 
+    /* Wait until the retransmission queue has room for the FIN */
+    while (_gnrc_tcp_pkt_rtx_full(tcb) && (state != FSM_STATE_CLOSED)) {
+        mbox_get(&mbox, &msg);
+        if (msg.type == MSG_TYPE_CONNECTION_TIMEOUT) {
+            TCP_DEBUG_INFO("Received MSG_TYPE_CONNECTION_TIMEOUT.");
+            _gnrc_tcp_fsm(tcb, FSM_EVENT_TIMEOUT_CONNECTION, NULL, NULL, 0);
+        }
+        state = _gnrc_tcp_fsm_get_state(tcb);
+    }
+
     /* Start connection teardown sequence */
-    _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
+    if (state != FSM_STATE_CLOSED) {
+        _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
+    }
 
     /* Loop until the connection has been closed */
     state = _gnrc_tcp_fsm_get_state(tcb);
@@ -705,8 +717,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                     MSG_TYPE_USER_SPEC_TIMEOUT, &mbox);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. Sent data is retransmitted until it is
+     * acknowledged, so there is no need to wait for the acknowledgment. */
+    while (ret == 0) {
         state = _gnrc_tcp_fsm_get_state(tcb);
 
         /* Check if the connections state is closed. If so, a reset was received */
@@ -729,9 +742,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                         MSG_TYPE_PROBE_TIMEOUT, &mbox);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
+        /* Try to send data in case we are not probing */
+        if (!probing_mode) {
             ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret != 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -746,7 +762,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 TCP_DEBUG_INFO("Received MSG_TYPE_USER_SPEC_TIMEOUT.");
-                _gnrc_tcp_fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 TCP_DEBUG_ERROR("-ETIMEDOUT: User specified timeout expired.");
                 ret = -ETIMEDOUT;
                 break;
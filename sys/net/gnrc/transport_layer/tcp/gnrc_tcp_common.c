@@ -17,11 +17,82 @@
  * @}
  */
 
+#include <utlist.h>
+#include "byteorder.h"
 #include "include/gnrc_tcp_common.h"
 
-static _gnrc_tcp_common_tcb_list_t _list = {NULL, MUTEX_INIT};
+#ifdef MODULE_GNRC_IPV6
+#include "net/ipv6/addr.h"
+#endif
+
+/**
+ * @brief Multiplier of the TCB hash, 2^32 divided by the golden ratio.
+ */
+#define HASH_MUL (2654435761U)
+
+static _gnrc_tcp_common_tcb_list_t _list = { .head = NULL, .lock = MUTEX_INIT };
+
+/**
+ * @brief Calculates the lookup table bucket of a connection.
+ *
+ * @param[in] local_port   Local port number.
+ * @param[in] peer_port    Peer port number.
+ * @param[in] peer_addr    Peer network layer address, NULL if unspecified.
+ *
+ * @returns   Index of the bucket.
+ */
+static unsigned _hash(uint16_t local_port, uint16_t peer_port, const uint8_t *peer_addr)
+{
+    uint32_t h = 0;
+
+#ifdef MODULE_GNRC_IPV6
+    if (peer_addr != NULL) {
+        for (unsigned i = 0; i < sizeof(ipv6_addr_t); i += sizeof(uint32_t)) {
+            h ^= byteorder_bebuftohl(&peer_addr[i]);
+        }
+    }
+#else
+    (void)peer_addr;
+#endif
+    /* Multiplicative hashing, the upper bits are mixed best */
+    h = (h * HASH_MUL) ^ (((uint32_t)local_port << 16) | peer_port);
+    h *= HASH_MUL;
+    return (h >> 16) & (TCB_HASH_BUCKETS - 1);
+}
 
 _gnrc_tcp_common_tcb_list_t *_gnrc_tcp_common_get_tcb_list(void)
 {
     return &_list;
 }
+
+void _gnrc_tcp_common_tcb_hash_update(gnrc_tcp_tcb_t *tcb)
+{
+    const uint8_t *peer_addr = NULL;
+
+#ifdef MODULE_GNRC_IPV6
+    if (!ipv6_addr_is_unspecified((ipv6_addr_t *)tcb->peer_addr)) {
+        peer_addr = tcb->peer_addr;
+    }
+#endif
+    _gnrc_tcp_common_tcb_hash_remove(tcb);
+    unsigned bucket = _hash(tcb->local_port, tcb->peer_port, peer_addr);
+    LL_PREPEND2(_list.hash[bucket], tcb, hash_next);
+    tcb->hash_bucket = bucket + 1;
+}
+
+void _gnrc_tcp_common_tcb_hash_remove(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->hash_bucket == 0) {
+        return;
+    }
+    LL_DELETE2(_list.hash[tcb->hash_bucket - 1], tcb, hash_next);
+    tcb->hash_next = NULL;
+    tcb->hash_bucket = 0;
+}
+
+gnrc_tcp_tcb_t *_gnrc_tcp_common_tcb_hash_bucket(uint16_t local_port,
+                                                 uint16_t peer_port,
+                                                 const uint8_t *peer_addr)
+{
+    return _list.hash[_hash(local_port, peer_port, peer_addr)];
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/congure.h
+ */
+#include <stdint.h>
+#include "congure.h"
+#include "net/gnrc/tcp/config.h"
+#include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_congure.h"
+#include "include/gnrc_tcp_pkt.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief Duplicate ACKs that trigger a fast retransmit (RFC 5681).
+ */
+#define FAST_RETRANSMIT_THRESH (3U)
+
+/**
+ * @brief Retransmits the oldest unacknowledged segment once per loss recovery.
+ *
+ * Further segments lost in the same window are retransmitted on partial
+ * acknowledgments or, with SACK, as soon as they are considered lost.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _fast_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->status & STATUS_RECOVERY) {
+        return;
+    }
+    TCP_DEBUG_INFO("Fast retransmit.");
+    _gnrc_tcp_pkt_enter_recovery(tcb);
+    _gnrc_tcp_pkt_retransmit(tcb, false);
+}
+
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+static void _reno_fr(congure_reno_snd_t *c)
+{
+    _fast_retransmit(c->super.ctx);
+}
+
+static bool _reno_same_wnd_adv(congure_reno_snd_t *c, congure_snd_ack_t *ack)
+{
+    gnrc_tcp_tcb_t *tcb = c->super.ctx;
+
+    return ack->wnd == tcb->snd_wnd;
+}
+
+static const congure_reno_snd_consts_t _reno_consts = {
+    .fr = _reno_fr,
+    .same_wnd_adv = _reno_same_wnd_adv,
+    .init_mss = CONFIG_GNRC_TCP_MSS,
+    /* Initial window bounds of RFC 3390 */
+    .cwnd_upper = 2190,
+    .cwnd_lower = 1095,
+    .init_ssthresh = CONGURE_WND_SIZE_MAX,
+    .frthresh = FAST_RETRANSMIT_THRESH,
+};
+#endif
+
+void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb)
+{
+    /* Use the smaller of both MSS, the peer may not have sent one */
+    uint16_t mss = CONFIG_GNRC_TCP_MSS;
+
+    if ((tcb->mss > 0) && (tcb->mss < mss)) {
+        mss = tcb->mss;
+    }
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+    congure_reno_snd_setup(&tcb->congure.reno, &_reno_consts);
+    tcb->congure.super.driver->init(&tcb->congure.super, tcb);
+    congure_reno_set_mss(&tcb->congure.reno, mss);
+#endif
+    tcb->recover = tcb->snd_nxt;
+    DEBUG("gnrc_tcp_congure: MSS %u, initial cwnd %u\n", (unsigned)mss,
+          (unsigned)tcb->congure.super.cwnd);
+}
+
+uint32_t _gnrc_tcp_congure_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t cwnd = tcb->congure.super.cwnd;
+
+    return (cwnd < tcb->snd_wnd) ? cwnd : tcb->snd_wnd;
+}
+
+void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, uint32_t len)
+{
+    tcb->congure.super.driver->report_msg_sent(&tcb->congure.super, len);
+}
+
+void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb, uint32_t seg_ack,
+                             uint32_t acked, uint16_t seg_wnd,
+                             uint32_t pay_len, bool clean)
+{
+    congure_snd_msg_t msg = { .size = acked };
+    congure_snd_ack_t ack = {
+        /* ACK IDs are relative to the ISS, so they are comparable as serial
+         * numbers over the whole connection */
+        .id = seg_ack - tcb->iss,
+        .size = pay_len,
+        .wnd = seg_wnd,
+        .clean = clean,
+    };
+
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+    /* Reno caps its flight size at cwnd, so it may count less than was sent */
+    if (msg.size > tcb->congure.reno.in_flight_size) {
+        msg.size = tcb->congure.reno.in_flight_size;
+    }
+#endif
+    tcb->congure.super.driver->report_msg_acked(&tcb->congure.super, &msg,
+                                                &ack);
+}
+
+void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
+        return;
+    }
+
+    const gnrc_tcp_rtx_t *rtx = &tcb->rtx[tcb->rtx_head];
+    congure_snd_msg_t msg = {
+        .send_time = rtx->sent,
+        .size = rtx->len,
+        .resends = rtx->resends,
+    };
+
+    /* The oldest segment is lost, and sent again right away */
+    msg.super.next = &msg.super;
+    tcb->congure.super.driver->report_msgs_timeout(&tcb->congure.super, &msg);
+    tcb->congure.super.driver->report_msg_sent(&tcb->congure.super, rtx->len);
+}
+/** @} */
@@ -207,18 +207,25 @@ static int _receive(gnrc_pktsnip_t *pkt)
 #endif
     }
 
-    /* Find TCB to for this packet */
+    /* Find TCB to for this packet: Listening TCBs are hashed without peer */
     _gnrc_tcp_common_tcb_list_t *list = _gnrc_tcp_common_get_tcb_list();
     mutex_lock(&list->lock);
-    tcb = list->head;
+#ifdef MODULE_GNRC_IPV6
+    tcb = (syn) ? _gnrc_tcp_common_tcb_hash_bucket(dst, PORT_UNSPEC, NULL)
+                : _gnrc_tcp_common_tcb_hash_bucket(dst, src,
+                                                   (uint8_t *)&((ipv6_hdr_t *)ip->data)->src);
+#endif
     while (tcb) {
 #ifdef MODULE_GNRC_IPV6
         /* Check if current TCB is fitting for the incoming packet */
         if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
             /* If SYN is set, a connection is listening on that port ... */
             ipv6_addr_t *tmp_addr = NULL;
-            _gnrc_tcp_fsm_state_t state = _gnrc_tcp_fsm_get_state(tcb);
-            if (syn && tcb->local_port == dst && state == FSM_STATE_LISTEN) {
+            /* The state is read without fsm_lock: state transitions take
+             * list->lock while holding fsm_lock, so taking fsm_lock here
+             * would invert the lock order. The FSM is run under fsm_lock
+             * with whatever state the TCB has by then. */
+            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
                 /* ... and local addr is unspec or pre configured */
                 tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
                 if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
@@ -243,7 +250,7 @@ static int _receive(gnrc_pktsnip_t *pkt)
         (void) src;
         (void) dst;
 #endif
-        tcb = tcb->next;
+        tcb = tcb->hash_next;
     }
     mutex_unlock(&list->lock);
 
@@ -273,6 +280,31 @@ static int _receive(gnrc_pktsnip_t *pkt)
     return 0;
 }
 
+#ifdef MODULE_GNRC_TCP_DIRECT_RCV
+/**
+ * @brief Netreg callback, processes received segments in the context of the
+ *        dispatching thread, usually the network layer thread.
+ *
+ * Segments to send are still passed to the eventloop.
+ *
+ * @param[in] cmd   Netapi command.
+ * @param[in] pkt   Packet to process.
+ * @param[in] ctx   Unused.
+ */
+static void _netreg_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    else if (gnrc_netapi_send(_tcp_eventloop_pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        TCP_DEBUG_ERROR("Can't pass packet to eventloop.");
+    }
+}
+#endif
+
 static void *_eventloop(__attribute__((unused)) void *arg)
 {
     TCP_DEBUG_ENTER;
@@ -291,7 +323,12 @@ static void *_eventloop(__attribute__((unused)) void *arg)
 
     /* Register GNRC TCPs handling thread in netreg */
     gnrc_netreg_entry_t entry;
+#ifdef MODULE_GNRC_TCP_DIRECT_RCV
+    gnrc_netreg_entry_cbd_t cbd = { .cb = _netreg_cb, .ctx = NULL };
+    gnrc_netreg_entry_init_cb(&entry, GNRC_NETREG_DEMUX_CTX_ALL, &cbd);
+#else
     gnrc_netreg_entry_init_pid(&entry, GNRC_NETREG_DEMUX_CTX_ALL, _tcp_eventloop_pid);
+#endif
     gnrc_netreg_register(GNRC_NETTYPE_TCP, &entry);
 
     /* dispatch NETAPI messages */
@@ -25,10 +25,12 @@
 #include "evtimer.h"
 #include "evtimer_msg.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_congure.h"
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_pkt.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_rcvbuf.h"
+#include "include/gnrc_tcp_sack.h"
 #include "include/gnrc_tcp_fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -92,11 +94,7 @@ static uint16_t _get_random_local_port(void)
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
-    }
+    _gnrc_tcp_pkt_clear_retransmit(tcb);
     TCP_DEBUG_LEAVE;
     return 0;
 }
@@ -148,8 +146,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit queue and out-of-order segments */
             _clear_retransmit(tcb);
+            _gnrc_tcp_sack_clear(tcb);
 
             /* Close connection if not listenng */
             if (!(tcb->status & STATUS_LISTENING))
@@ -157,6 +156,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
                 /* Remove connection from active connections */
                 mutex_lock(&list->lock);
                 LL_DELETE(list->head, tcb);
+                _gnrc_tcp_common_tcb_hash_remove(tcb);
                 mutex_unlock(&list->lock);
 
                 /* Free potentially allocated receive buffer */
@@ -174,8 +174,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             break;
 
         case FSM_STATE_LISTEN:
-            /* Clear Accepted Status */
-            tcb->status &= ~(STATUS_ACCEPTED);
+            /* Clear Accepted Status, SACK is negotiated per connection */
+            tcb->status &= ~(STATUS_ACCEPTED | STATUS_SACK);
 
             /* Clear address info */
 #ifdef MODULE_GNRC_IPV6
@@ -188,16 +188,22 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
+            /* Give back the receive chunks reserved for the former peer */
+            tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+
             /* Add connection to active connections (if not already active) */
             mutex_lock(&list->lock);
             LL_SEARCH(list->head, iter, tcb, TCB_EQUAL);
             if (iter == NULL) {
                 LL_PREPEND(list->head, tcb);
             }
+            _gnrc_tcp_common_tcb_hash_update(tcb);
             mutex_unlock(&list->lock);
             break;
 
         case FSM_STATE_SYN_SENT:
+            tcb->status &= ~(STATUS_SACK);
+
             /* Add connection to active connections (if not already active) */
             mutex_lock(&list->lock);
             LL_SEARCH(list->head, iter, tcb, TCB_EQUAL);
@@ -219,10 +225,16 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
                 }
                 LL_PREPEND(list->head, tcb);
             }
+            _gnrc_tcp_common_tcb_hash_update(tcb);
             mutex_unlock(&list->lock);
             break;
 
         case FSM_STATE_SYN_RCVD:
+            /* Peer is known now, move TCB to the bucket of the connection */
+            mutex_lock(&list->lock);
+            _gnrc_tcp_common_tcb_hash_update(tcb);
+            mutex_unlock(&list->lock);
+
             /* Setup timeout for listening TCBs */
             if (tcb->status & STATUS_LISTENING) {
                 _gnrc_tcp_eventloop_sched(&tcb->event_timeout,
@@ -237,6 +249,10 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             if (tcb->status & STATUS_LISTENING) {
                 _gnrc_tcp_eventloop_unsched(&tcb->event_timeout);
             }
+            /* Start congestion control once the connection is synchronized */
+            if (state == FSM_STATE_ESTABLISHED) {
+                _gnrc_tcp_congure_init(tcb);
+            }
             tcb->status |= STATUS_NOTIFY_USER;
             break;
 
@@ -273,7 +289,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
         return -ENOMEM;
     }
 
-    tcb->rcv_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
 
     if (tcb->status & STATUS_LISTENING) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -308,6 +324,9 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 /**
  * @brief FSM Handling function for sending data.
  *
+ * Sends segments as long as the send window, the congestion window and the
+ * retransmission queue allow.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
@@ -317,27 +336,41 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     TCP_DEBUG_ENTER;
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+
+    while (sent < len && !_gnrc_tcp_pkt_rtx_full(tcb)) {
+        uint32_t wnd = _gnrc_tcp_congure_wnd(tcb);
+        uint32_t in_flight = tcb->snd_nxt - tcb->snd_una;
+
+        /* Stop if window is closed */
+        if (in_flight >= wnd) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
+        size_t payload = wnd - in_flight;
         payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        if (tcb->mss > 0) {
+            payload = (payload < tcb->mss) ? payload : tcb->mss;
+        }
+        payload = (payload < (len - sent)) ? payload : (len - sent);
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
         _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH,
-                            tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+                            tcb->snd_nxt, tcb->rcv_nxt, (uint8_t *)buf + sent,
+                            payload);
+        if (out_pkt == NULL) {
+            break;
+        }
         _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
-        TCP_DEBUG_LEAVE;
-        return payload;
+        _gnrc_tcp_congure_sent(tcb, payload);
+        sent += payload;
     }
     TCP_DEBUG_LEAVE;
-    return 0;
+    return sent;
 }
 
 /**
@@ -353,17 +386,21 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     TCP_DEBUG_ENTER;
 
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
+    if (_gnrc_tcp_rcvbuf_get_used(tcb) == 0) {
         TCP_DEBUG_LEAVE;
         return 0;
     }
 
     /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+    size_t rcvd = _gnrc_tcp_rcvbuf_get(tcb, buf, len);
 
-    /* If receive buffer can store more than CONFIG_GNRC_TCP_MSS: set window to free buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= CONFIG_GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    /* If receive buffer can store a full MSS, half of its fair share of the
+     * receive pool or was read completely: set window to free buffer size
+     * (see RFC 1122, 4.2.3.3) */
+    uint16_t wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    if (wnd >= CONFIG_GNRC_TCP_MSS || wnd >= _gnrc_tcp_rcvbuf_get_share() / 2 ||
+        _gnrc_tcp_rcvbuf_get_used(tcb) == 0) {
+        tcb->rcv_wnd = wnd;
 
         /* Send ACK to announce window update */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -463,13 +500,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     uint32_t seg_seq = 0;            /* Sequence number of the incoming packet*/
     uint32_t seg_ack = 0;            /* Acknowledgment number of the incoming packet */
     uint32_t seg_wnd = 0;            /* Receive window of the incoming packet */
+    _gnrc_tcp_option_t opts;         /* Options applied once the packet is accepted */
 
     /* Search for TCP header. */
     snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_TCP);
     tcp_hdr_t *tcp_hdr = (tcp_hdr_t *) snp->data;
 
     /* Parse packet options, return if they are malformed */
-    if (_gnrc_tcp_option_parse(tcb, tcp_hdr) < 0) {
+    if (_gnrc_tcp_option_parse(tcb, tcp_hdr, &opts) < 0) {
         TCP_DEBUG_ERROR("Failed to parse TCP header options.");
         TCP_DEBUG_LEAVE;
         return 0;
@@ -514,7 +552,15 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             uint16_t dst = byteorder_ntohs(tcp_hdr->dst_port);
 
             /* Check if SYN request is handled by another connection */
-            lst = _gnrc_tcp_common_get_tcb_list()->head;
+            _gnrc_tcp_common_tcb_list_t *list = _gnrc_tcp_common_get_tcb_list();
+            const uint8_t *peer_addr = NULL;
+#ifdef MODULE_GNRC_IPV6
+            if (snp->type == GNRC_NETTYPE_IPV6) {
+                peer_addr = (uint8_t *)&((ipv6_hdr_t *)ip)->src;
+            }
+#endif
+            mutex_lock(&list->lock);
+            lst = _gnrc_tcp_common_tcb_hash_bucket(dst, src, peer_addr);
             while (lst) {
                 /* Compare port numbers and network layer addresses */
                 if (lst->local_port == dst && lst->peer_port == src) {
@@ -530,8 +576,9 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                     }
 #endif
                 }
-                lst = lst->next;
+                lst = lst->hash_next;
             }
+            mutex_unlock(&list->lock);
             /* Return if connection is already handled (port and addresses match) */
             /* cppcheck-suppress knownConditionTrueFalse
              * (reason: tmp *lst* can be true at runtime
@@ -573,6 +620,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
+            if (opts.sack_perm) {
+                tcb->status |= STATUS_SACK;
+            }
+
+            /* Peer is known now, reserve receive chunks for it */
+            tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
 
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
             _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss,
@@ -613,6 +666,9 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_SYN) {
             tcb->rcv_nxt = seg_seq + 1;
             tcb->irs = seg_seq;
+            if (opts.sack_perm) {
+                tcb->status |= STATUS_SACK;
+            }
             if (ctl & MSK_ACK) {
                 tcb->snd_una = seg_ack;
                 _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
@@ -710,10 +766,42 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2 || tcb->state == FSM_STATE_CLOSE_WAIT ||
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
+                /* The segment is acceptable, so are its SACK blocks */
+                _gnrc_tcp_option_apply_sack(tcb, &opts);
+
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     tcb->snd_una = seg_ack;
-                    _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                    int acked = _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                    _gnrc_tcp_congure_acked(tcb, seg_ack, (acked > 0) ? acked : 0,
+                                            seg_wnd, pay_len, !(ctl & (MSK_SYN | MSK_FIN)));
+
+                    /* Partial ACK during loss recovery: the next segment was lost as well.
+                     * With SACK, only segments followed by SACKed ones are lost. */
+                    if (tcb->status & STATUS_RECOVERY) {
+                        if (!LSS_32_BIT(seg_ack, tcb->recover)) {
+                            tcb->status &= ~STATUS_RECOVERY;
+                        }
+                        else if (tcb->status & STATUS_SACK) {
+                            _gnrc_tcp_pkt_retransmit_lost(tcb);
+                        }
+                        else {
+                            _gnrc_tcp_pkt_retransmit(tcb, false);
+                        }
+                    }
+                    /* Signal user, the retransmission queue has room again */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: Congestion control decides on fast retransmit.
+                 * Must be evaluated before the send window is updated. */
+                else if (seg_ack == tcb->snd_una) {
+                    _gnrc_tcp_congure_acked(tcb, seg_ack, 0, seg_wnd, pay_len,
+                                            !(ctl & (MSK_SYN | MSK_FIN)));
+
+                    /* SACK blocks of the duplicate ACK may reveal further losses */
+                    if ((tcb->status & STATUS_RECOVERY) && (tcb->status & STATUS_SACK)) {
+                        _gnrc_tcp_pkt_retransmit_lost(tcb);
+                    }
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -738,25 +826,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         TCP_DEBUG_LEAVE;
                         return 0;
@@ -779,14 +867,20 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 if (tcb->rcv_nxt == seg_seq) {
                     /* Copy contents into receive buffer */
                     while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
+                        tcb->rcv_nxt += _gnrc_tcp_rcvbuf_add(tcb, snp->data, snp->size);
                         snp = snp->next;
                     }
+                    /* Append segments that were received beyond the filled gap */
+                    _gnrc_tcp_sack_drain(tcb);
                     /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+                /* Keep data beyond a gap until the gap is filled */
+                else if (LSS_32_BIT(tcb->rcv_nxt, seg_seq)) {
+                    _gnrc_tcp_sack_store(tcb, in_pkt, seg_seq, pay_len);
+                }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
@@ -803,6 +897,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 TCP_DEBUG_LEAVE;
                 return 0;
             }
+            /* Accept FIN only after all data before it: Acknowledge up to the gap */
+            if (seg_seq + pay_len != tcb->rcv_nxt) {
+                _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
+                                    tcb->rcv_nxt, NULL, 0);
+                _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
+                TCP_DEBUG_LEAVE;
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
@@ -813,7 +915,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -857,9 +959,11 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (!_gnrc_tcp_pkt_rtx_empty(tcb)) {
+        /* Segments sent after the lost one are retransmitted on partial ACKs */
+        _gnrc_tcp_pkt_enter_recovery(tcb);
+        _gnrc_tcp_congure_timeout(tcb);
+        _gnrc_tcp_pkt_retransmit(tcb, true);
     }
     else {
         TCP_DEBUG_INFO("Retransmission queue is empty.");
@@ -16,15 +16,21 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
+
+#include "kernel_defines.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_option.h"
+#include "include/gnrc_tcp_pkt.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
-int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr, _gnrc_tcp_option_t *opts)
 {
     TCP_DEBUG_ENTER;
+    memset(opts, 0, sizeof(*opts));
+
     /* Extract offset value. Return if no options are set */
     uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
     if (offset <= TCP_HDR_OFFSET_MIN) {
@@ -64,6 +70,34 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                 tcb->mss = (option->value[0] << 8) | option->value[1];
                 break;
 
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    TCP_DEBUG_ERROR("Invalid SACK-Permitted option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK-Permitted option found.");
+                /* Only valid in SYN segments */
+                if (IS_USED(MODULE_GNRC_TCP_SACK) &&
+                    (byteorder_ntohs(hdr->off_ctl) & MSK_SYN)) {
+                    opts->sack_perm = true;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    (option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+                    TCP_DEBUG_ERROR("Invalid SACK option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK option found.");
+                opts->sack = option->value;
+                opts->sack_len = option->length - TCP_OPTION_LENGTH_MIN;
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     TCP_DEBUG_INFO("Valid, unsupported option found.");
@@ -83,3 +117,15 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     TCP_DEBUG_LEAVE;
     return 0;
 }
+
+void _gnrc_tcp_option_apply_sack(gnrc_tcp_tcb_t *tcb, const _gnrc_tcp_option_t *opts)
+{
+    TCP_DEBUG_ENTER;
+    if (tcb->status & STATUS_SACK) {
+        for (uint8_t i = 0; i < opts->sack_len; i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+            _gnrc_tcp_pkt_sack(tcb, byteorder_bebuftohl(opts->sack + i),
+                               byteorder_bebuftohl(opts->sack + i + 4));
+        }
+    }
+    TCP_DEBUG_LEAVE;
+}
@@ -28,6 +28,7 @@
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_pkt.h"
+#include "include/gnrc_tcp_sack.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -181,6 +182,8 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     if (ctl & MSK_SYN) {
         offset += 1;
     }
+    /* Add SACK-Permitted option in SYN or SACK option if segments are missing */
+    offset += _gnrc_tcp_sack_opt_words(tcb, ctl);
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(
         _gnrc_tcp_option_build_offset_control(offset, ctl));
@@ -217,7 +220,9 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
                     _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
 
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
             }
+            _gnrc_tcp_sack_opt_build(tcb, ctl, opt_ptr);
             /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
         }
@@ -285,11 +290,9 @@ int _gnrc_tcp_pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt,
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = evtimer_now_msec();
     }
     else {
         tcb->retries += 1;
@@ -375,11 +378,51 @@ uint32_t _gnrc_tcp_pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the retransmission timeout from the RTT estimation.
+ *
+ * @param[in,out] tcb   TCB holding the RTT estimation.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no RTT estimation yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
+                                    CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief (Re-)starts the retransmission timer with the current RTO.
+ *
+ * @param[in,out] tcb   TCB holding the retransmission timer.
+ */
+static void _sched_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
+                              MSG_TYPE_RETRANSMISSION, tcb);
+}
+
 int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
                                    const bool retransmit)
 {
     TCP_DEBUG_ENTER;
     gnrc_pktsnip_t *snp = NULL;
+    gnrc_tcp_rtx_t *rtx = NULL;
+    tcp_hdr_t *hdr = NULL;
     uint32_t ctl = 0;
     uint32_t len = 0;
 
@@ -390,16 +433,35 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
+    if (retransmit) {
+        /* Only the oldest packet in the retransmit queue is retransmitted on timeout */
+        if (_gnrc_tcp_pkt_rtx_empty(tcb) || tcb->rtx[tcb->rtx_head].pkt != pkt) {
+            TCP_DEBUG_ERROR("-EINVAL: pkt is not the oldest packet in retransmit queue.");
+            TCP_DEBUG_LEAVE;
+            return -EINVAL;
+        }
+
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(pkt, 1);
+
+        /* Double the rto (Timer Backoff) */
+        tcb->rto *= 2;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+        _sched_retransmit(tcb);
         TCP_DEBUG_LEAVE;
-        return -ENOMEM;
+        return 0;
     }
 
     /* Extract control bits and segment length */
     snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
-    ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
+    hdr = (tcp_hdr_t *) snp->data;
+    ctl = byteorder_ntohs(hdr->off_ctl);
     len = _gnrc_tcp_pkt_get_pay_len(pkt);
 
     /* Check if pkt contains reset or is a pure ACK, return */
@@ -408,96 +470,235 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Check if retransmit queue is full */
+    if (_gnrc_tcp_pkt_rtx_full(tcb)) {
+        TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
+        TCP_DEBUG_LEAVE;
+        return -ENOMEM;
+    }
+
+    /* Append pkt and increase users: every send attempt consumes a user */
+    rtx = &tcb->rtx[(tcb->rtx_head + tcb->rtx_len) % CONFIG_GNRC_TCP_RTX_QUEUE_SIZE];
+    rtx->pkt = pkt;
+    rtx->seq = byteorder_ntohl(hdr->seq_num);
+    rtx->len = _gnrc_tcp_pkt_get_seg_len(pkt);
+    rtx->sent = evtimer_now_msec();
+    rtx->resends = 0;
+    rtx->flags = 0;
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
-                                        CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    /* Start retransmission timer, if this is the only packet in flight */
+    if (tcb->rtx_len++ == 0) {
+        _calc_rto(tcb);
+        _sched_retransmit(tcb);
+    }
+    TCP_DEBUG_LEAVE;
+    return 0;
+}
+
+/**
+ * @brief Gets an entry of the retransmission queue.
+ *
+ * @param[in] tcb   TCB holding the retransmission queue.
+ * @param[in] i     Position in the queue, 0 is the oldest entry.
+ *
+ * @returns   Pointer to the entry.
+ */
+static gnrc_tcp_rtx_t *_rtx_at(gnrc_tcp_tcb_t *tcb, unsigned i)
+{
+    return &tcb->rtx[(tcb->rtx_head + i) % CONFIG_GNRC_TCP_RTX_QUEUE_SIZE];
+}
+
+/**
+ * @brief Sends an entry of the retransmission queue again.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in,out] rtx   Entry to retransmit.
+ *
+ * @returns   Zero on success.
+ */
+static int _resend(gnrc_tcp_tcb_t *tcb, gnrc_tcp_rtx_t *rtx)
+{
+    if (rtx->resends < UINT8_MAX) {
+        rtx->resends++;
+    }
+    rtx->flags |= RTX_FLAG_RETRANSMITTED;
+    return _gnrc_tcp_pkt_send(tcb, rtx->pkt, 0, true);
+}
+
+int _gnrc_tcp_pkt_retransmit(gnrc_tcp_tcb_t *tcb, const bool timeout)
+{
+    TCP_DEBUG_ENTER;
+    gnrc_tcp_rtx_t *rtx = NULL;
+
+    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
+        TCP_DEBUG_ERROR("-ENODATA: Retransmit queue is empty.");
+        TCP_DEBUG_LEAVE;
+        return -ENODATA;
+    }
+
+    if (timeout) {
+        /* The receiver may have dropped data it selectively acknowledged,
+         * forget about all SACKs (see RFC 2018, section 8) */
+        for (unsigned i = 0; i < tcb->rtx_len; i++) {
+            _rtx_at(tcb, i)->flags &= ~RTX_FLAG_SACKED;
         }
+        rtx = _rtx_at(tcb, 0);
+        _gnrc_tcp_pkt_setup_retransmit(tcb, rtx->pkt, true);
     }
     else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
-
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
+        /* Skip segments the receiver already has */
+        unsigned i = 0;
+        while (i < tcb->rtx_len && (_rtx_at(tcb, i)->flags & RTX_FLAG_SACKED)) {
+            i++;
+        }
+        if (i == tcb->rtx_len) {
+            TCP_DEBUG_LEAVE;
+            return -ENODATA;
         }
+        rtx = _rtx_at(tcb, i);
+
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(rtx->pkt, 1);
     }
+    TCP_DEBUG_LEAVE;
+    return _resend(tcb, rtx);
+}
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+int _gnrc_tcp_pkt_retransmit_lost(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    gnrc_tcp_rtx_t *lost = NULL;
+
+    /* A segment is considered lost, if a later segment was selectively
+     * acknowledged. Retransmit the oldest one that was not retransmitted
+     * during this loss recovery yet. */
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        gnrc_tcp_rtx_t *rtx = _rtx_at(tcb, i);
+
+        if (rtx->flags & RTX_FLAG_SACKED) {
+            if (lost != NULL) {
+                /* Increase users: every send attempt consumes a user */
+                gnrc_pktbuf_hold(lost->pkt, 1);
+                TCP_DEBUG_LEAVE;
+                return _resend(tcb, lost);
+            }
+        }
+        else if (lost == NULL && !(rtx->flags & RTX_FLAG_RETRANSMITTED)) {
+            lost = rtx;
+        }
     }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    TCP_DEBUG_LEAVE;
+    return -ENODATA;
+}
+
+void _gnrc_tcp_pkt_enter_recovery(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    tcb->status |= STATUS_RECOVERY;
+    tcb->recover = tcb->snd_nxt;
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        _rtx_at(tcb, i)->flags &= ~RTX_FLAG_RETRANSMITTED;
     }
+    TCP_DEBUG_LEAVE;
+}
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
-                              MSG_TYPE_RETRANSMISSION, tcb);
+void _gnrc_tcp_pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left,
+                        const uint32_t right)
+{
+    TCP_DEBUG_ENTER;
+    for (unsigned i = 0; i < tcb->rtx_len; i++) {
+        gnrc_tcp_rtx_t *rtx = _rtx_at(tcb, i);
+
+        if (LEQ_32_BIT(left, rtx->seq) && LEQ_32_BIT(rtx->seq + rtx->len, right)) {
+            rtx->flags |= RTX_FLAG_SACKED;
+        }
+    }
     TCP_DEBUG_LEAVE;
-    return 0;
 }
 
 int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     TCP_DEBUG_ENTER;
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    int acked = 0;
+    bool karn = true;
+    uint32_t sent = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (_gnrc_tcp_pkt_rtx_empty(tcb)) {
         TCP_DEBUG_ERROR("-ENODATA: No packet to acknowledge.");
         TCP_DEBUG_LEAVE;
         return -ENODATA;
     }
 
-    snp = gnrc_pktsnip_search_type(tcb->pkt_retransmit, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
+    /* Release all packets that are acknowledged completely */
+    while (!_gnrc_tcp_pkt_rtx_empty(tcb)) {
+        gnrc_tcp_rtx_t *rtx = &tcb->rtx[tcb->rtx_head];
 
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _gnrc_tcp_pkt_get_seg_len(
-        tcb->pkt_retransmit) - 1;
-
-        /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
-
-        /* Measure round trip time */
-        int32_t rtt = evtimer_now_msec() - tcb->rtt_start;
-
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
-            /* If this is the first sample taken */
-            if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
-                tcb->srtt = rtt;
-                tcb->rtt_var = (rtt >> 1);
-            }
-            /* If this is a subsequent sample */
-            else {
-                tcb->rtt_var = (tcb->rtt_var / CONFIG_GNRC_TCP_RTO_B_DIV) * (CONFIG_GNRC_TCP_RTO_B_DIV-1);
-                tcb->rtt_var += labs(tcb->srtt - rtt) / CONFIG_GNRC_TCP_RTO_B_DIV;
-                tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
-                tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
-            }
+        if (LSS_32_BIT(ack, rtx->seq + rtx->len)) {
+            break;
         }
+        /* Measure the round trip time with the latest packet, but only if none
+         * of the acknowledged packets was retransmitted (Karns Algorithm) */
+        karn = karn && (rtx->resends == 0);
+        sent = rtx->sent;
+        acked += rtx->len;
+
+        gnrc_pktbuf_release(rtx->pkt);
+        rtx->pkt = NULL;
+        tcb->rtx_head = (tcb->rtx_head + 1) % CONFIG_GNRC_TCP_RTX_QUEUE_SIZE;
+        tcb->rtx_len--;
+    }
+
+    if (acked == 0) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+
+    /* New data was acknowledged: stop timer and update rto */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    tcb->retries = 0;
+
+    /* Measure round trip time */
+    int32_t rtt = evtimer_now_msec() - sent;
+
+    /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
+    if (karn && rtt > 0) {
+        /* If this is the first sample taken */
+        if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
+            tcb->srtt = rtt;
+            tcb->rtt_var = (rtt >> 1);
+        }
+        /* If this is a subsequent sample */
+        else {
+            tcb->rtt_var = (tcb->rtt_var / CONFIG_GNRC_TCP_RTO_B_DIV) * (CONFIG_GNRC_TCP_RTO_B_DIV-1);
+            tcb->rtt_var += labs(tcb->srtt - rtt) / CONFIG_GNRC_TCP_RTO_B_DIV;
+            tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
+            tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
+        }
+    }
+
+    /* Restart timer for the packets still in flight */
+    if (!_gnrc_tcp_pkt_rtx_empty(tcb)) {
+        _calc_rto(tcb);
+        _sched_retransmit(tcb);
     }
     TCP_DEBUG_LEAVE;
-    return 0;
+    return acked;
+}
+
+void _gnrc_tcp_pkt_clear_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    while (!_gnrc_tcp_pkt_rtx_empty(tcb)) {
+        gnrc_pktbuf_release(tcb->rtx[tcb->rtx_head].pkt);
+        tcb->rtx[tcb->rtx_head].pkt = NULL;
+        tcb->rtx_head = (tcb->rtx_head + 1) % CONFIG_GNRC_TCP_RTX_QUEUE_SIZE;
+        tcb->rtx_len--;
+    }
+    tcb->status &= ~STATUS_RECOVERY;
+    TCP_DEBUG_LEAVE;
 }
 
 uint16_t _gnrc_tcp_pkt_calc_csum(const gnrc_pktsnip_t *hdr,
@@ -15,9 +15,13 @@
  *
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
+#include <assert.h>
 #include <errno.h>
 #include <mutex.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#include "net/gnrc/tcp.h"
 #include "net/gnrc/tcp/config.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_rcvbuf.h"
@@ -26,90 +30,129 @@
 #include "debug.h"
 
 /**
- * @brief Receive buffer entry.
+ * @brief Index marking the end of a chunk chain.
  */
-typedef struct {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} _rcvbuf_entry_t;
+#define CHUNK_NONE (UINT16_MAX)
+
+/**
+ * @brief Maximum number of chunks a single receive buffer can hold.
+ */
+#define CHUNKS_PER_BUF ((GNRC_TCP_RCV_BUF_SIZE + CONFIG_GNRC_TCP_RCV_CHUNK_SIZE - 1) / \
+                        CONFIG_GNRC_TCP_RCV_CHUNK_SIZE)
+
+/**
+ * @brief Maximum number of chunks reserved at once, one MSS worth of chunks.
+ */
+#define CHUNKS_PER_MSS ((CONFIG_GNRC_TCP_MSS + CONFIG_GNRC_TCP_RCV_CHUNK_SIZE - 1) / \
+                        CONFIG_GNRC_TCP_RCV_CHUNK_SIZE)
 
 /**
- * @brief Struct holding receive buffers.
+ * @brief Struct holding the receive pool.
  */
 typedef struct {
-    mutex_t lock;                                         /**< Access lock */
-    _rcvbuf_entry_t entries[CONFIG_GNRC_TCP_RCV_BUFFERS]; /**< Buffers */
+    mutex_t lock;                                 /**< Access lock */
+    uint16_t next[CONFIG_GNRC_TCP_RCV_CHUNKS];    /**< Next chunk in a chain */
+    uint16_t free;                                /**< First chunk of the free chain */
+    gnrc_tcp_rcvbuf_stats_t stats;                /**< Usage statistics */
+    uint8_t chunks[CONFIG_GNRC_TCP_RCV_CHUNKS][CONFIG_GNRC_TCP_RCV_CHUNK_SIZE]; /**< Storage */
 } _rcvbuf_t;
 
 /**
- * @brief Internal struct holding receive buffers.
+ * @brief Internal struct holding the receive pool.
  */
 static _rcvbuf_t _static_buf;
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Allocate a chunk that is not reserved. The pool must be locked.
  *
- * @returns   Not NULL if a receive buffer was allocated.
- *            NULL if allocation failed.
+ * @returns   Index of the allocated chunk.
+ *            CHUNK_NONE if the pool is exhausted or all free chunks are
+ *            reserved.
  */
-static void* _rcvbuf_alloc(void)
+static uint16_t _chunk_alloc(void)
 {
-    TCP_DEBUG_ENTER;
-    void *result = NULL;
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < CONFIG_GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+    uint16_t idx = CHUNK_NONE;
+
+    if (_static_buf.stats.chunks_free > _static_buf.stats.chunks_reserved) {
+        idx = _static_buf.free;
+        _static_buf.free = _static_buf.next[idx];
+        _static_buf.next[idx] = CHUNK_NONE;
+        _static_buf.stats.chunks_free--;
+        if (_static_buf.stats.chunks_free < _static_buf.stats.chunks_free_min) {
+            _static_buf.stats.chunks_free_min = _static_buf.stats.chunks_free;
         }
     }
-    mutex_unlock(&(_static_buf.lock));
-    TCP_DEBUG_LEAVE;
-    return result;
+    return idx;
 }
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release a chunk. The pool must be locked.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] idx   Index of the chunk.
  */
-static void _rcvbuf_free(void * const buf)
+static void _chunk_free(uint16_t idx)
 {
-    TCP_DEBUG_ENTER;
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < CONFIG_GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
-    }
-    mutex_unlock(&(_static_buf.lock));
-    TCP_DEBUG_LEAVE;
+    _static_buf.next[idx] = _static_buf.free;
+    _static_buf.free = idx;
+    _static_buf.stats.chunks_free++;
+}
+
+/**
+ * @brief Get the number of chunks a receive buffer may hold. The pool must be
+ *        locked.
+ *
+ * Every connection holding a receive buffer gets an equal share of the pool,
+ * but at least a single chunk.
+ *
+ * @returns   Fair share of a receive buffer in chunks.
+ */
+static uint16_t _fair_share(void)
+{
+    uint16_t users = (_static_buf.stats.users > 0) ? _static_buf.stats.users : 1;
+    uint16_t share = CONFIG_GNRC_TCP_RCV_CHUNKS / users;
+
+    share = (share > 0) ? share : 1;
+    return (share < CHUNKS_PER_BUF) ? share : CHUNKS_PER_BUF;
 }
 
 void _gnrc_tcp_rcvbuf_init(void)
 {
     TCP_DEBUG_ENTER;
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < CONFIG_GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
+    for (unsigned i = 0; i < CONFIG_GNRC_TCP_RCV_CHUNKS; ++i) {
+        _static_buf.next[i] = (i + 1 < CONFIG_GNRC_TCP_RCV_CHUNKS) ? i + 1 : CHUNK_NONE;
     }
+    _static_buf.free = 0;
+    memset(&(_static_buf.stats), 0, sizeof(_static_buf.stats));
+    _static_buf.stats.chunks = CONFIG_GNRC_TCP_RCV_CHUNKS;
+    _static_buf.stats.chunks_free = CONFIG_GNRC_TCP_RCV_CHUNKS;
+    _static_buf.stats.chunks_free_min = CONFIG_GNRC_TCP_RCV_CHUNKS;
     TCP_DEBUG_LEAVE;
 }
 
 int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
-        if (tcb->rcv_buf_raw == NULL) {
+    gnrc_tcp_rcvbuf_t *buf = &(tcb->rcv_buf);
+
+    if (buf->chunks == 0) {
+        mutex_lock(&(_static_buf.lock));
+        uint16_t idx = _chunk_alloc();
+        if (idx == CHUNK_NONE) {
+            _static_buf.stats.refused++;
+            mutex_unlock(&(_static_buf.lock));
             TCP_DEBUG_ERROR("-ENOMEM: Failed to allocate receive buffer.");
             TCP_DEBUG_LEAVE;
             return -ENOMEM;
         }
-        else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
-        }
+        _static_buf.stats.users++;
+        mutex_unlock(&(_static_buf.lock));
+
+        buf->head = idx;
+        buf->tail = idx;
+        buf->rd = 0;
+        buf->wr = 0;
+        buf->chunks = 1;
     }
     TCP_DEBUG_LEAVE;
     return 0;
@@ -118,9 +161,200 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
-        tcb->rcv_buf_raw = NULL;
+    gnrc_tcp_rcvbuf_t *buf = &(tcb->rcv_buf);
+
+    if (buf->chunks > 0) {
+        uint16_t idx = buf->head;
+
+        mutex_lock(&(_static_buf.lock));
+        for (uint16_t i = 0; i < buf->chunks; ++i) {
+            uint16_t next = _static_buf.next[idx];
+            _chunk_free(idx);
+            idx = next;
+        }
+        _static_buf.stats.chunks_reserved -= buf->reserved;
+        _static_buf.stats.users--;
+        mutex_unlock(&(_static_buf.lock));
+        memset(buf, 0, sizeof(*buf));
     }
     TCP_DEBUG_LEAVE;
 }
+
+size_t _gnrc_tcp_rcvbuf_add(gnrc_tcp_tcb_t *tcb, const void *data, size_t len)
+{
+    gnrc_tcp_rcvbuf_t *buf = &(tcb->rcv_buf);
+    size_t added = 0;
+
+    if (buf->chunks == 0) {
+        return 0;
+    }
+
+    while (added < len) {
+        /* Last chunk is full: Append a reserved one, or another one if the
+         * fair share allows it */
+        if (buf->wr == CONFIG_GNRC_TCP_RCV_CHUNK_SIZE) {
+            uint16_t idx = CHUNK_NONE;
+
+            mutex_lock(&(_static_buf.lock));
+            if (buf->reserved > 0) {
+                /* Can't fail, there are at least as many free chunks as reserved */
+                buf->reserved--;
+                _static_buf.stats.chunks_reserved--;
+                idx = _chunk_alloc();
+            }
+            else if (buf->chunks < _fair_share()) {
+                idx = _chunk_alloc();
+            }
+            if (idx == CHUNK_NONE) {
+                _static_buf.stats.denied++;
+            }
+            else {
+                _static_buf.next[buf->tail] = idx;
+            }
+            mutex_unlock(&(_static_buf.lock));
+
+            if (idx == CHUNK_NONE) {
+                TCP_DEBUG_INFO("Receive buffer can't grow any further.");
+                break;
+            }
+            buf->tail = idx;
+            buf->wr = 0;
+            buf->chunks++;
+        }
+
+        size_t n = CONFIG_GNRC_TCP_RCV_CHUNK_SIZE - buf->wr;
+        n = (n < len - added) ? n : len - added;
+        memcpy(_static_buf.chunks[buf->tail] + buf->wr, (const uint8_t *)data + added, n);
+        buf->wr += n;
+        added += n;
+    }
+    /* The data took its part of the advertised window */
+    tcb->rcv_wnd = (tcb->rcv_wnd > added) ? tcb->rcv_wnd - added : 0;
+    return added;
+}
+
+size_t _gnrc_tcp_rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *data, size_t len)
+{
+    gnrc_tcp_rcvbuf_t *buf = &(tcb->rcv_buf);
+    size_t rcvd = 0;
+
+    while ((rcvd < len) && (_gnrc_tcp_rcvbuf_get_used(tcb) > 0)) {
+        uint16_t end = (buf->head == buf->tail) ? buf->wr : CONFIG_GNRC_TCP_RCV_CHUNK_SIZE;
+        size_t n = end - buf->rd;
+
+        n = (n < len - rcvd) ? n : len - rcvd;
+        memcpy((uint8_t *)data + rcvd, _static_buf.chunks[buf->head] + buf->rd, n);
+        buf->rd += n;
+        rcvd += n;
+
+        /* Keep the last chunk, start over if it was read completely */
+        if (buf->head == buf->tail) {
+            if (buf->rd == buf->wr) {
+                buf->rd = 0;
+                buf->wr = 0;
+            }
+        }
+        /* Return the first chunk to the pool if it was read completely */
+        else if (buf->rd == CONFIG_GNRC_TCP_RCV_CHUNK_SIZE) {
+            mutex_lock(&(_static_buf.lock));
+            uint16_t next = _static_buf.next[buf->head];
+            _chunk_free(buf->head);
+            mutex_unlock(&(_static_buf.lock));
+
+            buf->head = next;
+            buf->rd = 0;
+            buf->chunks--;
+        }
+    }
+    return rcvd;
+}
+
+size_t _gnrc_tcp_rcvbuf_get_used(const gnrc_tcp_tcb_t *tcb)
+{
+    const gnrc_tcp_rcvbuf_t *buf = &(tcb->rcv_buf);
+
+    if (buf->chunks == 0) {
+        return 0;
+    }
+    return (buf->chunks - 1) * CONFIG_GNRC_TCP_RCV_CHUNK_SIZE + buf->wr - buf->rd;
+}
+
+uint16_t _gnrc_tcp_rcvbuf_get_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_rcvbuf_t *buf = &(tcb->rcv_buf);
+    size_t used = _gnrc_tcp_rcvbuf_get_used(tcb);
+
+    if (buf->chunks == 0) {
+        return 0;
+    }
+
+    uint16_t tail_free = CONFIG_GNRC_TCP_RCV_CHUNK_SIZE - buf->wr;
+    uint16_t needed = 0;
+
+    /* Listeners don't know their peer, nothing was advertised to it and
+     * nothing is reserved for it */
+    bool peer_known = (tcb->peer_port != PORT_UNSPEC);
+
+    /* Chunks the window advertised last still needs. They stay reserved
+     * until data is appended into them, so the window never shrinks. */
+    if (peer_known && (tcb->rcv_wnd > tail_free)) {
+        needed = (tcb->rcv_wnd - tail_free + CONFIG_GNRC_TCP_RCV_CHUNK_SIZE - 1) /
+                 CONFIG_GNRC_TCP_RCV_CHUNK_SIZE;
+    }
+
+    mutex_lock(&(_static_buf.lock));
+    uint16_t share = _fair_share();
+    uint16_t held = buf->chunks + buf->reserved;
+
+    /* Give back reservations beyond the current fair share that were not
+     * advertised, e.g. because other connections were opened since, and all
+     * reservations of a listener */
+    if ((buf->reserved > needed) && (!peer_known || (held > share))) {
+        uint16_t excess = (peer_known) ? held - share : buf->reserved;
+
+        excess = (excess < buf->reserved - needed) ? excess : buf->reserved - needed;
+        buf->reserved -= excess;
+        _static_buf.stats.chunks_reserved -= excess;
+        held -= excess;
+    }
+
+    /* Reserve free chunks up to the fair share, at most an MSS at once. The
+     * last free chunk is left for another connection to be opened. */
+    uint16_t avail = _static_buf.stats.chunks_free - _static_buf.stats.chunks_reserved;
+    if (peer_known && (used < GNRC_TCP_RCV_BUF_SIZE) && (share > held) && (avail > 1)) {
+        uint16_t extra = share - held;
+
+        extra = (extra < avail - 1) ? extra : avail - 1;
+        extra = (extra < CHUNKS_PER_MSS) ? extra : CHUNKS_PER_MSS;
+        buf->reserved += extra;
+        _static_buf.stats.chunks_reserved += extra;
+    }
+    mutex_unlock(&(_static_buf.lock));
+
+    if (used >= GNRC_TCP_RCV_BUF_SIZE) {
+        return 0;
+    }
+
+    size_t wnd = tail_free + (size_t)buf->reserved * CONFIG_GNRC_TCP_RCV_CHUNK_SIZE;
+    if (wnd > GNRC_TCP_RCV_BUF_SIZE - used) {
+        wnd = GNRC_TCP_RCV_BUF_SIZE - used;
+    }
+    return (wnd < UINT16_MAX) ? wnd : UINT16_MAX;
+}
+
+size_t _gnrc_tcp_rcvbuf_get_share(void)
+{
+    mutex_lock(&(_static_buf.lock));
+    size_t share = (size_t)_fair_share() * CONFIG_GNRC_TCP_RCV_CHUNK_SIZE;
+    mutex_unlock(&(_static_buf.lock));
+    return (share < GNRC_TCP_RCV_BUF_SIZE) ? share : GNRC_TCP_RCV_BUF_SIZE;
+}
+
+void gnrc_tcp_get_rcvbuf_stats(gnrc_tcp_rcvbuf_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    mutex_lock(&(_static_buf.lock));
+    *stats = _static_buf.stats;
+    mutex_unlock(&(_static_buf.lock));
+}
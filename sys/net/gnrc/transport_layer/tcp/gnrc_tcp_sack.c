@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/sack.h
+ */
+#include <string.h>
+#include "byteorder.h"
+#include "net/tcp.h"
+#include "net/gnrc.h"
+#include "net/gnrc/tcp/config.h"
+#include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_rcvbuf.h"
+#include "include/gnrc_tcp_sack.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief Contiguous range of received sequence numbers.
+ */
+typedef struct {
+    uint32_t left;    /**< First sequence number of the range */
+    uint32_t right;   /**< Sequence number following the range */
+} _block_t;
+
+/**
+ * @brief Merges the kept segments into ranges.
+ *
+ * @param[in]  tcb      TCB holding the kept segments.
+ * @param[out] blocks   Ranges in ascending order.
+ *
+ * @returns   Number of ranges.
+ */
+static unsigned _get_blocks(const gnrc_tcp_tcb_t *tcb,
+                            _block_t blocks[CONFIG_GNRC_TCP_SACK_QUEUE_SIZE])
+{
+    unsigned n = 0;
+
+    for (unsigned i = 0; i < tcb->ooo_len; i++) {
+        uint32_t left = tcb->ooo[i].seq;
+        uint32_t right = left + tcb->ooo[i].len;
+
+        if ((n > 0) && LEQ_32_BIT(left, blocks[n - 1].right)) {
+            if (GRT_32_BIT(right, blocks[n - 1].right)) {
+                blocks[n - 1].right = right;
+            }
+        }
+        else {
+            blocks[n].left = left;
+            blocks[n].right = right;
+            n++;
+        }
+    }
+    return n;
+}
+
+uint8_t _gnrc_tcp_sack_opt_words(const gnrc_tcp_tcb_t *tcb, const uint16_t ctl)
+{
+    _block_t blocks[CONFIG_GNRC_TCP_SACK_QUEUE_SIZE];
+    unsigned n = 0;
+
+    /* SACK-Permitted: always offered in SYN, accepted in SYN+ACK */
+    if (ctl & MSK_SYN) {
+        return (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK)) ? 1 : 0;
+    }
+    if (!(tcb->status & STATUS_SACK) || (ctl & MSK_RST) || !(ctl & MSK_ACK) ||
+        (tcb->ooo_len == 0)) {
+        return 0;
+    }
+
+    /* Two NOPs, kind and length, then two words per block */
+    n = _get_blocks(tcb, blocks);
+    n = (n < CONFIG_GNRC_TCP_SACK_BLOCKS) ? n : CONFIG_GNRC_TCP_SACK_BLOCKS;
+    return 1 + 2 * n;
+}
+
+void _gnrc_tcp_sack_opt_build(const gnrc_tcp_tcb_t *tcb, const uint16_t ctl,
+                              uint8_t *opt)
+{
+    _block_t blocks[CONFIG_GNRC_TCP_SACK_QUEUE_SIZE];
+    uint8_t words = _gnrc_tcp_sack_opt_words(tcb, ctl);
+    unsigned n = (words - 1) / 2;
+    unsigned latest = 0;
+
+    if (words == 0) {
+        return;
+    }
+
+    opt[0] = TCP_OPTION_KIND_NOP;
+    opt[1] = TCP_OPTION_KIND_NOP;
+    if (ctl & MSK_SYN) {
+        opt[2] = TCP_OPTION_KIND_SACK_PERM;
+        opt[3] = TCP_OPTION_LENGTH_SACK_PERM;
+        return;
+    }
+    opt[2] = TCP_OPTION_KIND_SACK;
+    opt[3] = TCP_OPTION_LENGTH_MIN + n * TCP_OPTION_LENGTH_SACK_BLOCK;
+    opt += 4;
+
+    /* The first block must contain the latest segment (RFC 2018, section 4),
+     * the others follow in ascending order */
+    unsigned numof = _get_blocks(tcb, blocks);
+    for (unsigned i = 0; i < numof; i++) {
+        if (LEQ_32_BIT(blocks[i].left, tcb->ooo_latest) &&
+            LSS_32_BIT(tcb->ooo_latest, blocks[i].right)) {
+            latest = i;
+        }
+    }
+    byteorder_htobebufl(opt, blocks[latest].left);
+    byteorder_htobebufl(opt + 4, blocks[latest].right);
+    opt += TCP_OPTION_LENGTH_SACK_BLOCK;
+    for (unsigned i = 0; (i < numof) && (n > 1); i++) {
+        if (i != latest) {
+            byteorder_htobebufl(opt, blocks[i].left);
+            byteorder_htobebufl(opt + 4, blocks[i].right);
+            opt += TCP_OPTION_LENGTH_SACK_BLOCK;
+            n--;
+        }
+    }
+}
+
+void _gnrc_tcp_sack_store(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          const uint32_t seg_seq, const uint32_t pay_len)
+{
+    TCP_DEBUG_ENTER;
+    unsigned pos = 0;
+
+    if (pay_len == 0) {
+        TCP_DEBUG_LEAVE;
+        return;
+    }
+
+    /* Find position to keep the segments sorted, drop duplicates */
+    while ((pos < tcb->ooo_len) && LEQ_32_BIT(tcb->ooo[pos].seq, seg_seq)) {
+        if ((tcb->ooo[pos].seq == seg_seq) && (tcb->ooo[pos].len >= pay_len)) {
+            TCP_DEBUG_LEAVE;
+            return;
+        }
+        pos++;
+    }
+    if (tcb->ooo_len >= CONFIG_GNRC_TCP_SACK_QUEUE_SIZE) {
+        TCP_DEBUG_INFO("Out-of-order queue is full, dropping segment.");
+        TCP_DEBUG_LEAVE;
+        return;
+    }
+
+    memmove(&tcb->ooo[pos + 1], &tcb->ooo[pos],
+            (tcb->ooo_len - pos) * sizeof(tcb->ooo[0]));
+    tcb->ooo[pos].pkt = pkt;
+    tcb->ooo[pos].seq = seg_seq;
+    tcb->ooo[pos].len = pay_len;
+    tcb->ooo_latest = seg_seq;
+    tcb->ooo_len++;
+    gnrc_pktbuf_hold(pkt, 1);
+    TCP_DEBUG_LEAVE;
+}
+
+void _gnrc_tcp_sack_drain(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    while ((tcb->ooo_len > 0) && LEQ_32_BIT(tcb->ooo[0].seq, tcb->rcv_nxt)) {
+        gnrc_tcp_ooo_t *ooo = &tcb->ooo[0];
+        uint32_t skip = tcb->rcv_nxt - ooo->seq;
+
+        /* Copy the part of the payload that was not received yet */
+        gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(ooo->pkt, GNRC_NETTYPE_UNDEF);
+        while (snp && snp->type == GNRC_NETTYPE_UNDEF && skip < ooo->len) {
+            if (skip < snp->size) {
+                size_t len = snp->size - skip;
+                size_t added = _gnrc_tcp_rcvbuf_add(tcb, (uint8_t *)snp->data + skip,
+                                                    len);
+                tcb->rcv_nxt += added;
+                if (added < len) {
+                    break;
+                }
+                skip = 0;
+            }
+            else {
+                skip -= snp->size;
+            }
+            snp = snp->next;
+        }
+
+        gnrc_pktbuf_release(ooo->pkt);
+        tcb->ooo_len--;
+        memmove(&tcb->ooo[0], &tcb->ooo[1], tcb->ooo_len * sizeof(tcb->ooo[0]));
+    }
+    TCP_DEBUG_LEAVE;
+}
+
+void _gnrc_tcp_sack_clear(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    for (unsigned i = 0; i < tcb->ooo_len; i++) {
+        gnrc_pktbuf_release(tcb->ooo[i].pkt);
+    }
+    tcb->ooo_len = 0;
+    TCP_DEBUG_LEAVE;
+}
+/** @} */
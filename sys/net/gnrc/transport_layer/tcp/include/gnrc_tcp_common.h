@@ -25,6 +25,7 @@
 #include "mutex.h"
 #include "evtimer.h"
 #include "net/gnrc/netapi.h"
+#include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -47,6 +48,16 @@ extern "C" {
 #define STATUS_NOTIFY_USER    (1 << 2) /**< Internal: Status bitmask NOTIFY_USER */
 #define STATUS_ACCEPTED       (1 << 3) /**< Internal: Status bitmask ACCEPTED */
 #define STATUS_LOCKED         (1 << 4) /**< Internal: Status bitmask LOCKED */
+#define STATUS_RECOVERY       (1 << 5) /**< Internal: Status bitmask RECOVERY */
+#define STATUS_SACK           (1 << 6) /**< Internal: Status bitmask SACK */
+/** @} */
+
+/**
+ * @brief Retransmission queue entry flags
+ * @{
+ */
+#define RTX_FLAG_SACKED        (1 << 0) /**< Internal: Selectively acknowledged */
+#define RTX_FLAG_RETRANSMITTED (1 << 1) /**< Internal: Retransmitted in loss recovery */
 /** @} */
 
 /**
@@ -146,12 +157,18 @@ extern "C" {
 #define TCP_DEBUG_INFO(msg) DEBUG("GNRC_TCP: Info: \"%s\", Func: %s, File: %s(%d)\n", \
                                   msg, DEBUG_FUNC, RIOT_FILE_RELATIVE, __LINE__)
 
+/**
+ * @brief Number of buckets of the TCB lookup table.
+ */
+#define TCB_HASH_BUCKETS (1U << CONFIG_GNRC_TCP_TCB_HASH_BUCKETS_EXP)
+
 /**
  * @brief TCB list type.
  */
 typedef struct {
-    gnrc_tcp_tcb_t *head; /**< Head of TCB list */
-    mutex_t lock;         /**< Lock of TCB list */
+    gnrc_tcp_tcb_t *head;                    /**< Head of TCB list */
+    gnrc_tcp_tcb_t *hash[TCB_HASH_BUCKETS];  /**< TCBs hashed by local port, peer port and address */
+    mutex_t lock;                            /**< Lock of TCB list and lookup table */
 } _gnrc_tcp_common_tcb_list_t;
 
 /**
@@ -161,6 +178,46 @@ typedef struct {
  */
 _gnrc_tcp_common_tcb_list_t *_gnrc_tcp_common_get_tcb_list(void);
 
+/**
+ * @brief Inserts a TCB into the lookup table, using its current local port,
+ *        peer port and peer address.
+ *
+ * A TCB that was inserted before is moved to its new bucket.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in,out] tcb   TCB to insert.
+ */
+void _gnrc_tcp_common_tcb_hash_update(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Removes a TCB from the lookup table.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in,out] tcb   TCB to remove. Nothing happens if it was not inserted.
+ */
+void _gnrc_tcp_common_tcb_hash_remove(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the TCBs that may be interested in a segment.
+ *
+ * The returned TCBs are linked by gnrc_tcp_tcb_t::hash_next and share the hash
+ * value of the given parameters. Callers must compare the TCB fields to find an
+ * exact match.
+ *
+ * @note Must be called from a context where the TCB list is locked.
+ *
+ * @param[in] local_port   Local port number.
+ * @param[in] peer_port    Peer port number, PORT_UNSPEC for listening TCBs.
+ * @param[in] peer_addr    Peer network layer address, NULL for listening TCBs.
+ *
+ * @returns   First TCB of the matching bucket, NULL if the bucket is empty.
+ */
+gnrc_tcp_tcb_t *_gnrc_tcp_common_tcb_hash_bucket(uint16_t local_port,
+                                                 uint16_t peer_port,
+                                                 const uint8_t *peer_addr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Binding of GNRC TCP to @ref sys_congure.
+ *
+ * The congestion window limits the data in flight along with the send window.
+ * Without a `gnrc_tcp_congure_%` module all functions are no-ops and only the
+ * send window applies.
+ */
+
+#ifndef GNRC_TCP_CONGURE_H
+#define GNRC_TCP_CONGURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+/**
+ * @brief Sets up congestion control for an established connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the number of bytes that may be in flight.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Minimum of the send window and the congestion window.
+ */
+uint32_t _gnrc_tcp_congure_wnd(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Reports a segment with new data as sent.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     len   Payload length of the segment.
+ */
+void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, uint32_t len);
+
+/**
+ * @brief Reports an acceptable ACK, may trigger a fast retransmit.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     seg_ack   Acknowledgment number of the ACK.
+ * @param[in]     acked     Number of bytes acknowledged by the ACK, zero for
+ *                          a duplicate ACK.
+ * @param[in]     seg_wnd   Window advertised by the ACK.
+ * @param[in]     pay_len   Payload length of the ACK.
+ * @param[in]     clean     Flag to mark that neither SYN nor FIN are set.
+ */
+void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb, uint32_t seg_ack,
+                             uint32_t acked, uint16_t seg_wnd,
+                             uint32_t pay_len, bool clean);
+
+/**
+ * @brief Reports that the retransmission timer of the oldest segment expired.
+ *
+ * Must be called before the segment is retransmitted.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb);
+#else
+static inline void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline uint32_t _gnrc_tcp_congure_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_wnd;
+}
+
+static inline void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, uint32_t len)
+{
+    (void)tcb;
+    (void)len;
+}
+
+static inline void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb,
+                                           uint32_t seg_ack, uint32_t acked,
+                                           uint16_t seg_wnd, uint32_t pay_len,
+                                           bool clean)
+{
+    (void)tcb;
+    (void)seg_ack;
+    (void)acked;
+    (void)seg_wnd;
+    (void)pay_len;
+    (void)clean;
+}
+
+static inline void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_CONGURE_H */
+/** @} */
@@ -20,6 +20,7 @@
 #ifndef GNRC_TCP_OPTION_H
 #define GNRC_TCP_OPTION_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "assert.h"
 #include "net/tcp.h"
@@ -29,6 +30,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Options of a received segment that are applied once the segment was
+ *        accepted.
+ */
+typedef struct {
+    const uint8_t *sack;   /**< SACK blocks, NULL if there are none */
+    uint8_t sack_len;      /**< Length of the SACK blocks in bytes */
+    bool sack_perm;        /**< SYN carries the SACK-Permitted option */
+} _gnrc_tcp_option_t;
+
 /**
  * @brief Helper function to build the MSS option.
  *
@@ -59,13 +70,27 @@ static inline uint16_t _gnrc_tcp_option_build_offset_control(uint16_t nopts, uin
 /**
  * @brief Parses options of a given TCP header.
  *
- * @param[in,out] tcb   TCB holding the connection information.
- * @param[in]     hdr   TCP header to be parsed.
+ * Only the MSS is stored in @p tcb right away. Options that must not be
+ * applied for segments that are dropped later on are stored in @p opts.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     hdr    TCP header to be parsed.
+ * @param[out]    opts   Options to apply once the segment was accepted.
  *
  * @returns   Zero on success.
  *            Negative value on error.
  */
-int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
+int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr, _gnrc_tcp_option_t *opts);
+
+/**
+ * @brief Marks segments of the retransmission queue as selectively acknowledged.
+ *
+ * Does nothing, if SACK was not negotiated for the connection.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     opts   Options of an accepted segment.
+ */
+void _gnrc_tcp_option_apply_sack(gnrc_tcp_tcb_t *tcb, const _gnrc_tcp_option_t *opts);
 
 #ifdef __cplusplus
 }
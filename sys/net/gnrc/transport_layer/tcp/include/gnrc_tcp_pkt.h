@@ -20,6 +20,7 @@
 #ifndef GNRC_TCP_PKT_H
 #define GNRC_TCP_PKT_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "net/gnrc.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -111,6 +112,11 @@ uint32_t _gnrc_tcp_pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * New packets are appended to the retransmission queue, the retransmission
+ * timer is started if it is not running yet. If @p retransmit is set, @p pkt
+ * must be the oldest packet in the queue. It is kept and the timer is restarted
+ * with a doubled timeout.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
@@ -123,16 +129,92 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
                                    const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Retransmits the oldest packet of the retransmission queue.
+ *
+ * Packets that were selectively acknowledged are skipped, unless the
+ * retransmission timer expired.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     timeout   Flag used to indicate that the retransmission timer
+ *                          expired. If set, the timeout is backed off.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if there is no packet to retransmit.
+ */
+int _gnrc_tcp_pkt_retransmit(gnrc_tcp_tcb_t *tcb, const bool timeout);
+
+/**
+ * @brief Retransmits the oldest packet that is considered lost.
+ *
+ * A packet is considered lost if a later packet was selectively acknowledged.
+ * Each packet is retransmitted only once per loss recovery.
  *
  * @param[in,out] tcb   TCB holding the connection information.
- * @param[in]     ack   Acknowldegment number used to acknowledge packets.
  *
  * @returns   Zero on success.
+ *            -ENODATA if no packet is considered lost.
+ */
+int _gnrc_tcp_pkt_retransmit_lost(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Starts loss recovery for all packets sent so far.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_pkt_enter_recovery(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Marks the packets inside a SACK block as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the retransmission queue.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block.
+ */
+void _gnrc_tcp_pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left,
+                        const uint32_t right);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     ack   Acknowldegment number used to acknowledge packets.
+ *
+ * @returns   Sequence number space of the removed packets.
  *            -ENODATA if there is nothing to acknowledge.
  */
 int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Releases all packets of the retransmission queue.
+ *
+ * @param[in,out] tcb   TCB holding the retransmission queue.
+ */
+void _gnrc_tcp_pkt_clear_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Checks if all sent packets were acknowledged.
+ *
+ * @param[in] tcb   TCB holding the retransmission queue.
+ *
+ * @returns   true if the retransmission queue is empty.
+ */
+static inline bool _gnrc_tcp_pkt_rtx_empty(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->rtx_len == 0;
+}
+
+/**
+ * @brief Checks if another packet can be sent before an acknowledgment.
+ *
+ * @param[in] tcb   TCB holding the retransmission queue.
+ *
+ * @returns   true if the retransmission queue is full.
+ */
+static inline bool _gnrc_tcp_pkt_rtx_full(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->rtx_len >= CONFIG_GNRC_TCP_RTX_QUEUE_SIZE;
+}
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
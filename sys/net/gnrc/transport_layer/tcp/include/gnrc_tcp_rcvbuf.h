@@ -14,12 +14,19 @@
  * @file
  * @brief       Functions for allocating and freeing the receive buffer.
  *
+ * Receive buffers are chains of chunks taken from a pool shared by all
+ * connections. A receive buffer reserves chunks up to its fair share of the
+ * pool for the window it advertises, takes them as data arrives, and returns
+ * chunks to the pool once they were read.
+ *
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 
 #ifndef GNRC_TCP_RCVBUF_H
 #define GNRC_TCP_RCVBUF_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -27,17 +34,19 @@ extern "C" {
 #endif
 
 /**
- * @brief Initializes global receive buffer.
+ * @brief Initializes global receive pool.
  */
 void _gnrc_tcp_rcvbuf_init(void);
 
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * The receive buffer starts with a single chunk.
+ *
  * @param[in,out] tcb   TCB that acquires receive buffer.
  *
  * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ *            -ENOMEM if all chunks of the receive pool are currently used.
  */
 int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
@@ -48,6 +57,69 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Append received data to the receive buffer.
+ *
+ * The appended data is taken from the advertised window, gnrc_tcp_tcb_t::rcv_wnd.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[in]     data   Data to append.
+ * @param[in]     len    Length of @p data.
+ *
+ * @returns   Number of bytes appended. Less than @p len if the receive buffer
+ *            could not grow any further.
+ */
+size_t _gnrc_tcp_rcvbuf_add(gnrc_tcp_tcb_t *tcb, const void *data, size_t len);
+
+/**
+ * @brief Take data from the receive buffer.
+ *
+ * Chunks that were read completely are returned to the receive pool.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[out]    data   Buffer to read into.
+ * @param[in]     len    Size of @p data.
+ *
+ * @returns   Number of bytes read.
+ */
+size_t _gnrc_tcp_rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *data, size_t len);
+
+/**
+ * @brief Get the number of bytes in the receive buffer.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Number of bytes that were received but not read yet.
+ */
+size_t _gnrc_tcp_rcvbuf_get_used(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Get the receive window to advertise.
+ *
+ * The window covers the free space of the last chunk and chunks reserved for
+ * the receive buffer. Free chunks of the pool are reserved up to the current
+ * fair share, at most an MSS worth at once, except for the last one, which is
+ * left for opening another connection. Listeners, which don't know their peer
+ * yet, reserve nothing.
+ *
+ * Chunks covering the window advertised last (gnrc_tcp_tcb_t::rcv_wnd, which
+ * appended data takes its part of) stay reserved, so a window once advertised
+ * can always be filled. Reservations beyond that and beyond the fair share are
+ * given back, e.g. once further connections were opened.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Receive window in bytes.
+ */
+uint16_t _gnrc_tcp_rcvbuf_get_wnd(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Get the fair share of the receive pool for a single receive buffer.
+ *
+ * @returns   Fair share in bytes, at most @ref GNRC_TCP_RCV_BUF_SIZE.
+ */
+size_t _gnrc_tcp_rcvbuf_get_share(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Selective acknowledgments (RFC 2018) for GNRC TCP.
+ *
+ * Segments received beyond a gap are kept until the gap is filled and are
+ * reported to the peer in SACK blocks. Without module `gnrc_tcp_sack` these
+ * segments are dropped and all functions are no-ops.
+ */
+
+#ifndef GNRC_TCP_SACK_H
+#define GNRC_TCP_SACK_H
+
+#include <stdint.h>
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_GNRC_TCP_SACK) || defined(DOXYGEN)
+/**
+ * @brief Gets the size of the SACK options of a segment.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ * @param[in] ctl   Control bits of the segment.
+ *
+ * @returns   Size of the SACK options in 32 bit words.
+ */
+uint8_t _gnrc_tcp_sack_opt_words(const gnrc_tcp_tcb_t *tcb, const uint16_t ctl);
+
+/**
+ * @brief Writes the SACK options of a segment.
+ *
+ * @param[in]  tcb   TCB holding the connection information.
+ * @param[in]  ctl   Control bits of the segment.
+ * @param[out] opt   Option field, must hold _gnrc_tcp_sack_opt_words() words.
+ */
+void _gnrc_tcp_sack_opt_build(const gnrc_tcp_tcb_t *tcb, const uint16_t ctl,
+                              uint8_t *opt);
+
+/**
+ * @brief Keeps a segment received beyond a gap.
+ *
+ * The segment is dropped, if there is no room left. Segments are kept even if
+ * the peer did not agree to SACK, the cumulative ACK still benefits.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     pkt       Received packet.
+ * @param[in]     seg_seq   Sequence number of the segment.
+ * @param[in]     pay_len   Payload length of the segment.
+ */
+void _gnrc_tcp_sack_store(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          const uint32_t seg_seq, const uint32_t pay_len);
+
+/**
+ * @brief Moves kept segments that are no longer beyond a gap to the receive
+ *        buffer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_sack_drain(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Releases all kept segments.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_sack_clear(gnrc_tcp_tcb_t *tcb);
+#else
+static inline uint8_t _gnrc_tcp_sack_opt_words(const gnrc_tcp_tcb_t *tcb,
+                                               const uint16_t ctl)
+{
+    (void)tcb;
+    (void)ctl;
+    return 0;
+}
+
+static inline void _gnrc_tcp_sack_opt_build(const gnrc_tcp_tcb_t *tcb,
+                                            const uint16_t ctl, uint8_t *opt)
+{
+    (void)tcb;
+    (void)ctl;
+    (void)opt;
+}
+
+static inline void _gnrc_tcp_sack_store(gnrc_tcp_tcb_t *tcb,
+                                        gnrc_pktsnip_t *pkt,
+                                        const uint32_t seg_seq,
+                                        const uint32_t pay_len)
+{
+    (void)tcb;
+    (void)pkt;
+    (void)seg_seq;
+    (void)pay_len;
+}
+
+static inline void _gnrc_tcp_sack_drain(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline void _gnrc_tcp_sack_clear(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_SACK_H */
+/** @} */
@@ -29,6 +29,7 @@
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6/error.h"
+#include "net/gnrc/pktprof.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG 0
@@ -237,6 +238,7 @@ static void *_event_loop(void *arg)
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+                gnrc_pktprof_stamp(msg.content.ptr, GNRC_PKTPROF_UDP);
                 _receive(msg.content.ptr);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_fib_hashed
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief   Maintenance of and lookups in the index of a FIB table
+ *
+ * The index only tracks the entries of a table. Entries are modified and
+ * removed by the FIB, which calls fib_hashed_update() resp.
+ * fib_hashed_sr_update() afterwards.
+ *
+ * @pre     fib_table_t::mtx_access of the table is locked for all functions.
+ */
+#ifndef PRIV_FIB_HASHED_H
+#define PRIV_FIB_HASHED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/fib/table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_FIB_HASHED) || defined(DOXYGEN)
+/**
+ * @brief   Checks if a table uses the hashed engine
+ *
+ * @param[in] table The table.
+ *
+ * @return  true, if @p table has an index.
+ */
+#define fib_hashed_active(table)    ((table)->hashed != NULL)
+
+/**
+ * @brief   Resets the index of a table
+ *
+ * @pre All entries of @p table are zeroed.
+ *
+ * @param[in] table The table.
+ */
+void fib_hashed_init(fib_table_t *table);
+
+/**
+ * @brief   Brings an entry of a single hop table into the index or updates it
+ *
+ * Entries with a lifetime of 0 are removed from the index.
+ *
+ * @param[in] table The table.
+ * @param[in] entry An entry of @p table.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, if the prefix length of @p entry cannot be indexed. The
+ *          entry is not in the index then.
+ */
+int fib_hashed_update(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief   Brings a source route into the index or updates it
+ *
+ * Source routes with a lifetime of 0 are removed from the index.
+ *
+ * @param[in] table The table.
+ * @param[in] sr    A source route of @p table.
+ */
+void fib_hashed_sr_update(fib_table_t *table, fib_sr_t *sr);
+
+/**
+ * @brief   Advances the expiry wheel of a table up to now
+ *
+ * @param[in] table The table.
+ *
+ * @return  Position of an expired entry or source route in @p table. The
+ *          caller has to remove it before calling this function again.
+ * @return  -1, if no entry expired.
+ */
+int fib_hashed_next_expired(fib_table_t *table);
+#else   /* MODULE_FIB_HASHED || defined(DOXYGEN) */
+#define fib_hashed_active(table)        ((void)(table), false)
+#define fib_hashed_init(table)          (void)(table)
+#define fib_hashed_sr_update(table, sr) ((void)(table), (void)(sr))
+#define fib_hashed_next_expired(table)  ((void)(table), -1)
+
+static inline int fib_hashed_update(fib_table_t *table, fib_entry_t *entry)
+{
+    (void)table;
+    (void)entry;
+    return 0;
+}
+#endif  /* MODULE_FIB_HASHED || defined(DOXYGEN) */
+
+/* The lookup functions don't make sense without an index. They are only
+ * called if fib_hashed_active() and are optimized out otherwise. */
+
+/**
+ * @brief   Looks up the best entry for a destination
+ *
+ * Same contract as fib_find_entry() in fib.c, apart from ties between
+ * matching prefixes being resolved in favor of the longest prefix.
+ *
+ * @param[in] table             The table.
+ * @param[in] dst               A destination address.
+ * @param[in] dst_size          Size of @p dst in bytes.
+ * @param[out] entry_arr        The best entry.
+ * @param[out] entry_arr_size   1, if an entry was found, 0 otherwise.
+ *
+ * @return  1, if an entry for exactly @p dst was found.
+ * @return  0, if an entry for a prefix of @p dst or a default route was found.
+ * @return  -EHOSTUNREACH, if no entry covers @p dst.
+ */
+int fib_hashed_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                          fib_entry_t **entry_arr, size_t *entry_arr_size);
+
+/**
+ * @brief   Looks up a source route to a destination
+ *
+ * Candidates are visited in the order of the source route headers, like the
+ * linear search does.
+ *
+ * @param[in] table         The table.
+ * @param[in] dst           A destination address.
+ * @param[in] dst_size      Size of @p dst in bytes.
+ * @param[in] sr_flags      The flags requested for the source route.
+ * @param[in] after         Only consider source routes behind this one. May
+ *                          be NULL.
+ * @param[out] other_flags  A source route to @p dst with flags other than
+ *                          @p sr_flags, if no route with @p sr_flags exists.
+ *
+ * @return  The first source route to @p dst with @p sr_flags.
+ * @return  NULL, if there is none.
+ */
+fib_sr_t *fib_hashed_sr_get(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                            uint32_t sr_flags, const fib_sr_t *after,
+                            fib_sr_t **other_flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_FIB_HASHED_H */
+/** @} */
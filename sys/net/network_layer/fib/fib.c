@@ -40,6 +40,8 @@
 #include "net/fib.h"
 #include "net/fib/table.h"
 
+#include "_fib-hashed.h"
+
 #ifdef MODULE_IPV6_ADDR
 #include "net/ipv6/addr.h"
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
@@ -68,6 +70,29 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+static int fib_sr_check_lifetime(fib_table_t *table, fib_sr_t *fib_sr);
+
+/**
+ * @brief removes all entries and source routes whose lifetime expired
+ *        from a table with an index, see @ref net_fib_hashed
+ *
+ * @param[in] table the FIB table to clean up
+ */
+static void fib_expire(fib_table_t *table)
+{
+    int pos;
+
+    while ((pos = fib_hashed_next_expired(table)) >= 0) {
+        if (table->table_type == FIB_TABLE_TYPE_SR) {
+            fib_sr_check_lifetime(table, &table->data.source_routes->headers[pos]);
+        }
+        else {
+            fib_remove(table, &table->data.entries[pos]);
+        }
+    }
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -84,6 +109,11 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
+    if (fib_hashed_active(table)) {
+        fib_expire(table);
+        return fib_hashed_find_entry(table, dst, dst_size, entry_arr, entry_arr_size);
+    }
+
     uint64_t now = xtimer_now_usec64();
 
     size_t count = 0;
@@ -196,6 +226,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -205,7 +236,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -225,6 +256,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
+    fib_hashed_update(table, entry);
 
     return 0;
 }
@@ -244,6 +276,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
  *
  * @return 0 on success
  *         -ENOMEM if no new entry can be created
+ *         -EINVAL if the table is indexed and cannot hold the prefix
  */
 static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *dst, size_t dst_size, uint32_t dst_flags,
@@ -272,6 +305,13 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                int res = fib_hashed_update(table, &table->data.entries[i]);
+
+                if (res < 0) {
+                    fib_remove(table, &table->data.entries[i]);
+                    return res;
+                }
+
                 return 0;
             }
         }
@@ -283,12 +323,17 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    /* drop the entry from the index while its destination is still intact */
+    entry->lifetime = 0;
+    fib_hashed_update(table, entry);
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -408,7 +453,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -438,7 +483,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -462,7 +507,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -482,7 +527,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -552,6 +597,8 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
 
+    fib_expire(table);
+
     for (size_t i = 0; i < table->size; ++i) {
         fib_entry_t *tmp = &table->data.entries[i];
         if ((tmp->global != NULL)
@@ -604,6 +651,7 @@ void fib_init(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    fib_hashed_init(table);
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -629,6 +677,7 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    fib_hashed_init(table);
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -664,6 +713,8 @@ int fib_get_num_used_entries(fib_table_t *table)
     mutex_lock(&(table->mtx_access));
     size_t used_entries = 0;
 
+    fib_expire(table);
+
     for (size_t i = 0; i < table->size; ++i) {
         used_entries += (size_t)(table->data.entries[i].global != NULL);
     }
@@ -695,6 +746,7 @@ int fib_sr_create(fib_table_t *table, fib_sr_t **fib_sr, kernel_pid_t sr_iface_i
             else {
                 table->data.source_routes->headers[i].sr_lifetime = FIB_LIFETIME_NO_EXPIRE;
             }
+            fib_hashed_sr_update(table, &table->data.source_routes->headers[i]);
             *fib_sr = &table->data.source_routes->headers[i];
             mutex_unlock(&(table->mtx_access));
             return 0;
@@ -709,18 +761,26 @@ int fib_sr_create(fib_table_t *table, fib_sr_t **fib_sr, kernel_pid_t sr_iface_i
 * @brief Internal function:
 *        checks the lifetime and removes the entry in case it expired
 */
-static int fib_sr_check_lifetime(fib_sr_t *fib_sr)
+static int fib_sr_check_lifetime(fib_table_t *table, fib_sr_t *fib_sr)
 {
+    if (fib_sr->sr_lifetime == FIB_LIFETIME_NO_EXPIRE) {
+        return 0;
+    }
+
     uint64_t tm = fib_sr->sr_lifetime - xtimer_now_usec64();
     /* check if the lifetime expired */
     if ((int64_t)tm < 0) {
         /* remove this sr if its lifetime expired */
         fib_sr->sr_lifetime = 0;
+        fib_hashed_sr_update(table, fib_sr);
 
         if (fib_sr->sr_path != NULL) {
-            fib_sr_entry_t *elt = NULL;
-            LL_FOREACH(fib_sr->sr_path, elt) {
+            fib_sr_entry_t *elt = NULL, *tmp = NULL;
+            LL_FOREACH_SAFE(fib_sr->sr_path, elt, tmp) {
+                /* give the entry back to the pool */
                 universal_address_rem(elt->address);
+                elt->address = NULL;
+                LL_DELETE(fib_sr->sr_path, elt);
             }
             fib_sr->sr_path = NULL;
         }
@@ -746,7 +806,7 @@ static int fib_sr_new_entry(fib_table_t *table, uint8_t *addr, size_t addr_size,
                 return -ENOMEM;
             }
             else {
-                (void)new_entry;
+                table->data.source_routes->entry_pool[i].next = NULL;
                 *new_entry = &table->data.source_routes->entry_pool[i];
                 return 0;
             }
@@ -779,7 +839,7 @@ int fib_sr_read_head(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *iface_i
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -802,7 +862,7 @@ int fib_sr_read_destination(fib_table_t *table, fib_sr_t *fib_sr,
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -830,7 +890,7 @@ int fib_sr_set(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *sr_iface_id,
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -845,6 +905,7 @@ int fib_sr_set(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *sr_iface_id,
 
     if (sr_lifetime != NULL) {
         fib_lifetime_to_absolute(*sr_lifetime, &(fib_sr->sr_lifetime));
+        fib_hashed_sr_update(table, fib_sr);
     }
 
     mutex_unlock(&(table->mtx_access));
@@ -860,6 +921,7 @@ int fib_sr_delete(fib_table_t *table, fib_sr_t *fib_sr)
     }
 
     fib_sr->sr_lifetime = 0;
+    fib_hashed_sr_update(table, fib_sr);
 
     if (fib_sr->sr_path != NULL) {
         fib_sr_entry_t *elt = NULL, *tmp = NULL;
@@ -889,7 +951,7 @@ int fib_sr_next(fib_table_t *table, fib_sr_t *fib_sr, fib_sr_entry_t **sr_path_e
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -923,7 +985,7 @@ int fib_sr_search(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, size_t ad
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -957,7 +1019,7 @@ int fib_sr_entry_append(fib_table_t *table, fib_sr_t *fib_sr,
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -986,6 +1048,7 @@ int fib_sr_entry_append(fib_table_t *table, fib_sr_t *fib_sr,
             fib_sr->sr_path = new_entry[0];
         }
         fib_sr->sr_dest = new_entry[0];
+        fib_hashed_sr_update(table, fib_sr);
     }
 
     mutex_unlock(&(table->mtx_access));
@@ -1003,7 +1066,7 @@ int fib_sr_entry_add(fib_table_t *table, fib_sr_t *fib_sr,
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -1042,6 +1105,7 @@ int fib_sr_entry_add(fib_table_t *table, fib_sr_t *fib_sr,
                 }
                 new_entry[0]->next = NULL;
                 fib_sr->sr_dest = new_entry[0];
+                fib_hashed_sr_update(table, fib_sr);
             }
         }
     }
@@ -1059,7 +1123,7 @@ int fib_sr_entry_delete(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, siz
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -1091,6 +1155,7 @@ int fib_sr_entry_delete(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, siz
                 /* if we remove the last entry we must adjust the destination */
                 fib_sr->sr_dest = tmp;
             }
+            fib_hashed_sr_update(table, fib_sr);
             mutex_unlock(&(table->mtx_access));
             return 0;
         }
@@ -1111,7 +1176,7 @@ int fib_sr_entry_overwrite(fib_table_t *table, fib_sr_t *fib_sr,
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -1147,6 +1212,7 @@ int fib_sr_entry_overwrite(fib_table_t *table, fib_sr_t *fib_sr,
             return -ENOMEM;
         }
         elt_repl->address = add;
+        fib_hashed_sr_update(table, fib_sr);
     }
 
     mutex_unlock(&(table->mtx_access));
@@ -1162,7 +1228,7 @@ int fib_sr_entry_get_address(fib_table_t *table, fib_sr_t *fib_sr, fib_sr_entry_
         return -EFAULT;
     }
 
-    if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
+    if (fib_sr_check_lifetime(table, fib_sr) == -ENOENT) {
         mutex_unlock(&(table->mtx_access));
         return -ENOENT;
     }
@@ -1264,6 +1330,7 @@ static fib_sr_t* _fib_create_sr_from_partial(fib_table_t *table, uint8_t *dst, s
                                         /* we copied until the destination */
                                         new_sr->sr_dest = new_entry;
                                         hit = new_sr;
+                                        fib_hashed_sr_update(table, new_sr);
 
                                         /* tell the RPs that a new sr has been created
                                          * the size and the flags parameters are ignored
@@ -1317,42 +1384,58 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
 
     bool skip = (fib_sr != NULL) && (*fib_sr != NULL)?true:false;
     /* Case 1 - check if we know a direct route */
-    for (size_t i = 0; i < table->size; ++i) {
-
-        if (fib_sr_check_lifetime(&table->data.source_routes->headers[i]) == -ENOENT) {
-            /* expired, so skip this sr and remember its position */
-            if (check_free_entry == -1) {
-                /* we want to fill up the source routes from the beginning */
-                check_free_entry = i;
-            }
-            continue;
-        }
-
-        if (skip) {
-            if (*fib_sr == &table->data.source_routes->headers[i]) {
-                skip = false;
+    if (fib_hashed_active(table)) {
+        fib_expire(table);
+        hit = fib_hashed_sr_get(table, dst, dst_size, *sr_flags,
+                                skip ? *fib_sr : NULL, &tmp_hit);
+        if (hit == NULL) {
+            /* remember the first free position for a partial route */
+            for (size_t i = 0; i < table->size; ++i) {
+                if (table->data.source_routes->headers[i].sr_lifetime == 0) {
+                    check_free_entry = i;
+                    break;
+                }
             }
-            /* we skip all entries upon the consecutive one to start search */
-            continue;
         }
+    }
+    else {
+        for (size_t i = 0; i < table->size; ++i) {
 
-        size_t addr_size_match = dst_size << 3;
-        if (universal_address_compare(table->data.source_routes->headers[i].sr_dest->address,
-                                      dst, &addr_size_match) == UNIVERSAL_ADDRESS_EQUAL) {
-            if (*sr_flags == table->data.source_routes->headers[i].sr_flags) {
-                /* found a perfect matching sr, no need to search further */
-                hit = &table->data.source_routes->headers[i];
-                tmp_hit = NULL;
+            if (fib_sr_check_lifetime(table, &table->data.source_routes->headers[i]) == -ENOENT) {
+                /* expired, so skip this sr and remember its position */
                 if (check_free_entry == -1) {
+                    /* we want to fill up the source routes from the beginning */
                     check_free_entry = i;
                 }
-                break;
+                continue;
             }
-            else {
-                /* found a sr to the destination but with different flags,
-                 * maybe we find a better one.
-                 */
-                tmp_hit = &table->data.source_routes->headers[i];
+
+            if (skip) {
+                if (*fib_sr == &table->data.source_routes->headers[i]) {
+                    skip = false;
+                }
+                /* we skip all entries upon the consecutive one to start search */
+                continue;
+            }
+
+            size_t addr_size_match = dst_size << 3;
+            if (universal_address_compare(table->data.source_routes->headers[i].sr_dest->address,
+                                          dst, &addr_size_match) == UNIVERSAL_ADDRESS_EQUAL) {
+                if (*sr_flags == table->data.source_routes->headers[i].sr_flags) {
+                    /* found a perfect matching sr, no need to search further */
+                    hit = &table->data.source_routes->headers[i];
+                    tmp_hit = NULL;
+                    if (check_free_entry == -1) {
+                        check_free_entry = i;
+                    }
+                    break;
+                }
+                else {
+                    /* found a sr to the destination but with different flags,
+                     * maybe we find a better one.
+                     */
+                    tmp_hit = &table->data.source_routes->headers[i];
+                }
             }
         }
     }
@@ -1379,6 +1462,7 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
              */
             if (hit != NULL) {
                 hit->sr_lifetime = 0;
+                fib_hashed_sr_update(table, hit);
 
                 if (hit->sr_path != NULL) {
                     fib_sr_entry_t *elt = NULL, *tmp = NULL;
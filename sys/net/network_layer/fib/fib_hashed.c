@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_fib_hashed
+ * @{
+ *
+ * @file
+ * @brief       Hash index and lifetime expiry wheel for FIB tables
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "net/fib/table.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "_fib-hashed.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#ifdef MODULE_FIB_HASHED
+
+/**
+ * @brief   Marks the end of a hash chain or wheel slot
+ */
+#define _NONE           (UINT16_MAX)
+
+/**
+ * @name    Hash chains an entry can be in
+ *
+ * An entry is identified in a hash chain by `(position << 1) | chain`.
+ * @{
+ */
+#define _EXACT          (0U)    /**< hashed by full destination address */
+#define _PFX            (1U)    /**< hashed by destination masked to prefix */
+/** @} */
+
+/**
+ * @name    Flags of fib_hashed_link_t::flags
+ * @{
+ */
+#define _FLAG_EXACT     (1U << _EXACT)
+#define _FLAG_PFX       (1U << _PFX)
+#define _FLAG_WHEEL     (0x4U)
+/** @} */
+
+#define _TICK_US        ((uint64_t)CONFIG_FIB_HASHED_WHEEL_TICK_MS * US_PER_MS)
+
+static_assert(CONFIG_FIB_HASHED_WHEEL_SIZE <= (UINT8_MAX + 1),
+              "CONFIG_FIB_HASHED_WHEEL_SIZE too large");
+
+static inline bool _is_sr(const fib_table_t *table)
+{
+    return table->table_type == FIB_TABLE_TYPE_SR;
+}
+
+static fib_hashed_link_t *_link(fib_table_t *table, unsigned idx)
+{
+    if (_is_sr(table)) {
+        return &table->data.source_routes->headers[idx].hashed;
+    }
+    return &table->data.entries[idx].hashed;
+}
+
+static uint64_t _lifetime(fib_table_t *table, unsigned idx)
+{
+    if (_is_sr(table)) {
+        return table->data.source_routes->headers[idx].sr_lifetime;
+    }
+    return table->data.entries[idx].lifetime;
+}
+
+static universal_address_container_t *_key(fib_table_t *table, unsigned idx)
+{
+    if (_is_sr(table)) {
+        fib_sr_entry_t *dest = table->data.source_routes->headers[idx].sr_dest;
+
+        return (dest != NULL) ? dest->address : NULL;
+    }
+    return table->data.entries[idx].global;
+}
+
+static unsigned _pfx_len(fib_table_t *table, unsigned idx)
+{
+    return (table->data.entries[idx].global_flags & FIB_FLAG_NET_PREFIX_MASK)
+           >> FIB_FLAG_NET_PREFIX_SHIFT;
+}
+
+static inline uint8_t _mask(unsigned pfx_len)
+{
+    return (uint8_t)(0xff << (8 - (pfx_len % 8)));
+}
+
+/* FNV-1a over the first pfx_len bits of addr */
+static uint16_t _bucket(const fib_hashed_t *hashed, const uint8_t *addr,
+                        size_t addr_size, unsigned pfx_len)
+{
+    uint32_t hash = 2166136261U;
+    unsigned bytes = pfx_len / 8;
+
+    for (unsigned i = 0; i < bytes; i++) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+    if (pfx_len % 8) {
+        hash = (hash ^ (addr[bytes] & _mask(pfx_len))) * 16777619U;
+    }
+    hash = (hash ^ addr_size) * 16777619U;
+    hash = (hash ^ pfx_len) * 16777619U;
+    return hash % hashed->buckets_numof;
+}
+
+static bool _pfx_equal(const uint8_t *a, const uint8_t *b, unsigned pfx_len)
+{
+    unsigned bytes = pfx_len / 8;
+
+    if (memcmp(a, b, bytes) != 0) {
+        return false;
+    }
+    return ((pfx_len % 8) == 0) || (((a[bytes] ^ b[bytes]) & _mask(pfx_len)) == 0);
+}
+
+static bool _is_all_zero(const universal_address_container_t *addr)
+{
+    for (unsigned i = 0; i < addr->address_size; i++) {
+        if (addr->address[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int _pfx_len_add(fib_hashed_t *hashed, unsigned pfx_len)
+{
+    unsigned i = 0;
+
+    while ((i < hashed->pfx_len_numof) && (hashed->pfx_len[i] > pfx_len)) {
+        i++;
+    }
+    if ((i < hashed->pfx_len_numof) && (hashed->pfx_len[i] == pfx_len)) {
+        hashed->pfx_len_users[i]++;
+        return 0;
+    }
+    if (hashed->pfx_len_numof == CONFIG_FIB_HASHED_PFX_LEN_NUMOF) {
+        DEBUG("fib_hashed: no space for prefix length %u\n", pfx_len);
+        return -ENOMEM;
+    }
+    memmove(&hashed->pfx_len[i + 1], &hashed->pfx_len[i],
+            (hashed->pfx_len_numof - i) * sizeof(hashed->pfx_len[0]));
+    memmove(&hashed->pfx_len_users[i + 1], &hashed->pfx_len_users[i],
+            (hashed->pfx_len_numof - i) * sizeof(hashed->pfx_len_users[0]));
+    hashed->pfx_len[i] = pfx_len;
+    hashed->pfx_len_users[i] = 1;
+    hashed->pfx_len_numof++;
+    return 0;
+}
+
+static void _pfx_len_remove(fib_hashed_t *hashed, unsigned pfx_len)
+{
+    unsigned i = 0;
+
+    while (hashed->pfx_len[i] != pfx_len) {
+        i++;
+        assert(i < hashed->pfx_len_numof);
+    }
+    if (--hashed->pfx_len_users[i] > 0) {
+        return;
+    }
+    hashed->pfx_len_numof--;
+    memmove(&hashed->pfx_len[i], &hashed->pfx_len[i + 1],
+            (hashed->pfx_len_numof - i) * sizeof(hashed->pfx_len[0]));
+    memmove(&hashed->pfx_len_users[i], &hashed->pfx_len_users[i + 1],
+            (hashed->pfx_len_numof - i) * sizeof(hashed->pfx_len_users[0]));
+}
+
+static void _chain_add(fib_table_t *table, unsigned idx, unsigned chain,
+                       uint16_t bucket)
+{
+    fib_hashed_link_t *link = _link(table, idx);
+    uint16_t *ptr = &table->hashed->buckets[bucket];
+
+    /* keep ordered by position so lookups resolve ties like the linear
+     * search would */
+    while ((*ptr != _NONE) && ((unsigned)(*ptr >> 1) < idx)) {
+        ptr = &_link(table, *ptr >> 1)->hash_next[*ptr & 1];
+    }
+    link->hash_next[chain] = *ptr;
+    link->bucket[chain] = bucket;
+    link->flags |= (1U << chain);
+    *ptr = (idx << 1) | chain;
+}
+
+static void _chain_remove(fib_table_t *table, unsigned idx, unsigned chain)
+{
+    fib_hashed_link_t *link = _link(table, idx);
+    uint16_t *ptr = &table->hashed->buckets[link->bucket[chain]];
+    uint16_t node = (idx << 1) | chain;
+
+    while (*ptr != node) {
+        assert(*ptr != _NONE);
+        ptr = &_link(table, *ptr >> 1)->hash_next[*ptr & 1];
+    }
+    *ptr = link->hash_next[chain];
+    link->flags &= ~(1U << chain);
+}
+
+/* The slots are lists like the DL lists of utlist.h: the previous entry of
+ * the head is the tail, the next entry of the tail is _NONE. */
+static void _wheel_add(fib_table_t *table, unsigned idx)
+{
+    fib_hashed_link_t *link = _link(table, idx);
+    uint64_t lifetime = _lifetime(table, idx);
+    uint8_t slot = (lifetime / _TICK_US) % CONFIG_FIB_HASHED_WHEEL_SIZE;
+    uint16_t head = table->hashed->wheel[slot];
+    uint16_t pos;
+
+    link->wheel_slot = slot;
+    link->flags |= _FLAG_WHEEL;
+    if (head == _NONE) {
+        link->wheel_next = _NONE;
+        link->wheel_prev = idx;
+        table->hashed->wheel[slot] = idx;
+        return;
+    }
+    /* keep slot ordered by lifetime, so only its head needs to be checked
+     * for expiry. Entries are mostly added with the latest lifetime, so
+     * search from the tail. */
+    pos = _link(table, head)->wheel_prev;
+    while (_lifetime(table, pos) > lifetime) {
+        if (pos == head) {
+            /* new head */
+            link->wheel_next = head;
+            link->wheel_prev = _link(table, head)->wheel_prev;
+            _link(table, head)->wheel_prev = idx;
+            table->hashed->wheel[slot] = idx;
+            return;
+        }
+        pos = _link(table, pos)->wheel_prev;
+    }
+    link->wheel_next = _link(table, pos)->wheel_next;
+    link->wheel_prev = pos;
+    if (link->wheel_next != _NONE) {
+        _link(table, link->wheel_next)->wheel_prev = idx;
+    }
+    else {
+        /* new tail */
+        _link(table, head)->wheel_prev = idx;
+    }
+    _link(table, pos)->wheel_next = idx;
+}
+
+static void _wheel_remove(fib_table_t *table, unsigned idx)
+{
+    fib_hashed_link_t *link = _link(table, idx);
+    uint16_t *head = &table->hashed->wheel[link->wheel_slot];
+
+    if (*head == idx) {
+        *head = link->wheel_next;
+    }
+    else {
+        _link(table, link->wheel_prev)->wheel_next = link->wheel_next;
+    }
+    if (link->wheel_next != _NONE) {
+        _link(table, link->wheel_next)->wheel_prev = link->wheel_prev;
+    }
+    else if (*head != _NONE) {
+        /* idx was the tail */
+        _link(table, *head)->wheel_prev = link->wheel_prev;
+    }
+    link->flags &= ~_FLAG_WHEEL;
+}
+
+static void _unlink(fib_table_t *table, unsigned idx)
+{
+    fib_hashed_link_t *link = _link(table, idx);
+
+    if (link->flags & _FLAG_WHEEL) {
+        _wheel_remove(table, idx);
+    }
+    if (link->flags & _FLAG_EXACT) {
+        _chain_remove(table, idx, _EXACT);
+    }
+    if (link->flags & _FLAG_PFX) {
+        _chain_remove(table, idx, _PFX);
+        _pfx_len_remove(table->hashed, _pfx_len(table, idx));
+    }
+}
+
+static int _update(fib_table_t *table, unsigned idx)
+{
+    fib_hashed_t *hashed = table->hashed;
+    uint64_t lifetime = _lifetime(table, idx);
+    universal_address_container_t *key = _key(table, idx);
+
+    _unlink(table, idx);
+    if (lifetime == 0) {
+        return 0;
+    }
+    if (lifetime != FIB_LIFETIME_NO_EXPIRE) {
+        _wheel_add(table, idx);
+    }
+    if (key == NULL) {
+        return 0;
+    }
+    _chain_add(table, idx, _EXACT,
+               _bucket(hashed, key->address, key->address_size,
+                       key->address_size << 3));
+    if (!_is_sr(table)) {
+        unsigned pfx_len = _pfx_len(table, idx);
+
+        /* all-zero destinations are default routes and only need to be
+         * found by their exact address */
+        if ((pfx_len == 0) || (pfx_len >= (key->address_size * 8U)) ||
+            _is_all_zero(key)) {
+            return 0;
+        }
+        if (_pfx_len_add(hashed, pfx_len) < 0) {
+            _unlink(table, idx);
+            return -ENOMEM;
+        }
+        _chain_add(table, idx, _PFX,
+                   _bucket(hashed, key->address, key->address_size, pfx_len));
+    }
+    return 0;
+}
+
+void fib_hashed_init(fib_table_t *table)
+{
+    fib_hashed_t *hashed = table->hashed;
+
+    if (hashed == NULL) {
+        return;
+    }
+    /* positions are stored shifted by one in the hash chains */
+    assert(table->size < (_NONE >> 1));
+    assert(hashed->buckets_numof > 0);
+    for (unsigned i = 0; i < hashed->buckets_numof; i++) {
+        hashed->buckets[i] = _NONE;
+    }
+    for (unsigned i = 0; i < CONFIG_FIB_HASHED_WHEEL_SIZE; i++) {
+        hashed->wheel[i] = _NONE;
+    }
+    hashed->pfx_len_numof = 0;
+    hashed->wheel_tick = xtimer_now_usec64() / _TICK_US;
+}
+
+int fib_hashed_update(fib_table_t *table, fib_entry_t *entry)
+{
+    if (table->hashed == NULL) {
+        return 0;
+    }
+    return _update(table, entry - table->data.entries);
+}
+
+void fib_hashed_sr_update(fib_table_t *table, fib_sr_t *sr)
+{
+    if (table->hashed == NULL) {
+        return;
+    }
+    _update(table, sr - table->data.source_routes->headers);
+}
+
+int fib_hashed_next_expired(fib_table_t *table)
+{
+    fib_hashed_t *hashed = table->hashed;
+
+    if (hashed == NULL) {
+        return -1;
+    }
+
+    uint64_t now = xtimer_now_usec64();
+    uint64_t tick = now / _TICK_US;
+
+    if ((tick - hashed->wheel_tick) >= CONFIG_FIB_HASHED_WHEEL_SIZE) {
+        /* a full turn of the wheel visits every slot anyway */
+        hashed->wheel_tick = tick - (CONFIG_FIB_HASHED_WHEEL_SIZE - 1);
+    }
+    while (1) {
+        uint16_t idx = hashed->wheel[hashed->wheel_tick % CONFIG_FIB_HASHED_WHEEL_SIZE];
+
+        if ((idx != _NONE) && (_lifetime(table, idx) < now)) {
+            DEBUG("fib_hashed: entry %u expired\n", idx);
+            return idx;
+        }
+        if (hashed->wheel_tick == tick) {
+            /* the current slot may still contain entries that expire
+             * within this tick, so don't move on */
+            return -1;
+        }
+        hashed->wheel_tick++;
+    }
+}
+
+static int _lookup(fib_table_t *table, unsigned chain, const uint8_t *addr,
+                   size_t addr_size, unsigned pfx_len)
+{
+    uint16_t node = table->hashed->buckets[_bucket(table->hashed, addr,
+                                                   addr_size, pfx_len)];
+
+    while (node != _NONE) {
+        unsigned idx = node >> 1;
+        universal_address_container_t *key = _key(table, idx);
+
+        if (((node & 1) == chain) && (key->address_size == addr_size)) {
+            if ((chain == _EXACT) && (memcmp(key->address, addr, addr_size) == 0)) {
+                return idx;
+            }
+            if ((chain == _PFX) && (_pfx_len(table, idx) == pfx_len) &&
+                _pfx_equal(key->address, addr, pfx_len)) {
+                return idx;
+            }
+        }
+        node = _link(table, idx)->hash_next[node & 1];
+    }
+    return -1;
+}
+
+int fib_hashed_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                          fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    static const uint8_t zero[UNIVERSAL_ADDRESS_SIZE];
+    fib_hashed_t *hashed = table->hashed;
+    unsigned dst_len = dst_size << 3;
+    int idx;
+
+    if ((idx = _lookup(table, _EXACT, dst, dst_size, dst_len)) >= 0) {
+        entry_arr[0] = &table->data.entries[idx];
+        *entry_arr_size = 1;
+        return 1;
+    }
+    for (unsigned i = 0; i < hashed->pfx_len_numof; i++) {
+        if ((hashed->pfx_len[i] < dst_len) &&
+            ((idx = _lookup(table, _PFX, dst, dst_size, hashed->pfx_len[i])) >= 0)) {
+            DEBUG("fib_hashed: found /%u prefix\n", hashed->pfx_len[i]);
+            entry_arr[0] = &table->data.entries[idx];
+            *entry_arr_size = 1;
+            return 0;
+        }
+    }
+    if ((dst_size <= sizeof(zero)) &&
+        ((idx = _lookup(table, _EXACT, zero, dst_size, dst_len)) >= 0)) {
+        DEBUG("fib_hashed: found default route\n");
+        entry_arr[0] = &table->data.entries[idx];
+        *entry_arr_size = 1;
+        return 0;
+    }
+    *entry_arr_size = 0;
+    return -EHOSTUNREACH;
+}
+
+fib_sr_t *fib_hashed_sr_get(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                            uint32_t sr_flags, const fib_sr_t *after,
+                            fib_sr_t **other_flags)
+{
+    fib_sr_t *headers = table->data.source_routes->headers;
+    unsigned first = 0;
+    uint16_t node;
+
+    *other_flags = NULL;
+    if (after != NULL) {
+        if (after->sr_lifetime == 0) {
+            /* the linear search never finds where to continue either */
+            return NULL;
+        }
+        first = (after - headers) + 1;
+    }
+    node = table->hashed->buckets[_bucket(table->hashed, dst, dst_size,
+                                          dst_size << 3)];
+    while (node != _NONE) {
+        unsigned idx = node >> 1;
+        universal_address_container_t *key = _key(table, idx);
+
+        if ((idx >= first) && (key->address_size == dst_size) &&
+            (memcmp(key->address, dst, dst_size) == 0)) {
+            if (headers[idx].sr_flags == sr_flags) {
+                *other_flags = NULL;
+                return &headers[idx];
+            }
+            *other_flags = &headers[idx];
+        }
+        node = _link(table, idx)->hash_next[node & 1];
+    }
+    return NULL;
+}
+
+#else   /* MODULE_FIB_HASHED */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_FIB_HASHED */
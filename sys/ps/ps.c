@@ -29,6 +29,14 @@
 #include "ztimer.h"
 #endif
 
+#ifdef MODULE_MALLOC_THREAD_CACHE
+#include "malloc_thread_cache.h"
+#endif
+
+#ifdef MODULE_STACK_MONITOR
+#include "stack_monitor.h"
+#endif
+
 #ifdef MODULE_TLSF_MALLOC
 #include "tlsf.h"
 #include "tlsf-malloc.h"
@@ -53,6 +61,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches  | runtime_usec "
+#endif
+#ifdef MODULE_MALLOC_THREAD_CACHE
+           "| allocs   | frees    | hits     "
 #endif
            "\n",
 #ifdef CONFIG_THREAD_NAMES
@@ -97,7 +108,17 @@ void ps(void)
 #ifdef DEVELHELP
             int stacksz = thread_get_stacksize(p);                          /* get stack size */
             overall_stacksz += stacksz;
+            char stack_alarm = ' ';
+#ifdef MODULE_STACK_MONITOR
+            stack_monitor_info_t stack;
+            stack_monitor_get(i, &stack);
+            int stack_free = stacksz - stack.peak;
+            if (stack.alarm) {
+                stack_alarm = '!';
+            }
+#else
             int stack_free = thread_measure_stack_free(thread_get_stackstart(p));
+#endif
             stacksz -= stack_free;
             overall_used += stacksz;
 #endif
@@ -108,6 +129,10 @@ void ps(void)
             unsigned runtime_major = runtime_us / rt_sum;
             unsigned runtime_minor = ((runtime_us % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+#endif
+#ifdef MODULE_MALLOC_THREAD_CACHE
+            malloc_thread_cache_stats_t heap;
+            malloc_thread_cache_stats(i, &heap);
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef CONFIG_THREAD_NAMES
@@ -115,10 +140,13 @@ void ps(void)
 #endif
                    " | %-8s %.1s | %3i"
 #ifdef DEVELHELP
-                   " | %6" PRIu32 " (%5i) (%5i) | %10p | %10p "
+                   " | %6" PRIu32 " (%5i)%c(%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u  | %10"PRIu32" "
+#endif
+#ifdef MODULE_MALLOC_THREAD_CACHE
+                   " | %8" PRIu32 " | %8" PRIu32 " | %8" PRIu32 " "
 #endif
                    "\n",
                    thread_getpid_of(p),
@@ -127,11 +155,15 @@ void ps(void)
 #endif
                    sname, queued, thread_get_priority(p)
 #ifdef DEVELHELP
-                   , (uint32_t)thread_get_stacksize(p), stacksz, stack_free,
+                   , (uint32_t)thread_get_stacksize(p), stacksz, stack_alarm,
+                   stack_free,
                    thread_get_stackstart(p), thread_get_sp(p)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches, ztimer_us
+#endif
+#ifdef MODULE_MALLOC_THREAD_CACHE
+                   , heap.allocs, heap.frees, heap.hits
 #endif
                   );
         }
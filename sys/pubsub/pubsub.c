@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_pubsub
+ * @{
+ *
+ * @file
+ * @brief       Topic based publish/subscribe implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "irq.h"
+#include "pubsub.h"
+#include "ztimer.h"
+
+static_assert((CONFIG_PUBSUB_BUCKETS & (CONFIG_PUBSUB_BUCKETS - 1)) == 0,
+              "CONFIG_PUBSUB_BUCKETS must be a power of two");
+
+static list_node_t *_bucket(pubsub_bus_t *bus, pubsub_topic_t topic)
+{
+    return &bus->buckets[topic & (CONFIG_PUBSUB_BUCKETS - 1)];
+}
+
+/* must be called with interrupts disabled */
+static bool _queue(pubsub_sub_t *sub, const pubsub_event_t *event)
+{
+    int pos = cib_put(&sub->cib);
+
+    if (pos < 0) {
+        sub->stats.dropped++;
+        if (sub->drop == PUBSUB_DROP_NEWEST) {
+            return false;
+        }
+        cib_get_unsafe(&sub->cib);
+        pos = cib_put_unsafe(&sub->cib);
+    }
+
+    sub->queue[pos] = *event;
+    return true;
+}
+
+void pubsub_bus_init(pubsub_bus_t *bus)
+{
+    memset(bus, 0, sizeof(*bus));
+}
+
+void pubsub_sub_init(pubsub_sub_t *sub, pubsub_event_t *queue,
+                     unsigned queue_size, pubsub_drop_t drop,
+                     thread_flags_t flag)
+{
+    memset(sub, 0, sizeof(*sub));
+    sub->thread = thread_get_active();
+    sub->queue = queue;
+    cib_init(&sub->cib, queue_size);
+    sub->flag = flag;
+    sub->drop = drop;
+}
+
+void pubsub_subscribe(pubsub_bus_t *bus, pubsub_subscription_t *subscription,
+                      pubsub_sub_t *sub, pubsub_topic_t topic,
+                      pubsub_filter_t filter, void *filter_arg)
+{
+    subscription->topic = topic;
+    subscription->sub = sub;
+    subscription->filter = filter;
+    subscription->filter_arg = filter_arg;
+
+    unsigned state = irq_disable();
+    list_add(_bucket(bus, topic), &subscription->next);
+    irq_restore(state);
+}
+
+void pubsub_unsubscribe(pubsub_bus_t *bus,
+                        pubsub_subscription_t *subscription)
+{
+    unsigned state = irq_disable();
+    list_remove(_bucket(bus, subscription->topic), &subscription->next);
+    irq_restore(state);
+}
+
+unsigned pubsub_publish(pubsub_bus_t *bus, pubsub_topic_t topic,
+                        const void *arg)
+{
+    const pubsub_event_t event = {
+        .topic = topic,
+        .arg = arg,
+        .time = ztimer_now(ZTIMER_USEC),
+    };
+    unsigned count = 0;
+
+    unsigned state = irq_disable();
+
+    for (list_node_t *e = _bucket(bus, topic)->next; e; e = e->next) {
+        pubsub_subscription_t *subscription =
+            container_of(e, pubsub_subscription_t, next);
+
+        if ((subscription->topic != topic)
+            || (subscription->filter
+                && !subscription->filter(&event, subscription->filter_arg))) {
+            continue;
+        }
+
+        pubsub_sub_t *sub = subscription->sub;
+
+        if (_queue(sub, &event)) {
+            /* yield only once after all subscribers got the event */
+            sub->thread->flags |= sub->flag;
+            thread_flags_wake(sub->thread);
+            count++;
+        }
+    }
+
+    irq_restore(state);
+
+    if (sched_context_switch_request && !irq_is_in()) {
+        thread_yield_higher();
+    }
+
+    return count;
+}
+
+bool pubsub_try_receive(pubsub_sub_t *sub, pubsub_event_t *event)
+{
+    unsigned state = irq_disable();
+    int pos = cib_get(&sub->cib);
+
+    if (pos < 0) {
+        irq_restore(state);
+        return false;
+    }
+
+    *event = sub->queue[pos];
+
+    uint32_t latency = ztimer_now(ZTIMER_USEC) - event->time;
+
+    sub->stats.received++;
+    sub->stats.latency_sum += latency;
+    if (latency > sub->stats.latency_max) {
+        sub->stats.latency_max = latency;
+    }
+    irq_restore(state);
+
+    return true;
+}
+
+void pubsub_receive(pubsub_sub_t *sub, pubsub_event_t *event)
+{
+    assert(sub->thread == thread_get_active());
+
+    /* the flag is set after queuing, so checking the queue first does not
+     * miss an event */
+    while (!pubsub_try_receive(sub, event)) {
+        thread_flags_wait_any(sub->flag);
+    }
+}
+
+void pubsub_sub_stats(const pubsub_sub_t *sub, pubsub_sub_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = sub->stats;
+    irq_restore(state);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_edf
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "sched_edf.h"
+#include "thread.h"
+#include "ztimer.h"
+
+/* a deadline that happens to be 0 must not be taken for none, so it is moved
+ * by 1 us */
+static void _set_deadline(thread_t *thread, uint32_t deadline)
+{
+    if (deadline == SCHED_EDF_NO_DEADLINE) {
+        deadline++;
+    }
+    sched_set_deadline(thread, deadline);
+}
+
+void sched_edf_task_init(sched_edf_task_t *task, uint32_t period,
+                         uint32_t deadline)
+{
+    assert((deadline > 0) && (deadline <= period));
+
+    thread_t *me = thread_get_active();
+
+    task->period = period;
+    task->deadline = deadline;
+    task->jobs = 0;
+    task->misses = 0;
+    task->release = ztimer_now(ZTIMER_USEC);
+
+    _set_deadline(me, task->release + deadline);
+    sched_change_priority(me, CONFIG_SCHED_EDF_PRIO);
+}
+
+void sched_edf_task_wait(sched_edf_task_t *task)
+{
+    thread_t *me = thread_get_active();
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+    uint32_t next = task->release + task->period;
+
+    task->jobs++;
+    if (now - task->release > task->deadline) {
+        task->misses++;
+    }
+
+    /* the deadline is set before sleeping, so that the timeout inserts the
+     * thread at the right position of the runqueue */
+    _set_deadline(me, next + task->deadline);
+    ztimer_periodic_wakeup(ZTIMER_USEC, &task->release, task->period);
+
+    if (task->release != next) {
+        /* more than a period late, ztimer_periodic_wakeup() restarted the
+         * period */
+        _set_deadline(me, task->release + task->deadline);
+    }
+
+    /* if the job was released without sleeping, a thread with an earlier
+     * deadline may be pending */
+    sched_switch(CONFIG_SCHED_EDF_PRIO);
+}
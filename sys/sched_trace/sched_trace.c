@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_trace
+ * @{
+ *
+ * @file
+ * @brief       Scheduler trace recorder implementation
+ *
+ * An ISR preempting the recording of an event claims the next slot, so the
+ * events are not necessarily in the order of their timestamps. The
+ * conversion script sorts them by time.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "msg.h"
+#include "sched_trace.h"
+#include "thread.h"
+#include "ztimer.h"
+
+/* version of the dump format */
+#define DUMP_VERSION            (1)
+#define DUMP_EVENTS_PER_LINE    (4U)
+
+static_assert((CONFIG_SCHED_TRACE_NUMOF & (CONFIG_SCHED_TRACE_NUMOF - 1)) == 0,
+              "CONFIG_SCHED_TRACE_NUMOF must be a power of two");
+
+static sched_trace_entry_t _events[CONFIG_SCHED_TRACE_NUMOF];
+static atomic_uint _pos;
+static atomic_bool _started;
+
+void sched_trace_record(sched_trace_event_t event, uint16_t arg,
+                        uint32_t data)
+{
+    if (!atomic_load_explicit(&_started, memory_order_relaxed)) {
+        return;
+    }
+
+    unsigned pos = atomic_fetch_add_explicit(&_pos, 1, memory_order_relaxed);
+    sched_trace_entry_t *entry = &_events[pos % CONFIG_SCHED_TRACE_NUMOF];
+
+    entry->time = ztimer_now(ZTIMER_USEC);
+    entry->event = event | (irq_is_in() ? SCHED_TRACE_IN_ISR : 0);
+    entry->pid = thread_getpid();
+    entry->arg = arg;
+    entry->data = data;
+}
+
+void sched_trace_start(void)
+{
+    atomic_store(&_started, true);
+}
+
+void sched_trace_stop(void)
+{
+    atomic_store(&_started, false);
+}
+
+void sched_trace_reset(void)
+{
+    atomic_store(&_pos, 0);
+}
+
+void sched_trace_dump(void)
+{
+    sched_trace_stop();
+
+    unsigned end = atomic_load(&_pos);
+    unsigned lost = (end > CONFIG_SCHED_TRACE_NUMOF)
+                  ? end - CONFIG_SCHED_TRACE_NUMOF : 0;
+
+    printf("sched_trace: begin %u %u %u %" PRIkernel_pid "\n", DUMP_VERSION,
+           end - lost, lost, (kernel_pid_t)KERNEL_PID_ISR);
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        if (thread_get(pid)) {
+            const char *name = thread_getname(pid);
+
+            printf("sched_trace: thread %" PRIkernel_pid " %s\n", pid,
+                   name ? name : "-");
+        }
+    }
+
+    for (unsigned pos = lost; pos < end; pos++) {
+        const sched_trace_entry_t *entry =
+            &_events[pos % CONFIG_SCHED_TRACE_NUMOF];
+
+        if ((pos - lost) % DUMP_EVENTS_PER_LINE == 0) {
+            printf("%ssched_trace: events", (pos == lost) ? "" : "\n");
+        }
+        printf(" %08" PRIx32 "%02x%02x%04x%08" PRIx32, entry->time,
+               entry->event, entry->pid, entry->arg, entry->data);
+    }
+    if (end != lost) {
+        puts("");
+    }
+
+    puts("sched_trace: end");
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the DNS cache
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/dns/cache.h"
+#include "shell.h"
+
+static int _dns_cache_handler(int argc, char **argv)
+{
+    if (argc == 1) {
+        dns_cache_stats_t stats;
+
+        dns_cache_get_stats(&stats);
+        printf("DNS cache: hits=%" PRIu32 " neg_hits=%" PRIu32
+               " misses=%" PRIu32 " evictions=%" PRIu32 "\n",
+               stats.hits, stats.neg_hits, stats.misses, stats.evictions);
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "flush") == 0)) {
+        dns_cache_flush();
+    }
+    else {
+        printf("usage: %s [flush]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
+
+SHELL_COMMAND(dns_cache, "Print DNS cache statistics or flush the cache",
+              _dns_cache_handler);
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the latency of priority event queues
+ *
+ * @}
+ */
+
+#include "event/prio.h"
+#include "shell.h"
+
+static int _event_prio_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    event_prio_print_stats();
+    return 0;
+}
+
+SHELL_COMMAND(evprio, "Print latency of priority event queues",
+              _event_prio_handler);
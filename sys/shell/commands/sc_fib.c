@@ -125,8 +125,10 @@ static void _fib_add(const char *dest, const char *next, kernel_pid_t pid, uint3
     }
 
     dst_flags |= (prefix << FIB_FLAG_NET_PREFIX_SHIFT);
-    fib_add_entry(&gnrc_ipv6_fib_table, pid, dst, dst_size, dst_flags, nxt,
-                  nxt_size, nxt_flags, lifetime);
+    if (fib_add_entry(&gnrc_ipv6_fib_table, pid, dst, dst_size, dst_flags, nxt,
+                      nxt_size, nxt_flags, lifetime) < 0) {
+        puts("\nfailed to add the entry");
+    }
 }
 
 int _fib_route_handler(int argc, char **argv)
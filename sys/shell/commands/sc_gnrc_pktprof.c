@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for GNRC packet profiling
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pktprof.h"
+#include "shell.h"
+
+static int _gnrc_pktprof_handler(int argc, char **argv)
+{
+    if (argc == 1) {
+        gnrc_pktprof_print(false);
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "json") == 0)) {
+        gnrc_pktprof_print(true);
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+        gnrc_pktprof_reset();
+    }
+    else {
+        printf("usage: %s [json|reset]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
+
+SHELL_COMMAND(pktprof, "Print latency of received packets per GNRC stage",
+              _gnrc_pktprof_handler);
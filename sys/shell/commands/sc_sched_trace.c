@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the scheduler trace recorder
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sched_trace.h"
+#include "shell.h"
+
+static int _sched_trace_handler(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("usage: %s {start|stop|reset|dump}\n", argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "start") == 0) {
+        sched_trace_start();
+    }
+    else if (strcmp(argv[1], "stop") == 0) {
+        sched_trace_stop();
+    }
+    else if (strcmp(argv[1], "reset") == 0) {
+        sched_trace_reset();
+    }
+    else if (strcmp(argv[1], "dump") == 0) {
+        sched_trace_dump();
+    }
+    else {
+        printf("usage: %s {start|stop|reset|dump}\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
+
+SHELL_COMMAND(schedtrace, "Record scheduler events", _sched_trace_handler);
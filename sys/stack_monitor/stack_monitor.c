@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_stack_monitor
+ * @{
+ *
+ * @file
+ * @brief       Stack usage monitor implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "irq.h"
+#include "stack_monitor.h"
+#include "thread.h"
+
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
+
+#ifndef DEVELHELP
+#error "stack_monitor requires DEVELHELP"
+#endif
+
+/**
+ * @brief   Watermark of a thread
+ */
+typedef struct {
+    const thread_t *thread;     /**< thread the watermark belongs to */
+    const char *mark;           /**< lowest stack address known to be used */
+    const char *scan;           /**< next word to check below mark */
+    bool painted;               /**< stack was painted on creation */
+    bool alarm;                 /**< alarm was raised for the thread */
+} _watermark_t;
+
+static _watermark_t _marks[KERNEL_PID_LAST + 1];
+static stack_monitor_alarm_cb_t _alarm_cb;
+
+static uint32_t _usage(const thread_t *thread, const char *mark)
+{
+    return thread->stack_size - (mark - thread->stack_start);
+}
+
+/* must be called with IRQs disabled */
+static void _update(const thread_t *thread, const char *sp)
+{
+    _watermark_t *wm = &_marks[thread->pid];
+
+    /* Stacks are aligned to words by thread_create(), so silence
+     * -Wcast-align */
+    const uintptr_t *end = (const uintptr_t *)(uintptr_t)thread->stack_start;
+
+    if (wm->thread != thread) {
+        /* new thread, its control block is on top of its stack */
+        wm->thread = thread;
+        wm->mark = (const char *)thread;
+        wm->scan = wm->mark;
+        wm->alarm = false;
+        /* thread_create() paints the lowest word of every stack as a guard,
+         * but only the next one of stacks painted as a whole */
+        wm->painted = (end[1] == (uintptr_t)&end[1]);
+    }
+
+    if ((sp >= thread->stack_start) && (sp < wm->mark)) {
+        wm->mark = (const char *)((uintptr_t)sp & ~(sizeof(uintptr_t) - 1));
+    }
+
+    /* Continue checking the words below the mark where the last switch
+     * stopped, and start over below the mark once the end was reached. So
+     * after enough switches, the whole stack below the mark was checked. */
+    if (wm->painted) {
+        const uintptr_t *word = (const uintptr_t *)(uintptr_t)wm->scan;
+
+        if ((word <= end) || (word > (const uintptr_t *)(uintptr_t)wm->mark)) {
+            word = (const uintptr_t *)(uintptr_t)wm->mark;
+        }
+        for (unsigned i = 0; (i < CONFIG_STACK_MONITOR_REFINE_WORDS) &&
+                             (word > end); i++) {
+            word--;
+            if (*word != (uintptr_t)word) {
+                wm->mark = (const char *)word;
+            }
+        }
+        wm->scan = (const char *)word;
+    }
+
+    if (!wm->alarm && ((uint64_t)_usage(thread, wm->mark) * 100 >
+                       (uint64_t)thread->stack_size *
+                       CONFIG_STACK_MONITOR_ALARM_PERCENT)) {
+        wm->alarm = true;
+        if (_alarm_cb) {
+            _alarm_cb(thread->pid);
+        }
+    }
+}
+
+static void _sched_cb(kernel_pid_t active, kernel_pid_t next)
+{
+    if (active != KERNEL_PID_UNDEF) {
+        const thread_t *thread = thread_get(active);
+
+        if (thread) {
+            _update(thread, thread_get_sp(thread));
+        }
+    }
+
+#ifdef MODULE_SCHEDSTATISTICS
+    sched_statistics_cb(active, next);
+#else
+    (void)next;
+#endif
+}
+
+void stack_monitor_init(void)
+{
+    sched_register_cb(_sched_cb);
+}
+
+void stack_monitor_set_alarm_cb(stack_monitor_alarm_cb_t cb)
+{
+    _alarm_cb = cb;
+}
+
+int stack_monitor_get(kernel_pid_t pid, stack_monitor_info_t *info)
+{
+    unsigned state = irq_disable();
+    const thread_t *thread = thread_get(pid);
+
+    if (!thread) {
+        irq_restore(state);
+        return -ENOENT;
+    }
+
+    if (thread == thread_get_active()) {
+        _update(thread, __builtin_frame_address(0));
+    }
+    else if (_marks[pid].thread != thread) {
+        /* not switched out yet since it was created */
+        _update(thread, thread_get_sp(thread));
+    }
+
+    const _watermark_t *wm = &_marks[pid];
+
+    info->size = thread->stack_size;
+    info->peak = _usage(thread, wm->mark);
+    info->alarm = wm->alarm;
+    irq_restore(state);
+
+    return 0;
+}
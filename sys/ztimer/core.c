@@ -25,33 +25,313 @@
 #include <assert.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <string.h>
 
+#include "bitarithm.h"
 #include "kernel_defines.h"
 #include "irq.h"
 #ifdef MODULE_PM_LAYERED
 #include "pm_layered.h"
 #endif
+#include "sched_trace.h"
 #include "ztimer.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry);
+static void _list_insert(ztimer_clock_t *clock, ztimer_base_t *entry);
 static bool _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry);
 static void _ztimer_update(ztimer_clock_t *clock);
 static void _ztimer_print(const ztimer_clock_t *clock);
 static uint32_t _ztimer_update_head_offset(ztimer_clock_t *clock);
 
-#ifdef MODULE_ZTIMER_EXTEND
 static inline uint32_t _min_u32(uint32_t a, uint32_t b)
 {
     return a < b ? a : b;
 }
-#endif
+
+#ifdef MODULE_ZTIMER_WHEEL
+/* log2 of ZTIMER_WHEEL_SLOTS */
+#define WHEEL_SLOT_BITS     (5U)
+#define WHEEL_SLOT_MASK     (ZTIMER_WHEEL_SLOTS - 1)
+
+static inline bool _wheel_active(const ztimer_clock_t *clock)
+{
+    return clock->wheel != NULL;
+}
+
+
+static inline unsigned _wheel_shift(const ztimer_wheel_t *wheel,
+                                    unsigned level)
+{
+    return wheel->shift + level * WHEEL_SLOT_BITS;
+}
+
+/* unsigned may only have 16 bits */
+static inline unsigned _lsb32(uint32_t v)
+{
+    unsigned pos = 0;
+
+    if (!(v & 0xffff)) {
+        v >>= 16;
+        pos = 16;
+    }
+    return pos + bitarithm_lsb(v & 0xffff);
+}
+
+static inline uint32_t _rotl32(uint32_t v, unsigned n)
+{
+    n &= 31;
+    return n ? (v << n) | (v >> (32 - n)) : v;
+}
+
+static bool _wheel_pending(const ztimer_clock_t *clock)
+{
+    for (unsigned level = 0; level < CONFIG_ZTIMER_WHEEL_LEVELS; level++) {
+        if (clock->wheel->occupied[level]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline uintptr_t _wheel_tag(const ztimer_wheel_t *wheel,
+                                   const ztimer_base_t *entry)
+{
+    return (uintptr_t)wheel ^ (uintptr_t)entry;
+}
+
+static void _wheel_link(ztimer_wheel_t *wheel, unsigned level, unsigned slot,
+                        ztimer_base_t *entry)
+{
+    ztimer_base_t **head = &wheel->slots[level][slot];
+
+    entry->next = *head;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    entry->pprev = head;
+    entry->tag = _wheel_tag(wheel, entry);
+    *head = entry;
+    wheel->occupied[level] |= 1UL << slot;
+}
+
+/* Timers that were never set (e.g. on the stack) may hold any value in
+ * pprev, so it is only trusted if the tag matches. The tag is cleared
+ * whenever a timer leaves its slot. */
+static inline bool _wheel_contains(const ztimer_clock_t *clock,
+                                   const ztimer_base_t *entry)
+{
+    return _wheel_active(clock) &&
+           (entry->tag == _wheel_tag(clock->wheel, entry));
+}
+
+static void _wheel_unlink(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uintptr_t pos = (uintptr_t)entry->pprev - (uintptr_t)&wheel->slots[0][0];
+
+    *entry->pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = entry->pprev;
+    }
+    else if ((pos < sizeof(wheel->slots)) && !*entry->pprev) {
+        /* clear the slot's bit if entry was the only timer in it */
+        pos /= sizeof(wheel->slots[0][0]);
+        wheel->occupied[pos / ZTIMER_WHEEL_SLOTS] &=
+            ~(1UL << (pos & WHEEL_SLOT_MASK));
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+    entry->tag = 0;
+}
+
+/* adds entry due @p ahead ticks after the clock's base */
+static void _wheel_add(ztimer_clock_t *clock, ztimer_base_t *entry,
+                       uint32_t ahead)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t now = clock->list.offset;
+    /* 64 bit to not wrap around */
+    uint64_t target = (uint64_t)now + ahead;
+    uint64_t window;
+    unsigned level, shift;
+
+    if ((target >> wheel->shift) == (now >> wheel->shift)) {
+        /* due within the current slot of the lowest level */
+        entry->offset = ahead;
+        entry->tag = 0;
+        _list_insert(clock, entry);
+        return;
+    }
+    for (level = 0; level < (CONFIG_ZTIMER_WHEEL_LEVELS - 1); level++) {
+        shift = _wheel_shift(wheel, level);
+        if (((target >> shift) - (now >> shift)) < ZTIMER_WHEEL_SLOTS) {
+            break;
+        }
+    }
+    shift = _wheel_shift(wheel, level);
+    window = target >> shift;
+    if ((window - (now >> shift)) >= ZTIMER_WHEEL_SLOTS) {
+        /* beyond the range of the wheel, park it in the last slot */
+        window = (now >> shift) + ZTIMER_WHEEL_SLOTS - 1;
+    }
+    entry->offset = (uint32_t)target;
+    _wheel_link(wheel, level, window & WHEEL_SLOT_MASK, entry);
+}
+
+/* moves all timers of the slots time advanced into since @p old_base
+ * down one level or into the list */
+static void _wheel_advance(ztimer_clock_t *clock, uint32_t old_base)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t now = clock->list.offset;
+    ztimer_base_t *due = NULL;
+
+    for (unsigned level = 0; level < CONFIG_ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned shift = _wheel_shift(wheel, level);
+        uint32_t passed = ((now >> shift) - (old_base >> shift)) &
+                          (UINT32_MAX >> shift);
+        uint32_t pending;
+
+        if (passed == 0) {
+            /* no slot boundary passed on the levels above either */
+            break;
+        }
+        pending = wheel->occupied[level];
+        if (passed < ZTIMER_WHEEL_SLOTS) {
+            pending &= _rotl32((1UL << passed) - 1, (old_base >> shift) + 1);
+        }
+        wheel->occupied[level] &= ~pending;
+        while (pending) {
+            unsigned slot = _lsb32(pending);
+            ztimer_base_t *head = wheel->slots[level][slot];
+            ztimer_base_t *tail = head;
+
+            pending &= ~(1UL << slot);
+            wheel->slots[level][slot] = NULL;
+            while (1) {
+                tail->tag = 0;
+                if (!tail->next) {
+                    break;
+                }
+                tail = tail->next;
+            }
+            tail->next = due;
+            due = head;
+        }
+    }
+    while (due) {
+        ztimer_base_t *entry = due;
+        uint32_t target = entry->offset;
+
+        due = entry->next;
+        entry->next = NULL;
+        /* targets of due slots are never before old_base */
+        if ((target - old_base) <= (now - old_base)) {
+            _wheel_add(clock, entry, 0);
+        }
+        else {
+            _wheel_add(clock, entry, target - now);
+        }
+    }
+}
+
+/* ticks from the clock's base to the next slot boundary with timers */
+static uint32_t _wheel_next(const ztimer_clock_t *clock)
+{
+    const ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t now = clock->list.offset;
+    uint32_t next = UINT32_MAX;
+
+    for (unsigned level = 0; level < CONFIG_ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned shift = _wheel_shift(wheel, level);
+        uint32_t window = (now >> shift) + 1;
+
+        if (!wheel->occupied[level]) {
+            continue;
+        }
+        window += _lsb32(_rotl32(wheel->occupied[level],
+                                 ZTIMER_WHEEL_SLOTS - (window & WHEEL_SLOT_MASK)));
+        next = _min_u32(next, (window << shift) - now);
+    }
+    return next;
+}
+
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel,
+                       uint8_t shift)
+{
+    assert((shift + WHEEL_SLOT_BITS * CONFIG_ZTIMER_WHEEL_LEVELS) <= 32);
+
+    unsigned state = irq_disable();
+
+    assert(!clock->list.next);
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->shift = shift;
+    clock->wheel = wheel;
+    irq_restore(state);
+}
+#else
+static inline bool _wheel_active(const ztimer_clock_t *clock)
+{
+    (void)clock;
+    return false;
+}
+
+static inline bool _wheel_contains(const ztimer_clock_t *clock,
+                                   const ztimer_base_t *entry)
+{
+    (void)clock;
+    (void)entry;
+    return false;
+}
+
+static inline bool _wheel_pending(const ztimer_clock_t *clock)
+{
+    (void)clock;
+    return false;
+}
+
+static inline void _wheel_unlink(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    (void)clock;
+    (void)entry;
+}
+
+static inline void _wheel_add(ztimer_clock_t *clock, ztimer_base_t *entry,
+                              uint32_t ahead)
+{
+    (void)clock;
+    (void)entry;
+    (void)ahead;
+}
+
+static inline void _wheel_advance(ztimer_clock_t *clock, uint32_t old_base)
+{
+    (void)clock;
+    (void)old_base;
+}
+
+static inline uint32_t _wheel_next(const ztimer_clock_t *clock)
+{
+    (void)clock;
+    return UINT32_MAX;
+}
+#endif /* MODULE_ZTIMER_WHEEL */
+
+static inline bool _is_empty(const ztimer_clock_t *clock)
+{
+    return !clock->list.next &&
+           !(_wheel_active(clock) && _wheel_pending(clock));
+}
 
 static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 {
-    if (!clock->list.next) {
+    if (_wheel_contains(clock, &t->base)) {
+        return 1;
+    }
+    else if (!clock->list.next) {
         return 0;
     }
     else {
@@ -92,6 +372,8 @@ uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     unsigned state = irq_disable();
 
     uint32_t now = _ztimer_update_head_offset(clock);
+    /* the clock is set for the current head, which might get later now */
+    bool was_head = clock->list.next == &timer->base;
 
     if (_is_set(clock, timer)) {
         _del_entry_from_list(clock, &timer->base);
@@ -107,14 +389,9 @@ uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
 
     timer->base.offset = val;
     _add_entry_to_list(clock, &timer->base);
-    if (clock->list.next == &timer->base) {
-#ifdef MODULE_ZTIMER_EXTEND
-        if (clock->max_value < UINT32_MAX) {
-            val = _min_u32(val, clock->max_value >> 1);
-        }
-        DEBUG("ztimer_set(): %p setting %" PRIu32 "\n", (void *)clock, val);
-#endif
-        clock->ops->set(clock, val);
+    if (was_head || _wheel_active(clock) ||
+        (clock->list.next == &timer->base)) {
+        _ztimer_update(clock);
     }
 
     irq_restore(state);
@@ -123,18 +400,28 @@ uint32_t ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
 
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 {
-    uint32_t delta_sum = 0;
-
-    ztimer_base_t *list = &clock->list;
-
 #ifdef MODULE_PM_LAYERED
-    /* First timer on the clock's linked list */
-    if (list->next == NULL &&
+    /* First timer on the clock */
+    if (_is_empty(clock) &&
         clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
         pm_block(clock->block_pm_mode);
     }
 #endif
 
+    if (_wheel_active(clock)) {
+        _wheel_add(clock, entry, entry->offset);
+    }
+    else {
+        _list_insert(clock, entry);
+    }
+}
+
+static void _list_insert(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    uint32_t delta_sum = 0;
+
+    ztimer_base_t *list = &clock->list;
+
     /* Jump past all entries which are set to an earlier target than the new entry */
     while (list->next) {
         ztimer_base_t *list_entry = list->next;
@@ -155,7 +442,7 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
         clock->last = entry;
     }
     list->next = entry;
-    DEBUG("_add_entry_to_list() %p offset %" PRIu32 "\n", (void *)entry,
+    DEBUG("_list_insert() %p offset %" PRIu32 "\n", (void *)entry,
           entry->offset);
 
 }
@@ -231,6 +518,9 @@ static uint32_t _ztimer_update_head_offset(ztimer_clock_t *clock)
     }
 
     clock->list.offset = now;
+    if (_wheel_active(clock)) {
+        _wheel_advance(clock, old_base);
+    }
     return now;
 }
 
@@ -243,32 +533,39 @@ static bool _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 
     assert(_is_set(clock, (ztimer_t *)entry));
 
-    while (list->next) {
-        ztimer_base_t *list_entry = list->next;
-        if (list_entry == entry) {
-            if (entry == clock->last) {
-                /* if entry was the last timer, set the clocks last to the
-                 * previous entry, or NULL if that was the list ptr */
-                clock->last = (list == &clock->list) ? NULL : list;
-            }
+    if (_wheel_contains(clock, entry)) {
+        _wheel_unlink(clock, entry);
+        was_removed = true;
+    }
+    else {
+        while (list->next) {
+            ztimer_base_t *list_entry = list->next;
+            if (list_entry == entry) {
+                if (entry == clock->last) {
+                    /* if entry was the last timer, set the clocks last to the
+                     * previous entry, or NULL if that was the list ptr */
+                    clock->last = (list == &clock->list) ? NULL : list;
+                }
 
-            list->next = entry->next;
-            if (list->next) {
-                list_entry = list->next;
-                list_entry->offset += entry->offset;
-            }
+                list->next = entry->next;
+                if (list->next) {
+                    list_entry = list->next;
+                    list_entry->offset += entry->offset;
+                }
 
-            was_removed = true;
-            /* reset the entry's next pointer so _is_set() considers it unset */
-            entry->next = NULL;
-            break;
+                was_removed = true;
+                /* reset the entry's next pointer so _is_set() considers it
+                 * unset */
+                entry->next = NULL;
+                break;
+            }
+            list = list->next;
         }
-        list = list->next;
     }
 
 #ifdef MODULE_PM_LAYERED
-    /* The last timer just got removed from the clock's linked list */
-    if (clock->list.next == NULL &&
+    /* The last timer just got removed from the clock */
+    if (_is_empty(clock) &&
         clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
         pm_unblock(clock->block_pm_mode);
     }
@@ -287,7 +584,8 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
             /* The last timer just got removed from the clock's linked list */
             clock->last = NULL;
 #ifdef MODULE_PM_LAYERED
-            if (clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+            if (_is_empty(clock) &&
+                clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
                 pm_unblock(clock->block_pm_mode);
             }
 #endif
@@ -305,23 +603,24 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
 
 static void _ztimer_update(ztimer_clock_t *clock)
 {
+    bool pending = clock->list.next != NULL;
+    uint32_t next = pending ? clock->list.next->offset : UINT32_MAX;
+
+    if (_wheel_active(clock) && _wheel_pending(clock)) {
+        pending = true;
+        next = _min_u32(next, _wheel_next(clock));
+    }
+
 #ifdef MODULE_ZTIMER_EXTEND
     if (clock->max_value < UINT32_MAX) {
-        if (clock->list.next) {
-            clock->ops->set(clock,
-                            _min_u32(clock->list.next->offset,
-                                     clock->max_value >> 1));
-        }
-        else {
-            clock->ops->set(clock, clock->max_value >> 1);
-        }
+        clock->ops->set(clock, _min_u32(next, clock->max_value >> 1));
 #else
     if (0) {
 #endif
     }
     else {
-        if (clock->list.next) {
-            clock->ops->set(clock, clock->list.next->offset);
+        if (pending) {
+            clock->ops->set(clock, next);
         }
         else {
             if (IS_USED(MODULE_ZTIMER_NOW64)) {
@@ -344,7 +643,10 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 
 #if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64
-    if (IS_USED(MODULE_ZTIMER_NOW64) || clock->max_value < UINT32_MAX) {
+    if (_wheel_active(clock)) {
+        /* checkpointing is done by _ztimer_update_head_offset() below */
+    }
+    else if (IS_USED(MODULE_ZTIMER_NOW64) || clock->max_value < UINT32_MAX) {
         /* calling now triggers checkpointing */
         uint32_t now = ztimer_now(clock);
 
@@ -373,23 +675,32 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 #endif
 
-    if (clock->list.next) {
+    if (_wheel_active(clock)) {
+        /* the alarm might have been set for a slot boundary of the wheel, so
+         * the head of the list need not be due */
+        _ztimer_update_head_offset(clock);
+    }
+    else if (clock->list.next) {
         clock->list.offset += clock->list.next->offset;
         clock->list.next->offset = 0;
+    }
 
-        ztimer_t *entry = _now_next(clock);
-        while (entry) {
-            DEBUG("ztimer_handler(): trigger %p->%p at %" PRIu32 "\n",
-                  (void *)entry, (void *)entry->base.next, clock->ops->now(
-                      clock));
-            entry->callback(entry->arg);
+    ztimer_t *entry = _now_next(clock);
+    while (entry) {
+        DEBUG("ztimer_handler(): trigger %p->%p at %" PRIu32 "\n",
+              (void *)entry, (void *)entry->base.next, clock->ops->now(
+                  clock));
+        ztimer_callback_t callback = entry->callback;
+
+        sched_trace_record(SCHED_TRACE_TIMER_ENTER, 0, (uintptr_t)callback);
+        callback(entry->arg);
+        sched_trace_record(SCHED_TRACE_TIMER_EXIT, 0, (uintptr_t)callback);
+        entry = _now_next(clock);
+        if (!entry) {
+            /* See if any more alarms expired during callback processing */
+            /* This reduces the number of implicit calls to clock->ops->now() */
+            _ztimer_update_head_offset(clock);
             entry = _now_next(clock);
-            if (!entry) {
-                /* See if any more alarms expired during callback processing */
-                /* This reduces the number of implicit calls to clock->ops->now() */
-                _ztimer_update_head_offset(clock);
-                entry = _now_next(clock);
-            }
         }
     }
 
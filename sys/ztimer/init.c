@@ -220,6 +220,18 @@ ztimer_clock_t *const ZTIMER_SEC = &_ztimer_convert_frac_sec.super.super;
 #  endif
 #endif
 
+#if MODULE_ZTIMER_WHEEL
+#  if MODULE_ZTIMER_USEC
+static ztimer_wheel_t _ztimer_wheel_usec;
+#  endif
+#  if MODULE_ZTIMER_MSEC
+static ztimer_wheel_t _ztimer_wheel_msec;
+#  endif
+#  if MODULE_ZTIMER_SEC
+static ztimer_wheel_t _ztimer_wheel_sec;
+#  endif
+#endif
+
 #if IS_USED(MODULE_ZTIMER_USEC)
 #ifndef CONFIG_ZTIMER_AUTO_ADJUST_BASE_ITVL
 #define CONFIG_ZTIMER_AUTO_ADJUST_BASE_ITVL     1000
@@ -297,6 +309,11 @@ void ztimer_init(void)
 #  else
     LOG_DEBUG("ztimer_init(): ZTIMER_USEC without conversion\n");
 #  endif
+#  if MODULE_ZTIMER_WHEEL
+    LOG_DEBUG("ztimer_init(): ZTIMER_USEC using timer wheel\n");
+    ztimer_wheel_init(ZTIMER_USEC, &_ztimer_wheel_usec,
+                      CONFIG_ZTIMER_USEC_WHEEL_SHIFT);
+#  endif
 
     /* warm-up time if set and needed */
     if (IS_USED(MODULE_ZTIMER_AUTO_ADJUST) &&
@@ -347,6 +364,11 @@ void ztimer_init(void)
               CONFIG_ZTIMER_MSEC_ADJUST);
     ZTIMER_MSEC->adjust = CONFIG_ZTIMER_MSEC_ADJUST;
 #  endif
+#  if MODULE_ZTIMER_WHEEL
+    LOG_DEBUG("ztimer_init(): ZTIMER_MSEC using timer wheel\n");
+    ztimer_wheel_init(ZTIMER_MSEC, &_ztimer_wheel_msec,
+                      CONFIG_ZTIMER_MSEC_WHEEL_SHIFT);
+#  endif
 #endif
 
 #if MODULE_ZTIMER_SEC
@@ -356,5 +378,10 @@ void ztimer_init(void)
     ztimer_convert_frac_init(&_ztimer_convert_frac_sec, ZTIMER_SEC_BASE,
                              FREQ_1HZ, ZTIMER_SEC_CONVERT_LOWER_FREQ);
 #  endif
+#  if MODULE_ZTIMER_WHEEL
+    LOG_DEBUG("ztimer_init(): ZTIMER_SEC using timer wheel\n");
+    ztimer_wheel_init(ZTIMER_SEC, &_ztimer_wheel_sec,
+                      CONFIG_ZTIMER_SEC_WHEEL_SHIFT);
+#  endif
 #endif
 }
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the linear and the hashed FIB engine
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/fib.h"
+#include "net/fib/table.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL)
+#endif
+
+#define TABLE_SIZE_MAX      (4096U)
+#define NEXT_HOP_NUMOF      (8U)
+#define LOOKUP_NUMOF        (64U)
+#define LIFETIME_MS         (3600U * MS_PER_SEC)
+#define IFACE               (6)
+#define PFX_LEN             (64U)
+
+static const unsigned _sizes[] = { 64, 512, TABLE_SIZE_MAX };
+
+static fib_entry_t _entries[TABLE_SIZE_MAX];
+static fib_sr_t _sr_headers[TABLE_SIZE_MAX];
+static fib_sr_entry_t _sr_pool[2 * TABLE_SIZE_MAX];
+static fib_sr_meta_t _sr_meta = { .headers = _sr_headers,
+                                  .entry_pool = _sr_pool,
+                                  .entry_pool_size = ARRAY_SIZE(_sr_pool) };
+static uint16_t _buckets[TABLE_SIZE_MAX];
+static fib_hashed_t _index = { .buckets = _buckets };
+static fib_table_t _table;
+
+static ipv6_addr_t _dst[LOOKUP_NUMOF];
+/* results of the linear engine, the hashed engine must find the same */
+static ipv6_addr_t _expected[LOOKUP_NUMOF];
+static unsigned _next_lookup;
+static char _name[32];
+static bool _failed;
+
+static void _host(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_from_str(addr, "2001:db8:ffff::");
+    addr->u16[7] = byteorder_htons(i);
+}
+
+static void _prefix(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_from_str(addr, "2001:db8::");
+    addr->u16[2] = byteorder_htons(i);
+}
+
+static void _next_hop(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_from_str(addr, "fe80::");
+    addr->u16[7] = byteorder_htons((i % NEXT_HOP_NUMOF) + 1);
+}
+
+static void _setup(uint8_t table_type, unsigned size, bool hashed)
+{
+    memset(&_table, 0, sizeof(_table));
+    if (table_type == FIB_TABLE_TYPE_SR) {
+        _table.data.source_routes = &_sr_meta;
+    }
+    else {
+        _table.data.entries = _entries;
+    }
+    _table.table_type = table_type;
+    _table.size = size;
+    _index.buckets_numof = size;
+    _table.hashed = hashed ? &_index : NULL;
+    fib_init(&_table);
+}
+
+static void _fill(unsigned size)
+{
+    ipv6_addr_t dst = IPV6_ADDR_UNSPECIFIED, next_hop;
+
+    /* every fourth entry is a prefix, the first one the default route */
+    for (unsigned i = 0; i < size; i++) {
+        uint32_t flags = 0;
+
+        if (i == 0) {
+            memset(&dst, 0, sizeof(dst));
+        }
+        else if ((i % 4) == 0) {
+            _prefix(&dst, i);
+            flags = PFX_LEN << FIB_FLAG_NET_PREFIX_SHIFT;
+        }
+        else {
+            _host(&dst, i);
+        }
+        _next_hop(&next_hop, i);
+        if (fib_add_entry(&_table, IFACE, dst.u8, sizeof(dst), flags,
+                          next_hop.u8, sizeof(next_hop), 0, LIFETIME_MS) != 0) {
+            printf("Error: unable to add entry %u\n", i);
+            _failed = true;
+        }
+    }
+}
+
+static void _fill_sr(unsigned size)
+{
+    for (unsigned i = 0; i < size; i++) {
+        ipv6_addr_t dst, next_hop;
+        fib_sr_t *sr;
+
+        _host(&dst, i);
+        _next_hop(&next_hop, i);
+        if ((fib_sr_create(&_table, &sr, IFACE, 0, LIFETIME_MS) != 0) ||
+            (fib_sr_entry_append(&_table, sr, next_hop.u8, sizeof(next_hop)) != 0) ||
+            (fib_sr_entry_append(&_table, sr, dst.u8, sizeof(dst)) != 0)) {
+            printf("Error: unable to add source route %u\n", i);
+            _failed = true;
+        }
+    }
+}
+
+static void _init_dsts(unsigned size, bool sr)
+{
+    for (unsigned j = 0; j < LOOKUP_NUMOF; j++) {
+        unsigned i = (j * 2654435761U) % size;
+
+        if (sr || ((j % 4) == 0)) {
+            _host(&_dst[j], i);
+        }
+        else if ((j % 4) == 1) {
+            /* below a prefix */
+            _prefix(&_dst[j], i & ~0x3);
+            _dst[j].u16[7] = byteorder_htons(j + 1);
+        }
+        else {
+            /* (mostly) covered only by the default route */
+            ipv6_addr_from_str(&_dst[j], "2001:db9::");
+            _dst[j].u16[7] = byteorder_htons(j + 1);
+        }
+    }
+}
+
+static int _get(unsigned j, ipv6_addr_t *next_hop)
+{
+    kernel_pid_t iface;
+    size_t next_hop_size = sizeof(*next_hop);
+    uint32_t next_hop_flags;
+
+    return fib_get_next_hop(&_table, &iface, next_hop->u8, &next_hop_size,
+                            &next_hop_flags, _dst[j].u8, sizeof(_dst[j]), 0);
+}
+
+static int _get_sr(unsigned j, ipv6_addr_t *path)
+{
+    kernel_pid_t iface;
+    uint32_t sr_flags = 0;
+    size_t path_len = 2;
+    size_t element_size = sizeof(ipv6_addr_t);
+
+    return fib_sr_get_route(&_table, _dst[j].u8, sizeof(_dst[j]), &iface,
+                            &sr_flags, path->u8, &path_len, &element_size,
+                            false, NULL);
+}
+
+static void _lookup(void)
+{
+    ipv6_addr_t next_hop;
+
+    _get(_next_lookup, &next_hop);
+    _next_lookup = (_next_lookup + 1) % LOOKUP_NUMOF;
+}
+
+static void _lookup_sr(void)
+{
+    ipv6_addr_t path[2];
+
+    _get_sr(_next_lookup, path);
+    _next_lookup = (_next_lookup + 1) % LOOKUP_NUMOF;
+}
+
+static void _check(bool sr, bool hashed)
+{
+    for (unsigned j = 0; j < LOOKUP_NUMOF; j++) {
+        ipv6_addr_t res[2];
+
+        if ((sr ? _get_sr(j, res) : _get(j, res)) < 0) {
+            printf("Error: no route for lookup %u\n", j);
+            _failed = true;
+        }
+        else if (!hashed) {
+            _expected[j] = res[0];
+        }
+        else if (!ipv6_addr_equal(&_expected[j], &res[0])) {
+            printf("Error: engines disagree on lookup %u\n", j);
+            _failed = true;
+        }
+    }
+}
+
+static void _bench(unsigned size, bool sr, bool hashed)
+{
+    const char *engine = hashed ? "hashed" : "linear";
+    benchmark_t bench;
+    uint32_t start;
+
+    _setup(sr ? FIB_TABLE_TYPE_SR : FIB_TABLE_TYPE_SH, size, hashed);
+    snprintf(_name, sizeof(_name), "%s add", engine);
+    /* filling the table can't be repeated, so it is a single sample */
+    benchmark_init(&bench, _name, size);
+    start = benchmark_now();
+    if (sr) {
+        _fill_sr(size);
+    }
+    else {
+        _fill(size);
+    }
+    benchmark_add(&bench, benchmark_now() - start);
+    benchmark_report(&bench);
+    _check(sr, hashed);
+    _next_lookup = 0;
+    snprintf(_name, sizeof(_name), "%s lookup", engine);
+    if (sr) {
+        BENCHMARK_RUN(_name, BENCH_RUNS, _lookup_sr());
+    }
+    else {
+        BENCHMARK_RUN(_name, BENCH_RUNS, _lookup());
+    }
+    fib_deinit(&_table);
+}
+
+int main(void)
+{
+    puts("FIB engine benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        printf("Single hop table with %u entries\n", _sizes[i]);
+        _init_dsts(_sizes[i], false);
+        _bench(_sizes[i], false, false);
+        _bench(_sizes[i], false, true);
+        printf("Source route table with %u entries\n", _sizes[i]);
+        _init_dsts(_sizes[i], true);
+        _bench(_sizes[i], true, false);
+        _bench(_sizes[i], true, true);
+        puts("");
+    }
+
+    puts(_failed ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
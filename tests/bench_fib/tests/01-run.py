@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# the linear engine needs a while for the largest tables
+TIMEOUT = 120
+BENCHMARK_REGEXP = r"\s*{func}:  min \d+\.\d+  median \d+\.\d+  p99 \d+\.\d+" \
+                   r"  max \d+\.\d+  mean \d+\.\d+ (us|cycles) per call" \
+                   r"  \(\d+ x \d+ calls\)"
+
+
+def testfunc(child):
+    child.expect_exact('FIB engine benchmark')
+    for size in (64, 512, 4096):
+        for table in ("Single hop", "Source route"):
+            child.expect_exact("{} table with {} entries".format(table, size))
+            for engine in ("linear", "hashed"):
+                child.expect(BENCHMARK_REGEXP.format(func=engine + " add"),
+                             timeout=TIMEOUT)
+                child.expect(BENCHMARK_REGEXP.format(func=engine + " lookup"),
+                             timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
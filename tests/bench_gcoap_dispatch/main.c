@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares finding gcoap resources in the path index with
+ *              searching all listeners one by one
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/gcoap.h"
+#include "net/gcoap/path_index.h"
+#include "ztimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define LISTENERS_NUMOF     (8U)
+#define RESOURCES_NUMOF     (7U)
+
+typedef struct {
+    const char *name;
+    const char *path;
+    int expected;
+} _case_t;
+
+static const _case_t _cases[] = {
+    /* first resource of the listener registered last */
+    { "first", "/l7/r0", GCOAP_RESOURCE_FOUND },
+    /* last resource of the listener registered first */
+    { "last", "/l0/r6", GCOAP_RESOURCE_FOUND },
+    { "subtree", "/sub/a/b/c", GCOAP_RESOURCE_FOUND },
+    { "method", "/put", GCOAP_RESOURCE_WRONG_METHOD },
+    { "miss", "/l0/x", GCOAP_RESOURCE_NO_PATH },
+};
+
+static char _paths[LISTENERS_NUMOF][RESOURCES_NUMOF][sizeof("/l0/r0")];
+static coap_resource_t _resources[LISTENERS_NUMOF][RESOURCES_NUMOF];
+static gcoap_listener_t _listeners[LISTENERS_NUMOF];
+
+static const coap_resource_t _sub_resources[] = {
+    { .path = "/put", .methods = COAP_PUT },
+    { .path = "/sub", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+};
+static gcoap_listener_t _sub_listener = {
+    .resources = _sub_resources,
+    .resources_len = ARRAY_SIZE(_sub_resources),
+};
+
+/* all listeners in the order they are registered */
+static gcoap_listener_t *_all[LISTENERS_NUMOF + 1];
+
+static uint8_t _buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+static volatile int _res;
+
+/* how gcoap searches listeners with the default request matcher, newest
+ * listener first */
+static int _find_linear(coap_pkt_t *pdu)
+{
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+    int ret = GCOAP_RESOURCE_NO_PATH;
+
+    if (coap_get_uri_path(pdu, uri) <= 0) {
+        return GCOAP_RESOURCE_NO_PATH;
+    }
+
+    coap_method_flags_t method = coap_method2flag(coap_get_code_detail(pdu));
+
+    for (unsigned l = ARRAY_SIZE(_all); l > 0; l--) {
+        gcoap_listener_t *listener = _all[l - 1];
+
+        for (size_t i = 0; i < listener->resources_len; i++) {
+            const coap_resource_t *resource = &listener->resources[i];
+            int res = coap_match_path(resource, uri);
+
+            if (res > 0) {
+                continue;
+            }
+            else if (res < 0) {
+                break;
+            }
+            if (!(resource->methods & method)) {
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+                continue;
+            }
+            return GCOAP_RESOURCE_FOUND;
+        }
+    }
+    return ret;
+}
+
+static int _find_index(coap_pkt_t *pdu)
+{
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+    const coap_resource_t *resource;
+    gcoap_listener_t *listener;
+
+    if (coap_get_uri_path(pdu, uri) <= 0) {
+        return GCOAP_RESOURCE_NO_PATH;
+    }
+    return gcoap_path_index_find((char *)uri,
+                                 coap_method2flag(coap_get_code_detail(pdu)),
+                                 GCOAP_SOCKET_TYPE_UDP, &resource, &listener);
+}
+
+static void _register(void)
+{
+    /* paths in alphabetical order, as the default request matcher expects */
+    for (unsigned l = 0; l < LISTENERS_NUMOF; l++) {
+        for (unsigned i = 0; i < RESOURCES_NUMOF; i++) {
+            snprintf(_paths[l][i], sizeof(_paths[l][i]), "/l%u/r%u", l, i);
+            _resources[l][i].path = _paths[l][i];
+            _resources[l][i].methods = COAP_GET | COAP_POST;
+        }
+        _listeners[l].resources = _resources[l];
+        _listeners[l].resources_len = RESOURCES_NUMOF;
+        _all[l] = &_listeners[l];
+    }
+    _all[LISTENERS_NUMOF] = &_sub_listener;
+
+    for (unsigned l = 0; l < ARRAY_SIZE(_all); l++) {
+        gcoap_register_listener(_all[l]);
+    }
+}
+
+int main(void)
+{
+    char name[32];
+    bool failed = false;
+
+    puts("gcoap dispatch benchmark\n");
+    _register();
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_cases); i++) {
+        coap_pkt_t pdu;
+
+        gcoap_req_init(&pdu, _buf, sizeof(_buf), COAP_METHOD_GET,
+                       _cases[i].path);
+        coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+
+        if ((_find_linear(&pdu) != _cases[i].expected) ||
+            (_find_index(&pdu) != _cases[i].expected)) {
+            printf("Error: unexpected result for %s\n", _cases[i].path);
+            failed = true;
+        }
+        snprintf(name, sizeof(name), "linear %s", _cases[i].name);
+        BENCHMARK_RUN(name, BENCH_RUNS, _res = _find_linear(&pdu));
+        snprintf(name, sizeof(name), "index %s", _cases[i].name);
+        BENCHMARK_RUN(name, BENCH_RUNS, _res = _find_index(&pdu));
+    }
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the rate of UDP packets GNRC receives
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netreg.h"
+#include "shell.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define MAIN_QUEUE_SIZE (8)
+#define SINK_QUEUE_SIZE (32)
+
+static msg_t main_msg_queue[MAIN_QUEUE_SIZE];
+static char sink_stack[THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t received;
+
+static void *_sink(void *arg)
+{
+    msg_t msg_queue[SINK_QUEUE_SIZE];
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(SINK_PORT,
+                                                         thread_getpid());
+
+    (void)arg;
+    msg_init_queue(msg_queue, SINK_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &reg);
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            received++;
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    return NULL;
+}
+
+static int _pps(int argc, char **argv)
+{
+    if ((argc < 2) || (atoi(argv[1]) <= 0)) {
+        printf("usage: %s <seconds>\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t duration = atoi(argv[1]) * MS_PER_SEC;
+    uint32_t count = received;
+    uint32_t start = ztimer_now(ZTIMER_MSEC);
+
+    ztimer_sleep(ZTIMER_MSEC, duration);
+    count = received - count;
+    duration = ztimer_now(ZTIMER_MSEC) - start;
+    printf("%" PRIu32 " packets in %" PRIu32 " ms: %" PRIu32 " pps\n",
+           count, duration, (uint32_t)(((uint64_t)count * MS_PER_SEC) / duration));
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "pps", "count UDP packets to the sink port", _pps },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(sink_stack, sizeof(sink_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _sink, NULL, "sink");
+
+    printf("Counting UDP packets to port %u (batched receive %s)\n",
+           SINK_PORT, IS_USED(MODULE_GNRC_NETIF_RX_BATCH) ? "on" : "off");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
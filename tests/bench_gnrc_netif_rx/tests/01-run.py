@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import socket
+import sys
+import threading
+
+from testrunner import run
+
+
+TAP = os.getenv("TAP", "tap0")
+SINK_PORT = int(os.getenv("SINK_PORT", "8808"))
+DURATION = 5
+PAYLOAD = b"\x00" * 32
+
+
+def get_lladdr(child):
+    child.sendline("ifconfig")
+    child.expect(r"inet6 addr: (?P<lladdr>fe80:[0-9a-fA-F:]+)\s+scope: link")
+    return child.match.group("lladdr").lower()
+
+
+def flood(addr, stop):
+    with socket.socket(socket.AF_INET6, socket.SOCK_DGRAM) as sock:
+        dst = socket.getaddrinfo("{}%{}".format(addr, TAP), SINK_PORT,
+                                 socket.AF_INET6, socket.SOCK_DGRAM)[0][4]
+        while not stop.is_set():
+            try:
+                sock.sendto(PAYLOAD, dst)
+            except OSError:
+                # the tap queue is full
+                pass
+
+
+def testfunc(child):
+    child.expect(r"Counting UDP packets to port \d+ \(batched receive (on|off)\)")
+    batched = child.match.group(1)
+    addr = get_lladdr(child)
+    stop = threading.Event()
+    flooder = threading.Thread(target=flood, args=(addr, stop))
+
+    flooder.start()
+    try:
+        child.sendline("pps {}".format(DURATION))
+        child.expect(r"(\d+) packets in \d+ ms: (\d+) pps",
+                     timeout=DURATION + 5)
+    finally:
+        stop.set()
+        flooder.join()
+    assert int(child.match.group(1)) > 0
+    print("\nbatched receive {}: {} pps".format(batched,
+                                               child.match.group(2)))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the goodput of GNRC TCP over a lossy link
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define MAIN_QUEUE_SIZE (8)
+#define BUFFER_SIZE     (256)
+#define TIMEOUT_MS      (60U * MS_PER_SEC)
+
+static msg_t main_msg_queue[MAIN_QUEUE_SIZE];
+static char server_stack[THREAD_STACKSIZE_MAIN];
+static uint8_t buffer[BUFFER_SIZE];
+static uint16_t server_port;
+
+/* Pattern of the transferred data, so the receiver can verify it */
+static inline uint8_t _pattern(uint32_t pos)
+{
+    return pos % 251;
+}
+
+static void *_server(void *arg)
+{
+    static uint8_t rcv_buf[BUFFER_SIZE];
+    static gnrc_tcp_tcb_queue_t queue;
+    static gnrc_tcp_tcb_t tcb;
+    gnrc_tcp_tcb_t *conn;
+    gnrc_tcp_ep_t local;
+
+    (void)arg;
+    gnrc_tcp_tcb_queue_init(&queue);
+    gnrc_tcp_tcb_init(&tcb);
+    gnrc_tcp_ep_init(&local, AF_INET6, NULL, 0, server_port, 0);
+
+    int res = gnrc_tcp_listen(&queue, &tcb, 1, &local);
+    if (res < 0) {
+        printf("listen failed: %d\n", res);
+        return NULL;
+    }
+    printf("listening on port %u\n", server_port);
+
+    while (1) {
+        uint32_t received = 0;
+        uint32_t errors = 0;
+
+        res = gnrc_tcp_accept(&queue, &conn, GNRC_TCP_NO_TIMEOUT);
+        if (res < 0) {
+            printf("accept failed: %d\n", res);
+            continue;
+        }
+        while ((res = gnrc_tcp_recv(conn, rcv_buf, sizeof(rcv_buf),
+                                    TIMEOUT_MS)) > 0) {
+            for (int i = 0; i < res; i++) {
+                if (rcv_buf[i] != _pattern(received + i)) {
+                    errors++;
+                }
+            }
+            received += res;
+        }
+        gnrc_tcp_close(conn);
+        printf("received %" PRIu32 " bytes, %" PRIu32 " errors\n",
+               received, errors);
+    }
+
+    return NULL;
+}
+
+static int _listen_cmd(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+    if (server_port) {
+        puts("already listening");
+        return 1;
+    }
+    server_port = atoi(argv[1]);
+    thread_create(server_stack, sizeof(server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "tcp_server");
+    return 0;
+}
+
+static int _send_cmd(int argc, char **argv)
+{
+    static gnrc_tcp_tcb_t tcb;
+    gnrc_tcp_ep_t remote;
+
+    if (argc < 3) {
+        printf("usage: %s <[addr]:port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_from_str(&remote, argv[1]) < 0) {
+        puts("invalid endpoint");
+        return 1;
+    }
+
+    uint32_t total = strtoul(argv[2], NULL, 10);
+    uint32_t sent = 0;
+
+    gnrc_tcp_tcb_init(&tcb);
+    uint32_t start = ztimer_now(ZTIMER_MSEC);
+    int res = gnrc_tcp_open(&tcb, &remote, 0);
+    if (res < 0) {
+        printf("open failed: %d\n", res);
+        return 1;
+    }
+
+    while (sent < total) {
+        size_t len = total - sent;
+        len = (len < sizeof(buffer)) ? len : sizeof(buffer);
+        for (size_t i = 0; i < len; i++) {
+            buffer[i] = _pattern(sent + i);
+        }
+        size_t done = 0;
+        while (done < len) {
+            res = gnrc_tcp_send(&tcb, buffer + done, len - done, TIMEOUT_MS);
+            if (res < 0) {
+                printf("send failed after %" PRIu32 " bytes: %d\n",
+                       (uint32_t)(sent + done), res);
+                gnrc_tcp_abort(&tcb);
+                return 1;
+            }
+            done += res;
+        }
+        sent += len;
+    }
+    /* Closing waits until all data was acknowledged */
+    gnrc_tcp_close(&tcb);
+
+    uint32_t duration = ztimer_now(ZTIMER_MSEC) - start;
+    uint32_t goodput = duration ? ((uint64_t)sent * MS_PER_SEC) / duration : 0;
+    printf("sent %" PRIu32 " bytes in %" PRIu32 " ms, %" PRIu32 " bytes/s\n",
+           sent, duration, goodput);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "listen", "receive TCP connections on a port", _listen_cmd },
+    { "send", "send a number of bytes to a TCP endpoint", _send_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(main_msg_queue, MAIN_QUEUE_SIZE);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
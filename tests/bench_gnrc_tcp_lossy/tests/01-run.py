@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import re
+import subprocess
+
+from subprocess import Popen
+from riotctrl.ctrl import RIOTCtrlBoardFactory
+from riotctrl_ctrl import native
+from riotctrl_shell.netif import Ifconfig, IfconfigListParser
+
+# 10% packet loss in both directions
+TOPOLOGY = "A B 0.9\n"
+PORT = 8080
+SIZE = 8192
+TIMEOUT = 300
+
+
+class RIOTCtrlAppFactory(RIOTCtrlBoardFactory):
+
+    def __init__(self):
+        super().__init__(board_cls={
+            'native': native.NativeRIOTCtrl,
+        })
+        self.ctrl_list = list()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        for ctrl in self.ctrl_list:
+            ctrl.stop_term()
+
+    def get_shell(self, application_directory='.', env={'BOARD': 'native'}):
+        ctrl = super().get_ctrl(
+            env=env,
+            application_directory=application_directory
+        )
+        self.ctrl_list.append(ctrl)
+        ctrl.start_term()
+        return Shell(ctrl)
+
+
+class Shell(Ifconfig):
+    pass
+
+
+def link_local_addr(shell):
+    netifs = IfconfigListParser().parse(shell.ifconfig_list())
+    netif = netifs[next(iter(netifs))]
+    return [addr["addr"] for addr in netif["ipv6_addrs"]
+            if addr["scope"] == "link"][0]
+
+
+def test_lossy_transfer(factory):
+    server = factory.get_shell()
+    client = factory.get_shell()
+
+    server.cmd("listen {}".format(PORT))
+    addr = link_local_addr(server)
+
+    res = client.cmd("send [{}]:{} {}".format(addr, PORT, SIZE),
+                     timeout=TIMEOUT)
+    match = re.search(r"sent (\d+) bytes in (\d+) ms, (\d+) bytes/s", res)
+    assert match, res
+    assert int(match.group(1)) == SIZE
+    print("\n{} bytes in {} ms with 10% loss: {} bytes/s".format(
+        match.group(1), match.group(2), match.group(3)))
+
+    server.riotctrl.term.expect(r"received (\d+) bytes, (\d+) errors",
+                                timeout=TIMEOUT)
+    assert int(server.riotctrl.term.match.group(1)) == SIZE
+    assert int(server.riotctrl.term.match.group(2)) == 0
+
+
+if __name__ == "__main__":
+    with Popen(['../../dist/tools/zep_dispatch/bin/zep_dispatch',
+                '-t', '-', '127.0.0.1', '17754'],
+               stdin=subprocess.PIPE) as zep_dispatch:
+        zep_dispatch.stdin.write(TOPOLOGY.encode())
+        zep_dispatch.stdin.close()
+        try:
+            with RIOTCtrlAppFactory() as factory:
+                test_lossy_transfer(factory)
+        finally:
+            zep_dispatch.terminate()
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the Internet checksum with a byte by byte
+ *              implementation
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/inet_csum.h"
+#include "random.h"
+#include "ztimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define BUF_SIZE            (1280U)
+
+/* an IPv6 header, a small packet, a typical 802.15.4 reassembled packet and
+ * the IPv6 minimum MTU */
+static const uint16_t _sizes[] = { 40, 128, 512, BUF_SIZE };
+
+/* one more byte to also measure unaligned buffers */
+static uint8_t _buf[BUF_SIZE + 1];
+static char _name[32];
+static volatile uint16_t _sum;
+
+/* how inet_csum_slice() used to work */
+static uint16_t _bytewise(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        uint16_t carry = csum >> 16;
+        csum = (csum & 0xffff) + carry;
+    }
+    return csum;
+}
+
+int main(void)
+{
+    bool failed = false;
+
+    puts("Internet checksum benchmark\n");
+    random_bytes(_buf, sizeof(_buf));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        uint16_t len = _sizes[i];
+
+        printf("%u bytes\n", len);
+        for (unsigned offset = 0; offset < 2; offset++) {
+            const uint8_t *buf = &_buf[offset];
+
+            if (_bytewise(0, buf, len) != inet_csum(0, buf, len)) {
+                printf("Error: checksums differ for offset %u\n", offset);
+                failed = true;
+            }
+            snprintf(_name, sizeof(_name), "bytewise +%u", offset);
+            BENCHMARK_RUN(_name, BENCH_RUNS, _sum = _bytewise(0, buf, len));
+            snprintf(_name, sizeof(_name), "inet_csum +%u", offset);
+            BENCHMARK_RUN(_name, BENCH_RUNS, _sum = inet_csum(0, buf, len));
+        }
+        puts("");
+    }
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
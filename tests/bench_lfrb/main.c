@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares passing frames through the lock-free ringbuffer
+ *              with tsrb
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "lfrb.h"
+#include "tsrb.h"
+#include "ztimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define FRAME_SIZE_MAX      (256U)
+#define FRAMES_NUMOF        (8U)
+
+static const uint16_t _sizes[] = { 16, 64, FRAME_SIZE_MAX };
+
+static uint8_t _tsrb_buf[FRAMES_NUMOF * FRAME_SIZE_MAX];
+static uint8_t _lfrb_buf[FRAMES_NUMOF * FRAME_SIZE_MAX];
+static atomic_uint_least32_t _flags[LFRB_MP_FLAGS_NUMOF(FRAMES_NUMOF)];
+static tsrb_t _tsrb;
+static lfrb_t _lfrb;
+
+static uint8_t _in[FRAME_SIZE_MAX];
+static uint8_t _out[FRAME_SIZE_MAX];
+static unsigned _len;
+
+static void _tsrb_pass(void)
+{
+    tsrb_add(&_tsrb, _in, _len);
+    tsrb_get(&_tsrb, _out, _len);
+}
+
+static void _lfrb_copy_pass(void)
+{
+    lfrb_put(&_lfrb, _in, 1);
+    lfrb_get(&_lfrb, _out, 1);
+}
+
+static void _lfrb_in_place_pass(void)
+{
+    unsigned n = 1;
+    void *frame = lfrb_reserve(&_lfrb, &n);
+
+    memcpy(frame, _in, _len);
+    lfrb_commit(&_lfrb, n);
+
+    n = 1;
+    const void *elem = lfrb_acquire(&_lfrb, &n);
+
+    memcpy(_out, elem, _len);
+    lfrb_release(&_lfrb, n);
+}
+
+static void _lfrb_mp_pass(void)
+{
+    lfrb_mp_put(&_lfrb, _in, 1);
+    lfrb_get(&_lfrb, _out, 1);
+}
+
+static bool _check(const char *name, void (*pass)(void))
+{
+    memset(_out, 0, sizeof(_out));
+    pass();
+    if (memcmp(_in, _out, _len) != 0) {
+        printf("Error: %s corrupted the frame\n", name);
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    bool failed = false;
+
+    puts("lfrb benchmark\n");
+    for (unsigned i = 0; i < sizeof(_in); i++) {
+        _in[i] = i;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        _len = _sizes[i];
+
+        printf("%u bytes\n", _len);
+        tsrb_init(&_tsrb, _tsrb_buf, sizeof(_tsrb_buf));
+        failed |= !_check("tsrb", _tsrb_pass);
+        BENCHMARK_RUN("tsrb", BENCH_RUNS, _tsrb_pass());
+
+        lfrb_init(&_lfrb, _lfrb_buf, _len, FRAMES_NUMOF);
+        failed |= !_check("lfrb copy", _lfrb_copy_pass);
+        BENCHMARK_RUN("lfrb copy", BENCH_RUNS, _lfrb_copy_pass());
+        failed |= !_check("lfrb in place", _lfrb_in_place_pass);
+        BENCHMARK_RUN("lfrb in place", BENCH_RUNS, _lfrb_in_place_pass());
+
+        lfrb_mp_init(&_lfrb, _lfrb_buf, _len, FRAMES_NUMOF, _flags);
+        failed |= !_check("lfrb mp", _lfrb_mp_pass);
+        BENCHMARK_RUN("lfrb mp", BENCH_RUNS, _lfrb_mp_pass());
+        puts("");
+    }
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
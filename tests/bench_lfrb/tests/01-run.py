@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+BENCHMARK_REGEXP = r"\s*{func}:  min \d+\.\d+  median \d+\.\d+  p99 \d+\.\d+" \
+                   r"  max \d+\.\d+  mean \d+\.\d+ (us|cycles) per call" \
+                   r"  \(\d+ x \d+ calls\)"
+
+
+def testfunc(child):
+    child.expect_exact('lfrb benchmark')
+    for size in (16, 64, 256):
+        child.expect_exact("{} bytes".format(size))
+        for impl in ("tsrb", "lfrb copy", "lfrb in place", "lfrb mp"):
+            child.expect(BENCHMARK_REGEXP.format(func=impl))
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
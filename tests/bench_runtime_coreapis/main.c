@@ -26,7 +26,7 @@
 #include "thread_flags.h"
 
 #ifndef BENCH_RUNS
-#define BENCH_RUNS          (1000UL * 1000UL)
+#define BENCH_RUNS          (10UL * 1000UL)
 #endif
 
 static mutex_t _lock;
@@ -64,19 +64,19 @@ int main(void)
 
     t = thread_get_active();
 
-    BENCHMARK_FUNC("nop loop", BENCH_RUNS, __asm__ volatile ("nop"));
+    BENCHMARK_RUN("nop loop", BENCH_RUNS, __asm__ volatile ("nop"));
     puts("");
-    BENCHMARK_FUNC("mutex_init()", BENCH_RUNS, mutex_init(&_lock));
-    BENCHMARK_FUNC("mutex lock/unlock", BENCH_RUNS, _mutex_lockunlock());
+    BENCHMARK_RUN("mutex_init()", BENCH_RUNS, mutex_init(&_lock));
+    BENCHMARK_RUN("mutex lock/unlock", BENCH_RUNS, _mutex_lockunlock());
     puts("");
-    BENCHMARK_FUNC("thread_flags_set()", BENCH_RUNS, thread_flags_set(t, _flag));
-    BENCHMARK_FUNC("thread_flags_clear()", BENCH_RUNS, thread_flags_clear(_flag));
-    BENCHMARK_FUNC("thread flags set/wait any", BENCH_RUNS, _flag_waitany());
-    BENCHMARK_FUNC("thread flags set/wait all", BENCH_RUNS, _flag_waitall());
-    BENCHMARK_FUNC("thread flags set/wait one", BENCH_RUNS, _flag_waitone());
+    BENCHMARK_RUN("thread_flags_set()", BENCH_RUNS, thread_flags_set(t, _flag));
+    BENCHMARK_RUN("thread_flags_clear()", BENCH_RUNS, thread_flags_clear(_flag));
+    BENCHMARK_RUN("thread flags set/wait any", BENCH_RUNS, _flag_waitany());
+    BENCHMARK_RUN("thread flags set/wait all", BENCH_RUNS, _flag_waitall());
+    BENCHMARK_RUN("thread flags set/wait one", BENCH_RUNS, _flag_waitone());
     puts("");
-    BENCHMARK_FUNC("msg_try_receive()", BENCH_RUNS, msg_try_receive(&_msg));
-    BENCHMARK_FUNC("msg_avail()", BENCH_RUNS, msg_avail());
+    BENCHMARK_RUN("msg_try_receive()", BENCH_RUNS, msg_try_receive(&_msg));
+    BENCHMARK_RUN("msg_avail()", BENCH_RUNS, msg_avail());
 
     puts("\n[SUCCESS]");
     return 0;
@@ -12,7 +12,9 @@ from testrunner import run
 
 # The default timeout is not enough for this test on some of the slower boards
 TIMEOUT = 30
-BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+BENCHMARK_REGEXP = r"\s*{func}:  min \d+\.\d+  median \d+\.\d+  p99 \d+\.\d+" \
+                   r"  max \d+\.\d+  mean \d+\.\d+ (us|cycles) per call" \
+                   r"  \(\d+ x \d+ calls\)"
 
 
 def testfunc(child):
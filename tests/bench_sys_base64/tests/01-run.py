@@ -10,11 +10,16 @@ import sys
 from testrunner import run
 
 
+BENCHMARK_REGEXP = r"\s*{func}:  min \d+\.\d+  median \d+\.\d+  p99 \d+\.\d+" \
+                   r"  max \d+\.\d+  mean \d+\.\d+ (us|cycles) per call" \
+                   r"  \(\d+ x \d+ calls\)"
+
+
 def testfunc(child):
     child.expect_exact("Verifying that base64 encoding works for benchmark input: OK\r\n")
     child.expect_exact("Verifying that base64 decoding works for benchmark input: OK\r\n")
-    child.expect(r"Encoding 1\.000 x 96 bytes \(128 bytes in base64\): [0-9]+ µs\r\n")
-    child.expect(r"Decoding 1\.000 x 96 bytes \(128 bytes in base64\): [0-9]+ µs\r\n")
+    child.expect(BENCHMARK_REGEXP.format(func="encode 96 bytes"))
+    child.expect(BENCHMARK_REGEXP.format(func="decode 128 bytes"))
 
 
 if __name__ == "__main__":
@@ -12,7 +12,9 @@ from testrunner import run
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+(, \"ticks\" : \d+)? }")
+    child.expect(r"\s*thread_flags_set:  min \d+\.\d+  median \d+\.\d+  p99 \d+\.\d+"
+                 r"  max \d+\.\d+  mean \d+\.\d+ (us|cycles) per call"
+                 r"  \(\d+ x \d+ calls\)")
 
 
 if __name__ == "__main__":
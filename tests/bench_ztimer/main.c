@@ -18,10 +18,12 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
 
 #include "test_utils/expect.h"
 
+#include "benchmark.h"
 #include "msg.h"
 #include "thread.h"
 #include "ztimer.h"
@@ -57,11 +59,14 @@ static unsigned _triggers;
 /*
  * The test assumes that first, middle and last will always end up in at the
  * same index within the timer queue.  In order to compensate for the time that
- * previous operations take themselves, the interval is corrected. The
- * variables "start" and "_base" are used for that.
+ * previous operations take themselves, the interval is corrected before every
+ * sample. The variables "_start" and "_base" are used for that.
  */
+static uint32_t _start;
 uint32_t _base;
 
+static benchmark_t _bench;
+
 static void _callback(void *arg) {
     unsigned *triggers = arg;
     *triggers += 1;
@@ -86,209 +91,99 @@ static void _timer_remove(unsigned n)
     ztimer_remove(ZTIMER, &_timers[n]);
 }
 
-static void _print_result(const char *desc, unsigned n, uint32_t total)
+static void _timer_set_remove(unsigned n)
 {
-    printf("%30s %8"PRIu32" / %u = %"PRIu32"\n", desc, total, n, total/n);
+    _timer_set(n);
+    _timer_remove(n);
 }
 
-int main(void)
+static void _timer_remove_set(unsigned n)
 {
-    puts("ztimer benchmark application.\n");
-
-    unsigned n;
-    uint32_t before, diff, start;
+    _timer_remove(n);
+    _timer_set(n);
+}
 
-    /* initializing timer structs */
-    for (unsigned int n = 0; n < NUMOF_TIMERS; n++) {
-        _timers[n].callback = _callback;
-        _timers[n].arg = &_triggers;
-    }
+static void _now(unsigned n)
+{
+    (void)n;
+    ztimer_now(ZTIMER);
+}
 
-    start = ztimer_now(ZTIMER_USEC);
+static void _rebase(void)
+{
+    _base = BASE - (ztimer_now(ZTIMER_USEC) - _start);
+}
 
-    /*
-     * test setting one set timer REPEAT times
-     *
-     */
-    _base = BASE;
-    before = ztimer_now(ZTIMER_USEC);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(0);
+/* run 'op' on timer 'n' REPEAT times per sample */
+static void _run(const char *desc, void (*op)(unsigned), unsigned n)
+{
+    benchmark_init(&_bench, desc, REPEAT);
+    for (unsigned s = 0; s < CONFIG_BENCHMARK_WARMUP + CONFIG_BENCHMARK_SAMPLES;
+         s++) {
+        _rebase();
+        uint32_t before = benchmark_now();
+        for (unsigned i = 0; i < REPEAT; i++) {
+            op(n);
+        }
+        uint32_t diff = benchmark_now() - before;
+        if (s >= CONFIG_BENCHMARK_WARMUP) {
+            benchmark_add(&_bench, diff);
+        }
     }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("set() one", REPEAT, diff);
+    benchmark_report(&_bench);
     expect(!_triggers);
+}
 
-    /*
-     * test removing one unset timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(0);
+/* run 'op' once on all timers, first to last or last to first */
+static void _run_many(const char *desc, void (*op)(unsigned), bool decreasing)
+{
+    benchmark_init(&_bench, desc, NUMOF_TIMERS);
+    _rebase();
+    uint32_t before = benchmark_now();
+    for (unsigned n = 0; n < NUMOF_TIMERS; n++) {
+        op(decreasing ? NUMOF_TIMERS - n - 1 : n);
     }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("remove() one", REPEAT, diff);
+    benchmark_add(&_bench, benchmark_now() - before);
+    benchmark_report(&_bench);
     expect(!_triggers);
+}
 
-    /*
-     * test setting / removing one timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(0);
-        _timer_remove(0);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("set() + remove() one", REPEAT, diff);
-    expect(!_triggers);
+int main(void)
+{
+    puts("ztimer benchmark application.\n");
 
-    /*
-     * test setting NUMOF_TIMERS timers with increasing targets
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
+    /* initializing timer structs */
     for (unsigned int n = 0; n < NUMOF_TIMERS; n++) {
-        _timer_set(n);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("set() many increasing target", NUMOF_TIMERS, diff);
-    expect(!_triggers);
-
-    /*
-     * test re-setting first timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(0);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("re-set()  first", REPEAT, diff);
-    expect(!_triggers);
-
-    /*
-     * test setting middle timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(NUMOF_TIMERS/2);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("re-set() middle", REPEAT, diff);
-    expect(!_triggers);
-
-    /*
-     * test setting last timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_set(NUMOF_TIMERS - 1);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("re-set()   last", REPEAT, diff);
-    expect(!_triggers);
-
-    /*
-     * test removing / setting first timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(0);
-        _timer_set(0);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("remove() + set()  first", REPEAT, diff);
-    expect(!_triggers);
-
-    /*
-     * test removing / setting middle timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(NUMOF_TIMERS/2);
-        _timer_set(NUMOF_TIMERS/2);
-    }
-
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("remove() + set() middle", REPEAT, diff);
-    expect(!_triggers);
-
-    /*
-     * test removing / setting last timer REPEAT times
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    _base = BASE  - (before - start);
-    for (n = 0; n < REPEAT; n++) {
-        _timer_remove(NUMOF_TIMERS - 1);
-        _timer_set(NUMOF_TIMERS - 1);
+        _timers[n].callback = _callback;
+        _timers[n].arg = &_triggers;
     }
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
-
-    _print_result("remove() + set()   last", REPEAT, diff);
-    expect(!_triggers);
+    _start = ztimer_now(ZTIMER_USEC);
 
-    /*
-     * test removing NUMOF_TIMERS timers (latest first)
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    for (n = 0; n < NUMOF_TIMERS; n++) {
-        _timer_remove(NUMOF_TIMERS - n - 1);
-    }
+    /* setting one set timer, removing one unset timer, both */
+    _run("set() one", _timer_set, 0);
+    _run("remove() one", _timer_remove, 0);
+    _run("set() + remove() one", _timer_set_remove, 0);
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+    /* setting NUMOF_TIMERS timers with increasing targets */
+    _run_many("set() many increasing target", _timer_set, false);
 
-    _print_result("remove() many decreasing", NUMOF_TIMERS, diff);
-    expect(!_triggers);
+    /* re-setting first, middle and last timer */
+    _run("re-set()  first", _timer_set, 0);
+    _run("re-set() middle", _timer_set, NUMOF_TIMERS/2);
+    _run("re-set()   last", _timer_set, NUMOF_TIMERS - 1);
 
-    /*
-     * test ztimer_now()
-     *
-     */
-    before = ztimer_now(ZTIMER_USEC);
-    n = REPEAT;
-    while (n--) {
-        ztimer_now(ZTIMER);
-    }
+    /* removing / setting first, middle and last timer */
+    _run("remove() + set()  first", _timer_remove_set, 0);
+    _run("remove() + set() middle", _timer_remove_set, NUMOF_TIMERS/2);
+    _run("remove() + set()   last", _timer_remove_set, NUMOF_TIMERS - 1);
 
-    diff = ztimer_now(ZTIMER_USEC) - before;
+    /* removing NUMOF_TIMERS timers (latest first) */
+    _run_many("remove() many decreasing", _timer_remove, true);
 
-    _print_result("ztimer_now()", REPEAT, diff);
-    expect(!_triggers);
+    _run("ztimer_now()", _now, 0);
 
-    _print_result("sizeof(ztimer_t)", NUMOF_TIMERS, sizeof(_timers));
+    printf("sizeof(ztimer_t): %u\n", (unsigned)sizeof(ztimer_t));
 
     puts("done.");
 
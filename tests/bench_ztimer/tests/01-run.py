@@ -10,10 +10,16 @@ import sys
 from testrunner import run
 
 
+BENCHMARK_REGEXP = r"\s*[\w() _\+]+:  min \d+\.\d+  median \d+\.\d+" \
+                   r"  p99 \d+\.\d+  max \d+\.\d+  mean \d+\.\d+" \
+                   r" (us|cycles) per call  \(\d+ x \d+ calls\)\r\n"
+
+
 def testfunc(child):
     child.expect_exact("ztimer benchmark application.\r\n")
-    for i in range(13):
-        child.expect(r"\s+[\w() _\+]+\s+\d+ / \d+ = \d+\r\n")
+    for i in range(12):
+        child.expect(BENCHMARK_REGEXP)
+    child.expect(r"sizeof\(ztimer_t\): \d+\r\n")
 
     child.expect_exact("done.\r\n")
 
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for buffer channels
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chan.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#define BUF_SIZE        (64U)
+#define BUF_NUMOF       (4U)
+#define BURSTS          (8U)
+#define FLAG_CHAN       (0x1)
+
+static uint8_t _mem[BUF_NUMOF * CHAN_BUF_SIZE(BUF_SIZE)]
+    __attribute__((aligned(sizeof(void *))));
+static chan_pool_t _pool;
+static msg_t _queue[BUF_NUMOF];
+static msg_t _queue_other[BUF_NUMOF];
+static chan_t _chan;
+static chan_t _chan_other;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void _fill(chan_buf_t *buf, uint8_t seq)
+{
+    memset(chan_buf_data(buf), seq, BUF_SIZE);
+    buf->len = BUF_SIZE;
+    buf->type = seq;
+}
+
+static void _check(chan_buf_t *buf, uint8_t seq)
+{
+    uint8_t *data = chan_buf_data(buf);
+
+    /* the buffer was passed, not copied */
+    expect((data > _mem) && (data < _mem + sizeof(_mem)));
+    expect((buf->len == BUF_SIZE) && (buf->type == seq));
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        expect(data[i] == seq);
+    }
+}
+
+static void *_producer(void *arg)
+{
+    (void)arg;
+    uint8_t seq = 0;
+
+    for (unsigned burst = 0; burst < BURSTS; burst++) {
+        for (unsigned i = 0; i < BUF_NUMOF; i++) {
+            chan_buf_t *buf = chan_buf_alloc(&_pool);
+
+            expect(buf);
+            _fill(buf, seq++);
+            chan_send(&_chan, buf);
+        }
+        expect(chan_buf_alloc(&_pool) == NULL);
+        /* woken up when all buffers are back in the pool */
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+static void *_consumer(void *arg)
+{
+    (void)arg;
+
+    chan_buf_t *buf = chan_recv(&_chan);
+
+    _check(buf, 42);
+    chan_buf_release(buf);
+    return NULL;
+}
+
+static void _test_batch(void)
+{
+    chan_buf_t *bufs[2 * BUF_NUMOF];
+    unsigned seq = 0;
+
+    chan_notify(&_chan, thread_get_active(), FLAG_CHAN);
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _producer, NULL, "producer");
+
+    while (seq < BURSTS * BUF_NUMOF) {
+        thread_flags_wait_any(FLAG_CHAN);
+
+        /* the producer runs at higher priority and fills the pool at once */
+        unsigned numof = chan_try_recv_batch(&_chan, bufs, ARRAY_SIZE(bufs));
+        expect(numof == BUF_NUMOF);
+        for (unsigned i = 0; i < numof; i++) {
+            _check(bufs[i], seq++);
+            chan_buf_release(bufs[i]);
+        }
+        expect(chan_pool_avail(&_pool) == BUF_NUMOF);
+        expect(chan_try_recv(&_chan) == NULL);
+        thread_wakeup(pid);
+    }
+    chan_notify(&_chan, NULL, 0);
+    puts("batch receive: OK");
+}
+
+static void _test_shared(void)
+{
+    chan_buf_t *buf = chan_buf_alloc(&_pool);
+
+    expect(buf);
+    _fill(buf, 7);
+    chan_buf_hold(buf);
+    chan_send(&_chan, buf);
+    chan_send(&_chan_other, buf);
+    expect(chan_pool_avail(&_pool) == BUF_NUMOF - 1);
+
+    chan_buf_t *received = chan_recv(&_chan);
+    _check(received, 7);
+    chan_buf_release(received);
+    expect(chan_pool_avail(&_pool) == BUF_NUMOF - 1);
+
+    received = chan_recv(&_chan_other);
+    expect(received == buf);
+    chan_buf_release(received);
+    expect(chan_pool_avail(&_pool) == BUF_NUMOF);
+    puts("shared buffer: OK");
+}
+
+static void _test_full(void)
+{
+    chan_buf_t *bufs[BUF_NUMOF];
+
+    for (unsigned i = 0; i < BUF_NUMOF; i++) {
+        bufs[i] = chan_buf_alloc(&_pool);
+        chan_buf_hold(bufs[i]);
+        expect(chan_try_send(&_chan, bufs[i]));
+    }
+    /* the queue is full, the caller keeps its reference */
+    expect(chan_try_send(&_chan, bufs[0]) == 0);
+    expect(chan_try_recv_batch(&_chan, bufs, BUF_NUMOF) == BUF_NUMOF);
+    for (unsigned i = 0; i < BUF_NUMOF; i++) {
+        chan_buf_release(bufs[i]);
+        chan_buf_release(bufs[i]);
+    }
+    expect(chan_pool_avail(&_pool) == BUF_NUMOF);
+    puts("full queue: OK");
+}
+
+static void _test_blocking(void)
+{
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _consumer, NULL, "consumer");
+
+    chan_buf_t *buf = chan_buf_alloc(&_pool);
+
+    _fill(buf, 42);
+    /* the consumer is blocked in chan_recv() and takes it right away */
+    chan_send(&_chan, buf);
+    expect(chan_pool_avail(&_pool) == BUF_NUMOF);
+    puts("blocking receive: OK");
+}
+
+int main(void)
+{
+    puts("chan test");
+
+    chan_pool_init(&_pool, _mem, BUF_SIZE, BUF_NUMOF);
+    chan_init(&_chan, &_pool, _queue, ARRAY_SIZE(_queue));
+    chan_init(&_chan_other, &_pool, _queue_other, ARRAY_SIZE(_queue_other));
+
+    _test_batch();
+    _test_shared();
+    _test_full();
+    _test_blocking();
+
+    puts("[SUCCESS]");
+    return 0;
+}
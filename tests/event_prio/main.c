@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for priority event queues
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "event/prio.h"
+#include "shell.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define NUMOF           (4U)
+#define SLEEP_MS        (10U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static event_prio_queue_t _queue;
+static event_prio_t _events[NUMOF];
+static char _order[NUMOF + 1];
+static unsigned _handled;
+
+static void _handler(event_t *event)
+{
+    event_prio_t *ev = container_of(event, event_prio_t, super);
+
+    _order[_handled++] = 'a' + (ev - _events);
+}
+
+static void _run(void)
+{
+    event_prio_t *ev;
+
+    _handled = 0;
+    memset(_order, 0, sizeof(_order));
+    while ((ev = event_prio_get(&_queue))) {
+        event_prio_handle(&_queue, ev);
+    }
+}
+
+static int _check(const char *name, const char *expected)
+{
+    int ok = (strcmp(_order, expected) == 0);
+
+    printf("%s: %s %s\n", name, _order, ok ? "OK" : "FAILED");
+    return ok;
+}
+
+static void *_poster(void *arg)
+{
+    (void)arg;
+
+    ztimer_sleep(ZTIMER_MSEC, SLEEP_MS);
+    event_prio_post(&_queue, &_events[3], 0);
+    return NULL;
+}
+
+int main(void)
+{
+    int ok = 1;
+
+    puts("event_prio test");
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        _events[i].super.handler = _handler;
+    }
+    event_prio_queue_init(&_queue, "test");
+
+    /* lower priorities first, equal priorities in order of posting */
+    event_prio_post(&_queue, &_events[0], 5);
+    event_prio_post(&_queue, &_events[1], 1);
+    event_prio_post(&_queue, &_events[2], 5);
+    event_prio_post(&_queue, &_events[3], 0);
+    _run();
+    ok &= _check("priority", "dbac");
+
+    /* posting again moves a queued event, cancelled events are skipped */
+    event_prio_post(&_queue, &_events[0], 3);
+    event_prio_post(&_queue, &_events[1], 2);
+    event_prio_post(&_queue, &_events[2], 1);
+    event_prio_post(&_queue, &_events[0], 0);
+    event_prio_post(&_queue, &_events[3], 4);
+    event_prio_cancel(&_queue, &_events[2]);
+    _run();
+    ok &= _check("repost", "abd");
+
+    event_prio_post_deadline(&_queue, &_events[0], 100);
+    event_prio_post_deadline(&_queue, &_events[1], 10);
+    event_prio_post_deadline(&_queue, &_events[2], 50);
+    _run();
+    ok &= _check("deadline", "bca");
+
+    /* an event posted by another thread wakes up the waiting owner */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _poster, NULL, "poster");
+    _handled = 0;
+    memset(_order, 0, sizeof(_order));
+    event_prio_handle(&_queue, event_prio_wait(&_queue));
+    ok &= _check("wait", "d");
+
+    event_prio_stats_t stats;
+
+    event_prio_stats(&_queue, &stats);
+    printf("handled: %u, max latency: %u us\n",
+           (unsigned)stats.handled, (unsigned)stats.latency_max);
+    ok &= (stats.handled == 11);
+    ok &= (stats.latency_max >= SLEEP_MS * US_PER_MS);
+
+    puts(ok ? "[SUCCESS]" : "[FAILED]");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(NULL, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("event_prio test")
+    child.expect_exact("priority: dbac OK")
+    child.expect_exact("repost: abd OK")
+    child.expect_exact("deadline: bca OK")
+    child.expect_exact("wait: d OK")
+    child.expect_exact("[SUCCESS]")
+    child.sendline("evprio")
+    child.expect(r"test\s+\|\s+11 \|\s+0 \|\s+\d+ \|\s+\d+\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the longest-prefix match trie of the NIB against the
+ *              behavior of the linear search
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "random.h"
+
+#define IFACE           (6)
+#define RANDOM_ROUNDS   (2000U)
+
+static void set_up(void)
+{
+    void *state = NULL;
+    gnrc_ipv6_nib_ft_t fte;
+
+    while (gnrc_ipv6_nib_ft_iter(NULL, 0, &state, &fte)) {
+        gnrc_ipv6_nib_ft_del(&fte.dst, fte.dst_len);
+        state = NULL;
+    }
+}
+
+static void _next_hop(ipv6_addr_t *next_hop, unsigned id)
+{
+    ipv6_addr_from_str(next_hop, "fe80::");
+    next_hop->u16[7] = byteorder_htons(id + 1);
+}
+
+/* the behavior of the linear search: most matching bits wins, on ties the
+ * first entry in the table wins */
+static bool _linear_get(const ipv6_addr_t *dst, gnrc_ipv6_nib_ft_t *res)
+{
+    void *state = NULL;
+    gnrc_ipv6_nib_ft_t fte;
+    uint8_t best_match = 0;
+
+    while (gnrc_ipv6_nib_ft_iter(NULL, 0, &state, &fte)) {
+        uint8_t match = ipv6_addr_match_prefix(&fte.dst, dst);
+
+        if ((fte.dst_len > 0) && (match > best_match) &&
+            (match >= fte.dst_len)) {
+            *res = fte;
+            best_match = match;
+        }
+    }
+    return (best_match > 0);
+}
+
+static void test_lpm_trie__nested(void)
+{
+    ipv6_addr_t pfx, dst, next_hop;
+    gnrc_ipv6_nib_ft_t fte;
+
+    ipv6_addr_from_str(&pfx, "2001:db8::");
+    _next_hop(&next_hop, 32);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 32, &next_hop, IFACE, 0));
+    ipv6_addr_from_str(&pfx, "2001:db8:1::");
+    _next_hop(&next_hop, 48);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 48, &next_hop, IFACE, 0));
+    ipv6_addr_from_str(&pfx, "2001:db8:1:2::");
+    _next_hop(&next_hop, 64);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 64, &next_hop, IFACE, 0));
+
+    ipv6_addr_from_str(&dst, "2001:db8:1:2::1");
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(64, fte.dst_len);
+    ipv6_addr_from_str(&dst, "2001:db8:1:3::1");
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(48, fte.dst_len);
+    ipv6_addr_from_str(&dst, "2001:db8:2::1");
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(32, fte.dst_len);
+    ipv6_addr_from_str(&dst, "2001:db9::1");
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+
+    /* removing the intermediate prefix must not cut off the more specific
+     * one */
+    ipv6_addr_from_str(&pfx, "2001:db8:1::");
+    gnrc_ipv6_nib_ft_del(&pfx, 48);
+    ipv6_addr_from_str(&dst, "2001:db8:1:3::1");
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(32, fte.dst_len);
+    ipv6_addr_from_str(&dst, "2001:db8:1:2::1");
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(64, fte.dst_len);
+}
+
+static void _random_addr(ipv6_addr_t *addr)
+{
+    random_bytes(addr->u8, sizeof(addr->u8));
+    /* keep prefixes close together so they nest and diverge late */
+    addr->u16[0] = byteorder_htons(0x2001);
+    addr->u8[2] &= 0x3;
+}
+
+static void test_lpm_trie__random(void)
+{
+    for (unsigned i = 0; i < RANDOM_ROUNDS; i++) {
+        ipv6_addr_t pfx, dst, next_hop;
+        gnrc_ipv6_nib_ft_t fte, exp;
+        unsigned pfx_len = random_uint32_range(1, IPV6_ADDR_BIT_LEN + 1);
+
+        _random_addr(&pfx);
+        if (random_uint32_range(0, 3) == 0) {
+            /* remove the best route covering pfx, if there is one */
+            if (_linear_get(&pfx, &exp)) {
+                gnrc_ipv6_nib_ft_del(&exp.dst, exp.dst_len);
+            }
+        }
+        else {
+            _next_hop(&next_hop, i);
+            /* -ENOMEM once table is full is fine */
+            gnrc_ipv6_nib_ft_add(&pfx, pfx_len, &next_hop, IFACE, 0);
+        }
+        /* query a destination below the new prefix and an unrelated one */
+        _random_addr(&dst);
+        ipv6_addr_init_prefix(&dst, &pfx, pfx_len);
+        for (unsigned j = 0; j < 2; j++) {
+            if (_linear_get(&dst, &exp)) {
+                TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+                TEST_ASSERT(ipv6_addr_equal(&exp.dst, &fte.dst));
+                TEST_ASSERT_EQUAL_INT(exp.dst_len, fte.dst_len);
+                TEST_ASSERT(ipv6_addr_equal(&exp.next_hop, &fte.next_hop));
+            }
+            else {
+                TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                                      gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+            }
+            _random_addr(&dst);
+        }
+    }
+}
+
+static Test *tests_lpm_trie(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_lpm_trie__nested),
+        new_TestFixture(test_lpm_trie__random),
+    };
+
+    EMB_UNIT_TESTCALLER(lpm_trie_tests, set_up, NULL, fixtures);
+
+    return (Test *)&lpm_trie_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_lpm_trie());
+    TESTS_END();
+
+    return 0;
+}
+/** @} */
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for the size-class packet buffer implementation
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf/slab.h"
+
+#define TEST_STRING4    "test"
+#define TEST_STRING16   "fdsalkhjfkasdhf"
+
+enum {
+    CLS_SNIP = 0,
+    CLS_SMALL,
+    CLS_MEDIUM,
+    CLS_LARGE,
+};
+
+static uint8_t _large[CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE];
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static unsigned _used(unsigned cls)
+{
+    gnrc_pktbuf_slab_class_stats_t stats;
+
+    gnrc_pktbuf_slab_get_class_stats(cls, &stats);
+    return stats.used;
+}
+
+static void test_pktbuf_slab_add__size_classes(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, TEST_STRING16,
+                                    sizeof(TEST_STRING16)));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* 16 bytes fit into a snip sized block, so both come from that class */
+    TEST_ASSERT_EQUAL_INT(2, _used(CLS_SNIP));
+    gnrc_pktbuf_release(pkt);
+    pkt = gnrc_pktbuf_add(NULL, NULL, CONFIG_GNRC_PKTBUF_SLAB_MEDIUM_SIZE,
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _used(CLS_SNIP));
+    TEST_ASSERT_EQUAL_INT(0, _used(CLS_SMALL));
+    TEST_ASSERT_EQUAL_INT(1, _used(CLS_MEDIUM));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__too_large(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL,
+                                     CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__fallback(void)
+{
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF + 1];
+    gnrc_pktbuf_slab_class_stats_t stats;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, NULL, CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE,
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF, _used(CLS_SMALL));
+    TEST_ASSERT_EQUAL_INT(1, _used(CLS_MEDIUM));
+    gnrc_pktbuf_slab_get_class_stats(CLS_SMALL, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.fallbacks);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    gnrc_pktbuf_slab_get_class_stats(CLS_SMALL, &stats);
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF, stats.max_used);
+}
+
+static void test_pktbuf_slab_add__memfull(void)
+{
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+    gnrc_pktbuf_slab_stats_t stats;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, _large, sizeof(_large),
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, _large, sizeof(_large),
+                                     GNRC_NETTYPE_TEST));
+    gnrc_pktbuf_slab_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.fails);
+    /* there are more free bytes in the smaller classes than requested */
+    TEST_ASSERT_EQUAL_INT(1, stats.frag_fails);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_mark__shared_block(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+    gnrc_pktbuf_slab_stats_t stats;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, sizeof(TEST_STRING4) - 1, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(pkt->next == hdr);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(hdr->data, TEST_STRING16,
+                                    sizeof(TEST_STRING4) - 1));
+    TEST_ASSERT(pkt->data == ((uint8_t *)hdr->data) + sizeof(TEST_STRING4) - 1);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16) - sizeof(TEST_STRING4) + 1,
+                          pkt->size);
+    /* no data was copied: two snips and one shared data block */
+    TEST_ASSERT_EQUAL_INT(3, _used(CLS_SNIP));
+    gnrc_pktbuf_slab_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16) + 2 * sizeof(gnrc_pktsnip_t),
+                          stats.requested);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* releasing the header first must keep the payload's block */
+    TEST_ASSERT_NOT_NULL(gnrc_pktbuf_remove_snip(pkt, hdr));
+    TEST_ASSERT_EQUAL_INT(2, _used(CLS_SNIP));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_realloc_data(void)
+{
+    gnrc_pktsnip_t *pkt;
+    void *data;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    /* shrinking and growing within the block does not move the data */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, sizeof(TEST_STRING4)));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, sizeof(TEST_STRING16)));
+    TEST_ASSERT(data == pkt->data);
+    /* growing beyond the block moves the data to a bigger class */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt,
+                                                      CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    TEST_ASSERT(data != pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, TEST_STRING16,
+                                    sizeof(TEST_STRING16)));
+    TEST_ASSERT_EQUAL_INT(1, _used(CLS_SMALL));
+    TEST_ASSERT_EQUAL_INT(ENOMEM,
+                          gnrc_pktbuf_realloc_data(pkt,
+                                                   CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE + 1));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_start_write(void)
+{
+    gnrc_pktsnip_t *pkt, *pkt_copy;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_hold(pkt, 1);
+    pkt_copy = gnrc_pktbuf_start_write(pkt);
+    TEST_ASSERT_NOT_NULL(pkt_copy);
+    TEST_ASSERT(pkt != pkt_copy);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    TEST_ASSERT_EQUAL_INT(1, pkt_copy->users);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_release(pkt_copy);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_pktbuf_slab(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab_add__size_classes),
+        new_TestFixture(test_pktbuf_slab_add__too_large),
+        new_TestFixture(test_pktbuf_slab_add__fallback),
+        new_TestFixture(test_pktbuf_slab_add__memfull),
+        new_TestFixture(test_pktbuf_slab_mark__shared_block),
+        new_TestFixture(test_pktbuf_slab_realloc_data),
+        new_TestFixture(test_pktbuf_slab_start_write),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, set_up, NULL, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_pktbuf_slab());
+    TESTS_END();
+
+    return 0;
+}
+/** @} */
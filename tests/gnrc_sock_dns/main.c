@@ -23,10 +23,13 @@
 
 #include <arpa/inet.h>
 
+#include "event.h"
 #include "net/sock/dns.h"
 #include "shell.h"
 
 #define MAIN_QUEUE_SIZE     (8)
+/* number of asynchronous requests for the same name at once */
+#define ASYNC_REQ_NUMOF     (3U)
 static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
 
 static int _dns(int argc, char **argv);
@@ -36,11 +39,15 @@ static const shell_command_t _shell_commands[] = {
     { NULL, NULL, NULL },
 };
 static char _shell_buffer[SHELL_DEFAULT_BUFSIZE];
+static sock_dns_req_t _async_reqs[ASYNC_REQ_NUMOF];
+static event_queue_t _async_queue;
+static unsigned _async_pending;
 
 static void _usage(char *cmd)
 {
     printf("usage: %s server <DNS server addr> <DNS server port>\n", cmd);
     printf("       %s request <name>\n", cmd);
+    printf("       %s async <name>\n", cmd);
 }
 
 static int _dns_server(int argc, char **argv)
@@ -70,25 +77,61 @@ static int _dns_server(int argc, char **argv)
     return 0;
 }
 
-static int _dns_request(char **argv)
+static int _print_result(const char *name, int res, const void *addr)
 {
-    uint8_t addr[16] = {0};
-    int res = sock_dns_query(argv[2], addr, AF_UNSPEC);
-
     if (res > 0) {
         char addrstr[INET6_ADDRSTRLEN];
 
         inet_ntop(res == 4 ? AF_INET : AF_INET6, addr, addrstr,
                   sizeof(addrstr));
-        printf("%s resolves to %s\n", argv[2], addrstr);
+        printf("%s resolves to %s\n", name, addrstr);
     }
     else {
-        printf("error resolving %s\n", argv[2]);
+        printf("error resolving %s\n", name);
         return 1;
     }
     return 0;
 }
 
+static int _dns_request(char **argv)
+{
+    uint8_t addr[16] = {0};
+    int res = sock_dns_query(argv[2], addr, AF_UNSPEC);
+
+    return _print_result(argv[2], res, addr);
+}
+
+static void _async_cb(sock_dns_req_t *req, int res, const void *addr,
+                      void *arg)
+{
+    (void)req;
+    _print_result(arg, res, addr);
+    _async_pending--;
+}
+
+static int _dns_async(char **argv)
+{
+    int res = 0;
+
+    event_queue_init(&_async_queue);
+    /* all requests are pending at the same time and share a single query */
+    for (unsigned i = 0; i < ASYNC_REQ_NUMOF; i++) {
+        if (sock_dns_query_async(&_async_reqs[i], argv[2], AF_UNSPEC,
+                                 &_async_queue, _async_cb, argv[2]) < 0) {
+            printf("error resolving %s\n", argv[2]);
+            res = 1;
+            continue;
+        }
+        _async_pending++;
+    }
+    while (_async_pending > 0) {
+        event_t *event = event_wait(&_async_queue);
+
+        event->handler(event);
+    }
+    return res;
+}
+
 static int _dns(int argc, char **argv)
 {
     if ((argc > 1) && (strcmp(argv[1], "server") == 0)) {
@@ -97,6 +140,9 @@ static int _dns(int argc, char **argv)
     else if ((argc > 2) && (strcmp(argv[1], "request") == 0)) {
         return _dns_request(argv);
     }
+    else if ((argc > 2) && (strcmp(argv[1], "async") == 0)) {
+        return _dns_async(argv);
+    }
     else {
         _usage(argv[0]);
         return 1;
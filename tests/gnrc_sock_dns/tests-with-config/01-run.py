@@ -9,6 +9,7 @@
 import base64
 import os
 import re
+import select
 import socket
 import sys
 import subprocess
@@ -35,6 +36,7 @@ TEST_A_DATA = "10.0.0.1"
 TEST_AAAA_DATA = "2001:db8::1"
 TEST_QDCOUNT = 2
 TEST_ANCOUNT = 2
+TEST_ASYNC_NUMOF = 3
 
 
 class Server(threading.Thread):
@@ -82,6 +84,14 @@ class Server(threading.Thread):
         self.reply = reply
         self.enter_loop.set()
 
+    def unanswered(self):
+        # drops the queries received while not listening
+        count = 0
+        while select.select([self.socket], [], [], 0)[0]:
+            self.socket.recv(1500)
+            count += 1
+        return count
+
     def stop(self):
         self.stopped = True
         self.enter_loop.set()
@@ -150,6 +160,24 @@ def test_success(child):
     assert(successful_dns_request(child, TEST_NAME, TEST_AAAA_DATA))
 
 
+def test_async_shared_query(child):
+    server.listen(DNS(qr=1, qdcount=TEST_QDCOUNT, ancount=TEST_ANCOUNT,
+                      qd=(DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_AAAA) /
+                          DNSQR(qname=TEST_NAME, qtype=DNS_RR_TYPE_A)),
+                      an=(DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_AAAA,
+                                rdlen=DNS_RR_TYPE_AAAA_DLEN,
+                                rdata=TEST_AAAA_DATA) /
+                          DNSRR(rrname=TEST_NAME, type=DNS_RR_TYPE_A,
+                                rdlen=DNS_RR_TYPE_A_DLEN, rdata=TEST_A_DATA))))
+    child.sendline("dns async {}".format(TEST_NAME))
+    # a request sending its own query would not get a reply
+    for _ in range(TEST_ASYNC_NUMOF):
+        child.expect_exact("{} resolves to {}".format(TEST_NAME,
+                                                      TEST_AAAA_DATA),
+                           timeout=3)
+    assert(server.unanswered() == 0)
+
+
 def test_timeout(child):
     # listen but send no reply
     server.listen()
@@ -295,6 +323,7 @@ def testfunc(child):
                     raise e
 
         run(test_success)
+        run(test_async_shared_query)
         run(test_timeout)
         run(test_too_short_response)
         run(test_qdcount_too_large1)
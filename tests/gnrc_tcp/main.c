@@ -6,6 +6,7 @@
  * directory for more details.
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -15,7 +16,9 @@
 #include "net/gnrc/tcp.h"
 
 #define MAIN_QUEUE_SIZE (8)
+#ifndef TCB_QUEUE_SIZE
 #define TCB_QUEUE_SIZE (1)
+#endif
 #define BUFFER_SIZE (2049)
 
 static msg_t main_msg_queue[MAIN_QUEUE_SIZE];
@@ -421,6 +424,20 @@ int gnrc_tcp_queue_get_local_cmd(int argc, char **argv)
     return 0;
 }
 
+int gnrc_tcp_get_rcvbuf_stats_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+    gnrc_tcp_rcvbuf_stats_t stats;
+
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    printf("%s: returns\n", argv[0]);
+    printf("Receive pool: chunks=%u free=%u free_min=%u users=%u denied=%" PRIu32
+           " refused=%" PRIu32 " reserved=%u\n", stats.chunks, stats.chunks_free,
+           stats.chunks_free_min, stats.users, stats.denied, stats.refused,
+           stats.chunks_reserved);
+    return 0;
+}
+
 /* Exporting GNRC TCP Api to for shell usage */
 static const shell_command_t shell_commands[] = {
     { "gnrc_tcp_ep_from_str", "Build endpoint from string",
@@ -449,6 +466,8 @@ static const shell_command_t shell_commands[] = {
       gnrc_tcp_get_remote_cmd },
     { "gnrc_tcp_queue_get_local", "gnrc_tcp: get queue local",
       gnrc_tcp_queue_get_local_cmd },
+    { "gnrc_tcp_get_rcvbuf_stats", "gnrc_tcp: get receive pool statistics",
+      gnrc_tcp_get_rcvbuf_stats_cmd },
     { "buffer_init", "init internal buffer",
       buffer_init_cmd },
     { "buffer_get_max_size", "get max size of internal buffer",
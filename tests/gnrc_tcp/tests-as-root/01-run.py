@@ -558,6 +558,32 @@ def test_gnrc_tcp_queue_get_local_returns_EADDRNOTAVAIL(child):
     child.expect_exact('gnrc_tcp_queue_get_local: returns -EADDRNOTAVAIL')
 
 
+@Runner(timeout=1)
+def test_gnrc_tcp_get_rcvbuf_stats(child):
+    """ This test verifies that a listening TCB holds a single chunk of the
+        receive pool and returns it and its reserved chunks after stop_listen.
+    """
+    child.sendline('gnrc_tcp_get_rcvbuf_stats')
+    child.expect(r'Receive pool: chunks=(\d+) free=(\d+) free_min=\d+ users=0 '
+                 r'denied=0 refused=0 reserved=0')
+    chunks = int(child.match.group(1))
+    assert int(child.match.group(2)) == chunks
+
+    riot_srv = RiotTcpServer(child, generate_port_number())
+    riot_srv.listen()
+    child.sendline('gnrc_tcp_get_rcvbuf_stats')
+    child.expect_exact('Receive pool: chunks={} free={} free_min={} users=1'.format(
+        chunks, chunks - 1, chunks - 1)
+    )
+    riot_srv.stop_listen()
+
+    child.sendline('gnrc_tcp_get_rcvbuf_stats')
+    child.expect_exact('Receive pool: chunks={} free={} free_min={} users=0'.format(
+        chunks, chunks, chunks - 1)
+    )
+    child.expect_exact('reserved=0')
+
+
 @Runner(timeout=5)
 def test_gnrc_tcp_accept_respects_GNRC_TCP_NO_TIMEOUT(child):
     """ gnrc_tcp_accept timeout mechanism must be disabled if GNRC_TCP_NO_TIMEOUT
@@ -0,0 +1 @@
+../gnrc_tcp/main.c
\ No newline at end of file
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+from helpers import Runner, RiotTcpServer, RiotTcpClient, HostTcpServer, HostTcpClient, \
+                    generate_port_number, sudo_guard
+
+
+@Runner(timeout=5)
+def test_send_data_from_riot_to_host(child):
+    """ Send Data from RIOT Node to Host system """
+    # Setup Host as server
+    with HostTcpServer(generate_port_number()) as host_srv:
+        # Setup Riot as client
+        with RiotTcpClient(child, host_srv) as riot_cli:
+            # Accept and close connection
+            host_srv.accept()
+
+            # Send Data from RIOT to Host system and verify reception
+            data = '0123456789' * 200
+            riot_cli.send(timeout_ms=0, payload_to_send=data)
+            host_srv.receive(data)
+
+            # Teardown connection
+            host_srv.close()
+
+
+@Runner(timeout=5)
+def test_send_data_from_host_to_riot(child):
+    """ Send Data from Host system to RIOT node """
+    # Setup RIOT as server
+    with RiotTcpServer(child, generate_port_number()) as riot_srv:
+        # Setup Host as client
+        with HostTcpClient(riot_srv) as host_cli:
+            riot_srv.accept(timeout_ms=1000)
+
+            # Send Data from Host system to RIOT
+            data = '0123456789' * 200
+            host_cli.send(data)
+            riot_srv.receive(timeout_ms=1000, sent_payload=data)
+
+            riot_srv.close()
+
+
+@Runner(timeout=10)
+def test_connections_share_local_port(child):
+    """ Two connections to the same listening port. Both listening TCBs are
+        in the same bucket, each one moves to the bucket of its connection
+        once a SYN arrived. Data of each connection must end up in its TCB.
+    """
+    with RiotTcpServer(child, generate_port_number()) as riot_srv:
+        with HostTcpClient(riot_srv) as host_cli1, HostTcpClient(riot_srv) as host_cli2:
+            payloads = {
+                host_cli1.sock.getsockname()[1]: ('first ' * 20, host_cli1),
+                host_cli2.sock.getsockname()[1]: ('second ' * 20, host_cli2),
+            }
+            for data, host_cli in payloads.values():
+                host_cli.send(data)
+
+            for _ in range(len(payloads)):
+                riot_srv.accept(timeout_ms=1000)
+
+                # Find the host client of the accepted connection
+                riot_srv.get_remote()
+                child.expect(r'port=(\d+)')
+                data, host_cli = payloads.pop(int(child.match.group(1)))
+
+                riot_srv.receive(timeout_ms=1000, sent_payload=data)
+                riot_srv.send(timeout_ms=0, payload_to_send=data)
+                host_cli.receive(data)
+                riot_srv.close()
+
+        # The TCBs listen again, so another connection can be accepted
+        with HostTcpClient(riot_srv):
+            riot_srv.accept(timeout_ms=1000)
+            riot_srv.close()
+
+
+@Runner(timeout=1)
+def test_gnrc_tcp_get_rcvbuf_stats(child):
+    """ Every listening TCB holds a single chunk of the receive pool and
+        reserves none.
+    """
+    child.sendline('gnrc_tcp_get_rcvbuf_stats')
+    child.expect(r'Receive pool: chunks=(\d+) free=(\d+) free_min=\d+ users=0 '
+                 r'denied=0 refused=0 reserved=0')
+    chunks = int(child.match.group(1))
+
+    with RiotTcpServer(child, generate_port_number()):
+        child.sendline('gnrc_tcp_get_rcvbuf_stats')
+        child.expect_exact('Receive pool: chunks={} free={} '.format(chunks, chunks - 2))
+        child.expect_exact('users=2 denied=0 refused=0 reserved=0')
+
+
+if __name__ == '__main__':
+    sudo_guard(uses_scapy=False)
+
+    # Read and run all test functions.
+    script = sys.modules[__name__]
+    tests = [getattr(script, t) for t in script.__dict__
+             if type(getattr(script, t)).__name__ == 'function'
+             and t.startswith('test_')]
+
+    for test in tests:
+        res = test()
+        if (res != 0):
+            sys.exit(res)
+
+    print('\n' + os.path.basename(sys.argv[0]) + ': success\n')
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test for the lock-free ringbuffer
+ *
+ * Timer ISRs and a thread write numbered elements into a small ringbuffer
+ * while the main thread reads them. The consumer checks that the elements
+ * of every producer arrive complete, in order and without gaps.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "lfrb.h"
+#include "thread.h"
+#include "ztimer.h"
+#include "ztimer/periodic.h"
+
+#ifndef DURATION_US
+#define DURATION_US         (2000000UL)
+#endif
+
+#define ELEMS_NUMOF         (32U)
+#define PRODUCERS_NUMOF     (3U)
+#define THREAD_PRODUCER     (PRODUCERS_NUMOF - 1)
+
+typedef struct {
+    uint32_t seq;
+    uint8_t producer;
+    uint8_t payload[19];
+} _elem_t;
+
+static _elem_t _buf[ELEMS_NUMOF];
+static atomic_uint_least32_t _flags[LFRB_MP_FLAGS_NUMOF(ELEMS_NUMOF)];
+static lfrb_t _rb;
+
+static ztimer_periodic_t _timers[PRODUCERS_NUMOF - 1];
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static volatile bool _stop;
+
+/* written by the producers only */
+static uint32_t _sent[PRODUCERS_NUMOF];
+static unsigned _full[PRODUCERS_NUMOF];
+/* written by the consumer only */
+static uint32_t _received[PRODUCERS_NUMOF];
+static unsigned _errors;
+
+static void _fill(_elem_t *elem, unsigned producer)
+{
+    elem->seq = _sent[producer]++;
+    elem->producer = producer;
+    memset(elem->payload, (uint8_t)elem->seq, sizeof(elem->payload));
+}
+
+static void _check(const _elem_t *elem)
+{
+    if ((elem->producer >= PRODUCERS_NUMOF) ||
+        (elem->seq != _received[elem->producer]) ||
+        (elem->payload[0] != (uint8_t)elem->seq) ||
+        (elem->payload[sizeof(elem->payload) - 1] != (uint8_t)elem->seq)) {
+        if (_errors++ < 5) {
+            printf("Error: producer %u sent %" PRIu32 ", expected %" PRIu32
+                   "\n", elem->producer, elem->seq,
+                   _received[elem->producer % PRODUCERS_NUMOF]);
+        }
+        return;
+    }
+    _received[elem->producer]++;
+}
+
+/* single producer: writes up to five elements in place */
+static bool _spsc_cb(void *arg)
+{
+    unsigned producer = (uintptr_t)arg;
+    unsigned n = 5;
+    _elem_t *elems = lfrb_reserve(&_rb, &n);
+
+    if (elems == NULL) {
+        _full[producer]++;
+        return ZTIMER_PERIODIC_KEEP_GOING;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        _fill(&elems[i], producer);
+    }
+    lfrb_commit(&_rb, n);
+
+    return ZTIMER_PERIODIC_KEEP_GOING;
+}
+
+/* multiple producers: ISRs copy, the thread writes in place */
+static bool _mpsc_cb(void *arg)
+{
+    unsigned producer = (uintptr_t)arg;
+    _elem_t elems[3];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(elems); i++) {
+        _fill(&elems[i], producer);
+    }
+
+    unsigned n = lfrb_mp_put(&_rb, elems, ARRAY_SIZE(elems));
+
+    if (n < ARRAY_SIZE(elems)) {
+        /* send the rest again next time */
+        _sent[producer] -= ARRAY_SIZE(elems) - n;
+        _full[producer]++;
+    }
+
+    return ZTIMER_PERIODIC_KEEP_GOING;
+}
+
+static void *_producer_thread(void *arg)
+{
+    (void)arg;
+
+    while (!_stop) {
+        unsigned n = 4;
+        _elem_t *elems = lfrb_mp_reserve(&_rb, &n);
+
+        if (elems == NULL) {
+            _full[THREAD_PRODUCER]++;
+            thread_yield();
+            continue;
+        }
+        for (unsigned i = 0; i < n; i++) {
+            _fill(&elems[i], THREAD_PRODUCER);
+        }
+        lfrb_mp_commit(&_rb, elems, n);
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+static void _start(ztimer_periodic_callback_t cb, unsigned numof)
+{
+    /* intervals without common factors, so the ISRs drift against the
+     * consumer */
+    static const uint32_t intervals[] = { 97, 131 };
+
+    memset(_sent, 0, sizeof(_sent));
+    memset(_full, 0, sizeof(_full));
+    memset(_received, 0, sizeof(_received));
+    _stop = false;
+
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_periodic_init(ZTIMER_USEC, &_timers[i], cb,
+                             (void *)(uintptr_t)i, intervals[i]);
+        ztimer_periodic_start(&_timers[i]);
+    }
+}
+
+static void _finish(const char *name, unsigned numof)
+{
+    uint32_t total = 0;
+    unsigned full = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_periodic_stop(&_timers[i]);
+    }
+
+    /* drain what was committed before the producers stopped */
+    for (_elem_t elem; lfrb_get(&_rb, &elem, 1);) {
+        _check(&elem);
+    }
+
+    for (unsigned i = 0; i < PRODUCERS_NUMOF; i++) {
+        if (_received[i] != _sent[i]) {
+            printf("Error: %s producer %u sent %" PRIu32 ", received %"
+                   PRIu32 "\n", name, i, _sent[i], _received[i]);
+            _errors++;
+        }
+        total += _received[i];
+        full += _full[i];
+    }
+    printf("%s: %" PRIu32 " elements, %u times full\n", name, total, full);
+}
+
+static void _test_spsc(void)
+{
+    lfrb_init(&_rb, _buf, sizeof(_elem_t), ELEMS_NUMOF);
+    _start(_spsc_cb, 1);
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    while (ztimer_now(ZTIMER_USEC) - start < DURATION_US) {
+        unsigned n = ELEMS_NUMOF;
+        const _elem_t *elems = lfrb_acquire(&_rb, &n);
+
+        for (unsigned i = 0; i < n; i++) {
+            _check(&elems[i]);
+        }
+        lfrb_release(&_rb, n);
+    }
+
+    _finish("spsc", 1);
+}
+
+static void _test_mpsc(void)
+{
+    lfrb_mp_init(&_rb, _buf, sizeof(_elem_t), ELEMS_NUMOF, _flags);
+    _start(_mpsc_cb, PRODUCERS_NUMOF - 1);
+
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN,
+                                     THREAD_CREATE_STACKTEST,
+                                     _producer_thread, NULL, "producer");
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    while (ztimer_now(ZTIMER_USEC) - start < DURATION_US) {
+        _elem_t elems[7];
+        unsigned n = lfrb_get(&_rb, elems, ARRAY_SIZE(elems));
+
+        for (unsigned i = 0; i < n; i++) {
+            _check(&elems[i]);
+        }
+        thread_yield();
+    }
+
+    _stop = true;
+    /* let the producer thread run into the stop flag */
+    while (thread_getstatus(pid) != STATUS_NOT_FOUND) {
+        thread_yield();
+    }
+    _finish("mpsc", PRODUCERS_NUMOF - 1);
+}
+
+int main(void)
+{
+    puts("lfrb stress test");
+
+    _test_spsc();
+    _test_mpsc();
+
+    puts(_errors ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
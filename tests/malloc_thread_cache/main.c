@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the per-thread heap caches
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "malloc_thread_cache.h"
+#include "ps.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static void *_block;
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    /* a block of another thread goes into the cache of this one */
+    free(_block);
+    _block = malloc(MALLOC_THREAD_CACHE_MIN);
+
+    /* stay alive, so that main can get the statistics */
+    thread_sleep();
+    return NULL;
+}
+
+int main(void)
+{
+    malloc_thread_cache_stats_t before, stats;
+    kernel_pid_t me = thread_getpid();
+
+    puts("malloc_thread_cache test");
+
+    /* the main thread may have used the heap during auto init already */
+    malloc_thread_cache_stats(me, &before);
+
+    /* requests of the same class are served from the cache */
+    void *ptr = malloc(20);
+    expect(ptr);
+    memset(ptr, 0xaa, 20);
+    free(ptr);
+    void *again = calloc(1, 32);
+    expect(again == ptr);
+    for (unsigned i = 0; i < 32; i++) {
+        expect(((uint8_t *)again)[i] == 0);
+    }
+    malloc_thread_cache_stats(me, &stats);
+    expect((stats.allocs - before.allocs == 2)
+           && (stats.frees - before.frees == 1)
+           && (stats.hits - before.hits == 1));
+
+    /* blocks larger than the largest class are never cached */
+    void *large = malloc(2 * MALLOC_THREAD_CACHE_MAX);
+    expect(large);
+    free(large);
+
+    /* the cache of a class is limited */
+    void *blocks[CONFIG_MALLOC_THREAD_CACHE_DEPTH + 1];
+    for (unsigned i = 0; i < ARRAY_SIZE(blocks); i++) {
+        blocks[i] = malloc(MALLOC_THREAD_CACHE_MAX);
+        expect(blocks[i]);
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(blocks); i++) {
+        free(blocks[i]);
+    }
+    malloc_thread_cache_stats(me, &before);
+    for (unsigned i = 0; i < ARRAY_SIZE(blocks); i++) {
+        blocks[i] = malloc(MALLOC_THREAD_CACHE_MAX);
+    }
+    malloc_thread_cache_stats(me, &stats);
+    expect(stats.hits - before.hits == CONFIG_MALLOC_THREAD_CACHE_DEPTH);
+    for (unsigned i = 0; i < ARRAY_SIZE(blocks); i++) {
+        free(blocks[i]);
+    }
+    malloc_thread_cache_flush();
+    free(again);
+
+    /* freeing a block allocated by another thread */
+    _block = malloc(MALLOC_THREAD_CACHE_MIN);
+    void *freed = _block;
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _thread, NULL, "thread");
+    expect(_block == freed);
+    malloc_thread_cache_stats(pid, &stats);
+    expect((stats.allocs == 1) && (stats.frees == 1) && (stats.hits == 1));
+    free(_block);
+
+    ps();
+
+    puts("[SUCCESS]");
+    return 0;
+}
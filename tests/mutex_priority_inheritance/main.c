@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define PRIO_HIGH           (THREAD_PRIORITY_MAIN - 3)
+#define PRIO_MEDIUM         (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_LOW            (THREAD_PRIORITY_MAIN - 1)
+
+/* how long the low priority thread holds the mutexes */
+#define CRITICAL_US         (10000UL)
+/* how long the medium priority thread keeps the CPU busy */
+#define BUSY_US             (100000UL)
+/* the high priority thread waits at most for the critical section, with some
+ * slack for timer jitter */
+#define MAX_LATENCY_US      (2 * CRITICAL_US)
+/* how long the high priority thread waits for the mutex held by main */
+#define TIMEOUT_US          (1000UL)
+
+static char _stacks[4][THREAD_STACKSIZE_DEFAULT];
+static mutex_t _outer = MUTEX_INIT;
+static mutex_t _inner = MUTEX_INIT;
+static kernel_pid_t _main_pid;
+static uint32_t _latency;
+static bool _nested_ok = true;
+static bool _timeout_ok;
+
+static void _busy_wait(uint32_t us)
+{
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    while (ztimer_now(ZTIMER_USEC) - start < us) {}
+}
+
+static void _done(void)
+{
+    msg_t m;
+
+    msg_send(&m, _main_pid);
+}
+
+static void _check_priority(const char *step, uint8_t expected)
+{
+    uint8_t prio = thread_get_active()->priority;
+
+    printf("low: %s, priority %u\n", step, (unsigned)prio);
+    if (prio != expected) {
+        _nested_ok = false;
+    }
+}
+
+static void *_low(void *arg)
+{
+    (void)arg;
+
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    mutex_lock(&_outer);
+    mutex_lock(&_inner);
+    _busy_wait(CRITICAL_US);
+    /* the high priority thread waits for the outer mutex only, so releasing
+     * the inner one must keep its priority */
+    _check_priority("holding both mutexes", PRIO_HIGH);
+    mutex_unlock(&_inner);
+    _check_priority("released inner mutex", PRIO_HIGH);
+    mutex_unlock(&_outer);
+    _check_priority("released outer mutex", PRIO_LOW);
+    _done();
+    return NULL;
+}
+
+static void *_medium(void *arg)
+{
+    (void)arg;
+
+    ztimer_sleep(ZTIMER_USEC, 5000);
+    puts("medium: busy");
+    _busy_wait(BUSY_US);
+    puts("medium: done");
+    _done();
+    return NULL;
+}
+
+static void *_high(void *arg)
+{
+    (void)arg;
+
+    ztimer_sleep(ZTIMER_USEC, 3000);
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    mutex_lock(&_outer);
+    _latency = ztimer_now(ZTIMER_USEC) - start;
+    mutex_unlock(&_outer);
+    puts("high: got mutex");
+    _done();
+    return NULL;
+}
+
+static void *_high_timeout(void *arg)
+{
+    (void)arg;
+
+    _timeout_ok = (ztimer_mutex_lock_timeout(ZTIMER_USEC, &_outer,
+                                             TIMEOUT_US) == -ECANCELED);
+    puts("high: timed out");
+    return NULL;
+}
+
+/* main holds the mutex until the high priority thread gives up on it, and
+ * must get back its own priority then */
+static void _check_timeout(void)
+{
+    mutex_lock(&_outer);
+    thread_create(_stacks[3], sizeof(_stacks[3]), PRIO_HIGH, 0, _high_timeout,
+                  NULL, "high_timeout");
+    printf("main: holding mutex, priority %u\n",
+           (unsigned)thread_get_active()->priority);
+    _busy_wait(2 * TIMEOUT_US);
+    printf("main: waiter timed out, priority %u\n",
+           (unsigned)thread_get_active()->priority);
+    if (thread_get_active()->priority != THREAD_PRIORITY_MAIN) {
+        _timeout_ok = false;
+    }
+    mutex_unlock(&_outer);
+}
+
+/* ztimer_sleep() waits on a locked mutex on its stack, which the timer
+ * callback unlocks. main must not be taken for its owner, so locking another
+ * mutex afterwards must not look at the gone one. */
+static bool _check_sleep(void)
+{
+    ztimer_sleep(ZTIMER_USEC, 1000);
+    if (thread_get_active()->mutexes_held != NULL) {
+        return false;
+    }
+    mutex_lock(&_inner);
+    mutex_unlock(&_inner);
+    printf("main: slept, priority %u\n",
+           (unsigned)thread_get_active()->priority);
+    return (thread_get_active()->mutexes_held == NULL) &&
+           (thread_get_active()->priority == THREAD_PRIORITY_MAIN);
+}
+
+int main(void)
+{
+    msg_t m;
+
+    puts("Mutex priority inheritance test");
+    _main_pid = thread_getpid();
+
+    /* the threads sleep first, so all of them exist before the first one
+     * locks the mutexes */
+    thread_create(_stacks[0], sizeof(_stacks[0]), PRIO_LOW, 0, _low, NULL,
+                  "low");
+    thread_create(_stacks[1], sizeof(_stacks[1]), PRIO_MEDIUM, 0, _medium,
+                  NULL, "medium");
+    thread_create(_stacks[2], sizeof(_stacks[2]), PRIO_HIGH, 0, _high, NULL,
+                  "high");
+
+    for (unsigned i = 0; i < 3; i++) {
+        msg_receive(&m);
+    }
+
+    printf("high priority thread waited %" PRIu32 " us (max %lu us)\n",
+           _latency, MAX_LATENCY_US);
+
+    _check_timeout();
+    bool sleep_ok = _check_sleep();
+
+    puts(((_latency <= MAX_LATENCY_US) && _nested_ok && _timeout_ok &&
+          sleep_ok) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
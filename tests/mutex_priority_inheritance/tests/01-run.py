@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Mutex priority inheritance test")
+    child.expect_exact("high: got mutex")
+    child.expect_exact("medium: done")
+    child.expect(r"high priority thread waited \d+ us \(max \d+ us\)")
+    child.expect_exact("high: timed out")
+    child.expect(r"main: slept, priority \d+")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for topic based publish/subscribe
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "pubsub.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+#define TOPICS_NUMOF        (40U)
+#define QUEUE_SIZE          (4U)
+#define FLAG_NEWEST         (0x1)
+#define FLAG_OLDEST         (0x2)
+#define FLAG_FILTERED       (0x4)
+
+static pubsub_bus_t _bus;
+static pubsub_topic_t _topics[TOPICS_NUMOF];
+static unsigned _args[TOPICS_NUMOF];
+
+static pubsub_event_t _queue_newest[QUEUE_SIZE];
+static pubsub_event_t _queue_oldest[QUEUE_SIZE];
+static pubsub_event_t _queue_filtered[QUEUE_SIZE];
+static pubsub_event_t _queue_worker[QUEUE_SIZE];
+static pubsub_sub_t _newest;
+static pubsub_sub_t _oldest;
+static pubsub_sub_t _filtered;
+static pubsub_sub_t _worker;
+static pubsub_subscription_t _subs_newest[TOPICS_NUMOF];
+static pubsub_subscription_t _subs_oldest[TOPICS_NUMOF];
+static pubsub_subscription_t _sub_filtered;
+static pubsub_subscription_t _sub_worker;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static pubsub_event_t _worker_event;
+
+static bool _even(const pubsub_event_t *event, void *arg)
+{
+    (void)arg;
+    return (*(const unsigned *)event->arg % 2) == 0;
+}
+
+static void *_worker_thread(void *arg)
+{
+    (void)arg;
+
+    pubsub_sub_init(&_worker, _queue_worker, QUEUE_SIZE, PUBSUB_DROP_NEWEST,
+                    THREAD_FLAG_PUBSUB);
+    pubsub_subscribe(&_bus, &_sub_worker, &_worker, pubsub_topic("ping"),
+                     NULL, NULL);
+    pubsub_receive(&_worker, &_worker_event);
+    return NULL;
+}
+
+static void _test_drop(void)
+{
+    pubsub_event_t event;
+    pubsub_sub_stats_t stats;
+
+    pubsub_sub_init(&_newest, _queue_newest, QUEUE_SIZE, PUBSUB_DROP_NEWEST,
+                    FLAG_NEWEST);
+    pubsub_sub_init(&_oldest, _queue_oldest, QUEUE_SIZE, PUBSUB_DROP_OLDEST,
+                    FLAG_OLDEST);
+    for (unsigned i = 0; i < TOPICS_NUMOF; i++) {
+        pubsub_subscribe(&_bus, &_subs_newest[i], &_newest, _topics[i],
+                         NULL, NULL);
+        pubsub_subscribe(&_bus, &_subs_oldest[i], &_oldest, _topics[i],
+                         NULL, NULL);
+    }
+
+    for (unsigned i = 0; i < TOPICS_NUMOF; i++) {
+        expect(pubsub_publish(&_bus, _topics[i], &_args[i])
+               == ((i < QUEUE_SIZE) ? 2 : 1));
+    }
+    expect(thread_flags_clear(FLAG_NEWEST | FLAG_OLDEST)
+           == (FLAG_NEWEST | FLAG_OLDEST));
+
+    /* the first events were kept */
+    for (unsigned i = 0; i < QUEUE_SIZE; i++) {
+        expect(pubsub_try_receive(&_newest, &event));
+        expect((event.topic == _topics[i]) && (event.arg == &_args[i]));
+    }
+    expect(!pubsub_try_receive(&_newest, &event));
+
+    /* the last events were kept */
+    for (unsigned i = TOPICS_NUMOF - QUEUE_SIZE; i < TOPICS_NUMOF; i++) {
+        expect(pubsub_try_receive(&_oldest, &event));
+        expect((event.topic == _topics[i]) && (event.arg == &_args[i]));
+    }
+    expect(!pubsub_try_receive(&_oldest, &event));
+
+    pubsub_sub_stats(&_newest, &stats);
+    expect((stats.received == QUEUE_SIZE)
+           && (stats.dropped == TOPICS_NUMOF - QUEUE_SIZE));
+    pubsub_sub_stats(&_oldest, &stats);
+    expect((stats.received == QUEUE_SIZE)
+           && (stats.dropped == TOPICS_NUMOF - QUEUE_SIZE));
+
+    for (unsigned i = 0; i < TOPICS_NUMOF; i++) {
+        pubsub_unsubscribe(&_bus, &_subs_newest[i]);
+        pubsub_unsubscribe(&_bus, &_subs_oldest[i]);
+        expect(pubsub_publish(&_bus, _topics[i], &_args[i]) == 0);
+    }
+    puts("drop policies: OK");
+}
+
+static void _test_filter(void)
+{
+    pubsub_event_t event;
+
+    pubsub_sub_init(&_filtered, _queue_filtered, QUEUE_SIZE,
+                    PUBSUB_DROP_NEWEST, FLAG_FILTERED);
+    pubsub_subscribe(&_bus, &_sub_filtered, &_filtered, _topics[0], _even,
+                     NULL);
+    for (unsigned i = 0; i < QUEUE_SIZE; i++) {
+        expect(pubsub_publish(&_bus, _topics[0], &_args[i]) == (i + 1) % 2);
+    }
+    for (unsigned i = 0; i < QUEUE_SIZE; i += 2) {
+        pubsub_receive(&_filtered, &event);
+        expect(event.arg == &_args[i]);
+    }
+    expect(!pubsub_try_receive(&_filtered, &event));
+    pubsub_unsubscribe(&_bus, &_sub_filtered);
+    puts("filter: OK");
+}
+
+static void _test_latency(void)
+{
+    pubsub_sub_stats_t stats;
+
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _worker_thread, NULL, "worker");
+
+    /* the worker waits for the event and runs right away */
+    expect(pubsub_publish(&_bus, pubsub_topic("ping"), &_args[0]) == 1);
+    expect(_worker_event.arg == &_args[0]);
+
+    pubsub_sub_stats(&_worker, &stats);
+    expect((stats.received == 1) && (stats.dropped == 0));
+    expect(stats.latency_sum == stats.latency_max);
+    printf("latency: %" PRIu32 " us\n", stats.latency_max);
+    puts("latency: OK");
+}
+
+int main(void)
+{
+    char name[16];
+
+    puts("pubsub test");
+
+    pubsub_bus_init(&_bus);
+    for (unsigned i = 0; i < TOPICS_NUMOF; i++) {
+        snprintf(name, sizeof(name), "topic/%u", i);
+        _topics[i] = pubsub_topic(name);
+        _args[i] = i;
+    }
+
+    _test_drop();
+    _test_filter();
+    _test_latency();
+
+    puts("[SUCCESS]");
+    return 0;
+}
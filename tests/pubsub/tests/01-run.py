@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("pubsub test")
+    child.expect_exact("drop policies: OK")
+    child.expect_exact("filter: OK")
+    child.expect(r"latency: \d+ us\r\n")
+    child.expect_exact("latency: OK")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for earliest deadline first scheduling
+ *
+ * Two periodic tasks with (execution time, period) of (28 ms, 60 ms) and
+ * (40 ms, 90 ms) use 91 % of the CPU time. This is more than the bound of
+ * 83 % for two tasks scheduled rate monotonic, and indeed the second task
+ * misses its deadline: its first job is preempted twice and completes after
+ * 96 ms. The same task set is then scheduled with @ref sys_sched_edf, which
+ * meets all deadlines.
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "sched_edf.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define HYPERPERIODS        (10U)
+#define HYPERPERIOD_US      (180U * US_PER_MS)
+#define CALIBRATION_LOOPS   (1UL << 22)
+
+typedef struct {
+    uint32_t period;
+    uint32_t exec_time;
+    uint8_t rm_priority;
+    unsigned jobs;
+    unsigned misses;
+} task_t;
+
+static task_t _tasks[] = {
+    { .period = 60 * US_PER_MS, .exec_time = 28 * US_PER_MS,
+      .rm_priority = THREAD_PRIORITY_MAIN - 3 },
+    { .period = 90 * US_PER_MS, .exec_time = 40 * US_PER_MS,
+      .rm_priority = THREAD_PRIORITY_MAIN - 2 },
+};
+
+static char _stacks[ARRAY_SIZE(_tasks)][THREAD_STACKSIZE_DEFAULT];
+static uint64_t _loops_per_ms;
+static uint32_t _start;
+static bool _edf;
+static atomic_uint _done;
+
+static void _loop(uint64_t loops)
+{
+    for (volatile uint64_t i = 0; i < loops; i++) {}
+}
+
+static void _calibrate(void)
+{
+    uint32_t before = ztimer_now(ZTIMER_USEC);
+
+    _loop(CALIBRATION_LOOPS);
+    _loops_per_ms = CALIBRATION_LOOPS * US_PER_MS
+                  / (ztimer_now(ZTIMER_USEC) - before);
+}
+
+/* consumes exec_time of CPU time, not counting the time preempted */
+static void _job(const task_t *task)
+{
+    _loop(_loops_per_ms * task->exec_time / US_PER_MS);
+}
+
+static void *_task(void *arg)
+{
+    task_t *task = arg;
+    unsigned jobs = HYPERPERIOD_US / task->period * HYPERPERIODS;
+
+    ztimer_sleep(ZTIMER_USEC, _start - ztimer_now(ZTIMER_USEC));
+
+    task->jobs = 0;
+    task->misses = 0;
+    if (_edf) {
+        sched_edf_task_t edf;
+
+        sched_edf_task_init(&edf, task->period, task->period);
+        while (edf.jobs < jobs) {
+            _job(task);
+            sched_edf_task_wait(&edf);
+        }
+        task->jobs = edf.jobs;
+        task->misses = edf.misses;
+    }
+    else {
+        uint32_t release = ztimer_now(ZTIMER_USEC);
+
+        while (task->jobs < jobs) {
+            _job(task);
+            task->jobs++;
+            if (ztimer_now(ZTIMER_USEC) - release > task->period) {
+                task->misses++;
+            }
+            ztimer_periodic_wakeup(ZTIMER_USEC, &release, task->period);
+        }
+    }
+
+    atomic_fetch_add(&_done, 1);
+    return NULL;
+}
+
+static unsigned _run(bool edf)
+{
+    unsigned misses = 0;
+
+    _edf = edf;
+    _done = 0;
+    _start = ztimer_now(ZTIMER_USEC) + 10 * US_PER_MS;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_tasks); i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), _tasks[i].rm_priority,
+                      THREAD_CREATE_STACKTEST, _task, &_tasks[i], "task");
+    }
+
+    /* the tasks run at higher priorities than main */
+    while (atomic_load(&_done) < ARRAY_SIZE(_tasks)) {
+        ztimer_sleep(ZTIMER_USEC, 10 * US_PER_MS);
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_tasks); i++) {
+        printf("%s: period %u ms: %u jobs, %u misses\n",
+               edf ? "EDF" : "RM", (unsigned)(_tasks[i].period / US_PER_MS),
+               _tasks[i].jobs, _tasks[i].misses);
+        misses += _tasks[i].misses;
+    }
+
+    return misses;
+}
+
+int main(void)
+{
+    puts("sched_edf test");
+
+    _calibrate();
+
+    unsigned rm_misses = _run(false);
+    unsigned edf_misses = _run(true);
+
+    puts(((rm_misses > 0) && (edf_misses == 0)) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
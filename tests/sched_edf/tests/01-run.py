@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("sched_edf test")
+    child.expect(r"RM: period 60 ms: 30 jobs, (\d+) misses\r\n")
+    child.expect(r"RM: period 90 ms: 20 jobs, (\d+) misses\r\n")
+    assert int(child.match.group(1)) > 0
+    child.expect_exact("EDF: period 60 ms: 30 jobs, 0 misses")
+    child.expect_exact("EDF: period 90 ms: 20 jobs, 0 misses")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the scheduler trace recorder
+ *
+ * The main thread sends messages to a worker thread of higher priority,
+ * which then blocks on a mutex held by the main thread until it returns
+ * from a sleep. The resulting dump can be converted with
+ * `dist/tools/sched_trace/sched_trace.py`.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "sched_trace.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define ROUNDS          (4U)
+#define SLEEP_US        (1000U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _mutex = MUTEX_INIT;
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+    msg_t m, reply = { .type = 0x0200 };
+
+    while (1) {
+        msg_receive(&m);
+        mutex_lock(&_mutex);
+        mutex_unlock(&_mutex);
+        if (m.type == 0x0101) {
+            msg_reply(&m, &reply);
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("sched_trace test");
+
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _worker, NULL, "worker");
+
+    sched_trace_start();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        msg_t m = { .type = 0x0100 };
+
+        mutex_lock(&_mutex);
+        msg_send(&m, pid);
+        ztimer_sleep(ZTIMER_USEC, SLEEP_US);
+        mutex_unlock(&_mutex);
+    }
+
+    msg_t m = { .type = 0x0101 }, reply;
+
+    msg_send_receive(&m, &reply, pid);
+    sched_trace_record(SCHED_TRACE_USER, 1, reply.type);
+    sched_trace_dump();
+
+    puts("[SUCCESS]");
+    return 0;
+}
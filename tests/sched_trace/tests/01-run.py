@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("sched_trace test")
+    child.expect(r"sched_trace: begin 1 (\d+) 0 \d+\r\n")
+    assert int(child.match.group(1)) > 0
+    child.expect(r"sched_trace: thread \d+ main\r\n")
+    child.expect(r"sched_trace: thread \d+ worker\r\n")
+    child.expect(r"sched_trace: events( [0-9a-f]{24}){1,4}\r\n")
+    child.expect_exact("sched_trace: end")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the stack usage monitor
+ *
+ * Two threads use 60 % and 10 % of their stacks in a call that returns
+ * before they block for the first time. After they were switched out often
+ * enough, the watermarks must match a full scan of the stacks, and only the
+ * first thread must have raised an alarm. A third thread uses 10 % of a
+ * stack that is not painted and must not raise an alarm either.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "ps.h"
+#include "stack_monitor.h"
+#include "thread.h"
+
+#define STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#define THREADS         (3U)
+/* unpainted stack of the last thread */
+#define UNPAINTED       (THREADS - 1)
+/* enough switches to check the whole stack */
+#define ROUNDS          (STACKSIZE / (CONFIG_STACK_MONITOR_REFINE_WORDS * \
+                                      sizeof(uintptr_t)) + 1)
+
+static char _stacks[THREADS][STACKSIZE];
+static const unsigned _percent[THREADS] = { 60, 10, 10 };
+static kernel_pid_t _pids[THREADS];
+static volatile unsigned _alarms;
+
+static void _alarm(kernel_pid_t pid)
+{
+    for (unsigned i = 0; i < THREADS; i++) {
+        if (pid == _pids[i]) {
+            _alarms |= 1U << i;
+        }
+    }
+}
+
+static void __attribute__((noinline)) _use(size_t size)
+{
+    volatile char buf[size];
+
+    memset((char *)buf, 0x55, size);
+}
+
+static void *_worker(void *arg)
+{
+    msg_t m;
+
+    _use(STACKSIZE * (unsigned)(uintptr_t)arg / 100);
+    while (1) {
+        msg_receive(&m);
+    }
+
+    return NULL;
+}
+
+static int _check(unsigned i)
+{
+    thread_t *thread = thread_get(_pids[i]);
+    stack_monitor_info_t info;
+    unsigned scan = thread_get_stacksize(thread) -
+                    thread_measure_stack_free(thread_get_stackstart(thread));
+
+    stack_monitor_get(_pids[i], &info);
+    int ok = ((info.peak == scan) || (i == UNPAINTED)) &&
+             (info.alarm == (i == 0)) && (!!(_alarms & (1U << i)) == (i == 0));
+
+    printf("thread %u: peak %u, scan %u, alarm %u: %s\n", i,
+           (unsigned)info.peak, scan, (unsigned)info.alarm,
+           ok ? "OK" : "FAILED");
+    return ok;
+}
+
+int main(void)
+{
+    int ok = 1;
+
+    puts("stack_monitor test");
+
+    stack_monitor_set_alarm_cb(_alarm);
+    for (unsigned i = 0; i < THREADS; i++) {
+        _pids[i] = thread_create(_stacks[i], STACKSIZE,
+                                 THREAD_PRIORITY_MAIN - 1,
+                                 (i == UNPAINTED) ? 0 : THREAD_CREATE_STACKTEST,
+                                 _worker, (void *)(uintptr_t)_percent[i],
+                                 "worker");
+    }
+
+    /* every message switches a worker in and out again */
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        msg_t m = { .type = round };
+
+        for (unsigned i = 0; i < THREADS; i++) {
+            msg_send(&m, _pids[i]);
+        }
+    }
+
+    for (unsigned i = 0; i < THREADS; i++) {
+        ok &= _check(i);
+    }
+
+    ps();
+    puts(ok ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
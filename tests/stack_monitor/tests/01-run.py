@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2022 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("stack_monitor test")
+    child.expect(r"thread 0: peak \d+, scan \d+, alarm 1: OK\r\n")
+    child.expect(r"thread 1: peak \d+, scan \d+, alarm 0: OK\r\n")
+    child.expect(r"thread 2: peak \d+, scan \d+, alarm 0: OK\r\n")
+    child.expect(r"\| worker\s+\| bl rx\s+_ \|\s+\d+ \|\s+\d+ \(\s*\d+\)!")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
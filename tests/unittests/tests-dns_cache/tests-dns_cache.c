@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/af.h"
+#include "net/dns/cache.h"
+#include "ztimer.h"
+
+#include "tests-dns_cache.h"
+
+static const uint8_t _addr4[] = { 192, 0, 2, 1 };
+static const uint8_t _addr6[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                  0, 0, 0, 0, 0, 0, 0, 1 };
+
+static void set_up(void)
+{
+    dns_cache_flush();
+}
+
+static void test_dns_cache__miss(void)
+{
+    uint8_t addr[16];
+    dns_cache_stats_t before, after;
+
+    dns_cache_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_UNSPEC));
+    dns_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+}
+
+static void test_dns_cache__hit(void)
+{
+    uint8_t addr[16];
+    dns_cache_stats_t before, after;
+
+    dns_cache_add("example.org", _addr4, sizeof(_addr4), 60);
+    dns_cache_add("example.org", _addr6, sizeof(_addr6), 60);
+
+    dns_cache_get_stats(&before);
+    /* names are case-insensitive, IPv6 is preferred */
+    TEST_ASSERT_EQUAL_INT(16, dns_cache_query("Example.ORG", addr, AF_UNSPEC));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr6, addr, sizeof(_addr6)));
+    TEST_ASSERT_EQUAL_INT(4, dns_cache_query("example.org", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr4, addr, sizeof(_addr4)));
+    dns_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.hits + 2, after.hits);
+}
+
+static void test_dns_cache__negative(void)
+{
+    uint8_t addr[16];
+
+    dns_cache_add_negative("example.org", AF_INET6, 60);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_cache_query("example.org", addr, AF_INET6));
+    /* says nothing about IPv4 */
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET));
+
+    dns_cache_add_negative("example.com", AF_UNSPEC, 60);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_cache_query("example.com", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_cache_query("example.com", addr, AF_INET6));
+}
+
+static void test_dns_cache__unspec(void)
+{
+    uint8_t addr[16];
+
+    /* nothing is known about an IPv6 address yet */
+    dns_cache_add("example.org", _addr4, sizeof(_addr4), 60);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_UNSPEC));
+
+    dns_cache_add_negative("example.org", AF_INET6, 60);
+    TEST_ASSERT_EQUAL_INT(4, dns_cache_query("example.org", addr, AF_UNSPEC));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr4, addr, sizeof(_addr4)));
+
+    /* no address of either family */
+    dns_cache_add_negative("example.com", AF_INET6, 60);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.com", addr, AF_UNSPEC));
+    dns_cache_add_negative("example.com", AF_INET, 60);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_cache_query("example.com", addr, AF_UNSPEC));
+}
+
+static void test_dns_cache__ttl_zero(void)
+{
+    uint8_t addr[16];
+
+    dns_cache_add("example.org", _addr4, sizeof(_addr4), 0);
+    dns_cache_add_negative("example.com", AF_UNSPEC, 0);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.com", addr, AF_INET));
+}
+
+static void test_dns_cache__name_too_long(void)
+{
+    char name[CONFIG_DNS_CACHE_NAME_LEN + 2];
+    uint8_t addr[16];
+
+    memset(name, 'a', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    dns_cache_add(name, _addr4, sizeof(_addr4), 60);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query(name, addr, AF_INET));
+}
+
+static void test_dns_cache__lru(void)
+{
+    char name[16];
+    uint8_t addr[16];
+    dns_cache_stats_t before, after;
+
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; i++) {
+        snprintf(name, sizeof(name), "host%u", i);
+        dns_cache_add(name, _addr4, sizeof(_addr4), 60);
+    }
+    /* host0 is used last, host1 is the least recently used entry now */
+    TEST_ASSERT_EQUAL_INT(4, dns_cache_query("host0", addr, AF_INET));
+
+    dns_cache_get_stats(&before);
+    dns_cache_add("example.org", _addr4, sizeof(_addr4), 60);
+    dns_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.evictions + 1, after.evictions);
+
+    TEST_ASSERT_EQUAL_INT(4, dns_cache_query("example.org", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(4, dns_cache_query("host0", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("host1", addr, AF_INET));
+}
+
+static void test_dns_cache__expiry(void)
+{
+    uint8_t addr[16];
+
+    dns_cache_add("example.org", _addr4, sizeof(_addr4), 1);
+    TEST_ASSERT_EQUAL_INT(4, dns_cache_query("example.org", addr, AF_INET));
+    ztimer_sleep(ZTIMER_SEC, 2);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET));
+}
+
+static void test_dns_cache__flush(void)
+{
+    uint8_t addr[16];
+
+    dns_cache_add("example.org", _addr4, sizeof(_addr4), 60);
+    dns_cache_flush();
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.org", addr, AF_INET));
+}
+
+Test *tests_dns_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_dns_cache__miss),
+        new_TestFixture(test_dns_cache__hit),
+        new_TestFixture(test_dns_cache__negative),
+        new_TestFixture(test_dns_cache__unspec),
+        new_TestFixture(test_dns_cache__ttl_zero),
+        new_TestFixture(test_dns_cache__name_too_long),
+        new_TestFixture(test_dns_cache__lru),
+        new_TestFixture(test_dns_cache__expiry),
+        new_TestFixture(test_dns_cache__flush),
+    };
+
+    EMB_UNIT_TESTCALLER(dns_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&dns_cache_tests;
+}
+
+void tests_dns_cache(void)
+{
+    TESTS_RUN(tests_dns_cache_tests());
+}
+/** @} */
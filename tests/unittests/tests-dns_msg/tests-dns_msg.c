@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/af.h"
+#include "net/dns.h"
+#include "net/dns/msg.h"
+
+#include "tests-dns_msg.h"
+
+/* header of a reply to a single question */
+#define HDR(flags, ancount, nscount) \
+    0x12, 0x34, (flags) >> 8, (flags) & 0xff, 0x00, 0x01, \
+    0x00, (ancount), 0x00, (nscount), 0x00, 0x00
+/* question for example.org, "\3org" is at offset 0x14 */
+#define QUESTION(type) \
+    7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'o', 'r', 'g', 0, \
+    0x00, (type), 0x00, DNS_CLASS_IN
+/* pointer to example.org in the question */
+#define PTR_EXAMPLE_ORG     0xc0, 0x0c
+/* pointer to org in the question */
+#define PTR_ORG             0xc0, 0x14
+#define TTL(ttl) \
+    (ttl) >> 24, ((ttl) >> 16) & 0xff, ((ttl) >> 8) & 0xff, (ttl) & 0xff
+#define RR(type, ttl, rdlength) \
+    0x00, (type), 0x00, DNS_CLASS_IN, TTL(ttl), 0x00, (rdlength)
+/* SOA for org with the given negative caching time */
+#define SOA(ttl, minimum) \
+    PTR_ORG, RR(DNS_TYPE_SOA, ttl, 32), \
+    2, 'n', 's', PTR_ORG, \
+    4, 'h', 'o', 's', 't', PTR_ORG, \
+    TTL(1), TTL(3600), TTL(900), TTL(604800), TTL(minimum)
+
+#define DNS_TYPE_CNAME      (5)
+#define RCODE_SERVFAIL      (0x8182)
+#define RCODE_NXDOMAIN      (0x8183)
+#define RCODE_NOERROR       (0x8180)
+
+#define ADDR4               192, 0, 2, 1
+#define ADDR6               0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, \
+                            0, 0, 0, 0, 0, 0, 0, 1
+
+static const uint8_t _addr4[] = { ADDR4 };
+static const uint8_t _addr6[] = { ADDR6 };
+
+static void test_dns_msg__cname_ttl(void)
+{
+    static const uint8_t reply[] = {
+        HDR(RCODE_NOERROR, 3, 0),
+        QUESTION(DNS_TYPE_AAAA),
+        /* example.org CNAME www.example.org, rdata at offset 0x29 */
+        PTR_EXAMPLE_ORG, RR(DNS_TYPE_CNAME, 3600, 6),
+        3, 'w', 'w', 'w', PTR_EXAMPLE_ORG,
+        /* www.example.org CNAME host.example.org */
+        0xc0, 0x29, RR(DNS_TYPE_CNAME, 30, 7),
+        4, 'h', 'o', 's', 't', PTR_EXAMPLE_ORG,
+        /* host.example.org AAAA */
+        4, 'h', 'o', 's', 't', PTR_EXAMPLE_ORG, RR(DNS_TYPE_AAAA, 600, 16),
+        ADDR6,
+    };
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(16, dns_msg_parse_reply(reply, sizeof(reply),
+                                                  AF_INET6, addr, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr6, addr, sizeof(_addr6)));
+    /* the address is only valid as long as the shortest-lived CNAME */
+    TEST_ASSERT_EQUAL_INT(30, ttl);
+}
+
+static void test_dns_msg__skip_rdlength(void)
+{
+    static const uint8_t reply[] = {
+        HDR(RCODE_NOERROR, 2, 0),
+        QUESTION(DNS_TYPE_A),
+        /* skipped by its RDLENGTH */
+        PTR_EXAMPLE_ORG, RR(DNS_TYPE_AAAA, 600, 16), ADDR6,
+        PTR_EXAMPLE_ORG, RR(DNS_TYPE_A, 300, 4), ADDR4,
+    };
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(4, dns_msg_parse_reply(reply, sizeof(reply),
+                                                 AF_INET, addr, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr4, addr, sizeof(_addr4)));
+    TEST_ASSERT_EQUAL_INT(300, ttl);
+}
+
+static void test_dns_msg__nodata(void)
+{
+    static const uint8_t reply[] = {
+        HDR(RCODE_NOERROR, 0, 1),
+        QUESTION(DNS_TYPE_AAAA),
+        SOA(900, 120),
+    };
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_msg_parse_reply(reply, sizeof(reply),
+                                                       AF_INET6, addr, &ttl));
+    /* MINIMUM of the SOA is smaller than its TTL */
+    TEST_ASSERT_EQUAL_INT(120, ttl);
+}
+
+static void test_dns_msg__nxdomain(void)
+{
+    static const uint8_t reply[] = {
+        HDR(RCODE_NXDOMAIN, 0, 1),
+        QUESTION(DNS_TYPE_AAAA),
+        SOA(60, 120),
+    };
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_msg_parse_reply(reply, sizeof(reply),
+                                                       AF_INET6, addr, &ttl));
+    /* TTL of the SOA is smaller than its MINIMUM */
+    TEST_ASSERT_EQUAL_INT(60, ttl);
+}
+
+static void test_dns_msg__nxdomain_no_soa(void)
+{
+    static const uint8_t reply[] = {
+        HDR(RCODE_NXDOMAIN, 0, 0),
+        QUESTION(DNS_TYPE_AAAA),
+    };
+    uint8_t addr[16];
+    uint32_t ttl = 42;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, dns_msg_parse_reply(reply, sizeof(reply),
+                                                       AF_INET6, addr, &ttl));
+    /* nothing to cache the reply for */
+    TEST_ASSERT_EQUAL_INT(0, ttl);
+}
+
+static void test_dns_msg__servfail(void)
+{
+    static const uint8_t reply[] = {
+        HDR(RCODE_SERVFAIL, 0, 0),
+        QUESTION(DNS_TYPE_AAAA),
+    };
+    uint8_t addr[16];
+
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, dns_msg_parse_reply(reply, sizeof(reply),
+                                                        AF_INET6, addr, NULL));
+}
+
+Test *tests_dns_msg_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_dns_msg__cname_ttl),
+        new_TestFixture(test_dns_msg__skip_rdlength),
+        new_TestFixture(test_dns_msg__nodata),
+        new_TestFixture(test_dns_msg__nxdomain),
+        new_TestFixture(test_dns_msg__nxdomain_no_soa),
+        new_TestFixture(test_dns_msg__servfail),
+    };
+
+    EMB_UNIT_TESTCALLER(dns_msg_tests, NULL, NULL, fixtures);
+
+    return (Test *)&dns_msg_tests;
+}
+
+void tests_dns_msg(void)
+{
+    TESTS_RUN(tests_dns_msg_tests());
+}
+/** @} */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/fib.h"
+#include "net/fib/hashed.h"
+
+#include "tests-fib_hashed.h"
+
+#define TABLE_SIZE      (8)
+#define ADDR_SIZE       (16)
+
+static fib_entry_t _entries[TABLE_SIZE];
+static uint16_t _buckets[TABLE_SIZE];
+static fib_hashed_t _index = { .buckets = _buckets,
+                               .buckets_numof = TABLE_SIZE };
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = TABLE_SIZE,
+                              .mtx_access = MUTEX_INIT,
+                              .hashed = &_index };
+
+/* 2001:db8:0:10::/60 */
+static const uint8_t _pfx60[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0x10 };
+/* 2001:db8::/48 */
+static const uint8_t _pfx48[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8 };
+
+static void set_up(void)
+{
+    fib_init(&_table);
+}
+
+static void tear_down(void)
+{
+    fib_deinit(&_table);
+}
+
+static void _add(const uint8_t *dst, unsigned pfx_len, uint8_t next_hop)
+{
+    uint8_t nh[ADDR_SIZE] = { 0xfe, 0x80 };
+
+    nh[ADDR_SIZE - 1] = next_hop;
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&_table, 1, (uint8_t *)dst,
+                                           ADDR_SIZE,
+                                           pfx_len << FIB_FLAG_NET_PREFIX_SHIFT,
+                                           nh, ADDR_SIZE, 0,
+                                           (uint32_t)FIB_LIFETIME_NO_EXPIRE));
+}
+
+/* returns the last byte of the next hop, or the error */
+static int _get(const uint8_t *dst)
+{
+    uint8_t nh[ADDR_SIZE];
+    size_t nh_size = sizeof(nh);
+    kernel_pid_t iface;
+    uint32_t nh_flags;
+    int res = fib_get_next_hop(&_table, &iface, nh, &nh_size, &nh_flags,
+                               (uint8_t *)dst, ADDR_SIZE, 0);
+
+    return (res < 0) ? res : nh[ADDR_SIZE - 1];
+}
+
+static void test_fib_hashed__pfx_not_byte_aligned(void)
+{
+    uint8_t dst[ADDR_SIZE];
+
+    _add(_pfx60, 60, 60);
+    _add(_pfx48, 48, 48);
+
+    /* 2001:db8:0:1f::1 is in the /60 */
+    memcpy(dst, _pfx60, sizeof(dst));
+    dst[7] = 0x1f;
+    dst[ADDR_SIZE - 1] = 1;
+    TEST_ASSERT_EQUAL_INT(60, _get(dst));
+    /* 2001:db8:0:20::1 differs in the last bit of the /60 */
+    dst[7] = 0x20;
+    TEST_ASSERT_EQUAL_INT(48, _get(dst));
+    /* 2001:db9::1 in neither */
+    dst[3] = 0xb9;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _get(dst));
+}
+
+static void test_fib_hashed__pfx_host_bits(void)
+{
+    /* 2001:db8:0:1::1/64 */
+    uint8_t pfx[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1 };
+    uint8_t dst[ADDR_SIZE];
+
+    pfx[ADDR_SIZE - 1] = 1;
+    _add(pfx, 64, 64);
+
+    /* the bits after the prefix length are ignored */
+    memcpy(dst, pfx, sizeof(dst));
+    dst[8] = 0xff;
+    dst[ADDR_SIZE - 1] = 0x42;
+    TEST_ASSERT_EQUAL_INT(64, _get(dst));
+    /* the entry is also found by its exact address */
+    TEST_ASSERT_EQUAL_INT(64, _get(pfx));
+    dst[7] = 2;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _get(dst));
+}
+
+static void test_fib_hashed__longest_pfx(void)
+{
+    /* 2001:db8:0:10::4/127 */
+    uint8_t pfx127[ADDR_SIZE];
+    uint8_t dst[ADDR_SIZE];
+
+    memcpy(pfx127, _pfx60, sizeof(pfx127));
+    pfx127[ADDR_SIZE - 1] = 4;
+    _add(_pfx48, 48, 48);
+    _add(pfx127, 127, 127);
+    _add(_pfx60, 60, 60);
+
+    memcpy(dst, _pfx60, sizeof(dst));
+    dst[ADDR_SIZE - 1] = 5;
+    TEST_ASSERT_EQUAL_INT(127, _get(dst));
+    dst[ADDR_SIZE - 1] = 6;
+    TEST_ASSERT_EQUAL_INT(60, _get(dst));
+    dst[7] = 0;
+    TEST_ASSERT_EQUAL_INT(48, _get(dst));
+}
+
+Test *tests_fib_hashed_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fib_hashed__pfx_not_byte_aligned),
+        new_TestFixture(test_fib_hashed__pfx_host_bits),
+        new_TestFixture(test_fib_hashed__longest_pfx),
+    };
+
+    EMB_UNIT_TESTCALLER(fib_hashed_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&fib_hashed_tests;
+}
+
+void tests_fib_hashed(void)
+{
+    TESTS_RUN(tests_fib_hashed_tests());
+}
+/** @} */
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the gcoap path index
+ */
+
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "net/gcoap.h"
+#include "net/gcoap/path_index.h"
+
+#include "tests-gcoap.h"
+
+#define RANDOM_LISTENERS    (3U)
+#define RANDOM_RESOURCES    (8U)
+#define RANDOM_PATH_MAX     (8U)
+#define RANDOM_ROUNDS       (2000U)
+
+static const coap_resource_t _resources_first[] = {
+    { .path = "/pi/a", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+    { .path = "/pi/ab", .methods = COAP_GET },
+    { .path = "/pi/b", .methods = COAP_POST },
+    { .path = "/pi/b", .methods = COAP_PUT },
+    { .path = "/pi/cd/e", .methods = COAP_GET },
+};
+
+static const coap_resource_t _resources_second[] = {
+    { .path = "/pi/ab", .methods = COAP_GET },
+    { .path = "/pi/cd", .methods = COAP_GET },
+};
+
+static gcoap_listener_t _first = {
+    .resources = _resources_first,
+    .resources_len = ARRAY_SIZE(_resources_first),
+};
+
+static gcoap_listener_t _second = {
+    .resources = _resources_second,
+    .resources_len = ARRAY_SIZE(_resources_second),
+};
+
+static char _paths[RANDOM_LISTENERS][RANDOM_RESOURCES][RANDOM_PATH_MAX + 1];
+static coap_resource_t _random_resources[RANDOM_LISTENERS][RANDOM_RESOURCES];
+static gcoap_listener_t _random_listeners[RANDOM_LISTENERS];
+static uint32_t _rand_state = 0x2545f491;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the sequence must not depend on the random module */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void _random_path(char *path)
+{
+    /* few characters, so paths share prefixes and match each other */
+    static const char chars[] = "/ab";
+    unsigned len = 2 + _rand() % (RANDOM_PATH_MAX - 1);
+
+    path[0] = '/';
+    path[1] = 'r';
+    for (unsigned i = 2; i < len; i++) {
+        path[i] = chars[_rand() % (sizeof(chars) - 1)];
+    }
+    path[len] = '\0';
+}
+
+static coap_method_flags_t _random_method(void)
+{
+    return coap_method2flag(1 + _rand() % 4);
+}
+
+/* what the default request matcher finds, without relying on the order of
+ * the resources */
+static int _find_linear(const char *uri, coap_method_flags_t method,
+                        const coap_resource_t **resource,
+                        gcoap_listener_t **listener)
+{
+    int ret = GCOAP_RESOURCE_NO_PATH;
+
+    for (int l = RANDOM_LISTENERS - 1; l >= 0; l--) {
+        for (unsigned i = 0; i < RANDOM_RESOURCES; i++) {
+            const coap_resource_t *r = &_random_resources[l][i];
+
+            if (coap_match_path(r, (uint8_t *)uri) != 0) {
+                continue;
+            }
+            if (!(r->methods & method)) {
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+                continue;
+            }
+            *resource = r;
+            *listener = &_random_listeners[l];
+            return GCOAP_RESOURCE_FOUND;
+        }
+    }
+    return ret;
+}
+
+static void _find(int expected, const char *uri, coap_method_flags_t method,
+                  const coap_resource_t *expected_resource)
+{
+    const coap_resource_t *resource = NULL;
+    gcoap_listener_t *listener = NULL;
+
+    TEST_ASSERT_EQUAL_INT(expected,
+                          gcoap_path_index_find(uri, method,
+                                                GCOAP_SOCKET_TYPE_UDP,
+                                                &resource, &listener));
+    if (expected == GCOAP_RESOURCE_FOUND) {
+        TEST_ASSERT(resource == expected_resource);
+    }
+}
+
+static void set_up(void)
+{
+    static bool added;
+
+    if (added) {
+        return;
+    }
+    added = true;
+
+    TEST_ASSERT_EQUAL_INT(0, gcoap_path_index_add(&_first));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_path_index_add(&_second));
+
+    for (unsigned l = 0; l < RANDOM_LISTENERS; l++) {
+        for (unsigned i = 0; i < RANDOM_RESOURCES; i++) {
+            coap_resource_t *r = &_random_resources[l][i];
+
+            _random_path(_paths[l][i]);
+            r->path = _paths[l][i];
+            r->methods = _random_method();
+            if (_rand() % 4 == 0) {
+                r->methods |= COAP_MATCH_SUBTREE;
+            }
+        }
+        _random_listeners[l].resources = _random_resources[l];
+        _random_listeners[l].resources_len = RANDOM_RESOURCES;
+        TEST_ASSERT_EQUAL_INT(0, gcoap_path_index_add(&_random_listeners[l]));
+    }
+}
+
+/**
+ * @brief   Exact paths only match themselves
+ */
+static void test_gcoap_path_index_exact(void)
+{
+    _find(GCOAP_RESOURCE_FOUND, "/pi/cd/e", COAP_GET, &_resources_first[4]);
+    _find(GCOAP_RESOURCE_FOUND, "/pi/cd", COAP_GET, &_resources_second[1]);
+    _find(GCOAP_RESOURCE_NO_PATH, "/pi/c", COAP_GET, NULL);
+    _find(GCOAP_RESOURCE_NO_PATH, "/pi/cd/", COAP_GET, NULL);
+    _find(GCOAP_RESOURCE_NO_PATH, "/pi", COAP_GET, NULL);
+    _find(GCOAP_RESOURCE_NO_PATH, "/", COAP_GET, NULL);
+    _find(GCOAP_RESOURCE_NO_PATH, "", COAP_GET, NULL);
+}
+
+/**
+ * @brief   Paths with COAP_MATCH_SUBTREE match all paths they prefix
+ */
+static void test_gcoap_path_index_subtree(void)
+{
+    _find(GCOAP_RESOURCE_FOUND, "/pi/a", COAP_GET, &_resources_first[0]);
+    _find(GCOAP_RESOURCE_FOUND, "/pi/a/b/c", COAP_GET, &_resources_first[0]);
+    _find(GCOAP_RESOURCE_FOUND, "/pi/abc", COAP_GET, &_resources_first[0]);
+    _find(GCOAP_RESOURCE_WRONG_METHOD, "/pi/a/b", COAP_POST, NULL);
+}
+
+/**
+ * @brief   The method has to match and resources with the same path are
+ *          tried in order
+ */
+static void test_gcoap_path_index_method(void)
+{
+    _find(GCOAP_RESOURCE_FOUND, "/pi/b", COAP_POST, &_resources_first[2]);
+    _find(GCOAP_RESOURCE_FOUND, "/pi/b", COAP_PUT, &_resources_first[3]);
+    _find(GCOAP_RESOURCE_WRONG_METHOD, "/pi/b", COAP_GET, NULL);
+    _find(GCOAP_RESOURCE_WRONG_METHOD, "/pi/cd/e", COAP_DELETE, NULL);
+}
+
+/**
+ * @brief   The listener added last wins
+ */
+static void test_gcoap_path_index_precedence(void)
+{
+    _find(GCOAP_RESOURCE_FOUND, "/pi/ab", COAP_GET, &_resources_second[0]);
+    TEST_ASSERT(gcoap_path_index_contains(&_first));
+    TEST_ASSERT(gcoap_path_index_contains(&_second));
+}
+
+/**
+ * @brief   Listeners that do not fit are not added
+ */
+static void test_gcoap_path_index_full(void)
+{
+    /* the resources are not accessed if they do not fit */
+    gcoap_listener_t too_big = {
+        .resources = _resources_first,
+        .resources_len = CONFIG_GCOAP_PATH_INDEX_SIZE + 1,
+    };
+
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gcoap_path_index_add(&too_big));
+    TEST_ASSERT(!gcoap_path_index_contains(&too_big));
+    TEST_ASSERT(too_big.request_matcher == NULL);
+}
+
+/**
+ * @brief   The index finds the same as a linear search for random paths
+ */
+static void test_gcoap_path_index_random(void)
+{
+    for (unsigned i = 0; i < RANDOM_ROUNDS; i++) {
+        char uri[RANDOM_PATH_MAX + 1];
+        coap_method_flags_t method = _random_method();
+        const coap_resource_t *resource = NULL, *expected_resource = NULL;
+        gcoap_listener_t *listener = NULL, *expected_listener = NULL;
+
+        _random_path(uri);
+        int expected = _find_linear(uri, method, &expected_resource,
+                                    &expected_listener);
+        TEST_ASSERT_EQUAL_INT(expected,
+                              gcoap_path_index_find(uri, method,
+                                                    GCOAP_SOCKET_TYPE_UDP,
+                                                    &resource, &listener));
+        if (expected == GCOAP_RESOURCE_FOUND) {
+            TEST_ASSERT(expected_resource == resource);
+            TEST_ASSERT(expected_listener == listener);
+        }
+    }
+}
+
+Test *tests_gcoap_path_index_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gcoap_path_index_exact),
+        new_TestFixture(test_gcoap_path_index_subtree),
+        new_TestFixture(test_gcoap_path_index_method),
+        new_TestFixture(test_gcoap_path_index_precedence),
+        new_TestFixture(test_gcoap_path_index_full),
+        new_TestFixture(test_gcoap_path_index_random),
+    };
+
+    EMB_UNIT_TESTCALLER(gcoap_path_index_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gcoap_path_index_tests;
+}
+
+/** @} */
@@ -415,5 +415,6 @@ Test *tests_gcoap_tests(void)
 void tests_gcoap(void)
 {
     TESTS_RUN(tests_gcoap_tests());
+    TESTS_RUN(tests_gcoap_path_index_tests());
 }
 /** @} */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include "embUnit.h"
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktprof.h"
+
+#include "tests-gnrc_pktprof.h"
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_pktprof_reset();
+}
+
+static void test_pktprof_percentile__empty(void)
+{
+    gnrc_pktprof_hist_t hist;
+
+    gnrc_pktprof_get(GNRC_PKTPROF_IPV6, &hist);
+    TEST_ASSERT_EQUAL_INT(0, hist.count);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktprof_percentile(&hist, 50));
+}
+
+static void test_pktprof_percentile__buckets(void)
+{
+    gnrc_pktprof_hist_t hist;
+
+    for (unsigned i = 0; i < 90; i++) {
+        gnrc_pktprof_record(GNRC_PKTPROF_UDP, 10);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        gnrc_pktprof_record(GNRC_PKTPROF_UDP, 1000);
+    }
+    gnrc_pktprof_get(GNRC_PKTPROF_UDP, &hist);
+
+    TEST_ASSERT_EQUAL_INT(100, hist.count);
+    TEST_ASSERT_EQUAL_INT(1000, hist.max);
+    TEST_ASSERT_EQUAL_INT(90, hist.buckets[3]);
+    TEST_ASSERT_EQUAL_INT(10, hist.buckets[9]);
+    /* within [8, 16) and [512, 1024) respectively */
+    TEST_ASSERT_EQUAL_INT(11, gnrc_pktprof_percentile(&hist, 50));
+    TEST_ASSERT_EQUAL_INT(971, gnrc_pktprof_percentile(&hist, 99));
+    TEST_ASSERT_EQUAL_INT(1000, gnrc_pktprof_percentile(&hist, 100));
+}
+
+static void test_pktprof_percentile__last_bucket(void)
+{
+    gnrc_pktprof_hist_t hist;
+
+    gnrc_pktprof_record(GNRC_PKTPROF_SOCK, UINT32_MAX);
+    gnrc_pktprof_get(GNRC_PKTPROF_SOCK, &hist);
+    TEST_ASSERT_EQUAL_INT(1, hist.buckets[CONFIG_GNRC_PKTPROF_BUCKETS - 1]);
+    TEST_ASSERT(UINT32_MAX == gnrc_pktprof_percentile(&hist, 99));
+}
+
+static void test_pktprof_stamp__hops(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    gnrc_pktprof_hist_t hist;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pkt_append(pkt, netif);
+
+    /* the first stage has no previous stamp to count from */
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_NETIF);
+    gnrc_pktprof_get(GNRC_PKTPROF_NETIF, &hist);
+    TEST_ASSERT_EQUAL_INT(0, hist.count);
+
+    /* skipped stages are not counted */
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_IPV6);
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_SOCK);
+    gnrc_pktprof_get(GNRC_PKTPROF_SIXLOWPAN, &hist);
+    TEST_ASSERT_EQUAL_INT(0, hist.count);
+    gnrc_pktprof_get(GNRC_PKTPROF_IPV6, &hist);
+    TEST_ASSERT_EQUAL_INT(1, hist.count);
+    gnrc_pktprof_get(GNRC_PKTPROF_SOCK, &hist);
+    TEST_ASSERT_EQUAL_INT(1, hist.count);
+
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktprof_stamp__shared(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    gnrc_pktprof_hist_t hist;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pkt_append(pkt, netif);
+
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_NETIF);
+    /* dispatched to two receivers */
+    gnrc_pktbuf_hold(pkt, 1);
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_UDP);
+    gnrc_pktprof_get(GNRC_PKTPROF_UDP, &hist);
+    TEST_ASSERT_EQUAL_INT(0, hist.count);
+    gnrc_pktbuf_release(pkt);
+
+    /* the last receiver may stamp again */
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_SOCK);
+    gnrc_pktprof_get(GNRC_PKTPROF_SOCK, &hist);
+    TEST_ASSERT_EQUAL_INT(1, hist.count);
+
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktprof_stamp__no_netif(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+    gnrc_pktprof_hist_t hist;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_NETIF);
+    gnrc_pktprof_stamp(pkt, GNRC_PKTPROF_IPV6);
+    gnrc_pktprof_get(GNRC_PKTPROF_IPV6, &hist);
+    TEST_ASSERT_EQUAL_INT(0, hist.count);
+
+    gnrc_pktbuf_release(pkt);
+}
+
+Test *tests_gnrc_pktprof_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktprof_percentile__empty),
+        new_TestFixture(test_pktprof_percentile__buckets),
+        new_TestFixture(test_pktprof_percentile__last_bucket),
+        new_TestFixture(test_pktprof_stamp__hops),
+        new_TestFixture(test_pktprof_stamp__shared),
+        new_TestFixture(test_pktprof_stamp__no_netif),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_pktprof_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_pktprof_tests;
+}
+
+void tests_gnrc_pktprof(void)
+{
+    TESTS_RUN(tests_gnrc_pktprof_tests());
+}
+/** @} */
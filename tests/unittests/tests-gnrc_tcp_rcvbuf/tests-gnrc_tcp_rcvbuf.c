@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "net/gnrc/tcp.h"
+
+#include "include/gnrc_tcp_rcvbuf.h"
+
+#include "tests-gnrc_tcp_rcvbuf.h"
+
+#define CHUNK_SIZE      (CONFIG_GNRC_TCP_RCV_CHUNK_SIZE)
+#define TCB_NUMOF       (10U)
+
+static gnrc_tcp_tcb_t _tcbs[TCB_NUMOF];
+static uint8_t _data[GNRC_TCP_RCV_BUF_SIZE];
+
+static void set_up(void)
+{
+    _gnrc_tcp_rcvbuf_init();
+    memset(_tcbs, 0, sizeof(_tcbs));
+}
+
+static void _release_all(void)
+{
+    gnrc_tcp_rcvbuf_stats_t stats;
+
+    for (unsigned i = 0; i < TCB_NUMOF; i++) {
+        _gnrc_tcp_rcvbuf_release_buffer(&_tcbs[i]);
+    }
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(stats.chunks, stats.chunks_free);
+    TEST_ASSERT_EQUAL_INT(0, stats.chunks_reserved);
+    TEST_ASSERT_EQUAL_INT(0, stats.users);
+}
+
+/* opens a connection to a peer, or a listener if peer_port is 0 */
+static int _open(gnrc_tcp_tcb_t *tcb, uint16_t peer_port)
+{
+    int res;
+
+    tcb->peer_port = peer_port;
+    res = _gnrc_tcp_rcvbuf_get_buffer(tcb);
+    if (res == 0) {
+        tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    }
+    return res;
+}
+
+static void test_rcvbuf_wnd_growth(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_tcp_rcvbuf_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(0, _open(tcb, 1));
+    /* the last chunk and an MSS worth of reserved chunks */
+    TEST_ASSERT_EQUAL_INT(5 * CHUNK_SIZE, tcb->rcv_wnd);
+    /* grows up to the full receive buffer */
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, tcb->rcv_wnd);
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(7, stats.chunks_reserved);
+
+    /* data takes its part of the window */
+    TEST_ASSERT_EQUAL_INT(5 * CHUNK_SIZE,
+                          _gnrc_tcp_rcvbuf_add(tcb, _data, 5 * CHUNK_SIZE));
+    TEST_ASSERT_EQUAL_INT(3 * CHUNK_SIZE, tcb->rcv_wnd);
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    TEST_ASSERT_EQUAL_INT(3 * CHUNK_SIZE, tcb->rcv_wnd);
+
+    /* data beyond the window is denied */
+    TEST_ASSERT_EQUAL_INT(3 * CHUNK_SIZE,
+                          _gnrc_tcp_rcvbuf_add(tcb, _data, 4 * CHUNK_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, tcb->rcv_wnd);
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_rcvbuf_get_wnd(tcb));
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.denied);
+    TEST_ASSERT_EQUAL_INT(0, stats.chunks_reserved);
+
+    /* reading opens the window again, an MSS at a time */
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE,
+                          _gnrc_tcp_rcvbuf_get(tcb, _data, sizeof(_data)));
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    TEST_ASSERT_EQUAL_INT(5 * CHUNK_SIZE, tcb->rcv_wnd);
+
+    _release_all();
+}
+
+static void test_rcvbuf_listener(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_tcp_rcvbuf_stats_t stats;
+
+    /* a listener holds a chunk but reserves nothing */
+    TEST_ASSERT_EQUAL_INT(0, _open(tcb, 0));
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE, tcb->rcv_wnd);
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.chunks_reserved);
+
+    /* a SYN arrives */
+    tcb->peer_port = 1;
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    TEST_ASSERT_EQUAL_INT(5 * CHUNK_SIZE, tcb->rcv_wnd);
+
+    /* back to listening */
+    tcb->peer_port = 0;
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE, tcb->rcv_wnd);
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.chunks_reserved);
+
+    _release_all();
+}
+
+static void test_rcvbuf_fair_share(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_tcp_rcvbuf_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(0, _open(tcb, 1));
+    tcb->rcv_wnd = _gnrc_tcp_rcvbuf_get_wnd(tcb);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, tcb->rcv_wnd);
+
+    /* 11 chunks are free, 7 of them reserved */
+    for (unsigned i = 1; i < 5; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _open(&_tcbs[i], 0));
+        TEST_ASSERT_EQUAL_INT(CHUNK_SIZE, _tcbs[i].rcv_wnd);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _open(&_tcbs[5], 0));
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.refused);
+    TEST_ASSERT_EQUAL_INT(5, stats.users);
+
+    /* the fair share dropped, but the advertised window is kept */
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, _gnrc_tcp_rcvbuf_get_wnd(tcb));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE,
+                          _gnrc_tcp_rcvbuf_add(tcb, _data, sizeof(_data)));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE,
+                          _gnrc_tcp_rcvbuf_get(tcb, _data, sizeof(_data)));
+
+    /* grows up to the fair share of 12 / 5 chunks only, the new window is
+     * not advertised (e.g. as it is too small to announce) */
+    TEST_ASSERT_EQUAL_INT(2 * CHUNK_SIZE, _gnrc_tcp_rcvbuf_get_wnd(tcb));
+
+    /* more connections, the fair share drops to a single chunk */
+    TEST_ASSERT_EQUAL_INT(0, _open(&_tcbs[5], 0));
+    TEST_ASSERT_EQUAL_INT(0, _open(&_tcbs[6], 0));
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.chunks_reserved);
+
+    /* the reservation that wasn't advertised is given back */
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE, _gnrc_tcp_rcvbuf_get_wnd(tcb));
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.chunks_reserved);
+
+    /* and another connection is no longer denied more than its share */
+    TEST_ASSERT_EQUAL_INT(0, _open(&_tcbs[7], 2));
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE, _tcbs[7].rcv_wnd);
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE,
+                          _gnrc_tcp_rcvbuf_add(&_tcbs[7], _data, 2 * CHUNK_SIZE));
+    gnrc_tcp_get_rcvbuf_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.denied);
+    TEST_ASSERT_EQUAL_INT(1, stats.refused);
+
+    _release_all();
+}
+
+Test *tests_gnrc_tcp_rcvbuf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rcvbuf_wnd_growth),
+        new_TestFixture(test_rcvbuf_listener),
+        new_TestFixture(test_rcvbuf_fair_share),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_rcvbuf_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_tcp_rcvbuf_tests;
+}
+
+void tests_gnrc_tcp_rcvbuf(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_rcvbuf_tests());
+}
+/** @} */
@@ -165,6 +165,80 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* the byte by byte implementation the optimized one has to agree with */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++, accum_len++) {
+        csum += (accum_len & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _rand_state = 0x6b5f1d03;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the sequence must not depend on the random module */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void test_inet_csum__compare_random(void)
+{
+    /* large enough for the SIMD paths on native, + 8 for misalignment */
+    static uint8_t data[1500 + 8];
+
+    for (unsigned i = 0; i < 2000; i++) {
+        unsigned offset = _rand() % 8;
+        uint16_t len = _rand() % (sizeof(data) - offset);
+        uint16_t sum = _rand();
+        size_t accum_len = _rand() % 4;
+        /* all ones stresses carry handling */
+        uint8_t fill = (i & 1) ? 0xff : 0;
+
+        for (unsigned j = 0; j < sizeof(data); j++) {
+            data[j] = (_rand() % 4) ? fill : (uint8_t)_rand();
+        }
+        TEST_ASSERT_EQUAL_INT(
+            _ref_csum_slice(sum, &data[offset], len, accum_len),
+            inet_csum_slice(sum, &data[offset], len, accum_len));
+    }
+}
+
+static void test_inet_csum__compare_slices(void)
+{
+    static uint8_t data[600];
+
+    for (unsigned i = 0; i < 200; i++) {
+        uint16_t expected, sum = 0;
+        size_t pos = 0;
+
+        for (unsigned j = 0; j < sizeof(data); j++) {
+            data[j] = _rand();
+        }
+        expected = _ref_csum_slice(0, data, sizeof(data), 0);
+        /* checksum the same domain in random, also odd sized, slices */
+        while (pos < sizeof(data)) {
+            uint16_t len = _rand() % 80;
+
+            if (len > (sizeof(data) - pos)) {
+                len = sizeof(data) - pos;
+            }
+            sum = inet_csum_slice(sum, &data[pos], len, pos);
+            pos += len;
+        }
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +250,8 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__compare_random),
+        new_TestFixture(test_inet_csum__compare_slices),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "lfrb.h"
+#include "tests-lfrb.h"
+
+#define ELEMS_NUMOF     (8U)
+
+typedef struct {
+    uint32_t seq;
+    uint8_t data[3];
+} _elem_t;
+
+static _elem_t _lfrb_buffer[ELEMS_NUMOF];
+static atomic_uint_least32_t _flags[LFRB_MP_FLAGS_NUMOF(ELEMS_NUMOF)];
+static _elem_t _io[ELEMS_NUMOF * 2];
+static lfrb_t _lfrb;
+
+static void _fill(_elem_t *elems, unsigned n, uint32_t seq)
+{
+    for (unsigned i = 0; i < n; i++) {
+        elems[i].seq = seq + i;
+        memset(elems[i].data, (uint8_t)(seq + i), sizeof(elems[i].data));
+    }
+}
+
+static void _check(const _elem_t *elems, unsigned n, uint32_t seq)
+{
+    for (unsigned i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_INT(seq + i, elems[i].seq);
+        TEST_ASSERT_EQUAL_INT((uint8_t)(seq + i), elems[i].data[2]);
+    }
+}
+
+static void set_up(void)
+{
+    memset(_io, 0, sizeof(_io));
+    lfrb_init(&_lfrb, _lfrb_buffer, sizeof(_elem_t), ELEMS_NUMOF);
+}
+
+static void set_up_mp(void)
+{
+    memset(_io, 0, sizeof(_io));
+    lfrb_mp_init(&_lfrb, _lfrb_buffer, sizeof(_elem_t), ELEMS_NUMOF, _flags);
+}
+
+static void test_empty(void)
+{
+    TEST_ASSERT(lfrb_empty(&_lfrb));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_avail(&_lfrb));
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF, lfrb_free(&_lfrb));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_get(&_lfrb, _io, ELEMS_NUMOF));
+}
+
+static void test_put_get(void)
+{
+    _fill(_io, 3, 0);
+    TEST_ASSERT_EQUAL_INT(3, lfrb_put(&_lfrb, _io, 3));
+    TEST_ASSERT_EQUAL_INT(3, lfrb_avail(&_lfrb));
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF - 3, lfrb_free(&_lfrb));
+
+    memset(_io, 0, sizeof(_io));
+    TEST_ASSERT_EQUAL_INT(3, lfrb_get(&_lfrb, _io, ELEMS_NUMOF));
+    _check(_io, 3, 0);
+    TEST_ASSERT(lfrb_empty(&_lfrb));
+}
+
+static void test_full(void)
+{
+    _fill(_io, ELEMS_NUMOF * 2, 0);
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF, lfrb_put(&_lfrb, _io, ELEMS_NUMOF * 2));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_free(&_lfrb));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_put(&_lfrb, _io, 1));
+
+    memset(_io, 0, sizeof(_io));
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF, lfrb_get(&_lfrb, _io, ELEMS_NUMOF * 2));
+    _check(_io, ELEMS_NUMOF, 0);
+}
+
+static void test_wrap(void)
+{
+    uint32_t seq = 0;
+
+    /* move the positions so that every later put wraps around */
+    _fill(_io, 5, 0);
+    lfrb_put(&_lfrb, _io, 5);
+    lfrb_get(&_lfrb, _io, 5);
+
+    for (unsigned i = 0; i < 3 * ELEMS_NUMOF; i++) {
+        _fill(_io, 6, 5 + seq);
+        TEST_ASSERT_EQUAL_INT(6, lfrb_put(&_lfrb, _io, 6));
+        memset(_io, 0, sizeof(_io));
+        TEST_ASSERT_EQUAL_INT(6, lfrb_get(&_lfrb, _io, 6));
+        _check(_io, 6, 5 + seq);
+        seq += 6;
+    }
+}
+
+static void test_reserve_commit(void)
+{
+    unsigned n = ELEMS_NUMOF;
+    _elem_t *elems;
+
+    /* only the contiguous space up to the end of the buffer is reserved */
+    _fill(_io, 6, 0);
+    lfrb_put(&_lfrb, _io, 6);
+    lfrb_get(&_lfrb, _io, 4);
+
+    elems = lfrb_reserve(&_lfrb, &n);
+    TEST_ASSERT(elems == &_lfrb_buffer[6]);
+    TEST_ASSERT_EQUAL_INT(2, n);
+    _fill(elems, n, 6);
+
+    /* nothing is visible before the commit */
+    TEST_ASSERT_EQUAL_INT(2, lfrb_avail(&_lfrb));
+    lfrb_commit(&_lfrb, n);
+    TEST_ASSERT_EQUAL_INT(4, lfrb_avail(&_lfrb));
+
+    n = ELEMS_NUMOF;
+    elems = lfrb_reserve(&_lfrb, &n);
+    TEST_ASSERT(elems == &_lfrb_buffer[0]);
+    TEST_ASSERT_EQUAL_INT(4, n);
+    _fill(elems, 1, 8);
+    lfrb_commit(&_lfrb, 1);
+
+    TEST_ASSERT_EQUAL_INT(5, lfrb_get(&_lfrb, _io, ELEMS_NUMOF));
+    _check(_io, 5, 4);
+}
+
+static void test_reserve_full(void)
+{
+    unsigned n = 1;
+
+    _fill(_io, ELEMS_NUMOF, 0);
+    lfrb_put(&_lfrb, _io, ELEMS_NUMOF);
+    TEST_ASSERT_NULL(lfrb_reserve(&_lfrb, &n));
+    TEST_ASSERT_EQUAL_INT(0, n);
+}
+
+static void test_acquire_release(void)
+{
+    const _elem_t *elems;
+    unsigned n = ELEMS_NUMOF;
+
+    TEST_ASSERT_NULL(lfrb_acquire(&_lfrb, &n));
+    TEST_ASSERT_EQUAL_INT(0, n);
+
+    _fill(_io, 6, 0);
+    lfrb_put(&_lfrb, _io, 6);
+    lfrb_get(&_lfrb, _io, 6);
+    _fill(_io, 5, 6);
+    lfrb_put(&_lfrb, _io, 5);
+
+    /* only the contiguous elements up to the end of the buffer */
+    n = ELEMS_NUMOF;
+    elems = lfrb_acquire(&_lfrb, &n);
+    TEST_ASSERT(elems == &_lfrb_buffer[6]);
+    TEST_ASSERT_EQUAL_INT(2, n);
+    _check(elems, n, 6);
+    lfrb_release(&_lfrb, 1);
+    TEST_ASSERT_EQUAL_INT(4, lfrb_avail(&_lfrb));
+
+    n = ELEMS_NUMOF;
+    elems = lfrb_acquire(&_lfrb, &n);
+    TEST_ASSERT_EQUAL_INT(1, n);
+    _check(elems, n, 7);
+    lfrb_release(&_lfrb, n);
+
+    n = 2;
+    elems = lfrb_acquire(&_lfrb, &n);
+    TEST_ASSERT(elems == &_lfrb_buffer[0]);
+    TEST_ASSERT_EQUAL_INT(2, n);
+    _check(elems, n, 8);
+}
+
+static void test_mp_put_get(void)
+{
+    _fill(_io, ELEMS_NUMOF * 2, 0);
+    TEST_ASSERT_EQUAL_INT(5, lfrb_mp_put(&_lfrb, _io, 5));
+    TEST_ASSERT_EQUAL_INT(5, lfrb_get(&_lfrb, &_io[ELEMS_NUMOF], 5));
+    _check(&_io[ELEMS_NUMOF], 5, 0);
+
+    /* wraps around, so it is reserved in two parts */
+    _fill(_io, ELEMS_NUMOF * 2, 5);
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF, lfrb_mp_put(&_lfrb, _io,
+                                                   ELEMS_NUMOF * 2));
+    TEST_ASSERT_EQUAL_INT(0, lfrb_free(&_lfrb));
+    memset(_io, 0, sizeof(_io));
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF, lfrb_get(&_lfrb, _io, ELEMS_NUMOF));
+    _check(_io, ELEMS_NUMOF, 5);
+}
+
+static void test_mp_commit_order(void)
+{
+    unsigned n1 = 2, n2 = 3;
+    _elem_t *first = lfrb_mp_reserve(&_lfrb, &n1);
+    _elem_t *second = lfrb_mp_reserve(&_lfrb, &n2);
+
+    TEST_ASSERT(first == &_lfrb_buffer[0]);
+    TEST_ASSERT(second == &_lfrb_buffer[2]);
+    TEST_ASSERT_EQUAL_INT(ELEMS_NUMOF - 5, lfrb_free(&_lfrb));
+
+    /* the second reservation is committed first, but cannot be read until
+     * the first one is committed as well */
+    _fill(second, n2, 2);
+    lfrb_mp_commit(&_lfrb, second, n2);
+    TEST_ASSERT_EQUAL_INT(0, lfrb_avail(&_lfrb));
+
+    _fill(first, n1, 0);
+    lfrb_mp_commit(&_lfrb, first, n1);
+    TEST_ASSERT_EQUAL_INT(5, lfrb_avail(&_lfrb));
+    TEST_ASSERT_EQUAL_INT(5, lfrb_get(&_lfrb, _io, ELEMS_NUMOF));
+    _check(_io, 5, 0);
+}
+
+static void test_mp_reuse(void)
+{
+    /* the commit flags must be clear again whenever space is reused */
+    for (uint32_t seq = 0; seq < 4 * ELEMS_NUMOF;) {
+        unsigned n = 3;
+        _elem_t *elems = lfrb_mp_reserve(&_lfrb, &n);
+
+        TEST_ASSERT_NOT_NULL(elems);
+        _fill(elems, n, seq);
+        TEST_ASSERT_EQUAL_INT(0, lfrb_avail(&_lfrb));
+        lfrb_mp_commit(&_lfrb, elems, n);
+        TEST_ASSERT_EQUAL_INT(n, lfrb_get(&_lfrb, _io, ELEMS_NUMOF));
+        _check(_io, n, seq);
+        /* less than 3 at the end of the buffer */
+        seq += n;
+    }
+}
+
+static Test *tests_lfrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_empty),
+        new_TestFixture(test_put_get),
+        new_TestFixture(test_full),
+        new_TestFixture(test_wrap),
+        new_TestFixture(test_reserve_commit),
+        new_TestFixture(test_reserve_full),
+        new_TestFixture(test_acquire_release),
+    };
+
+    EMB_UNIT_TESTCALLER(lfrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&lfrb_tests;
+}
+
+static Test *tests_lfrb_mp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_empty),
+        new_TestFixture(test_mp_put_get),
+        new_TestFixture(test_mp_commit_order),
+        new_TestFixture(test_mp_reuse),
+    };
+
+    EMB_UNIT_TESTCALLER(lfrb_mp_tests, set_up_mp, NULL, fixtures);
+
+    return (Test *)&lfrb_mp_tests;
+}
+
+void tests_lfrb(void)
+{
+    TESTS_RUN(tests_lfrb_tests());
+    TESTS_RUN(tests_lfrb_mp_tests());
+}
+/** @} */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include "embUnit.h"
+#include "kernel_defines.h"
+
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+
+#include "unittests-constants.h"
+#include "tests-netreg_hashed.h"
+
+#define PORTS_NUMOF     (64U)
+
+static gnrc_netreg_entry_t _ports[PORTS_NUMOF];
+
+static void set_up(void)
+{
+    gnrc_netreg_init();
+    gnrc_netreg_stats_reset();
+}
+
+static void _register_ports(void)
+{
+    for (unsigned i = 0; i < PORTS_NUMOF; i++) {
+        gnrc_netreg_entry_init_pid(&_ports[i], TEST_UINT16 + i, TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &_ports[i]));
+    }
+}
+
+static void test_netreg_hashed__lookup_all(void)
+{
+    _register_ports();
+    for (unsigned i = 0; i < PORTS_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + i);
+
+        TEST_ASSERT(res == &_ports[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    }
+    /* same demux context, other type */
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                        TEST_UINT16 + PORTS_NUMOF));
+}
+
+static void test_netreg_hashed__lookup_depth(void)
+{
+    gnrc_netreg_stats_t stats;
+
+    _register_ports();
+    for (unsigned i = 0; i < PORTS_NUMOF; i++) {
+        gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i);
+    }
+    gnrc_netreg_stats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(PORTS_NUMOF, stats.lookups);
+    /* a single list would be walked to the end for the first port */
+    TEST_ASSERT(stats.depth_max < PORTS_NUMOF);
+    TEST_ASSERT(stats.visited < (PORTS_NUMOF * (PORTS_NUMOF + 1)) / 2);
+}
+
+static void test_netreg_hashed__unregister(void)
+{
+    _register_ports();
+    for (unsigned i = 0; i < PORTS_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &_ports[i]);
+    }
+    for (unsigned i = 0; i < PORTS_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + i);
+
+        TEST_ASSERT((i % 2) ? (res == &_ports[i]) : (res == NULL));
+    }
+}
+
+static void test_netreg_stats__count(void)
+{
+    gnrc_netreg_stats_t stats;
+
+    gnrc_netreg_entry_init_pid(&_ports[0], TEST_UINT16, TEST_UINT8);
+    gnrc_netreg_entry_init_pid(&_ports[1], TEST_UINT16, TEST_UINT8 + 1);
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_ports[0]);
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_ports[1]);
+
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    gnrc_netreg_stats_get(&stats);
+    /* two hits, each visiting one entry, and the final miss */
+    TEST_ASSERT_EQUAL_INT(3, stats.lookups);
+    TEST_ASSERT_EQUAL_INT(2, stats.visited);
+    TEST_ASSERT_EQUAL_INT(1, stats.depth_max);
+
+    gnrc_netreg_stats_reset();
+    gnrc_netreg_stats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.lookups);
+    TEST_ASSERT_EQUAL_INT(0, stats.visited);
+    TEST_ASSERT_EQUAL_INT(0, stats.depth_max);
+}
+
+Test *tests_netreg_hashed_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netreg_hashed__lookup_all),
+        new_TestFixture(test_netreg_hashed__lookup_depth),
+        new_TestFixture(test_netreg_hashed__unregister),
+        new_TestFixture(test_netreg_stats__count),
+    };
+
+    EMB_UNIT_TESTCALLER(netreg_hashed_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netreg_hashed_tests;
+}
+
+void tests_netreg_hashed(void)
+{
+    TESTS_RUN(tests_netreg_hashed_tests());
+}
+/** @} */
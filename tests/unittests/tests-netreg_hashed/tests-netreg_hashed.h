@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``gnrc_netreg_hashed`` and
+ *              ``gnrc_netreg_stats`` modules
+ */
+#ifndef TESTS_NETREG_HASHED_H
+#define TESTS_NETREG_HASHED_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_netreg_hashed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_NETREG_HASHED_H */
+/** @} */
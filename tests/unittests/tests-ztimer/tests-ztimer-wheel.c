@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2022 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ztimer timer wheel
+ */
+
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer.h"
+
+#define TIMER_NUMOF     (48U)
+#define RANDOM_ROUNDS   (4000U)
+#define WHEEL_SHIFT     (4U)
+
+typedef struct {
+    ztimer_t timer;
+    ztimer_clock_t *clock;
+    uint32_t fired;         /**< clock time the timer fired at */
+    unsigned count;         /**< number of times the timer fired */
+} _timer_t;
+
+static ztimer_mock_t _mock_list;
+static ztimer_mock_t _mock_wheel;
+static ztimer_wheel_t _wheel;
+static _timer_t _list_timers[TIMER_NUMOF];
+static _timer_t _wheel_timers[TIMER_NUMOF];
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the sequence must not depend on the random module */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void _cb(void *arg)
+{
+    _timer_t *t = arg;
+
+    t->fired = ztimer_now(t->clock);
+    t->count++;
+}
+
+static void _init_timers(_timer_t *timers, ztimer_clock_t *clock)
+{
+    memset(timers, 0, TIMER_NUMOF * sizeof(*timers));
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        timers[i].timer.callback = _cb;
+        timers[i].timer.arg = &timers[i];
+        timers[i].clock = clock;
+    }
+}
+
+static void _init(uint8_t width)
+{
+    ztimer_mock_init(&_mock_list, width);
+    ztimer_mock_init(&_mock_wheel, width);
+    ztimer_wheel_init(&_mock_wheel.super, &_wheel, WHEEL_SHIFT);
+    _init_timers(_list_timers, &_mock_list.super);
+    _init_timers(_wheel_timers, &_mock_wheel.super);
+}
+
+static void _advance(uint32_t val)
+{
+    ztimer_mock_advance(&_mock_list, val);
+    ztimer_mock_advance(&_mock_wheel, val);
+}
+
+/* values spread over all levels of the wheel, including its last slots and
+ * values beyond its range */
+static uint32_t _random_val(void)
+{
+    unsigned bits = _rand() % 32;
+
+    return _rand() & ((1UL << bits) - 1);
+}
+
+static void _check_equal(void)
+{
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(_list_timers[i].count, _wheel_timers[i].count);
+        TEST_ASSERT_EQUAL_INT(_list_timers[i].fired, _wheel_timers[i].fired);
+        TEST_ASSERT_EQUAL_INT(
+            ztimer_is_set(&_mock_list.super, &_list_timers[i].timer),
+            ztimer_is_set(&_mock_wheel.super, &_wheel_timers[i].timer));
+    }
+}
+
+/**
+ * @brief   Timers on every level fire exactly at their target
+ */
+static void test_ztimer_wheel_levels(void)
+{
+    /* within the current slot, on levels 0 to 3, beyond the wheel */
+    static const uint32_t vals[] = {
+        3, 17, 500, 20000, 700000, 3000000, 0x80000000ul, 0xfffffffful
+    };
+    ztimer_clock_t *z = &_mock_wheel.super;
+
+    _init(32);
+    ztimer_mock_advance(&_mock_wheel, 5);
+    for (unsigned i = 0; i < ARRAY_SIZE(vals); i++) {
+        ztimer_set(z, &_wheel_timers[i].timer, vals[i]);
+        TEST_ASSERT(ztimer_is_set(z, &_wheel_timers[i].timer));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(vals); i++) {
+        uint32_t now = ztimer_now(z);
+
+        ztimer_mock_advance(&_mock_wheel, vals[i] + 5 - now - 1);
+        TEST_ASSERT_EQUAL_INT(0, _wheel_timers[i].count);
+        TEST_ASSERT(ztimer_is_set(z, &_wheel_timers[i].timer));
+        ztimer_mock_advance(&_mock_wheel, 1);
+        TEST_ASSERT_EQUAL_INT(1, _wheel_timers[i].count);
+        TEST_ASSERT_EQUAL_INT(vals[i] + 5, _wheel_timers[i].fired);
+        TEST_ASSERT(!ztimer_is_set(z, &_wheel_timers[i].timer));
+    }
+}
+
+/**
+ * @brief   Removed timers don't fire and the clock stops when empty
+ */
+static void test_ztimer_wheel_remove(void)
+{
+    ztimer_clock_t *z = &_mock_wheel.super;
+
+    _init(32);
+    ztimer_set(z, &_wheel_timers[0].timer, 1000);
+    ztimer_set(z, &_wheel_timers[1].timer, 1000);
+    ztimer_set(z, &_wheel_timers[2].timer, 100000);
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[1].timer));
+    TEST_ASSERT(!ztimer_remove(z, &_wheel_timers[1].timer));
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[2].timer));
+    ztimer_mock_advance(&_mock_wheel, 200000);
+    TEST_ASSERT_EQUAL_INT(1, _wheel_timers[0].count);
+    TEST_ASSERT_EQUAL_INT(0, _wheel_timers[1].count);
+    TEST_ASSERT_EQUAL_INT(0, _wheel_timers[2].count);
+    TEST_ASSERT_EQUAL_INT(0, _mock_wheel.armed);
+}
+
+/**
+ * @brief   Timers are removed from the head, the middle and the end of a slot
+ */
+static void test_ztimer_wheel_remove_slot(void)
+{
+    ztimer_clock_t *z = &_mock_wheel.super;
+
+    _init(32);
+    /* all in the same slot, the last one set is its head */
+    for (unsigned i = 0; i < 4; i++) {
+        ztimer_set(z, &_wheel_timers[i].timer, 1000);
+    }
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[3].timer));
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[1].timer));
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[0].timer));
+    TEST_ASSERT(ztimer_is_set(z, &_wheel_timers[2].timer));
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[2].timer));
+    TEST_ASSERT(!ztimer_is_set(z, &_wheel_timers[2].timer));
+    /* the slot is empty again, so the clock stops */
+    ztimer_mock_advance(&_mock_wheel, 2000);
+    TEST_ASSERT_EQUAL_INT(0, _mock_wheel.armed);
+    for (unsigned i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _wheel_timers[i].count);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        ztimer_set(z, &_wheel_timers[i].timer, 1000);
+    }
+    TEST_ASSERT(ztimer_remove(z, &_wheel_timers[2].timer));
+    ztimer_mock_advance(&_mock_wheel, 1000);
+    TEST_ASSERT_EQUAL_INT(1, _wheel_timers[0].count);
+    TEST_ASSERT_EQUAL_INT(1, _wheel_timers[1].count);
+    TEST_ASSERT_EQUAL_INT(0, _wheel_timers[2].count);
+    TEST_ASSERT_EQUAL_INT(1, _wheel_timers[3].count);
+}
+
+/**
+ * @brief   Timers that were never set are not taken for timers in the wheel
+ */
+static void test_ztimer_wheel_uninitialized(void)
+{
+    ztimer_clock_t *z = &_mock_wheel.super;
+    ztimer_base_t *link = NULL;
+    ztimer_t t;
+
+    _init(32);
+    ztimer_set(z, &_wheel_timers[0].timer, 100000);
+    /* what a timer on the stack may look like before its first use */
+    memset(&t, 0x5a, sizeof(t));
+    t.base.pprev = &link;
+    t.callback = _cb;
+    t.arg = &_wheel_timers[1];
+    TEST_ASSERT(!ztimer_remove(z, &t));
+    ztimer_set(z, &t, 100000);
+    TEST_ASSERT(ztimer_is_set(z, &t));
+    ztimer_mock_advance(&_mock_wheel, 100000);
+    TEST_ASSERT_EQUAL_INT(1, _wheel_timers[0].count);
+    TEST_ASSERT_EQUAL_INT(1, _wheel_timers[1].count);
+    TEST_ASSERT(!ztimer_is_set(z, &t));
+    TEST_ASSERT_NULL(link);
+}
+
+static void _random(uint8_t width)
+{
+    _rand_state = 0x2545f491;
+    _init(width);
+    for (unsigned i = 0; i < RANDOM_ROUNDS; i++) {
+        unsigned idx = _rand() % TIMER_NUMOF;
+        uint32_t val = _random_val();
+
+        switch (_rand() % 4) {
+        case 0:
+            TEST_ASSERT_EQUAL_INT(
+                ztimer_remove(&_mock_list.super, &_list_timers[idx].timer),
+                ztimer_remove(&_mock_wheel.super, &_wheel_timers[idx].timer));
+            break;
+        case 1:
+            /* mostly small steps, so timers fire every now and then */
+            _advance(val >> (_rand() % 16));
+            break;
+        default:
+            ztimer_set(&_mock_list.super, &_list_timers[idx].timer, val);
+            ztimer_set(&_mock_wheel.super, &_wheel_timers[idx].timer, val);
+            break;
+        }
+        _check_equal();
+    }
+    /* let all timers expire */
+    for (unsigned i = 0; i < 4; i++) {
+        _advance(0x40000000ul);
+    }
+    _check_equal();
+}
+
+/**
+ * @brief   A clock with wheel behaves like one with the list only
+ */
+static void test_ztimer_wheel_random32(void)
+{
+    _random(32);
+}
+
+/**
+ * @brief   Same on a clock that needs extension
+ */
+static void test_ztimer_wheel_random16(void)
+{
+    _random(16);
+}
+
+Test *tests_ztimer_wheel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_wheel_levels),
+        new_TestFixture(test_ztimer_wheel_remove),
+        new_TestFixture(test_ztimer_wheel_remove_slot),
+        new_TestFixture(test_ztimer_wheel_uninitialized),
+        new_TestFixture(test_ztimer_wheel_random32),
+        new_TestFixture(test_ztimer_wheel_random16),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_wheel_tests, NULL, NULL, fixtures);
+
+    return (Test *)&ztimer_wheel_tests;
+}
+
+/** @} */